@@ -58,7 +58,6 @@ private:
 	/**
 	* Put private members here.
 	*/
-	NMR::PModelMeshObject meshObject();
 	NMR::CMesh* mesh();
 
 	NMR::CMeshInformation_Properties* getMeshInformationProperties();
@@ -77,6 +76,8 @@ public:
 	*/
 	CMeshObject(NMR::PModelResource pResource);
 
+	NMR::PModelMeshObject meshObject();
+
 	/**
 	* Public member functions to implement.
 	*/
@@ -105,6 +106,14 @@ public:
 
 	bool IsManifoldAndOriented();
 
+	void SetFileBackedStorageActive(const bool bFileBackedStorageActive, const std::string & sDirectory);
+
+	bool GetFileBackedStorageActive();
+
+	void SetQuantizedStorageActive(const bool bQuantizedStorageActive, const sLib3MFPosition Origin, const Lib3MF_double dUnits, const Lib3MF_uint32 nBitCount);
+
+	bool GetQuantizedStorageActive();
+
 	bool IsMeshObject();
 
 	bool IsComponentsObject();
@@ -141,6 +141,8 @@ public:
 
 	IMeshObject * AddMeshObject ();
 
+	IMeshObject * AddMeshObjectCopy (IMeshObject* pSourceMeshObject);
+
 	IComponentsObject * AddComponentsObject ();
 
 	ISliceStack * AddSliceStack(const Lib3MF_double dZBottom);
@@ -95,6 +95,14 @@ public:
 
 	bool GetStrictModeActive ();
 
+	void SetFileBackedMeshStorageActive (const bool bFileBackedMeshStorageActive, const std::string & sDirectory);
+
+	bool GetFileBackedMeshStorageActive ();
+
+	void SetParallelMeshParsingActive (const bool bParallelMeshParsingActive);
+
+	bool GetParallelMeshParsingActive ();
+
 	std::string GetWarning (const Lib3MF_uint32 nIndex, Lib3MF_uint32 & nErrorCode);
 
 	Lib3MF_uint32 GetWarningCount ();
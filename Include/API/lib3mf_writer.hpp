@@ -93,6 +93,10 @@ public:
 
 	void SetDecimalPrecision(const Lib3MF_uint32 nDecimalPrecision) override;
 
+	void SetMeshReorderingActive(const bool bMeshReorderingActive) override;
+
+	bool GetMeshReorderingActive() override;
+
 	IBinaryStream * CreateBinaryStream(const std::string & sPath);
 
 	void AssignBinaryStream(IBase* pInstance, IBinaryStream* pBinaryStream);
@@ -33,6 +33,7 @@ Abstract: Progress Monitor
 
 #include "Common/3MF_ProgressTypes.h"
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <stack>
@@ -53,6 +54,10 @@ namespace NMR
 		CProgressMonitor();
 		void SetProgressCallback(Lib3MFProgressCallback callback, void* userData);
 		void ClearProgressCallback();
+		// Shares one cancellation between monitors, e.g. with monitors of worker threads. A monitor reports
+		// cancellation once the flag is set, and sets it when its own callback cancels.
+		void SetCancelFlag(std::shared_ptr<std::atomic<bool>> pCancelFlag);
+		std::shared_ptr<std::atomic<bool>> GetCancelFlag();
 		// Returns true if the last callback call returned false
 		bool WasAborted();
 		bool QueryCancelled(bool throwIfCancelled);
@@ -73,6 +78,9 @@ namespace NMR
 		void* m_userData;
 		bool m_lastCallbackResult;
 		std::mutex m_callbackMutex;
+		std::shared_ptr<std::atomic<bool>> m_pCancelFlag;
+
+		bool QueryCallback(ProgressIdentifier identifier, bool throwIfCancelled);
 	};
 
 	typedef std::shared_ptr <CProgressMonitor> PProgressMonitor;
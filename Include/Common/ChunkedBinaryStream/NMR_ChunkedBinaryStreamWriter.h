@@ -68,6 +68,8 @@ namespace NMR {
 
 		nfUint32 addIntArray (const nfInt32 * pData, nfUint32 nLength, eChunkedBinaryPredictionType predictionType);
 		nfUint32 addFloatArray(const nfFloat * pData, nfUint32 nLength, eChunkedBinaryPredictionType predictionType, nfFloat fDiscretizationUnits);
+		// Writes the same entry as addFloatArray, for values which are given as multiples of the units already
+		nfUint32 addQuantizedFloatArray(const nfInt32 * pValues, nfUint32 nLength, eChunkedBinaryPredictionType predictionType, nfFloat fDiscretizationUnits);
 
 		void copyToStream (PExportStream pStream);
 
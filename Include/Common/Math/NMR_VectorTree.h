@@ -26,8 +26,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 Abstract:
 
-NMR_VectorTree.h defines a n*log(n) lookup tree class to identify vectors by
-their position.
+NMR_VectorTree.h defines a lookup class to identify vectors by their position.
+Positions are rounded down to a grid with the given unit size, and looked up in a
+CVertexWeldingTable.
 
 --*/
 
@@ -35,22 +36,15 @@ their position.
 #define __NMR_VECTORTREE
 
 #include "Common/Math/NMR_Geometry.h" 
+#include "Common/Math/NMR_VertexWelding.h" 
 #include "Common/NMR_Types.h" 
 
-#include <map>
-
 namespace NMR {
 
-	typedef struct {
-		NVEC3I m_position;
-	} VECTORTREEENTRY;
-
-	bool operator< (_In_ const VECTORTREEENTRY & entry1, _In_ const VECTORTREEENTRY & entry2);
-
 	class CVectorTree {
 	private:
 		nfFloat m_fUnits;
-		std::map <VECTORTREEENTRY, nfUint32> m_entries;
+		CVertexWeldingTable m_Table;
 	public:
 		CVectorTree();
 		CVectorTree(_In_ nfFloat fUnits);
@@ -72,6 +66,9 @@ namespace NMR {
 		void removeVector3(_In_ NVEC3 vVector);
 		void removeIntVector2(_In_ NVEC2I vVector);
 		void removeIntVector3(_In_ NVEC3I vVector);
+
+		// Preallocates the lookup for nCount vectors
+		void reserve(_In_ nfUint32 nCount);
 	};
 
 }
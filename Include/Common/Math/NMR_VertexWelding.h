@@ -0,0 +1,100 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_VertexWelding.h defines the vertex welding functions, which identify positions
+that fall into the same cell of a grid with a given unit size.
+
+CVertexWeldingTable is an open addressing hash table with linear probing from grid
+cells to values. It stores its entries in a single array, so adding a position does
+not allocate memory unless the table grows.
+
+fnVertexWeldSorted welds a whole array of positions at once. It sorts the grid cells
+in parallel chunks, which pays off for large inputs on several cores.
+
+--*/
+
+#ifndef __NMR_VERTEXWELDING
+#define __NMR_VERTEXWELDING
+
+#include "Common/Math/NMR_Geometry.h"
+#include "Common/NMR_Types.h"
+
+#include <vector>
+
+// Value which marks empty entries, it cannot be stored in the table
+#define NMR_VERTEXWELDING_EMPTYVALUE 0xffffffff
+#define NMR_VERTEXWELDING_MINCAPACITY 64
+// Minimum number of positions a worker thread processes in fnVertexWeldSorted
+#define NMR_VERTEXWELDING_PARALLELCHUNKSIZE 65536
+
+namespace NMR {
+
+	typedef struct {
+		NVEC3I m_position;
+		nfUint32 m_nValue;
+	} VERTEXWELDINGENTRY;
+
+	class CVertexWeldingTable {
+	private:
+		std::vector<VERTEXWELDINGENTRY> m_Entries;
+		nfUint32 m_nCount;
+		size_t m_nMask;
+
+		size_t getHomeSlot(_In_ const NVEC3I & vPosition);
+		// Returns the slot holding the position, or the empty slot it would be added in
+		size_t findSlot(_In_ const NVEC3I & vPosition);
+		void rehash(_In_ size_t nCapacity);
+		// Adds the position unless it is in the table, nStoredValue receives the value in the table
+		nfBool addEntry(_In_ const NVEC3I & vPosition, _In_ nfUint32 nValue, _Out_ nfUint32 & nStoredValue);
+
+	public:
+		CVertexWeldingTable();
+
+		// Grows the table, so that nCount positions fit without rehashing
+		void reserve(_In_ nfUint32 nCount);
+		nfUint32 getCount();
+		void clear();
+
+		_Success_(return) nfBool find(_In_ const NVEC3I & vPosition, _Out_ nfUint32 & nValue);
+		// Adds the position, unless it is in the table already. Returns if it has been added.
+		nfBool insert(_In_ const NVEC3I & vPosition, _In_ nfUint32 nValue);
+		// Returns the value of the position, after adding it with nValue if it was not in the table
+		nfUint32 findOrInsert(_In_ const NVEC3I & vPosition, _In_ nfUint32 nValue);
+		void remove(_In_ const NVEC3I & vPosition);
+	};
+
+	// Welds nCount positions with the given unit size. WeldedIndices receives for every position the
+	// index of its welded vertex, UniqueIndices for every welded vertex the first position it stems from.
+	// Welded vertices are numbered in the order of their first position, like adding the positions
+	// one by one to a CVertexWeldingTable does.
+	void fnVertexWeldSorted(_In_ const NVEC3 * pPositions, _In_ nfUint32 nCount, _In_ nfFloat fUnits,
+		_Out_ std::vector<nfUint32> & WeldedIndices, _Out_ std::vector<nfUint32> & UniqueIndices);
+
+}
+
+#endif // __NMR_VERTEXWELDING
@@ -43,30 +43,113 @@ You can only add nodes and faces to mesh. You cannot remove the existing structu
 
 #include "Common/Math/NMR_Geometry.h"
 #include "Common/Mesh/NMR_MeshTypes.h"
+#include "Common/Mesh/NMR_MeshMappedStorage.h"
+#include "Common/Mesh/NMR_MeshOutboxCache.h"
 #include "Common/MeshInformation/NMR_MeshInformationHandler.h"
 #include "Common/NMR_Types.h"
+#include "Common/NMR_MonotonicArena.h"
 #include "Common/Mesh/NMR_BeamLattice.h"
 
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace NMR {
 
+	class CMesh;
+
+	// A mesh and the transformation it is merged with, see CMesh::mergeMeshes
+	typedef struct {
+		CMesh * m_pMesh;
+		NMATRIX3 m_mMatrix;
+	} MESHMERGEINSTANCE;
+
+	// Arrays of the structure-of-arrays storage. Copies of a mesh share them, until one of the meshes changes them.
+	typedef std::vector<nfFloat, CMeshArrayAllocator<nfFloat>> MESHCOORDINATEARRAY;
+	typedef std::vector<nfInt32, CMeshArrayAllocator<nfInt32>> MESHINDEXARRAY;
+	typedef std::vector<nfInt16, CMeshArrayAllocator<nfInt16>> MESHQUANTIZED16ARRAY;
+	typedef std::vector<nfInt32, CMeshArrayAllocator<nfInt32>> MESHQUANTIZED32ARRAY;
+
+	// Quantized storage only uses the arrays of its bit count
+	typedef struct {
+		MESHCOORDINATEARRAY m_Coordinates[3];
+		MESHQUANTIZED16ARRAY m_Quantized16[3];
+		MESHQUANTIZED32ARRAY m_Quantized32[3];
+	} MESHNODEBUFFER;
+
+	typedef struct {
+		MESHINDEXARRAY m_NodeIndices;
+	} MESHFACEBUFFER;
+
 	class CMesh {
 	private:
 		MESHNODES m_Nodes;
 		MESHFACES m_Faces;
 		CBeamLattice m_BeamLattice;
 
+		// Structure-of-arrays storage, replaces m_Nodes and m_Faces in MESHSTORAGEMODE_SOA and MESHSTORAGEMODE_QUANTIZED
+		eMeshStorageMode m_StorageMode;
+		std::shared_ptr<MESHNODEBUFFER> m_pNodeBuffer;
+		std::shared_ptr<MESHFACEBUFFER> m_pFaceBuffer;
+		PMeshMappedStorage m_pMappedStorage;
+		MESHQUANTIZATION m_Quantization;
+		PMonotonicArena m_pArena;
+
 		PMeshInformationHandler m_pMeshInformationHandler;
 
+		// Invalidated by every method which adds or may move nodes
+		CMeshOutboxCache m_OutboxCache;
+
+		// Create empty buffers, which allocate their arrays from the mapped storage of the mesh
+		void resetBuffers();
+		// Return the buffers for writing, after copying them if they are shared with another mesh
+		_Ret_notnull_ MESHNODEBUFFER * writeNodeBuffer();
+		_Ret_notnull_ MESHFACEBUFFER * writeFaceBuffer();
+		// Quantized node storage. quantizeNodes stores coordinate triples in existing nodes, and throws before
+		// storing any of them if one does not fit. dequantizeNodes reads nodes back as coordinate triples.
+		void resizeQuantizedNodes(_In_ MESHNODEBUFFER * pNodeBuffer, _In_ size_t nNodeCount);
+		void quantizeNodes(_In_ MESHNODEBUFFER * pNodeBuffer, _In_ nfUint32 nIndex, _In_ nfUint32 nCount, _In_ const nfFloat * pCoordinates);
+		void dequantizeNodes(_In_ nfUint32 nIndex, _In_ nfUint32 nCount, _Out_ nfFloat * pCoordinates);
+		// Throws if a node of the mesh does not fit into the quantization
+		void checkQuantization(_In_ const MESHQUANTIZATION & Quantization);
+
+		// Shares the storage of an empty mesh with another mesh, if the merge does not transform it
+		nfBool shareMesh(_In_ CMesh * pMesh, _In_ const NMATRIX3 & mMatrix);
+
+		void mergeNodesSoA(_In_ CMesh * pMesh, _In_ const NMATRIX3 & mMatrix);
+		// Bulk merge of the nodes and faces of a mesh in any storage mode, span by span
+		void mergeNodesBatched(_In_ CMesh * pMesh, _In_ const NMATRIX3 & mMatrix);
+		void mergeFacesBatched(_In_ CMesh * pMesh, _In_ nfUint32 nSourceNodeCount, _In_ nfInt32 nNodeOffset, _In_opt_ CMeshInformationHandler * pOtherMeshInformationHandler);
+		void mergeBeams(_In_ CMesh * pMesh, _In_ nfUint32 nSourceNodeCount, _In_ nfInt32 nNodeOffset);
+
+		// Grow or shrink the node and face storage. New elements are uninitialized until they are overwritten.
+		void resizeNodes(_In_ nfUint64 nNodeCount);
+		void resizeFaces(_In_ nfUint64 nFaceCount);
+		// Overwrite existing nodes and faces with transformed or offset elements of another mesh.
+		// Disjoint target ranges can be written from several threads at once.
+		void mergeNodeRange(_In_ CMesh * pMesh, _In_ const NMATRIX3 & mMatrix, _In_ nfUint32 nSourceIndex, _In_ nfUint32 nTargetIndex, _In_ nfUint32 nCount);
+		void mergeFaceRange(_In_ CMesh * pMesh, _In_ nfUint32 nSourceNodeCount, _In_ nfInt32 nNodeOffset, _In_ nfUint32 nSourceIndex, _In_ nfUint32 nTargetIndex, _In_ nfUint32 nCount);
+
+		// Work on the element range [nStart, nEnd), so that checkSanity and extendOutbox can split the mesh into chunks
+		nfBool hasInvalidNodes(_In_ nfUint32 nStart, _In_ nfUint32 nEnd);
+		nfBool hasInvalidFaces(_In_ nfUint32 nStart, _In_ nfUint32 nEnd, _In_ nfUint32 nNodeCount);
+		void mergeNodeBounds(_In_ nfUint32 nStart, _In_ nfUint32 nEnd, _In_ const NMATRIX3 & mMatrix, _In_ nfBool bTransform, _Inout_ NOUTBOX3 & oOutbox);
+		// Visits all nodes, in parallel chunks
+		void mergeAllNodeBounds(_Inout_ NOUTBOX3 & oOutbox, _In_ const NMATRIX3 & mMatrix);
+
 	public:
 		CMesh();
+		// Copies a mesh. The copy shares the node and face storage with the original until one of them changes,
+		// which converts the original to structure-of-arrays storage.
 		CMesh(_In_opt_ CMesh * pMesh);
 
 		void mergeMesh(_In_opt_ CMesh * pMesh);
 		void addToMesh(_In_opt_ CMesh * pMesh);
 		void mergeMesh(_In_opt_ CMesh * pMesh, _In_ NMATRIX3 mMatrix);
 		void addToMesh(_In_opt_ CMesh * pMesh, _In_ NMATRIX3 mMatrix);
+		// Same result as calling mergeMesh for the instances in order. Large merges are presized
+		// and copied into their ranges in parallel.
+		void mergeMeshes(_In_ const std::vector<MESHMERGEINSTANCE> & Instances);
 
 		_Ret_notnull_ MESHNODE * addNode(_In_ const NVEC3 vPosition);
 		_Ret_notnull_ MESHNODE * addNode(_In_ const nfFloat posX, _In_ const nfFloat posY, _In_ const nfFloat posZ);
@@ -74,15 +157,81 @@ namespace NMR {
 		_Ret_notnull_ MESHFACE * addFace(_In_ nfInt32 nNodeIndex1, _In_ nfInt32 nNodeIndex2, _In_ nfInt32 nNodeIndex3);
 		_Ret_notnull_ MESHBEAM * addBeam(_In_ MESHNODE * pNode1, _In_ MESHNODE * pNode2, _In_ nfDouble dRadius1, _In_ nfDouble dRadius2,
 			_In_ nfInt32 eCapMode1, _In_ nfInt32 eCapMode2);
+		_Ret_notnull_ MESHBEAM * addBeam(_In_ nfInt32 nNodeIndex1, _In_ nfInt32 nNodeIndex2, _In_ nfDouble dRadius1, _In_ nfDouble dRadius2,
+			_In_ nfInt32 eCapMode1, _In_ nfInt32 eCapMode2);
 		_Ret_notnull_ PBEAMSET addBeamSet();
+
+		// Variants of addNode and addFace which return the new index instead of a record,
+		// so that they work in either storage mode. Node indices of faces are not range checked.
+		nfUint32 appendNode(_In_ const NVEC3 vPosition);
+		nfUint32 appendFace(_In_ nfInt32 nNodeIndex1, _In_ nfInt32 nNodeIndex2, _In_ nfInt32 nNodeIndex3);
+
+		// Bulk variants for ranges. Coordinates are x, y, z triples, node indices are triples per face.
+		// All elements are validated before any is added, and the index of the first new element is returned.
+		nfUint32 addNodes(_In_ const nfFloat * pCoordinates, _In_ nfUint32 nCount);
+		nfUint32 addFaces(_In_ const nfInt32 * pNodeIndices, _In_ nfUint32 nCount);
 		
 		nfUint32 getNodeCount();
 		nfUint32 getFaceCount();
 		nfUint32 getBeamCount();
 		nfUint32 getBeamSetCount();
 
+		// Preallocate storage for the given total counts, e.g. when a reader knows or can estimate them
+		void reserveNodes(_In_ nfUint32 nNodeCount);
+		void reserveFaces(_In_ nfUint32 nFaceCount);
+		void reserveBeams(_In_ nfUint32 nBeamCount);
+		nfUint32 getFaceCapacity();
+
+		// Node and face records only exist in paged storage. The record based methods (addNode, addFace,
+		// getNode, getFace) switch a mesh in structure-of-arrays storage back to paged storage first.
+		// Node records are writable, so positions must not be changed through a record after extendOutbox
+		// has been called, unless the record is fetched again with getNode.
 		_Ret_notnull_ MESHNODE * getNode(_In_ nfUint32 nIdx);
 		_Ret_notnull_ MESHFACE * getFace(_In_ nfUint32 nIdx);
+		// Records do not store their index. These look it up, which is slower than keeping the index.
+		nfUint32 getNodeIndex(_In_ const MESHNODE * pNode);
+		nfUint32 getFaceIndex(_In_ const MESHFACE * pFace);
+
+		// Converts the existing nodes and faces. Beams always stay paged.
+		void setStorageMode(_In_ eMeshStorageMode eStorageMode);
+		eMeshStorageMode getStorageMode();
+
+		// Moves the node and face arrays to memory mapped temporary files of the storage, or back to the heap
+		// if it is nullptr. Switches the mesh to structure-of-arrays storage, which keeps the arrays there
+		// until it is switched back. Beams and properties stay in memory. Copies of the mesh inherit the storage.
+		void setMappedStorage(_In_opt_ PMeshMappedStorage pStorage);
+		_Ret_maybenull_ PMeshMappedStorage getMappedStorage();
+
+		// Allocates the beam blocks which are added later from the arena, which frees them together with the
+		// blocks of other meshes, e.g. of all meshes of a model. Readers also allocate properties from it.
+		// Node and face blocks come from a small arena of the mesh, which is freed when they leave paged
+		// storage. Only for meshes without nodes, faces and beams. Copies of the mesh do not inherit the
+		// arena, and clear detaches the mesh from it.
+		void setArena(_In_opt_ PMonotonicArena pArena);
+		_Ret_maybenull_ PMonotonicArena getArena();
+
+		// Switches to quantized storage, which rounds all existing and new coordinates to the quantization.
+		// A quantized mesh is requantized. Throws NMR_ERROR_QUANTIZEDCOORDINATEOUTOFRANGE, and keeps the mesh as it is,
+		// if a node does not fit. Positions read back as origin + q * units, in single precision.
+		void quantize(_In_ const MESHQUANTIZATION & Quantization);
+		// The quantization of the last call to quantize, or the default one
+		const MESHQUANTIZATION & getQuantization();
+		// The integer coordinates of a quantized mesh as x, y, z triples, e.g. to write them without rounding them again
+		void copyQuantizedNodeCoordinates(_In_ nfUint32 nStartIndex, _In_ nfUint32 nCount, _Out_ nfInt32 * pValues);
+
+		// Index based access, which works in either storage mode
+		NVEC3 getNodePosition(_In_ nfUint32 nIdx);
+		void setNodePosition(_In_ nfUint32 nIdx, _In_ const NVEC3 vPosition);
+		void getFaceNodeIndices(_In_ nfUint32 nIdx, _Out_ nfInt32 * pNodeIndices);
+		void setFaceNodeIndices(_In_ nfUint32 nIdx, _In_ const nfInt32 * pNodeIndices);
+		void copyNodePositions(_In_ nfUint32 nStartIndex, _In_ nfUint32 nCount, _Out_ nfFloat * pCoordinates);
+		void copyFaceNodeIndices(_In_ nfUint32 nStartIndex, _In_ nfUint32 nCount, _Out_ nfInt32 * pNodeIndices);
+
+		// Contiguous arrays of the structure-of-arrays storage. The coordinates are nullptr in paged and quantized storage,
+		// the node indices in paged storage. nAxis selects the x, y or z coordinates, the index array holds three node indices per face.
+		_Ret_maybenull_ const nfFloat * getNodeCoordinates(_In_ nfUint32 nAxis);
+		_Ret_maybenull_ const nfInt32 * getFaceNodeIndexArray();
+
 		_Ret_notnull_ MESHBEAM * getBeam(_In_ nfUint32 nIdx);
 		_Ret_notnull_ PBEAMSET getBeamSet(_In_ nfUint32 nIdx);
 
@@ -106,6 +255,8 @@ namespace NMR {
 		_Ret_notnull_ CMeshInformationHandler * createMeshInformationHandler();
 		void clearMeshInformationHandler();
 		void patchMeshInformationResources(_In_ std::map<PackageResourceID, PackageResourceID> &oldToNewMapping);
+		// Uses the cached outbox or hull points if possible, so repeated calls do not visit all nodes.
+		// Not safe to call from several threads at once, since it fills the cache.
 		void extendOutbox(_Out_ NOUTBOX3& vOutBox, _In_ const NMATRIX3 mAccumulatedMatrix);
 	};
 
@@ -0,0 +1,94 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_MeshEdgeTopology.h defines the class CMeshEdgeTopology, which finds the edges of
+a mesh and counts the faces on either side of each of them.
+
+Every half-edge of a face is packed into a 64 bit key of its two node indices, the
+keys are radix sorted in parallel chunks, and a linear pass over the sorted keys
+collects the edges. Edges are ordered by their node indices.
+
+--*/
+
+#ifndef __NMR_MESHEDGETOPOLOGY
+#define __NMR_MESHEDGETOPOLOGY
+
+#include "Common/Mesh/NMR_Mesh.h"
+#include "Common/NMR_Types.h"
+
+#include <memory>
+#include <vector>
+
+// Number of key bits sorted per radix pass
+#define NMR_MESHEDGETOPOLOGY_RADIXBITS 11
+// Number of faces whose node indices are copied at once when creating the keys
+#define NMR_MESHEDGETOPOLOGY_FACEBATCHSIZE 4096
+
+namespace NMR {
+
+	typedef struct {
+		// The smaller node index comes first
+		nfInt32 m_nodeindices[2];
+		// Half-edges running from the smaller to the larger node index, and the other way round
+		nfUint32 m_nPositiveCount;
+		nfUint32 m_nNegativeCount;
+	} MESHTOPOLOGYEDGE;
+
+	class CMeshEdgeTopology {
+	private:
+		std::vector<MESHTOPOLOGYEDGE> m_Edges;
+		nfUint32 m_nBoundaryEdgeCount;
+		nfUint32 m_nNonManifoldEdgeCount;
+		nfUint32 m_nMisorientedEdgeCount;
+
+	public:
+		// Builds the topology of all faces of the mesh, whose node indices must be valid
+		CMeshEdgeTopology(_In_ CMesh * pMesh);
+
+		nfUint32 getEdgeCount();
+		const MESHTOPOLOGYEDGE & getEdge(_In_ nfUint32 nIdx);
+
+		// Edges with a single face
+		nfUint32 getBoundaryEdgeCount();
+		// Edges with more than two faces
+		nfUint32 getNonManifoldEdgeCount();
+		// Edges with two faces, which run along the edge in the same direction
+		nfUint32 getMisorientedEdgeCount();
+
+		void getBoundaryEdges(_Out_ std::vector<nfUint32> & EdgeIndices);
+		void getNonManifoldEdges(_Out_ std::vector<nfUint32> & EdgeIndices);
+
+		// True if every edge has two faces, which run along it in opposite directions
+		nfBool isManifoldAndOriented();
+	};
+
+	typedef std::shared_ptr <CMeshEdgeTopology> PMeshEdgeTopology;
+
+}
+
+#endif // __NMR_MESHEDGETOPOLOGY
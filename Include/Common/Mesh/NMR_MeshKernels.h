@@ -0,0 +1,72 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_MeshKernels.h defines the inner loops of the mesh validation, bounding box
+computation and node transformation. They work on contiguous arrays, i.e. one block of a paged mesh or the
+arrays of a mesh in structure-of-arrays storage, and process four elements at a time
+with SSE2 where it is available.
+
+--*/
+
+#ifndef __NMR_MESHKERNELS
+#define __NMR_MESHKERNELS
+
+#include "Common/NMR_Types.h"
+#include "Common/NMR_Local.h"
+#include "Common/Math/NMR_Geometry.h"
+
+#include <cstddef>
+
+namespace NMR {
+
+	// Returns true if the magnitude of any value is above fLimit. NaN values are never above the limit.
+	nfBool fnMeshKernelExceedsLimit(_In_ const nfFloat * pValues, _In_ size_t nCount, _In_ nfFloat fLimit);
+
+	// Returns true if any face references a node outside of [0, nNodeCount) or the same node twice.
+	// pNodeIndices holds three node indices per face.
+	nfBool fnMeshKernelHasInvalidFaces(_In_ const nfInt32 * pNodeIndices, _In_ size_t nFaceCount, _In_ nfUint32 nNodeCount);
+
+	// Merges the values into a minimum and a maximum, NaN values are ignored
+	void fnMeshKernelMergeAxisBounds(_In_ const nfFloat * pValues, _In_ size_t nCount, _Inout_ nfFloat & fMin, _Inout_ nfFloat & fMax);
+
+	// Merges positions into a bounding box, pCoordinates holds x, y and z per position
+	void fnMeshKernelMergeBounds(_In_ const nfFloat * pCoordinates, _In_ size_t nCount, _Inout_ NOUTBOX3 & oOutbox);
+
+	// Merges positions transformed by mMatrix into a bounding box. The coordinates of position i are
+	// pX[i * nStride], pY[i * nStride] and pZ[i * nStride]. The results equal those of fnMATRIX3_apply.
+	void fnMeshKernelMergeTransformedBounds(_In_ const nfFloat * pX, _In_ const nfFloat * pY, _In_ const nfFloat * pZ, _In_ size_t nStride,
+		_In_ size_t nCount, _In_ const NMATRIX3 & mMatrix, _Inout_ NOUTBOX3 & oOutbox);
+
+	// Transforms positions by mMatrix into pTarget, which receives x, y and z per position and must not
+	// overlap the source. The source layout and the results are the same as in fnMeshKernelMergeTransformedBounds.
+	void fnMeshKernelTransformPositions(_In_ const nfFloat * pX, _In_ const nfFloat * pY, _In_ const nfFloat * pZ, _In_ size_t nStride,
+		_In_ size_t nCount, _In_ const NMATRIX3 & mMatrix, _Out_ nfFloat * pTarget);
+
+}
+
+#endif // __NMR_MESHKERNELS
@@ -0,0 +1,138 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_MeshMappedStorage.h defines the CMeshMappedStorage Class and the CMeshArrayAllocator template.
+Mapped storage places the large node and face arrays of meshes in memory mapped temporary files,
+so that the operating system can page them out to disk instead of keeping them in memory.
+
+--*/
+
+#ifndef __NMR_MESHMAPPEDSTORAGE
+#define __NMR_MESHMAPPEDSTORAGE
+
+#include "Common/Mesh/NMR_MeshTypes.h"
+#include "Common/Platform/NMR_MappedTemporaryFile.h"
+#include "Common/NMR_Types.h"
+#include "Common/NMR_Local.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <type_traits>
+
+namespace NMR {
+
+	class CMeshMappedStorage {
+	private:
+		std::wstring m_sDirectory;
+		std::mutex m_Mutex;
+		std::map<void *, PMappedTemporaryFile> m_Files;
+
+	public:
+		CMeshMappedStorage() = delete;
+		// An empty directory selects the temporary directory of the system
+		CMeshMappedStorage(_In_ const std::wstring & sDirectory);
+
+		std::wstring getDirectory();
+
+		// Every allocation is a file of its own. Safe to call from several threads at once.
+		_Ret_notnull_ void * allocate(_In_ size_t cbSize);
+		void deallocate(_In_ void * pData);
+	};
+
+	typedef std::shared_ptr<CMeshMappedStorage> PMeshMappedStorage;
+
+	// Allocates arrays of NMR_MESH_MAPPEDSTORAGEMINSIZE bytes and more from its mapped storage, and all
+	// other arrays from the heap. The storage travels with the arrays when they are copied, moved or swapped.
+	template <typename T> class CMeshArrayAllocator {
+	private:
+		PMeshMappedStorage m_pStorage;
+
+		static nfBool isMapped(_In_ size_t nCount)
+		{
+			return nCount >= NMR_MESH_MAPPEDSTORAGEMINSIZE / sizeof(T);
+		}
+
+	public:
+		typedef T value_type;
+		typedef std::true_type propagate_on_container_copy_assignment;
+		typedef std::true_type propagate_on_container_move_assignment;
+		typedef std::true_type propagate_on_container_swap;
+
+		CMeshArrayAllocator()
+		{
+		}
+
+		CMeshArrayAllocator(_In_ PMeshMappedStorage pStorage)
+			: m_pStorage(pStorage)
+		{
+		}
+
+		template <typename U> CMeshArrayAllocator(_In_ const CMeshArrayAllocator<U> & Other)
+			: m_pStorage(Other.getStorage())
+		{
+		}
+
+		PMeshMappedStorage getStorage() const
+		{
+			return m_pStorage;
+		}
+
+		T * allocate(_In_ size_t nCount)
+		{
+			if (nCount > ((size_t)-1) / sizeof(T))
+				throw std::bad_alloc();
+			if (m_pStorage && isMapped(nCount))
+				return static_cast<T *>(m_pStorage->allocate(nCount * sizeof(T)));
+			return static_cast<T *>(::operator new(nCount * sizeof(T)));
+		}
+
+		void deallocate(_In_ T * pData, _In_ size_t nCount)
+		{
+			if (m_pStorage && isMapped(nCount))
+				m_pStorage->deallocate(pData);
+			else
+				::operator delete(pData);
+		}
+	};
+
+	template <typename T, typename U> bool operator==(_In_ const CMeshArrayAllocator<T> & A, _In_ const CMeshArrayAllocator<U> & B)
+	{
+		return A.getStorage() == B.getStorage();
+	}
+
+	template <typename T, typename U> bool operator!=(_In_ const CMeshArrayAllocator<T> & A, _In_ const CMeshArrayAllocator<U> & B)
+	{
+		return A.getStorage() != B.getStorage();
+	}
+
+}
+
+#endif // __NMR_MESHMAPPEDSTORAGE
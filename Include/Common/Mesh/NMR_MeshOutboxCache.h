@@ -0,0 +1,112 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_MeshOutboxCache.h defines the class CMeshOutboxCache, which keeps the data a mesh
+needs to compute the outbox of its transformed nodes without visiting all of them.
+
+The cache holds the untransformed outbox of the nodes, which yields the exact outbox
+for transforms that map every axis onto a single axis. For other transforms it holds a
+subset of the nodes, which contains all vertices of the convex hull. Nodes are left out
+if they lie inside the convex hull of the nodes that are extreme along a set of fixed
+directions, since they can never be extreme themselves. A first pass tests all nodes
+against the 13 directions of a cube, a second pass tests the remaining ones against 64
+directions spread over the sphere.
+
+Transformed nodes are rounded to single precision, so a node inside of the hull may end up
+outside of the transformed hull points. Nodes are therefore only left out if they lie at
+least a margin inside of the hull, which scales with the magnitude of the coordinates. Transforms
+whose rounding error exceeds this margin, such as large translations of a small mesh, visit all nodes.
+
+--*/
+
+#ifndef __NMR_MESHOUTBOXCACHE
+#define __NMR_MESHOUTBOXCACHE
+
+#include "Common/Math/NMR_Geometry.h"
+#include "Common/NMR_Types.h"
+#include "Common/NMR_Local.h"
+
+#include <vector>
+
+// Hull points are only kept if they are fewer than this fraction of the nodes
+#define NMR_MESHOUTBOXCACHE_MAXHULLFRACTION 0.5
+// Nodes closer to the boundary of a tetrahedron than this barycentric margin are kept
+#define NMR_MESHOUTBOXCACHE_BARYCENTRICMARGIN 0.0001
+// Nodes closer to the boundary of the hull than this many float epsilons of the largest coordinate are kept
+#define NMR_MESHOUTBOXCACHE_MARGINEPSILONS 1024
+// Bound of the rounding error of a transformed coordinate, in float epsilons of the sum of the magnitudes of its terms
+#define NMR_MESHOUTBOXCACHE_TRANSFORMEPSILONS 4
+
+namespace NMR {
+
+	class CMesh;
+
+	class CMeshOutboxCache {
+	private:
+		nfBool m_bHasLocalOutbox;
+		NOUTBOX3 m_LocalOutbox;
+
+		// Number of queries which had to visit all nodes since the last invalidation
+		nfUint32 m_nFullQueryCount;
+		nfBool m_bHasHullPoints;
+		// x, y and z per hull point
+		std::vector<nfFloat> m_HullPoints;
+		// Distance inside of the hull of every node which is no hull point
+		double m_dHullMargin;
+		// Largest absolute coordinate along each axis
+		double m_dMaxCoordinates[3];
+
+	public:
+		CMeshOutboxCache();
+
+		// Has to be called whenever a node is added or moved
+		void invalidate();
+
+		_Success_(return) nfBool getLocalOutbox(_Out_ NOUTBOX3 & oOutbox);
+		void setLocalOutbox(_In_ const NOUTBOX3 & oOutbox);
+
+		// Returns true if the outbox of the transformed nodes follows from the untransformed outbox,
+		// i.e. if every row of the linear part of mMatrix has at most one non-zero entry
+		static nfBool isAxisAligned(_In_ const NMATRIX3 & mMatrix);
+		// Merges the corners of the local outbox transformed by an axis aligned matrix
+		void mergeLocalOutbox(_In_ const NMATRIX3 & mMatrix, _Inout_ NOUTBOX3 & oOutbox);
+
+		// Merges the transformed hull points. Returns false if there are none, or if the rounding
+		// error of the transform could exceed the margin by which the other nodes lie inside of the hull.
+		nfBool mergeHullPoints(_In_ const NMATRIX3 & mMatrix, _Inout_ NOUTBOX3 & oOutbox);
+		// Counts a query which visits all nodes. Returns true if the hull points should be built,
+		// which happens on the second such query, so that a single query costs no more than one pass.
+		nfBool countFullQuery();
+		// Collects the hull points of the nodes of the mesh. They are discarded again if they
+		// are not much fewer than the nodes.
+		void buildHullPoints(_In_ CMesh * pMesh);
+	};
+
+}
+
+#endif // __NMR_MESHOUTBOXCACHE
@@ -0,0 +1,81 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_MeshReordering.h defines the class CMeshReordering, which computes an order of the
+faces and nodes of a mesh that improves the locality of its node indices.
+
+The faces are ordered with the Tipsify algorithm of Sander, Nehab and Barczak, which fans
+around one node at a time and prefers nodes that are still in a simulated vertex cache.
+The nodes are then numbered in the order in which the reordered faces and the beams use
+them. Both passes run in linear time. The mesh itself is not changed.
+
+--*/
+
+#ifndef __NMR_MESHREORDERING
+#define __NMR_MESHREORDERING
+
+#include "Common/Mesh/NMR_Mesh.h"
+#include "Common/NMR_Types.h"
+
+#include <memory>
+#include <vector>
+
+// Size of the simulated vertex cache
+#define NMR_MESHREORDERING_CACHESIZE 16
+
+namespace NMR {
+
+	class CMeshReordering {
+	private:
+		// Old face and node index for every new index
+		std::vector<nfUint32> m_FaceOrder;
+		std::vector<nfUint32> m_NodeOrder;
+		// New node index for every old index
+		std::vector<nfUint32> m_NewNodeIndices;
+		nfBool m_bReordered;
+
+		void orderFaces(_In_ const std::vector<nfInt32> & NodeIndices, _In_ nfUint32 nNodeCount);
+		void orderNodes(_In_ CMesh * pMesh, _In_ const std::vector<nfInt32> & NodeIndices);
+
+	public:
+		// Keeps the original order if any face references an invalid node or the same node twice
+		CMeshReordering(_In_ CMesh * pMesh);
+
+		// False if the original order was kept
+		nfBool isReordered();
+
+		nfUint32 getOldFaceIndex(_In_ nfUint32 nNewIndex);
+		nfUint32 getOldNodeIndex(_In_ nfUint32 nNewIndex);
+		nfUint32 getNewNodeIndex(_In_ nfUint32 nOldIndex);
+	};
+
+	typedef std::shared_ptr <CMeshReordering> PMeshReordering;
+
+}
+
+#endif // __NMR_MESHREORDERING
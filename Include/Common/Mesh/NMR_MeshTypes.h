@@ -55,16 +55,41 @@ In addition, some constants are defined here.
 #define NMR_MESH_BEAMBLOCKCOUNT 256
 #define NMR_MESH_NODEEDGELINKBLOCKCOUNT 256
 
+// Minimum number of elements a worker thread processes when checking or measuring a mesh
+#define NMR_MESH_PARALLELCHUNKSIZE 65536
+// Number of nodes or faces mergeMesh transforms or offsets at a time, before appending them in bulk
+#define NMR_MESH_MERGEBATCHSIZE 4096
+// Minimum size in bytes of an array which is placed in mapped storage, smaller arrays stay on the heap
+#define NMR_MESH_MAPPEDSTORAGEMINSIZE 1048576
+// Default units of the quantization of a mesh, the same as the binary vertex streams are written with
+#define NMR_MESH_DEFAULTQUANTIZATIONUNITS 0.001f
+// Largest magnitude of a quantized coordinate, the largest one binary vertex streams can hold
+#define NMR_MESH_MAXQUANTIZEDVALUE (1 << 30)
+
 namespace NMR {
 
+	enum eMeshStorageMode {
+		MESHSTORAGEMODE_PAGED = 0,	// MESHNODE and MESHFACE records in paged blocks
+		MESHSTORAGEMODE_SOA = 1,	// Contiguous coordinate and node index arrays
+		MESHSTORAGEMODE_QUANTIZED = 2	// Contiguous integer coordinate arrays, see MESHQUANTIZATION, and node index arrays
+	};
+
+	// A quantized coordinate q stands for m_vOrigin + q * m_fUnits, per axis. q has 16 or 32 bits,
+	// and at most the magnitude NMR_MESH_MAXQUANTIZEDVALUE.
+	typedef struct {
+		NVEC3 m_vOrigin;
+		nfFloat m_fUnits;
+		nfUint32 m_nBitCount;
+	} MESHQUANTIZATION;
+
+	// Nodes and faces do not store their own index, it is their position in the mesh.
+	// CMesh::getNodeIndex and CMesh::getFaceIndex derive it from a record pointer.
 	typedef struct {
-		nfInt32 m_index;
 		NVEC3 m_position;
 	} MESHNODE;
 	typedef CPagedVector<MESHNODE, NMR_MESH_NODEBLOCKCOUNT> MESHNODES;
 
 	typedef struct {
-		nfInt32 m_index;
 		nfInt32 m_nodeindices[3];
 	} MESHFACE;
 	typedef CPagedVector<MESHFACE, NMR_MESH_FACEBLOCKCOUNT> MESHFACES;
@@ -67,6 +67,11 @@ namespace NMR {
 		nfBool m_bIgnoreInvalidFaces;
 		nfBool m_bImportColors;
 
+		// Reads the next facet, and returns if its coordinates are in valid space
+		nfBool readFacet(_In_ CImportStream * pStream, _Out_ MESHFORMAT_STL_FACET & Facet);
+		// Variant of loadMesh for large files, which welds all nodes at once with fnVertexWeldSorted
+		void loadMeshSorted(_In_ CMesh * pMesh, _In_opt_ NMATRIX3 * pmMatrix, _In_ nfUint32 nFaceCount);
+
 	public:
 		CMeshImporter_STL();
 		CMeshImporter_STL(_In_ PImportStream pStream);
@@ -51,12 +51,22 @@ namespace NMR {
 		PMeshInformationContainer m_pContainer;
 		nfUint64 m_nInternalID;
 
+		// Copies the raw records of a range of faces, for information types whose records hold no references
+		void copyFaceDataFrom(_In_ nfUint32 nFaceIndex, _In_ CMeshInformation * pOtherInformation, _In_ nfUint32 nOtherFaceIndex, _In_ nfUint32 nCount);
+		// Copies the container if it is shared with another information, before it is changed
+		void makeContainerUnique();
+
 	public:
 		CMeshInformation();
 		virtual ~CMeshInformation() = default;
 
 		_Ret_notnull_ MESHINFORMATIONFACEDATA * getFaceData(nfUint32 nFaceIndex);
+		// Read-only access, which does not copy a shared container
+		_Ret_notnull_ const MESHINFORMATIONFACEDATA * readFaceData(nfUint32 nFaceIndex);
+		// Shares the face records of another information of the same type, until one of them is changed
+		void shareFaceDataFrom(_In_ CMeshInformation * pOtherInformation);
 		_Ret_notnull_ MESHINFORMATIONFACEDATA * addFaceData(_In_ nfUint32 nNewFaceCount);
+		void reserveFaceData(_In_ nfUint32 nFaceCount);
 		void resetFaceInformation(_In_ nfUint32 nFaceIndex);
 		void resetAllFaceInformation();
 
@@ -65,6 +75,8 @@ namespace NMR {
 		virtual eMeshInformationType getType() = 0;
 		virtual void cloneDefaultInfosFrom(_In_ CMeshInformation * pOtherInformation) = 0;
 		virtual void cloneFaceInfosFrom(_In_ nfUint32 nFaceIndex, _In_ CMeshInformation * pOtherInformation, _In_ nfUint32 nOtherFaceIndex) = 0;
+		// Clones nCount consecutive faces, face by face unless a derived class knows better
+		virtual void cloneFaceInfoRangeFrom(_In_ nfUint32 nFaceIndex, _In_ CMeshInformation * pOtherInformation, _In_ nfUint32 nOtherFaceIndex, _In_ nfUint32 nCount);
 		virtual PMeshInformation cloneInstance(_In_ nfUint32 nCurrentFaceCount) = 0;
 		virtual void permuteNodeInformation(_In_ nfUint32 nFaceIndex, _In_ nfUint32 nNodeIndex1, _In_ nfUint32 nNodeIndex2, _In_ nfUint32 nNodeIndex3) = 0;
 		virtual void mergeInformationFrom (_In_ CMeshInformation * pInformation) = 0;
@@ -37,6 +37,7 @@ This class provides a memory container for holding the texture information state
 #include "Common/MeshInformation/NMR_MeshInformationTypes.h"
 #include "Common/NMR_Types.h"
 #include "Common/NMR_Local.h"
+#include "Common/NMR_MonotonicArena.h"
 
 #include <vector>
 #include <memory>
@@ -50,16 +51,31 @@ namespace NMR {
 		nfUint32 m_nFaceCount;
 		nfUint32 m_nRecordSize;
 		std::vector<MESHINFORMATIONFACEDATA *> m_DataBlocks;
+		// Owned memory; reserved blocks share one allocation
+		std::vector<MESHINFORMATIONFACEDATA *> m_Allocations;
 		MESHINFORMATIONFACEDATA * m_CurrentDataBlock;
+		// Source of new blocks if set, its blocks are not in m_Allocations
+		PMonotonicArena m_pArena;
+
+		// Returns nCount zeroed bytes
+		_Ret_notnull_ MESHINFORMATIONFACEDATA * allocateData(size_t nCount);
 
 	public:
 		CMeshInformationContainer();
 		CMeshInformationContainer(nfUint32 nCurrentFaceCount, nfUint32 nRecordSize);
+		// Allocates its blocks from the arena, nullptr selects the heap
+		CMeshInformationContainer(nfUint32 nCurrentFaceCount, nfUint32 nRecordSize, _In_opt_ PMonotonicArena pArena);
+		// Copies all records of another container, into blocks on the heap
+		CMeshInformationContainer(_In_ CMeshInformationContainer * pOtherContainer);
 		~CMeshInformationContainer();
 		_Ret_notnull_ MESHINFORMATIONFACEDATA * addFaceData(nfUint32 nNewFaceCount);
 		_Ret_notnull_ MESHINFORMATIONFACEDATA * getFaceData(nfUint32 nIdx);
+		void reserveFaceData(nfUint32 nFaceCount);
+		// Copies the records of nCount faces from another container with the same record size
+		void copyFaceData(nfUint32 nFaceIndex, _In_ CMeshInformationContainer * pOtherContainer, nfUint32 nOtherFaceIndex, nfUint32 nCount);
 
 		nfUint32 getCurrentFaceCount();
+		// Also detaches the container from its arena
 		void clear();
 	};
 
@@ -52,6 +52,7 @@ namespace NMR {
 
 		void addInformation(_In_ PMeshInformation pInformation);
 		void addFace(_In_ nfUint32 nNewFaceCount);
+		void reserveFaces(_In_ nfUint32 nFaceCount);
 
 		CMeshInformation * getInformationIndexed(_In_ nfUint32 nIdx);
 		PMeshInformation getPInformationIndexed(_In_ nfUint32 nIdx);
@@ -59,8 +60,11 @@ namespace NMR {
 		nfUint32 getInformationCount();
 
 		void addInfoTableFrom(_In_ CMeshInformationHandler * pOtherInfoHandler, _In_ nfUint32 nCurrentFaceCount);
+		// Adds the informations of another handler to an empty handler, sharing their face records
+		void shareInfoTableFrom(_In_ CMeshInformationHandler * pOtherInfoHandler);
 		void cloneDefaultInfosFrom(_In_ CMeshInformationHandler * pOtherInfoHandler);
 		void cloneFaceInfosFrom(_In_ nfUint32 nFaceIdx, _In_ CMeshInformationHandler * pOtherInfoHandler, _In_ nfUint32 nOtherFaceIndex);
+		void cloneFaceInfoRangeFrom(_In_ nfUint32 nFaceIdx, _In_ CMeshInformationHandler * pOtherInfoHandler, _In_ nfUint32 nOtherFaceIndex, _In_ nfUint32 nCount);
 		void permuteNodeInformation(_In_ nfUint32 nFaceIdx, _In_ nfUint32 nNodeIndex1, _In_ nfUint32 nNodeIndex2, _In_ nfUint32 nNodeIndex3);
 		void resetFaceInformation(_In_ nfUint32 nFaceIdx);
 
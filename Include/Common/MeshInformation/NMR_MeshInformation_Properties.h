@@ -65,12 +65,15 @@ namespace NMR {
 	public:
 		CMeshInformation_Properties();
 		CMeshInformation_Properties(nfUint32 nCurrentFaceCount);
+		// Allocates the face data from the arena, nullptr selects the heap
+		CMeshInformation_Properties(nfUint32 nCurrentFaceCount, _In_opt_ PMonotonicArena pArena);
 
 		void invalidateFace(_In_ MESHINFORMATIONFACEDATA * pData) override;
 
 		eMeshInformationType getType() override;
 		void cloneDefaultInfosFrom(_In_ CMeshInformation * pOtherInformation) override;
 		void cloneFaceInfosFrom(_In_ nfUint32 nFaceIndex, _In_ CMeshInformation * pOtherInformation, _In_ nfUint32 nOtherFaceIndex) override;
+		void cloneFaceInfoRangeFrom(_In_ nfUint32 nFaceIndex, _In_ CMeshInformation * pOtherInformation, _In_ nfUint32 nOtherFaceIndex, _In_ nfUint32 nCount) override;
 		PMeshInformation cloneInstance(_In_ nfUint32 nCurrentFaceCount) override;
 		void permuteNodeInformation(_In_ nfUint32 nFaceIndex, _In_ nfUint32 nNodeIndex1, _In_ nfUint32 nNodeIndex2, _In_ nfUint32 nNodeIndex3) override;
 		nfUint32 getBackupSize() override;
@@ -571,6 +571,8 @@ Core framework error codes (0x2XXX)
 // Too many beams
 #define NMR_ERROR_TOOMANYBEAMS 0x203D
 
+// A node coordinate does not fit into the quantization of the mesh
+#define NMR_ERROR_QUANTIZEDCOORDINATEOUTOFRANGE 0x203E
 
 // Invalid slice polygon index
 #define NMR_ERROR_INVALIDSLICEPOLYGON 0x2040
@@ -0,0 +1,84 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_MonotonicArena.h defines the CMonotonicArena Class.
+A monotonic arena hands out memory from large blocks by advancing a pointer. Single allocations
+are never freed, all blocks are freed at once when the arena is destroyed. This suits objects
+which live exactly as long as a model, e.g. the blocks of the meshes which are read into it.
+
+--*/
+
+#ifndef __NMR_MONOTONICARENA
+#define __NMR_MONOTONICARENA
+
+#include "Common/NMR_Types.h"
+#include "Common/NMR_Local.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Maximum size of the blocks of an arena. Allocations of more than a quarter of it get a block of their own.
+#define NMR_MONOTONICARENA_BLOCKSIZE (1 << 16)
+
+namespace NMR {
+
+	class CMonotonicArena {
+	private:
+		std::mutex m_Mutex;
+		std::vector<nfByte *> m_Blocks;
+		nfByte * m_pCurrent;
+		size_t m_nRemaining;
+		size_t m_nBlockSize;
+		nfUint64 m_nReservedSize;
+
+		_Ret_notnull_ nfByte * allocateBlock(_In_ size_t cbSize);
+
+	public:
+		CMonotonicArena();
+		// The first block has the given size, every following block doubles in size up to NMR_MONOTONICARENA_BLOCKSIZE.
+		// Suits arenas which are often small, e.g. the arena of a single mesh.
+		CMonotonicArena(_In_ size_t nFirstBlockSize);
+		~CMonotonicArena();
+
+		CMonotonicArena(_In_ const CMonotonicArena &) = delete;
+		CMonotonicArena & operator=(_In_ const CMonotonicArena &) = delete;
+
+		// The memory stays valid until the arena is destroyed. nAlignment is a power of two
+		// up to the alignment of the heap. Safe to call from several threads at once.
+		_Ret_notnull_ void * allocate(_In_ size_t cbSize, _In_ size_t nAlignment);
+
+		// Size of all blocks of the arena, in bytes
+		nfUint64 getReservedSize();
+	};
+
+	typedef std::shared_ptr<CMonotonicArena> PMonotonicArena;
+
+}
+
+#endif // __NMR_MONOTONICARENA
@@ -26,43 +26,28 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 Abstract:
 
-NMR_PairMatchingTree.h defines a n-log-n tree class which is able to identify
-duplicate pairs of numbers in a given data set.
+NMR_NumberParser.h defines locale independent functions to parse numbers from strings.
+Floating point values are converted with the Eisel-Lemire algorithm and are rounded
+exactly like a correctly rounding strtod/strtof in the "C" locale. Hexadecimal floating
+point values are not accepted, as the 3MF number format has no hexadecimal notation.
 
 --*/
 
-#ifndef __NMR_PAIRMATCHINGTREE
-#define __NMR_PAIRMATCHINGTREE
+#ifndef __NMR_NUMBERPARSER
+#define __NMR_NUMBERPARSER
 
-#include "Common/Math/NMR_Geometry.h" 
-#include "Common/NMR_Types.h" 
-
-#include <map>
+#include "Common/NMR_Types.h"
+#include "Common/NMR_Local.h"
 
 namespace NMR {
 
-	typedef struct {
-		nfInt32 m_pair[2];
-	} PAIRMATCHINGTREEENTRY;
-
-	bool operator< (_In_ const PAIRMATCHINGTREEENTRY & entry1, _In_ const PAIRMATCHINGTREEENTRY & entry2);
-
-	class CPairMatchingTree {
-	private:
-		std::map <PAIRMATCHINGTREEENTRY, nfInt32> m_entries;
-	public:
-		CPairMatchingTree();
-		~CPairMatchingTree();
-
-		void addMatch(_In_ nfInt32 data1, _In_ nfInt32 data2, _In_ nfInt32 param);
-		_Success_(return) nfBool checkMatch(_In_ nfInt32 data1, _In_ nfInt32 data2, _Out_opt_ nfInt32 &param);
-		void deleteMatch(_In_ nfInt32 data1, _In_ nfInt32 data2);
-	};
+	// Each function parses the longest numeric prefix of pszValue, skipping leading white space.
+	// It returns the first character after the number, or pszValue if no conversion could be performed.
+	// Out of range floating point values return +/- infinity, out of range integers are saturated.
+	const nfChar * fnParseDouble(_In_z_ const nfChar * pszValue, _Out_ nfDouble & dResult);
+	const nfChar * fnParseFloat(_In_z_ const nfChar * pszValue, _Out_ nfFloat & fResult);
+	const nfChar * fnParseInt64(_In_z_ const nfChar * pszValue, _Out_ nfInt64 & nResult);
 
 }
 
-#endif // __NMR_PAIRMATCHINGTREE
-
-
-
-
+#endif // __NMR_NUMBERPARSER
@@ -29,6 +29,12 @@ Abstract:
 NMR_PagedVector.h defines a vector class which allocates its memory block-wise, leading to 
 significant performance improvements against a standard template library vector.
 
+The first block holds the given block size of elements, and every following block doubles
+in size up to NMR_PAGEDVECTOR_MAXBLOCKSIZE elements. Huge vectors therefore need only few
+allocations, while small vectors stay small. Elements never move once they are allocated.
+Blocks are allocated from the heap, or from a monotonic arena which frees them together
+with the blocks of other vectors.
+
 --*/
 
 #ifndef __NMR_PAGEDVECTOR
@@ -37,34 +43,139 @@ significant performance improvements against a standard template library vector.
 #include "Common/NMR_Local.h"
 #include "Common/NMR_Types.h"
 #include "Common/NMR_Exception.h"
+#include "Common/NMR_MonotonicArena.h"
 #include <vector>
+#include <algorithm>
+#include <functional>
 
 #include <array>
+#include <new>
+#include <type_traits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Blocks stop growing at this number of elements
+#define NMR_PAGEDVECTOR_MAXBLOCKSIZE (1 << 20)
 
 namespace NMR {
 
+	inline nfUint32 fnPagedVectorFloorLog2(_In_ nfUint32 nValue)
+	{
+#ifdef _MSC_VER
+		unsigned long nIndex;
+		_BitScanReverse(&nIndex, nValue);
+		return (nfUint32)nIndex;
+#else
+		return 31 - (nfUint32)__builtin_clz(nValue);
+#endif
+	}
+
 	template <class T, unsigned int DEFAULTBLOCKSIZE = 1024>
 	class CPagedVector {
+		// Size of the first block
 		nfUint32 m_nBlockSize;
+		// Block m_nMaxBlockLevel and all following blocks have the maximum size
+		nfUint32 m_nMaxBlockLevel;
+		// Number of elements in the growing blocks before block m_nMaxBlockLevel
+		nfUint32 m_nGrowthCount;
 		nfUint32 m_nCount;
+		size_t m_nCapacity;
 		T * m_pHeadBlock;
+		// Index range of the head block
+		nfUint64 m_nHeadBlockStart;
+		nfUint64 m_nHeadBlockEnd;
 		std::vector<T *> m_pBlocks;
-	public:
+		// Owned memory; reserved blocks share one allocation
+		std::vector<T *> m_pAllocations;
+		// Source of new blocks if set, its blocks are not in m_pAllocations
+		PMonotonicArena m_pArena;
 
-		CPagedVector() {
+		void initialize(_In_ nfUint32 nBlockSize) {
 			m_nCount = 0;
+			m_nCapacity = 0;
 			m_pHeadBlock = NULL;
-			m_nBlockSize = DEFAULTBLOCKSIZE;
+			m_nHeadBlockStart = 0;
+			m_nHeadBlockEnd = 0;
+			m_nBlockSize = nBlockSize;
 			if (m_nBlockSize == 0)
 				throw CNMRException(NMR_ERROR_INVALIDBLOCKSIZE);
+
+			m_nMaxBlockLevel = 0;
+			while ((m_nMaxBlockLevel < 31) && (((nfUint64)m_nBlockSize << (m_nMaxBlockLevel + 1)) <= NMR_PAGEDVECTOR_MAXBLOCKSIZE))
+				m_nMaxBlockLevel++;
+			m_nGrowthCount = m_nBlockSize * ((1u << m_nMaxBlockLevel) - 1);
+		}
+
+		_Ret_notnull_ T * allocateElements(_In_ size_t nCount) {
+			if (m_pArena) {
+				if (nCount > ((size_t)-1) / sizeof(T))
+					throw std::bad_alloc();
+				T * pElements = static_cast<T *>(m_pArena->allocate(nCount * sizeof(T), std::alignment_of<T>::value));
+				for (size_t nIndex = 0; nIndex < nCount; nIndex++)
+					new (&pElements[nIndex]) T;
+				return pElements;
+			}
+
+			T * pElements = new T[nCount];
+			m_pAllocations.push_back(pElements);
+			return pElements;
+		}
+
+		size_t blockSize(_In_ size_t nBlockIndex) {
+			return (size_t)m_nBlockSize << std::min(nBlockIndex, (size_t)m_nMaxBlockLevel);
+		}
+
+		nfUint64 blockStart(_In_ size_t nBlockIndex) {
+			if (nBlockIndex <= m_nMaxBlockLevel)
+				return (nfUint64)m_nBlockSize * ((1ull << nBlockIndex) - 1);
+			return m_nGrowthCount + (nfUint64)(nBlockIndex - m_nMaxBlockLevel) * blockSize(nBlockIndex);
+		}
+
+		// Maps an element index to its block and the position within the block
+		void locate(_In_ nfUint32 nIdx, _Out_ size_t & nBlockIndex, _Out_ nfUint32 & nOffset) {
+			if (nIdx < m_nGrowthCount) {
+				nfUint32 nLevel = fnPagedVectorFloorLog2(nIdx / m_nBlockSize + 1);
+				nBlockIndex = nLevel;
+				nOffset = nIdx - m_nBlockSize * ((1u << nLevel) - 1);
+			}
+			else {
+				nfUint32 nMaxBlockSize = m_nBlockSize << m_nMaxBlockLevel;
+				nfUint32 nRemainder = nIdx - m_nGrowthCount;
+				nBlockIndex = m_nMaxBlockLevel + nRemainder / nMaxBlockSize;
+				nOffset = nRemainder % nMaxBlockSize;
+			}
+		}
+
+		void nextBlock() {
+			size_t nBlockIndex;
+			nfUint32 nOffset;
+			locate(m_nCount, nBlockIndex, nOffset);
+
+			if (nBlockIndex < m_pBlocks.size()) {
+				m_pHeadBlock = m_pBlocks[nBlockIndex];
+			}
+			else {
+				size_t nBlockSize = blockSize(nBlockIndex);
+				m_pAllocations.reserve(m_pAllocations.size() + 1);
+				m_pBlocks.reserve(m_pBlocks.size() + 1);
+				m_pHeadBlock = allocateElements(nBlockSize);
+				m_pBlocks.push_back(m_pHeadBlock);
+				m_nCapacity += nBlockSize;
+			}
+
+			m_nHeadBlockStart = blockStart(nBlockIndex);
+			m_nHeadBlockEnd = m_nHeadBlockStart + blockSize(nBlockIndex);
+		}
+	public:
+
+		CPagedVector() {
+			initialize(DEFAULTBLOCKSIZE);
 		}
 
 		CPagedVector(_In_ nfUint32 nBlockSize) {
-			m_nCount = 0;
-			m_pHeadBlock = NULL;
-			m_nBlockSize = nBlockSize;
-			if (m_nBlockSize == 0)
-				throw CNMRException(NMR_ERROR_INVALIDBLOCKSIZE);
+			initialize(nBlockSize);
 		}
 
 		~CPagedVector() {
@@ -76,15 +187,11 @@ namespace NMR {
 		}
 
 		_Ret_notnull_ T * allocData() {
-			nfUint32 nIdx = (m_nCount % m_nBlockSize);
-
-			// Allocate new node block if necessary
-			if (nIdx == 0) {
-				m_pHeadBlock = new T[m_nBlockSize];
-				m_pBlocks.push_back(m_pHeadBlock);
-			}
+			// Switch to the next block, allocate it if it was not reserved
+			if (m_nCount == m_nHeadBlockEnd)
+				nextBlock();
 
-			T * pResult = &m_pHeadBlock[nIdx];
+			T * pResult = &m_pHeadBlock[m_nCount - m_nHeadBlockStart];
 			m_nCount++;
 
 			return pResult;
@@ -96,48 +203,181 @@ namespace NMR {
 		}
 
 		T& allocDataRef(_Out_ nfUint32& nNewIndex) {
-			nfUint32 nIdx = (m_nCount % m_nBlockSize);
-
-			// Allocate new node block if necessary
-			if (nIdx == 0) {
-				m_pHeadBlock = new T[m_nBlockSize];
-				m_pBlocks.push_back(m_pHeadBlock);
-			}
-
 			nNewIndex = m_nCount;
-			m_nCount++;
-
-			return m_pHeadBlock[nIdx];
+			return *allocData();
 		}
 
 		_Ret_notnull_ T * getData(_In_ nfUint32 nIdx) {
 			if (nIdx >= m_nCount)
 				throw CNMRException(NMR_ERROR_INVALIDINDEX);
 
-			T * block = m_pBlocks[nIdx / m_nBlockSize];
-			return &block[nIdx % m_nBlockSize];
+			size_t nBlockIndex;
+			nfUint32 nOffset;
+			locate(nIdx, nBlockIndex, nOffset);
+			return &m_pBlocks[nBlockIndex][nOffset];
 		}
 
 		T& getDataRef(_In_ nfUint32 nIdx) {
-			if (nIdx >= m_nCount)
+			return *getData(nIdx);
+		}
+
+		// Allocates up to nMaxCount elements, which are contiguous in memory. Fewer are allocated
+		// if the current block is full before, so callers loop until all elements are allocated.
+		_Ret_notnull_ T * allocRange(_In_ nfUint32 nMaxCount, _Out_ nfUint32 & nAllocatedCount) {
+			// Switch to the next block, allocate it if it was not reserved
+			if (m_nCount == m_nHeadBlockEnd)
+				nextBlock();
+
+			nAllocatedCount = (nfUint32)std::min((nfUint64)nMaxCount, m_nHeadBlockEnd - m_nCount);
+			T * pResult = &m_pHeadBlock[m_nCount - m_nHeadBlockStart];
+			m_nCount += nAllocatedCount;
+
+			return pResult;
+		}
+
+		// Returns the element nStartIndex and the number of elements that follow it contiguously
+		// in the same block, so that ranges can be processed block by block.
+		_Ret_notnull_ T * getRange(_In_ nfUint32 nStartIndex, _Out_ nfUint32 & nContiguousCount) {
+			if (nStartIndex >= m_nCount)
 				throw CNMRException(NMR_ERROR_INVALIDINDEX);
 
-			T* block = m_pBlocks[nIdx / m_nBlockSize];
-			return block[nIdx % m_nBlockSize];
+			size_t nBlockIndex;
+			nfUint32 nOffset;
+			locate(nStartIndex, nBlockIndex, nOffset);
+			nContiguousCount = (nfUint32)std::min((size_t)(blockSize(nBlockIndex) - nOffset), (size_t)(m_nCount - nStartIndex));
+			return &m_pBlocks[nBlockIndex][nOffset];
+		}
+
+		// Returns the index of an element of this vector. This searches the blocks,
+		// so it is meant for occasional lookups and not for loops over all elements.
+		nfUint32 getIndex(_In_ const T * pElement) {
+			std::less<const T *> Less;
+			for (size_t nBlockIndex = 0; nBlockIndex < m_pBlocks.size(); nBlockIndex++) {
+				const T * pBlock = m_pBlocks[nBlockIndex];
+				if (!Less(pElement, pBlock) && Less(pElement, pBlock + blockSize(nBlockIndex))) {
+					nfUint64 nIndex = blockStart(nBlockIndex) + (nfUint64)(pElement - pBlock);
+					if (nIndex >= m_nCount)
+						break;
+					return (nfUint32)nIndex;
+				}
+			}
+			throw CNMRException(NMR_ERROR_INVALIDINDEX);
+		}
+
+		// Copies nCount elements, starting at nStartIndex, into pTarget
+		void copyOut(_In_ nfUint32 nStartIndex, _In_ nfUint32 nCount, _Out_ T * pTarget) {
+			if ((nfUint64)nStartIndex + nCount > m_nCount)
+				throw CNMRException(NMR_ERROR_INVALIDINDEX);
+
+			nfUint32 nIndex = nStartIndex;
+			nfUint32 nEndIndex = nStartIndex + nCount;
+			while (nIndex < nEndIndex) {
+				nfUint32 nContiguousCount;
+				T * pSource = getRange(nIndex, nContiguousCount);
+				nContiguousCount = std::min(nContiguousCount, nEndIndex - nIndex);
+
+				std::copy(pSource, pSource + nContiguousCount, pTarget);
+				pTarget += nContiguousCount;
+				nIndex += nContiguousCount;
+			}
+		}
+
+		// Appends nCount elements copied from pSource
+		void appendRange(_In_ const T * pSource, _In_ nfUint32 nCount) {
+			reserve(m_nCount + nCount);
+
+			while (nCount > 0) {
+				nfUint32 nAllocatedCount;
+				T * pTarget = allocRange(nCount, nAllocatedCount);
+
+				std::copy(pSource, pSource + nAllocatedCount, pTarget);
+				pSource += nAllocatedCount;
+				nCount -= nAllocatedCount;
+			}
+		}
+
+		// Allocates the blocks for nCount elements at once, so that adding them does not allocate anymore
+		void reserve(_In_ nfUint32 nCount) {
+			if (nCount <= m_nCapacity)
+				return;
+
+			size_t nFirstBlock = m_pBlocks.size();
+			size_t nBlockCount = nFirstBlock;
+			size_t nNewCapacity = m_nCapacity;
+			while (nNewCapacity < nCount) {
+				nNewCapacity += blockSize(nBlockCount);
+				nBlockCount++;
+			}
+
+			m_pAllocations.reserve(m_pAllocations.size() + 1);
+			m_pBlocks.reserve(nBlockCount);
+			T * pAllocation = allocateElements(nNewCapacity - m_nCapacity);
+
+			for (size_t nBlockIndex = nFirstBlock; nBlockIndex < nBlockCount; nBlockIndex++) {
+				m_pBlocks.push_back(pAllocation);
+				pAllocation += blockSize(nBlockIndex);
+			}
+			m_nCapacity = nNewCapacity;
+		}
+
+		// Drops the elements from nCount on, but keeps their blocks for elements added later
+		void truncate(_In_ nfUint32 nCount) {
+			if (nCount >= m_nCount)
+				return;
+
+			m_nCount = nCount;
+			if (nCount == 0) {
+				m_pHeadBlock = NULL;
+				m_nHeadBlockStart = 0;
+				m_nHeadBlockEnd = 0;
+				return;
+			}
+
+			size_t nBlockIndex;
+			nfUint32 nOffset;
+			locate(nCount - 1, nBlockIndex, nOffset);
+			m_pHeadBlock = m_pBlocks[nBlockIndex];
+			m_nHeadBlockStart = blockStart(nBlockIndex);
+			m_nHeadBlockEnd = m_nHeadBlockStart + blockSize(nBlockIndex);
+		}
+
+		nfUint32 getCapacity() {
+			return (nfUint32) std::min(m_nCapacity, (size_t)0xffffffff);
+		}
+
+		// Blocks which are allocated later come from the arena, or from the heap if it is nullptr.
+		// Only for elements which need no destructor, since the arena does not call any. The vector
+		// holds the arena of its blocks, so it can only be replaced while the vector has no blocks.
+		void setArena(_In_opt_ PMonotonicArena pArena) {
+			static_assert(std::is_trivially_destructible<T>::value, "arena blocks are not destructed");
+			if ((pArena != m_pArena) && !m_pBlocks.empty())
+				throw CNMRException(NMR_ERROR_INVALIDPARAM);
+			m_pArena = pArena;
+		}
+
+		_Ret_maybenull_ PMonotonicArena getArena() {
+			return m_pArena;
 		}
 
+		// Also detaches the vector from its arena, so that refilling it does not grow the arena
 		void clearAllData() {
-			for (auto iIterator = m_pBlocks.begin(); iIterator != m_pBlocks.end(); iIterator++)
+			for (auto iIterator = m_pAllocations.begin(); iIterator != m_pAllocations.end(); iIterator++)
 			{
-				T * pBlock = *iIterator;
-				delete[] pBlock;
+				T * pAllocation = *iIterator;
+				delete[] pAllocation;
 			}
 
+			m_pAllocations.clear();
 			m_pBlocks.clear();
+			m_pArena.reset();
 			m_nCount = 0;
+			m_nCapacity = 0;
 			m_pHeadBlock = NULL;
+			m_nHeadBlockStart = 0;
+			m_nHeadBlockEnd = 0;
 		}
 
+		// Size of the first block, later blocks are larger
 		nfUint32 getBlockSize() {
 			return m_nBlockSize;
 		}
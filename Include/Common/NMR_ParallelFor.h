@@ -0,0 +1,57 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_ParallelFor.h defines functions to split a range of elements into chunks and to
+process the chunks on worker threads.
+
+--*/
+
+#ifndef __NMR_PARALLELFOR
+#define __NMR_PARALLELFOR
+
+#include "Common/NMR_Types.h"
+#include "Common/NMR_Local.h"
+
+#include <functional>
+
+namespace NMR {
+
+	// Returns the number of chunks for nCount elements: one per hardware thread, but no chunk smaller than nMinChunkSize.
+	// Returns 0 for an empty range.
+	nfUint32 fnParallelGetChunkCount(_In_ nfUint64 nCount, _In_ nfUint64 nMinChunkSize);
+
+	// Returns the first element of a chunk. Chunk nChunkIndex spans the elements up to the start of the next chunk.
+	nfUint64 fnParallelGetChunkStart(_In_ nfUint64 nCount, _In_ nfUint32 nChunkCount, _In_ nfUint32 nChunkIndex);
+
+	// Calls fnChunk for all chunk indices. The calling thread processes the first chunk, worker threads the others.
+	// After all chunks are done, the exception of the first failed chunk is rethrown.
+	void fnParallelForChunks(_In_ nfUint32 nChunkCount, _In_ const std::function<void(nfUint32 nChunkIndex)> & fnChunk);
+
+}
+
+#endif // __NMR_PARALLELFOR
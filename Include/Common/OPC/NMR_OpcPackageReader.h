@@ -54,6 +54,7 @@ namespace NMR {
 
 		// ZIP Handling Variables
 		std::vector<nfByte> m_Buffer;
+		PImportStream m_pMappedStream;
 		zip_error_t m_ZIPError;
 		zip_t * m_ZIParchive;
 		zip_source_t * m_ZIPsource;
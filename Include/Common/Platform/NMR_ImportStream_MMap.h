@@ -0,0 +1,81 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_ImportStream_MMap.h defines the CImportStream_MMap Class.
+This is a platform independent class for reading from a memory mapped file.
+Copies to memory are zero-copy views that keep the mapping alive.
+
+--*/
+
+#ifndef __NMR_IMPORTSTREAM_MMAP
+#define __NMR_IMPORTSTREAM_MMAP
+
+#include "Common/Platform/NMR_ImportStream_Memory.h"
+#include "Common/NMR_Types.h"
+#include "Common/NMR_Local.h"
+
+#include <memory>
+
+namespace NMR {
+
+	class CMemoryMappedFile {
+		private:
+			const nfByte * m_pData;
+			nfUint64 m_cbSize;
+#ifdef _WIN32
+			void * m_hFile;
+			void * m_hMapping;
+#endif // _WIN32
+		public:
+			CMemoryMappedFile(_In_ const nfWChar * pwszFileName);
+			~CMemoryMappedFile();
+
+			const nfByte * getData();
+			nfUint64 getSize();
+	};
+
+	typedef std::shared_ptr<CMemoryMappedFile> PMemoryMappedFile;
+
+	class CImportStream_MMap : public CImportStream_Memory {
+		private:
+			PMemoryMappedFile m_pMappedFile;
+			const nfByte * m_Buffer;
+		protected:
+			virtual const nfByte * getAt(nfUint64 nPosition);
+		public:
+			CImportStream_MMap(_In_ const nfWChar * pwszFileName);
+			CImportStream_MMap(_In_ PMemoryMappedFile pMappedFile, _In_ nfUint64 nOffset, _In_ nfUint64 cbBytes);
+
+			virtual PImportStream copyToMemory();
+	};
+
+	typedef std::shared_ptr<CImportStream_MMap> PImportStream_MMap;
+
+} // namespace NMR
+
+#endif // __NMR_IMPORTSTREAM_MMAP
@@ -61,6 +61,9 @@ namespace NMR {
 		virtual nfUint64 retrieveSize();
 		virtual void writeToFile(_In_ const nfWChar * pwszFileName);
 		virtual PImportStream copyToMemory() = 0;
+
+		// Direct access to the whole stream content, nullptr for empty streams
+		const nfByte * getData();
 	};
 
 }
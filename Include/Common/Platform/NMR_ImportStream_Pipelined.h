@@ -0,0 +1,103 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_ImportStream_Pipelined.h defines the CImportStream_Pipelined Class.
+This is a forward-only stream that reads its source stream on a producer thread
+into a bounded ring of chunks. Used for ZIP entries, inflating the next chunk
+overlaps with parsing the current one.
+
+--*/
+
+#ifndef __NMR_IMPORTSTREAM_PIPELINED
+#define __NMR_IMPORTSTREAM_PIPELINED
+
+#include "Common/Platform/NMR_ImportStream.h"
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#define NMR_IMPORTSTREAM_PIPELINED_CHUNKSIZE (512 * 1024)
+#define NMR_IMPORTSTREAM_PIPELINED_CHUNKCOUNT 4
+// Smaller streams are not worth a thread
+#define NMR_IMPORTSTREAM_PIPELINED_MINSIZE (4 * 1024 * 1024)
+
+namespace NMR {
+
+	class CImportStream_Pipelined : public CImportStream {
+	private:
+		PImportStream m_pSourceStream;
+		nfUint64 m_nSize;
+		nfUint64 m_nPosition;
+
+		std::vector<std::vector<nfByte>> m_Chunks;
+		std::vector<nfUint64> m_ChunkSizes;
+
+		// Consumer state, only accessed by the reading thread
+		nfUint32 m_nReadChunk;
+		nfUint64 m_nReadOffset;
+		nfBool m_bHoldsChunk;
+
+		// Shared state, guarded by m_Mutex
+		nfUint32 m_nFilledChunks;
+		nfBool m_bSourceFinished;
+		nfBool m_bStopProducer;
+		std::exception_ptr m_pProducerException;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_ChunkFilled;
+		std::condition_variable m_ChunkReleased;
+		std::thread m_ProducerThread;
+
+		void produceChunks();
+		void stopProducer();
+	public:
+		CImportStream_Pipelined() = delete;
+		CImportStream_Pipelined(_In_ PImportStream pSourceStream);
+		~CImportStream_Pipelined();
+
+		// Returns true if a stream of the given size should be pipelined on this machine
+		static nfBool isWorthPipelining(_In_ nfUint64 nSize);
+
+		virtual nfBool seekPosition(_In_ nfUint64 position, _In_ nfBool bHasToSucceed);
+		virtual nfBool seekForward(_In_ nfUint64 bytes, _In_ nfBool bHasToSucceed);
+		virtual nfBool seekFromEnd(_In_ nfUint64 bytes, _In_ nfBool bHasToSucceed);
+		virtual nfUint64 readBuffer(_In_ nfByte * pBuffer, _In_ nfUint64 cbTotalBytesToRead, nfBool bNeedsToReadAll);
+		virtual nfUint64 retrieveSize();
+		virtual void writeToFile(_In_ const nfWChar * pwszFileName);
+		virtual PImportStream copyToMemory();
+		virtual nfUint64 getPosition();
+	};
+
+	typedef std::shared_ptr <CImportStream_Pipelined> PImportStream_Pipelined;
+
+}
+
+#endif // __NMR_IMPORTSTREAM_PIPELINED
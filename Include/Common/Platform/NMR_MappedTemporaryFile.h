@@ -0,0 +1,69 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_MappedTemporaryFile.h defines the CMappedTemporaryFile Class.
+This is a platform independent class for a writable memory mapping of an anonymous
+temporary file, which is removed as soon as the mapping is released.
+
+--*/
+
+#ifndef __NMR_MAPPEDTEMPORARYFILE
+#define __NMR_MAPPEDTEMPORARYFILE
+
+#include "Common/NMR_Types.h"
+#include "Common/NMR_Local.h"
+
+#include <memory>
+#include <string>
+
+namespace NMR {
+
+	class CMappedTemporaryFile {
+		private:
+			nfByte * m_pData;
+			nfUint64 m_cbSize;
+#ifdef _WIN32
+			void * m_hFile;
+			void * m_hMapping;
+#endif // _WIN32
+		public:
+			CMappedTemporaryFile() = delete;
+			// An empty directory selects the temporary directory of the system. All space of the file is allocated
+			// up front, throws NMR_ERROR_COULDNOTCREATEFILE if the directory has not enough of it.
+			CMappedTemporaryFile(_In_ const std::wstring & sDirectory, _In_ nfUint64 cbSize);
+			~CMappedTemporaryFile();
+
+			nfByte * getData();
+			nfUint64 getSize();
+	};
+
+	typedef std::shared_ptr<CMappedTemporaryFile> PMappedTemporaryFile;
+
+} // namespace NMR
+
+#endif // __NMR_MAPPEDTEMPORARYFILE
@@ -43,6 +43,7 @@ classes.
 namespace NMR {
 
 	PImportStream fnCreateImportStreamInstance(_In_ const nfChar * pszFileName);
+	PImportStream fnCreateImportStreamInstance(_In_ const nfChar * pszFileName, _In_ nfBool bMemoryMapped);
 	PExportStream fnCreateExportStreamInstance(_In_ const nfChar * pszFileName);
 	PXmlReader fnCreateXMLReaderInstance(_In_ PImportStream pImportStream, PProgressMonitor  pProgressMonitor);
 	PXmlWriter fnCreateXMLWriterInstance(_In_ PExportStream pExportStream, PProgressMonitor pProgressMonitor);
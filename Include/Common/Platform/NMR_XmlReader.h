@@ -48,6 +48,7 @@ namespace NMR {
 	class CXmlReader {
 	protected:
 		PImportStream m_pImportStream;
+		nfBool m_bAllowRawContent;
 	public:
 		CXmlReader(_In_ PImportStream pImportStream);
 		virtual ~CXmlReader() = default;
@@ -56,6 +57,8 @@ namespace NMR {
 		virtual void GetValue(_Outptr_result_buffer_maybenull_(*pcchValue + 1)  const nfChar ** ppszValue, _Out_opt_  nfUint32 *pcwchValue) = 0;
 		virtual void GetNamespaceURI(_Outptr_result_buffer_maybenull_(*pcchValue + 1)  const nfChar ** ppszValue, _Out_opt_  nfUint32 *pcchValue) = 0;
 		virtual bool GetNamespaceURI(const std::string &sNameSpacePrefix, std::string &sNameSpaceURI) = 0;
+		// Interned ID of the namespace of the current node, see eXmlNameSpaceID
+		virtual nfUint32 GetNamespaceID() = 0;
 		virtual bool NamespaceRegistered(const std::string &sNameSpaceURI) = 0;
 
 		virtual nfBool Read(_Out_ eXmlReaderNodeType & NodeType) = 0;
@@ -65,6 +68,15 @@ namespace NMR {
 		virtual nfBool MoveToNextAttribute() = 0;
 		virtual nfBool IsDefault() = 0;
 		virtual void CloseElement();
+
+		// Raw content access lets callers parse well-known content directly from in-memory documents.
+		// It is disabled by default, as the caller has to reproduce the reader's behaviour for that content.
+		void AllowRawContent(_In_ nfBool bAllowRawContent);
+		// Returns the unparsed document from the next node up to the end of the document, together with the
+		// namespace ID unprefixed elements resolve to. Returns false if the document is not held in memory.
+		virtual nfBool GetRawContent(_Outptr_ const nfChar ** ppStart, _Outptr_ const nfChar ** ppEnd, _Out_ nfUint32 & nDefaultNameSpaceID);
+		// Continues reading at pResume, which has to lie within the content returned by GetRawContent
+		virtual void SkipRawContent(_In_ const nfChar * pResume);
 	};
 
 	typedef std::shared_ptr<CXmlReader> PXmlReader;
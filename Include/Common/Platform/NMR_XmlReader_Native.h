@@ -34,6 +34,8 @@ NMR_XMLReader_Native.h defines a XML reader class with a native XML parsing impl
 #define __NMR_XMLREADER_NATIVE
 
 #include "Common/Platform/NMR_XmlReader.h"
+#include "Common/Platform/NMR_XmlReader_NativeScan.h"
+#include "Common/Platform/NMR_XmlTokens.h"
 #include "Common/3MF_ProgressMonitor.h"
 
 #include <memory>
@@ -73,6 +75,12 @@ NMR_XMLReader_Native.h defines a XML reader class with a native XML parsing impl
 
 namespace NMR {
 
+	typedef struct {
+		std::string m_sPrefix;
+		std::string m_sURI;
+		nfUint32 m_nID;
+	} XMLNATIVENAMESPACE;
+
 	class CXmlReader_Native : public CXmlReader {
 	private:
 		nfUint32 m_progressCounter;
@@ -124,15 +132,24 @@ namespace NMR {
 		// NameSpace handling
 		std::string m_sDefaultNameSpace;
 		nfUint32 m_cbDefaultNameSpaceLength;
+		nfUint32 m_nDefaultNameSpaceID;
 		nfBool m_bNameSpaceIsAttribute;
-		std::map<std::string, std::string> m_sNameSpaces;
+		// Declared prefixes, documents only declare a handful of them
+		std::vector<XMLNATIVENAMESPACE> m_NameSpaces;
+		// Interned URIs that are not known namespaces, indexed by ID - XMLNAMESPACEID_FIRSTCUSTOM
+		std::vector<std::string> m_CustomNameSpaceURIs;
 		void registerNameSpace(_In_ std::string sPrefix, _In_ std::string sURI);
+		nfUint32 internNameSpace(_In_ const std::string & sURI);
+		const XMLNATIVENAMESPACE * findNameSpace(_In_z_ const nfChar * pszPrefix);
 
 
 		// Fill next buffer chunk
 		nfBool ensureFilledBuffer();
 		void readNextBufferFromStream();
 
+		// Vectorized character scanning
+		XMLSCANFUNCTIONS m_ScanFunctions;
+
 		// Parse Text Buffer
 		nfChar * parseUnknown(_In_ nfChar * pszStart, _In_ nfChar * pszEnd);
 		nfChar * parseText(_In_ nfChar * pszStart, _In_ nfChar * pszEnd);
@@ -160,6 +177,7 @@ namespace NMR {
 		virtual void GetLocalName(_Outptr_result_buffer_maybenull_(*pcwchLocalName + 1) const nfChar ** ppwszLocalName, _Out_opt_ nfUint32 *pcwchLocalName);
 		virtual void GetNamespaceURI(_Outptr_result_buffer_maybenull_(*pcwchValue + 1)  const nfChar ** ppwszValue, _Out_opt_  nfUint32 *pcwchValue);
 		virtual bool GetNamespaceURI(const std::string &sNameSpacePrefix, std::string &sNameSpaceURI);
+		virtual nfUint32 GetNamespaceID();
 		virtual bool NamespaceRegistered(const std::string &sNameSpaceURI);
 
 		virtual nfBool Read(_Out_ eXmlReaderNodeType & NodeType);
@@ -170,6 +188,9 @@ namespace NMR {
 		virtual nfBool IsDefault();
 		virtual void CloseElement();
 
+		virtual nfBool GetRawContent(_Outptr_ const nfChar ** ppStart, _Outptr_ const nfChar ** ppEnd, _Out_ nfUint32 & nDefaultNameSpaceID);
+		virtual void SkipRawContent(_In_ const nfChar * pResume);
+
 	};
 
 	typedef std::shared_ptr<CXmlReader_Native> PXmlReader_Native;
@@ -0,0 +1,158 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_XmlReader_NativeScan.h defines vectorized character scanning functions for the native
+XML parser. Each function returns a pointer to the first character of a given character
+class in [pStart, pEnd), or pEnd if there is none.
+
+Short spans are probed inline with SSE2, which is the baseline on all x86 platforms.
+Longer spans are handed to a wide scan function, which uses AVX2 if the processor
+supports it at runtime.
+
+--*/
+
+#ifndef __NMR_XMLREADER_NATIVESCAN
+#define __NMR_XMLREADER_NATIVESCAN
+
+#include "Common/NMR_Types.h"
+#include "Common/NMR_Local.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+#define __NMR_XMLSCAN_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Character classes of the native XML parser
+#define NMR_XMLSCAN_TEXTEND '<'
+#define NMR_XMLSCAN_ELEMENTNAMEEND 9, 10, 13, 32, '?', '>', '/'
+#define NMR_XMLSCAN_ENDELEMENTNAMEEND '/', '?', '>'
+#define NMR_XMLSCAN_ATTRIBUTENAMEEND 9, 10, 13, 32, 34, 39, '='
+#define NMR_XMLSCAN_DOUBLEQUOTE 34
+#define NMR_XMLSCAN_SINGLEQUOTE 39
+#define NMR_XMLSCAN_NAMESPACESEPARATOR ':', 0
+
+namespace NMR {
+
+	typedef nfChar * (*XmlScanFunction) (_In_ nfChar * pStart, _In_ nfChar * pEnd);
+
+	typedef struct {
+		XmlScanFunction m_fnTextEnd;
+		XmlScanFunction m_fnElementNameEnd;
+		XmlScanFunction m_fnEndElementNameEnd;
+		XmlScanFunction m_fnAttributeNameEnd;
+		XmlScanFunction m_fnDoubleQuote;
+		XmlScanFunction m_fnSingleQuote;
+		XmlScanFunction m_fnNameSpaceSeparator;
+	} XMLSCANFUNCTIONS;
+
+	// Returns the fastest wide scan function set supported by the current processor
+	const XMLSCANFUNCTIONS & fnXmlScanGetFunctions();
+
+	// Returns the portable byte-by-byte scan function set
+	const XMLSCANFUNCTIONS & fnXmlScanGetScalarFunctions();
+
+	template <nfChar C>
+	inline nfBool fnXmlScanIsAny(_In_ nfChar cChar)
+	{
+		return cChar == C;
+	}
+
+	template <nfChar C, nfChar C2, nfChar... CREST>
+	inline nfBool fnXmlScanIsAny(_In_ nfChar cChar)
+	{
+		return (cChar == C) || fnXmlScanIsAny<C2, CREST...>(cChar);
+	}
+
+	template <nfChar... CSET>
+	inline nfChar * fnXmlScanScalar(_In_ nfChar * pStart, _In_ nfChar * pEnd)
+	{
+		nfChar * pChar = pStart;
+		while (pChar != pEnd) {
+			if (fnXmlScanIsAny<CSET...>(*pChar))
+				return pChar;
+			pChar++;
+		}
+		return pChar;
+	}
+
+	inline nfUint32 fnXmlScanFirstBit(_In_ nfUint32 nMask)
+	{
+#ifdef _MSC_VER
+		unsigned long nIndex;
+		_BitScanForward(&nIndex, nMask);
+		return (nfUint32)nIndex;
+#else
+		return (nfUint32)__builtin_ctz(nMask);
+#endif
+	}
+
+#ifdef __NMR_XMLSCAN_SSE2
+
+	template <nfChar C>
+	inline __m128i fnXmlScanCompareSSE2(_In_ __m128i vChars)
+	{
+		return _mm_cmpeq_epi8(vChars, _mm_set1_epi8(C));
+	}
+
+	template <nfChar C, nfChar C2, nfChar... CREST>
+	inline __m128i fnXmlScanCompareSSE2(_In_ __m128i vChars)
+	{
+		return _mm_or_si128(fnXmlScanCompareSSE2<C>(vChars), fnXmlScanCompareSSE2<C2, CREST...>(vChars));
+	}
+
+	template <nfChar... CSET>
+	inline nfUint32 fnXmlScanMaskSSE2(_In_ const nfChar * pChar)
+	{
+		__m128i vChars = _mm_loadu_si128((const __m128i *) pChar);
+		return (nfUint32)_mm_movemask_epi8(fnXmlScanCompareSSE2<CSET...>(vChars));
+	}
+
+#endif // __NMR_XMLSCAN_SSE2
+
+	// Probes the first 16 characters inline and passes longer spans on to fnWideScan
+	template <nfChar... CSET>
+	inline nfChar * fnXmlScan(_In_ nfChar * pStart, _In_ nfChar * pEnd, _In_ XmlScanFunction fnWideScan)
+	{
+#ifdef __NMR_XMLSCAN_SSE2
+		if (pEnd - pStart >= 16) {
+			nfUint32 nMask = fnXmlScanMaskSSE2<CSET...>(pStart);
+			if (nMask != 0)
+				return pStart + fnXmlScanFirstBit(nMask);
+			return fnWideScan(pStart + 16, pEnd);
+		}
+#endif // __NMR_XMLSCAN_SSE2
+		return fnXmlScanScalar<CSET...>(pStart, pEnd);
+	}
+
+}
+
+#endif // __NMR_XMLREADER_NATIVESCAN
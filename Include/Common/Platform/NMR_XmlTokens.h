@@ -0,0 +1,99 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_XmlTokens.h defines integer IDs for the XML namespaces and the element and attribute
+names the 3MF reader dispatches on most often. Namespace URIs are interned by the XML
+reader when they are declared, local names are resolved through a perfect hash table.
+
+--*/
+
+#ifndef __NMR_XMLTOKENS
+#define __NMR_XMLTOKENS
+
+#include "Common/NMR_Types.h"
+#include "Common/NMR_Local.h"
+
+namespace NMR {
+
+	enum eXmlNameSpaceID {
+		XMLNAMESPACEID_NONE = 0,
+		XMLNAMESPACEID_XML,
+		XMLNAMESPACEID_XMLNS,
+		XMLNAMESPACEID_CORESPEC093,
+		XMLNAMESPACEID_CORESPEC100,
+		XMLNAMESPACEID_MATERIALSPEC,
+		XMLNAMESPACEID_PRODUCTIONSPEC,
+		XMLNAMESPACEID_BEAMLATTICESPEC,
+		XMLNAMESPACEID_SLICESPEC,
+		XMLNAMESPACEID_TOOLPATHSPEC,
+		XMLNAMESPACEID_ZCOMPRESSION,
+		// Unknown namespace URIs are interned with IDs starting here
+		XMLNAMESPACEID_FIRSTCUSTOM
+	};
+
+	enum eXmlToken {
+		XMLTOKEN_UNKNOWN = 0,
+		XMLTOKEN_VERTEX,
+		XMLTOKEN_TRIANGLE,
+		XMLTOKEN_BEAM,
+		XMLTOKEN_SEGMENT,
+		XMLTOKEN_HATCH,
+		XMLTOKEN_POINT,
+		XMLTOKEN_X,
+		XMLTOKEN_Y,
+		XMLTOKEN_Z,
+		XMLTOKEN_V1,
+		XMLTOKEN_V2,
+		XMLTOKEN_V3,
+		XMLTOKEN_P1,
+		XMLTOKEN_P2,
+		XMLTOKEN_P3,
+		XMLTOKEN_PID,
+		XMLTOKEN_R1,
+		XMLTOKEN_R2,
+		XMLTOKEN_CAP1,
+		XMLTOKEN_CAP2,
+		XMLTOKEN_X1,
+		XMLTOKEN_Y1,
+		XMLTOKEN_X2,
+		XMLTOKEN_Y2,
+		XMLTOKEN_TYPE,
+		XMLTOKEN_PARTID,
+		XMLTOKEN_PROFILEID,
+		XMLTOKEN_STARTV
+	};
+
+	// Returns the ID of a known namespace URI, or XMLNAMESPACEID_FIRSTCUSTOM if it is not known
+	nfUint32 fnXmlLookupNameSpaceID(_In_z_ const nfChar * pszNameSpaceURI);
+
+	// Returns the token of a local name with nLength characters, or XMLTOKEN_UNKNOWN
+	eXmlToken fnXmlLookupToken(_In_z_ const nfChar * pszName, _In_ nfUint32 nLength);
+
+}
+
+#endif // __NMR_XMLTOKENS
@@ -105,6 +105,9 @@ namespace NMR {
 		std::map<PackageResourceID, PModelResource> m_ResourceMap;
 		CResourceHandler m_resourceHandler;
 
+		// Blocks of the meshes which are read into the model, see getArena
+		PMonotonicArena m_pArena;
+
 	private:
 		std::vector<PModelResource> m_Resources;
 
@@ -266,6 +269,10 @@ namespace NMR {
 		// Clear all build items and Resources
 		void clearAll ();
 
+		// Arena for the meshes and properties which readers create. clearAll replaces it, the blocks
+		// of the previous arena are freed at once when no mesh uses them anymore.
+		_Ret_notnull_ PMonotonicArena getArena();
+
 		// Creates a unique handle for identifying child classes (e.g. build items)
 		nfUint32 createHandle();
 
@@ -292,6 +299,11 @@ namespace NMR {
 		std::string getProductionModelAttachmentPath(_In_ nfUint32 nIndex);
 		PModelAttachment findProductionModelAttachment(_In_ std::string sPath);
 
+		// Production Extension part staging: a non-root model part can be read into a
+		// staging model of its own and moved into the package model afterwards
+		void shareModelAttachments(_In_ CModel * pSourceModel);
+		void mergeProductionPart(_In_ CModel * pPartModel);
+
 		// Required Extension Handling
 		nfBool RequireExtension(_In_ const std::string sExtension);
 
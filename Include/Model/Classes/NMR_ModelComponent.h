@@ -68,7 +68,7 @@ namespace NMR {
 		PUUID uuid();
 		void setUUID(PUUID uuid);
 
-		void mergeToMesh(_In_ CMesh * pMesh, _In_ const NMATRIX3 mMatrix);
+		void collectMeshes(_Inout_ std::vector<MESHMERGEINSTANCE> & Instances, _In_ const NMATRIX3 mMatrix);
 	};
 
 	typedef std::shared_ptr <CModelComponent> PModelComponent;
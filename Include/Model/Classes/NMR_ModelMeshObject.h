@@ -56,12 +56,15 @@ namespace NMR {
 		CModelMeshObject() = delete;
 		CModelMeshObject(_In_ const ModelResourceID sID, _In_ CModel * pModel);
 		CModelMeshObject(_In_ const ModelResourceID sID, _In_ CModel * pModel, _In_ PMesh pMesh);
+		// Copies another mesh object. The mesh shares its storage with the original until one of them is changed.
+		// Triangle properties and beam lattice attributes refer to resources, and are only copied within one model.
+		CModelMeshObject(_In_ const ModelResourceID sID, _In_ CModel * pModel, _In_ CModelMeshObject * pSourceObject);
 		~CModelMeshObject();
 		
 		_Ret_notnull_ CMesh * getMesh ();
 		void setMesh (_In_ PMesh pMesh);
 
-		void mergeToMesh(_In_ CMesh * pMesh, _In_ const NMATRIX3 mMatrix) override;
+		void collectMeshes(_Inout_ std::vector<MESHMERGEINSTANCE> & Instances, _In_ const NMATRIX3 mMatrix) override;
 
 		void setObjectType(_In_ eModelObjectType ObjectType) override;
 
@@ -92,8 +92,10 @@ namespace NMR {
 		nfBool setObjectTypeString(_In_ std::string sTypeString, _In_ nfBool bRaiseException);
 
 		// Merge the object into a mesh object
-		virtual void mergeToMesh(_In_ CMesh * pMesh, _In_ const NMATRIX3 mMatrix);
+		void mergeToMesh(_In_ CMesh * pMesh, _In_ const NMATRIX3 mMatrix);
 		void mergeToMesh(_In_ CMesh * pMesh);
+		// Appends the meshes the object consists of, with their accumulated transformations, in merge order
+		virtual void collectMeshes(_Inout_ std::vector<MESHMERGEINSTANCE> & Instances, _In_ const NMATRIX3 mMatrix);
 
 		// check, if the object is a valid object description
 		virtual nfBool isValid() = 0;
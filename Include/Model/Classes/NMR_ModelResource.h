@@ -68,6 +68,8 @@ namespace NMR {
 		nfBool hasResourceIndexMap();
 
 		_Ret_notnull_ CModel * getModel();
+		// Only used to move a resource between models that share one package
+		void setModel(_In_ CModel * pModel);
 	};
 
 	typedef std::shared_ptr <CModelResource> PModelResource;
@@ -71,6 +71,9 @@ namespace NMR {
 		PPackageResourceID findResourceID(PackageResourceID id);
 		PPackageResourceID findResourceID(std::string path, ModelResourceID id);
 
+		// Takes over all IDs of another handler in the order they were generated there
+		void adoptResourceIDs(CResourceHandler & sourceHandler, std::map<PackageResourceID, PackageResourceID> &oldToNewMapping);
+
 		void FlattenIDs();
 
 		void clear();
@@ -56,11 +56,12 @@ namespace NMR {
 		eModelBeamLatticeCapMode m_eCapMode1;
 		eModelBeamLatticeCapMode m_eCapMode2;
 	protected:
-		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
+		virtual void OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
 		virtual void OnNSAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue, _In_z_ const nfChar * pNameSpace);
 	public:
 		CModelReaderNode_BeamLattice1702_Beam() = delete;
 		CModelReaderNode_BeamLattice1702_Beam(_In_ CModel * pModel, _In_ PModelReaderWarnings pWarnings);
+		void reset();
 
 		virtual void parseXML(_In_ CXmlReader * pXMLReader);
 
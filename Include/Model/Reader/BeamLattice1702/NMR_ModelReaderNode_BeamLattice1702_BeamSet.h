@@ -33,6 +33,7 @@ NMR_ModelReaderNode_BeamLattice1702_BeamSet.h covers the official 3MF beamlattic
 #define __NMR_MODELREADERNODE_BEAMLATTICE1702_BEAMSET
 
 #include "Model/Reader/NMR_ModelReaderNode.h"
+#include "Model/Reader/BeamLattice1702/NMR_ModelReaderNode_BeamLattice1702_Ref.h"
 #include "Model/Classes/NMR_ModelComponent.h"
 #include "Model/Classes/NMR_ModelComponentsObject.h"
 #include "Model/Classes/NMR_ModelObject.h"
@@ -42,6 +43,8 @@ namespace NMR {
 	class CModelReaderNode_BeamLattice1702_BeamSet : public CModelReaderNode {
 	private:
 		BEAMSET * m_pBeamSet;
+
+		PModelReaderNode_BeamLattice1702_Ref m_pRefNode;
 	protected:
 		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
 		virtual void OnNSAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue, _In_z_ const nfChar * pNameSpace);
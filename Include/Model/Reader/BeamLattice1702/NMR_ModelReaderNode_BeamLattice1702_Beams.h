@@ -36,6 +36,7 @@ NMR_ModelReaderNode_BeamLattice1702_Beams.h covers the official 3MF beamlattice
 #define __NMR_MODELREADERNODE_BEAMLATTICE1702_BEAMS
 
 #include "Model/Reader/NMR_ModelReaderNode.h"
+#include "Model/Reader/BeamLattice1702/NMR_ModelReaderNode_BeamLattice1702_Beam.h"
 #include "Model/Classes/NMR_ModelComponent.h"
 #include "Model/Classes/NMR_ModelObject.h"
 
@@ -49,8 +50,10 @@ namespace NMR {
 		nfDouble m_dDefaultRadius;
 		eModelBeamLatticeCapMode m_eDefaultCapMode;
 
+		PModelReaderNode_BeamLattice1702_Beam m_pBeamNode;
+
 		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
-		virtual void OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
+		virtual void OnTokenizedNSChildElement(_In_ nfUint32 nNameSpaceID, _In_ eXmlToken Token, _In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
 	public:
 		CModelReaderNode_BeamLattice1702_Beams() = delete;
 		CModelReaderNode_BeamLattice1702_Beams(_In_ CModel * pModel, _In_ CMesh * pMesh, _In_ nfDouble defaultRadius, _In_ eModelBeamLatticeCapMode defaultCapMode, _In_ PModelReaderWarnings pWarnings);
@@ -47,6 +47,7 @@ namespace NMR {
 	public:
 		CModelReaderNode_BeamLattice1702_Ref() = delete;
 		CModelReaderNode_BeamLattice1702_Ref(_In_ PModelReaderWarnings pWarnings);
+		void reset();
 
 		virtual void parseXML(_In_ CXmlReader * pXMLReader);
 		void retrieveIndex(_Out_ nfInt32 & nIndex);
@@ -37,6 +37,7 @@ A model reader reads in a model file and generates an in-memory representation o
 #include "Model/Classes/NMR_Model.h" 
 #include "Model/Reader/NMR_ModelReaderWarnings.h" 
 #include "Common/MeshImport/NMR_MeshImporter.h" 
+#include "Common/Mesh/NMR_MeshMappedStorage.h"
 #include "Common/3MF_ProgressMonitor.h" 
 
 #include <list>
@@ -52,6 +53,7 @@ namespace NMR {
 
 		PModelReaderWarnings m_pWarnings;
 		PProgressMonitor m_pProgressMonitor;
+		PMeshMappedStorage m_pMeshMappedStorage;
 
 		void readFromMeshImporter(_In_ CMeshImporter * pImporter);
 	public:
@@ -67,6 +69,11 @@ namespace NMR {
 		void removeRelationToRead(_In_ std::string sRelationShipType);
 
 		void SetProgressCallback(Lib3MFProgressCallback callback, void* userData);
+
+		// Places the node and face arrays of the meshes which are read in memory mapped temporary files
+		// of the storage, so that meshes larger than the memory can be read (default: nullptr, in memory)
+		void setMeshMappedStorage(_In_opt_ PMeshMappedStorage pMeshMappedStorage);
+		PMeshMappedStorage getMeshMappedStorage();
 	};
 
 	typedef std::shared_ptr <CModelReader> PModelReader;
@@ -36,28 +36,57 @@ A model reader node is an abstract base class for all XML nodes of a 3MF Model S
 
 #include "Model/Classes/NMR_Model.h"
 #include "Model/Reader/NMR_ModelReaderWarnings.h"
+#include "Model/Reader/NMR_ModelReader_RawBlocks.h"
 #include "Common/Platform/NMR_XmlReader.h"
+#include "Common/Platform/NMR_XmlTokens.h"
 #include "Common/3MF_ProgressMonitor.h"
 
 #include "Common/ChunkedBinaryStream/NMR_ChunkedBinaryStreamCollection.h"
+#include "Common/Mesh/NMR_MeshMappedStorage.h"
 
 namespace NMR {
 
 	class CModelReaderNode {
 	private:
+		// View into the XML reader buffer, valid as long as the element is the reader's current element
+		const nfChar * m_pszName;
+		// Owned copy of the name, only made for elements with content
 		std::string m_sName;
 		nfBool m_bParsedAttributes;
 		nfBool m_bParsedContent;
 		nfBool m_bIsEmptyElement;
 
+		void persistName();
+
 	protected:
 		PProgressMonitor m_pProgressMonitor;
 		PModelReaderWarnings m_pWarnings;
 		PChunkedBinaryStreamCollection m_pBinaryStreamCollection;
+		PMeshMappedStorage m_pMeshMappedStorage;
 
+		void resetNode();
 		void parseName(_In_ CXmlReader * pXMLReader);
 		void parseAttributes(_In_ CXmlReader * pXMLReader);
 		void parseContent(_In_ CXmlReader * pXMLReader);
+		// Alternative to parseContent for large blocks of uniform elements in the given namespace.
+		// Returns false if the content has to be read with parseContent.
+		nfBool parseRawContent(_In_ CXmlReader * pXMLReader, _In_ nfUint32 nNameSpaceID, _In_ CModelReader_RawBlockParser & BlockParser);
+
+		// Returns the node for the next child element of a repeated leaf type, such as a vertex or triangle.
+		// Blocks of these elements are parsed with a single node, which is created with the given arguments
+		// on first use and reset for every further child element instead of allocating one per element.
+		// The caller keeps the node in a member; the arguments must therefore be the same for all children,
+		// and the node's reset() has to clear everything that was parsed for the previous element.
+		template <typename TNode, typename... TArgs>
+		TNode * reuseChildNode(_Inout_ std::shared_ptr<TNode> & pNode, TArgs&&... Args)
+		{
+			if (pNode.get() == nullptr)
+				pNode = std::make_shared<TNode>(std::forward<TArgs>(Args)...);
+			else
+				pNode->reset();
+
+			return pNode.get();
+		}
 
 		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
 		virtual void OnText(_In_z_ const nfChar * pText, _In_ CXmlReader * pXMLReader);
@@ -65,6 +94,10 @@ namespace NMR {
 
 		virtual void OnNSAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue, _In_z_ const nfChar * pNameSpace);
 		virtual void OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
+
+		// Called with the name token and the interned namespace ID, forward to OnAttribute and OnNSChildElement by default
+		virtual void OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
+		virtual void OnTokenizedNSChildElement(_In_ nfUint32 nNameSpaceID, _In_ eXmlToken Token, _In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
 	public:
 		CModelReaderNode() = delete;
 		CModelReaderNode(_In_ PModelReaderWarnings pWarnings, _In_ PProgressMonitor pProgressMonitor = nullptr);
@@ -74,10 +107,16 @@ namespace NMR {
 		PModelReaderWarnings getWarnings();
 
 		virtual void parseXML(_In_ CXmlReader * pXMLReader) = 0;
+		// Feeds an attribute that has not been read through an XML reader, e.g. by a raw block parser
+		void parseRawAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
 
 		void setBinaryStreamCollection (PChunkedBinaryStreamCollection pBinaryStreamCollection);
 		PChunkedBinaryStreamCollection getBinaryStreamCollection();
 		nfBool supportsBinaryStreams();
+
+		// Storage of the meshes which are read, nullptr keeps them in memory
+		void setMeshMappedStorage(PMeshMappedStorage pMeshMappedStorage);
+		PMeshMappedStorage getMeshMappedStorage();
 	};
 
 	typedef std::shared_ptr <CModelReaderNode> PModelReaderNode;
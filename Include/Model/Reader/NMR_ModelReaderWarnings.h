@@ -91,6 +91,9 @@ namespace NMR {
 
 		nfUint32 getWarningCount();
 		PModelReaderWarning getWarning(_In_ nfUint32 nIndex);
+
+		// Appends the warnings of another collection, without re-checking their levels
+		void mergeWarnings(_In_ CModelReaderWarnings * pSourceWarnings);
 	};
 
 	typedef std::shared_ptr <CModelReaderWarnings> PModelReaderWarnings;
@@ -44,6 +44,9 @@ namespace NMR {
 	class CModelReader_3MF : public CModelReader {
 	protected:
 		nfBool m_bAllowBinaryStreams;
+		nfBool m_bPipelinedInflate;
+		nfBool m_bParallelProductionParts;
+		nfBool m_bParallelMeshParsing;
 		PChunkedBinaryStreamCollection m_pBinaryStreamCollection;
 
 		virtual PImportStream extract3MFOPCPackage(_In_ PImportStream pPackageStream) = 0;
@@ -55,6 +58,19 @@ namespace NMR {
 
 		virtual void readStream(_In_ PImportStream pStream);
 		virtual void addTextureAttachment(_In_ std::string sPath, _In_ PImportStream pStream);
+
+		// Inflate large model parts on a producer thread while they are parsed (default: on)
+		void setPipelinedInflate(_In_ nfBool bPipelinedInflate);
+		nfBool getPipelinedInflate();
+
+		// Read the non-root model parts of the production extension on worker threads (default: on)
+		void setParallelProductionParts(_In_ nfBool bParallelProductionParts);
+		nfBool getParallelProductionParts();
+
+		// Split large vertex and triangle blocks of in-memory packages into ranges that are parsed on
+		// worker threads (default: off). The root model part is inflated into memory for this.
+		void setParallelMeshParsing(_In_ nfBool bParallelMeshParsing);
+		nfBool getParallelMeshParsing();
 	};
 
 	typedef std::shared_ptr <CModelReader_3MF> PModelReader_3MF;
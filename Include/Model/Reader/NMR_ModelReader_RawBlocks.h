@@ -0,0 +1,107 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_ModelReader_RawBlocks.h defines a parser for large blocks of uniform, empty elements
+(e.g. the vertices and triangles of a mesh) that reads them directly from an in-memory document.
+The block is split at element boundaries into ranges, which are parsed on worker threads.
+Only a plain subset of XML is accepted; for anything else the parser gives up and the caller
+reads the block with the streaming XML reader instead.
+
+--*/
+
+#ifndef __NMR_MODELREADER_RAWBLOCKS
+#define __NMR_MODELREADER_RAWBLOCKS
+
+#include "Common/NMR_Types.h"
+#include "Common/NMR_Local.h"
+#include "Common/Platform/NMR_XmlTokens.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Ranges start at this size and double with every window of ranges
+#define NMR_RAWBLOCK_MINRANGESIZE (64 * 1024)
+#define NMR_RAWBLOCK_MAXRANGESIZE (8 * 1024 * 1024)
+// Longer attribute names and values are left to the streaming reader
+#define NMR_RAWBLOCK_MAXATTRIBUTELENGTH 64
+
+namespace NMR {
+
+	// Receives the elements of one range. Every range gets its own instance, which is only used by one thread.
+	class CModelReader_RawRange {
+	public:
+		virtual ~CModelReader_RawRange() = default;
+
+		virtual void beginElement() = 0;
+		// Returns false if the attribute needs the streaming reader, e.g. because it would raise a warning
+		virtual nfBool onAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pszName, _In_z_ const nfChar * pszValue) = 0;
+		// May throw for invalid elements, the block is then left to the streaming reader
+		virtual void endElement() = 0;
+	};
+
+	typedef std::shared_ptr<CModelReader_RawRange> PModelReader_RawRange;
+
+	typedef struct {
+		PModelReader_RawRange m_pRange;
+		const nfChar * m_pStart;
+		const nfChar * m_pEnd;
+		// Behind the end tag of the block, if the range contains it
+		const nfChar * m_pBlockEnd;
+		nfBool m_bSuccess;
+	} MODELREADERRAWRANGE;
+
+	class CModelReader_RawBlockParser {
+	private:
+		std::string m_sBlockName;
+		std::string m_sElementName;
+		std::function<PModelReader_RawRange()> m_fnCreateRange;
+		nfUint32 m_nThreadCount;
+
+		// Parsed ranges in document order
+		std::vector<PModelReader_RawRange> m_Ranges;
+
+		void parseRange(_Inout_ MODELREADERRAWRANGE & Range);
+		const nfChar * parseElement(_In_ const nfChar * pChar, _In_ const nfChar * pEnd, _In_ CModelReader_RawRange * pRange);
+		const nfChar * parseBlockEnd(_In_ const nfChar * pChar, _In_ const nfChar * pEnd);
+	public:
+		CModelReader_RawBlockParser() = delete;
+		CModelReader_RawBlockParser(_In_z_ const nfChar * pszElementName, _In_ std::function<PModelReader_RawRange()> fnCreateRange);
+
+		// Parses the content of the block from pStart on, which has to follow the block's start tag.
+		// On success, ppResume points behind the end tag of the block.
+		nfBool parse(_In_z_ const nfChar * pszBlockName, _In_ const nfChar * pStart, _In_ const nfChar * pEnd, _Outptr_ const nfChar ** ppResume);
+
+		nfUint32 getRangeCount();
+		CModelReader_RawRange * getRange(_In_ nfUint32 nIndex);
+	};
+
+}
+
+#endif // __NMR_MODELREADER_RAWBLOCKS
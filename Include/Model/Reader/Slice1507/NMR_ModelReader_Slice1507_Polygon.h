@@ -30,6 +30,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define __NMR_MODELREADERNODE_SLICE1507_POLYGON
 
 #include "Model/Reader/NMR_ModelReaderNode.h"
+#include "Model/Reader/Slice1507/NMR_ModelReader_Slice1507_Segment.h"
 #include "Model/Classes/NMR_ModelComponent.h"
 #include "Model/Classes/NMR_ModelComponentsObject.h"
 #include "Model/Classes/NMR_ModelObject.h"
@@ -45,9 +46,11 @@ namespace NMR {
 		nfUint32 m_PolygonIndex;
 		nfUint32 m_StartV;
 
+		PModelReaderNode_Slices1507_Segment m_pSegmentNode;
+
 	protected:
 		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
-		virtual void OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
+		virtual void OnTokenizedNSChildElement(_In_ nfUint32 nNameSpaceID, _In_ eXmlToken Token, _In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
 
 	public:
 		CModelReaderNode_Slices1507_Polygon() = delete;
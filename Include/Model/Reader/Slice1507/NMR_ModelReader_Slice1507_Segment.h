@@ -47,12 +47,13 @@ namespace NMR {
 		nfUint32 m_PolygonIndex;
 
 	protected:
-		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
+		virtual void OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
 		virtual void OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
 
 	public:
 		CModelReaderNode_Slices1507_Segment() = delete;
 		CModelReaderNode_Slices1507_Segment(_In_ CSlice *pSlice, nfUint32 nPolygonIndex, _In_ PModelReaderWarnings pWarnings);
+		void reset();
 
 		virtual void parseXML(_In_ CXmlReader * pXMLReader);
 	};
@@ -48,12 +48,13 @@ namespace NMR {
 		CSlice *m_pSlice;
 
 	protected:
-		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
+		virtual void OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
 		virtual void OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
 
 	public:
 		CModelReaderNode_Slices1507_Vertex() = delete;
 		CModelReaderNode_Slices1507_Vertex(_In_ CSlice *pSlice, _In_ PModelReaderWarnings pWarnings);
+		void reset();
 
 		virtual void parseXML(_In_ CXmlReader * pXMLReader);
 	};
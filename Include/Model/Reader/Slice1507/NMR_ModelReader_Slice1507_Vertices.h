@@ -34,6 +34,7 @@ NMR_ModelReaderNode_slice1507_Segment.h covers the vertices of the private 3MF s
 #define __NMR_MODELREADERNODE_SLICE1507_VERTICES
 
 #include "Model/Reader/NMR_ModelReaderNode.h"
+#include "Model/Reader/Slice1507/NMR_ModelReader_Slice1507_Vertex.h"
 #include "Model/Classes/NMR_ModelComponent.h"
 #include "Model/Classes/NMR_ModelComponentsObject.h"
 #include "Model/Classes/NMR_ModelObject.h"
@@ -44,9 +45,11 @@ namespace NMR {
 	private:
 		CSlice *m_pSlice;
 
+		PModelReaderNode_Slices1507_Vertex m_pVertexNode;
+
 	protected:
 		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
-		virtual void OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
+		virtual void OnTokenizedNSChildElement(_In_ nfUint32 nNameSpaceID, _In_ eXmlToken Token, _In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
 
 	public:
 		CModelReaderNode_Slices1507_Vertices() = delete;
@@ -49,6 +49,7 @@ namespace NMR {
 	public:
 		CModelReaderNode093_TextureVertex() = delete;
 		CModelReaderNode093_TextureVertex(_In_ PModelReaderWarnings pWarnings);
+		void reset();
 
 		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
 
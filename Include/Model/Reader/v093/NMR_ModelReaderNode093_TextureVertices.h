@@ -35,6 +35,7 @@ A vertices reader model node is a parser for the vertices node of an XML Model S
 #define __NMR_MODELREADERNODE093_TEXTUREVERTICES
 
 #include "Model/Reader/NMR_ModelReaderNode.h"
+#include "Model/Reader/v093/NMR_ModelReaderNode093_TextureVertex.h"
 #include "Model/Reader/NMR_ModelReader_TexCoordMapping.h"
 #include "Model/Classes/NMR_ModelComponent.h"
 #include "Model/Classes/NMR_ModelObject.h"
@@ -46,6 +47,8 @@ namespace NMR {
 		CMesh * m_pMesh; 
 		PModelReader_TexCoordMapping m_pTexCoordMapping;
 		ModelResourceIndex m_nTexCoordIndex;
+
+		PModelReaderNode093_TextureVertex m_pTextureVertexNode;
 	protected:
 		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
 		virtual void OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
@@ -58,6 +58,7 @@ namespace NMR {
 	public:
 		CModelReaderNode093_Triangle() = delete;
 		CModelReaderNode093_Triangle(_In_ PModelReaderWarnings pWarnings);
+		void reset();
 
 		virtual void parseXML(_In_ CXmlReader * pXMLReader);
 		void retrieveIndices(_Out_ nfInt32 & nIndex1, _Out_ nfInt32 & nIndex2, _Out_ nfInt32 & nIndex3, nfInt32 nNodeCount);
@@ -35,6 +35,7 @@ A triangles reader model node is a parser for the triangles node of an XML Model
 #define __NMR_MODELREADERNODE093_TRIANGLES
 
 #include "Model/Reader/NMR_ModelReaderNode.h"
+#include "Model/Reader/v093/NMR_ModelReaderNode093_Triangle.h"
 #include "Model/Reader/NMR_ModelReader_ColorMapping.h"
 #include "Model/Reader/NMR_ModelReader_TexCoordMapping.h"
 
@@ -54,6 +55,8 @@ namespace NMR {
 		PModelReader_TexCoordMapping m_pTexCoordMapping;
 		PModelBaseMaterialResource m_pDefaultMaterialResource;
 
+		PModelReaderNode093_Triangle m_pTriangleNode;
+
 		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
 		virtual void OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
 
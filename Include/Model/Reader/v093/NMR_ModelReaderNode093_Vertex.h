@@ -51,6 +51,7 @@ namespace NMR {
 	public:
 		CModelReaderNode093_Vertex() = delete;
 		CModelReaderNode093_Vertex(_In_ PModelReaderWarnings pWarnings);
+		void reset();
 
 		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
 
@@ -35,6 +35,7 @@ A vertices reader model node is a parser for the vertices node of an XML Model S
 #define __NMR_MODELREADERNODE093_VERTICES
 
 #include "Model/Reader/NMR_ModelReaderNode.h"
+#include "Model/Reader/v093/NMR_ModelReaderNode093_Vertex.h"
 #include "Model/Classes/NMR_ModelComponent.h"
 #include "Model/Classes/NMR_ModelObject.h"
 
@@ -43,6 +44,8 @@ namespace NMR {
 	class CModelReaderNode093_Vertices : public CModelReaderNode {
 	private:
 		CMesh * m_pMesh;
+
+		PModelReaderNode093_Vertex m_pVertexNode;
 	protected:
 		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
 		virtual void OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
@@ -50,10 +50,11 @@ namespace NMR {
 		nfInt32 m_nIndex2;
 		nfInt32 m_nIndex3;
 
-		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
+		virtual void OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
 	public:
 		CModelReaderNode100_Triangle() = delete;
 		CModelReaderNode100_Triangle(_In_ PModelReaderWarnings pWarnings);
+		void reset();
 
 		virtual void parseXML(_In_ CXmlReader * pXMLReader);
 		void retrieveIndices(_Out_ nfInt32 & nIndex1, _Out_ nfInt32 & nIndex2, _Out_ nfInt32 & nIndex3, nfInt32 nNodeCount);
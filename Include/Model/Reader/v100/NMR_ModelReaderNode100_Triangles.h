@@ -36,12 +36,38 @@ A triangles reader model node is a parser for the triangles node of an XML Model
 
 #include "Common/MeshInformation/NMR_MeshInformation_Properties.h"
 #include "Model/Reader/NMR_ModelReaderNode.h"
+#include "Model/Reader/v100/NMR_ModelReaderNode100_Triangle.h"
 #include "Model/Reader/NMR_ModelReader_TexCoordMapping.h"
 #include "Model/Classes/NMR_ModelComponent.h"
 #include "Model/Classes/NMR_ModelObject.h"
 
 namespace NMR {
 
+	typedef struct {
+		nfInt32 m_nIndices[3];
+		ModelResourceID m_nResourceID;
+		ModelResourceIndex m_nResourceIndices[3];
+	} MODELREADERTRIANGLE;
+
+	// Triangles of one range of a block that is parsed by CModelReader_RawBlockParser
+	class CModelReaderNode100_TriangleRange : public CModelReader_RawRange {
+	private:
+		CModelReaderNode100_Triangle m_TriangleNode;
+		nfInt32 m_nNodeCount;
+		ModelResourceID m_nDefaultResourceID;
+		ModelResourceIndex m_nDefaultResourceIndex;
+		std::vector<MODELREADERTRIANGLE> m_Triangles;
+	public:
+		CModelReaderNode100_TriangleRange() = delete;
+		CModelReaderNode100_TriangleRange(_In_ nfInt32 nNodeCount, _In_ ModelResourceID nDefaultResourceID, _In_ ModelResourceIndex nDefaultResourceIndex);
+
+		virtual void beginElement();
+		virtual nfBool onAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pszName, _In_z_ const nfChar * pszValue);
+		virtual void endElement();
+
+		const std::vector<MODELREADERTRIANGLE> & getTriangles();
+	};
+
 	class CModelReaderNode100_Triangles : public CModelReaderNode {
 	protected:
 		CMesh * m_pMesh;
@@ -50,14 +76,28 @@ namespace NMR {
 		ModelResourceID m_nDefaultResourceID;
 		ModelResourceIndex m_nDefaultResourceIndex;
 		ModelResourceID m_nUsedResourceID;
+		// Faces to reserve once the first triangle is read
+		nfUint64 m_nEstimatedFaceCount;
 
 		std::string m_sBinaryStreamPath;
 
+		PModelReaderNode100_Triangle m_pTriangleNode;
+
+		// Property resource of the last resolved pid. Consecutive triangles mostly share their pid,
+		// so they do not look up the resource by path and ID again.
+		ModelResourceID m_nCachedResourceID;
+		PPackageResourceID m_pCachedPackageResourceID;
+		CModelResource * m_pCachedResource;
+		CMeshInformation_Properties * m_pProperties;
+
 		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
-		virtual void OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
+		virtual void OnTokenizedNSChildElement(_In_ nfUint32 nNameSpaceID, _In_ eXmlToken Token, _In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
 
 		_Ret_notnull_ CMeshInformation_Properties * createPropertiesInformation();
 
+		// Reserves mesh storage for nFaceCount more faces
+		void reserveFaces(_In_ nfUint64 nFaceCount);
+
 		void addFace (ModelResourceIndex nIndex1, ModelResourceIndex nIndex2, ModelResourceIndex nIndex3, ModelResourceID nResourceID, ModelResourceIndex nResourceIndex1, ModelResourceIndex nResourceIndex2, ModelResourceIndex nResourceIndex3);
 	public:
 		CModelReaderNode100_Triangles() = delete;
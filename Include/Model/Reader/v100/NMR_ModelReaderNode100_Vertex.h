@@ -51,8 +51,9 @@ namespace NMR {
 	public:
 		CModelReaderNode100_Vertex() = delete;
 		CModelReaderNode100_Vertex(_In_ PModelReaderWarnings pWarnings);
+		void reset();
 
-		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
+		virtual void OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
 
 		virtual void parseXML(_In_ CXmlReader * pXMLReader);
 
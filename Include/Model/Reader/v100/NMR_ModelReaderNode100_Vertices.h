@@ -35,18 +35,36 @@ A vertices reader model node is a parser for the vertices node of an XML Model S
 #define __NMR_MODELREADERNODE100_VERTICES
 
 #include "Model/Reader/NMR_ModelReaderNode.h"
+#include "Model/Reader/v100/NMR_ModelReaderNode100_Vertex.h"
 #include "Model/Classes/NMR_ModelComponent.h"
 #include "Model/Classes/NMR_ModelObject.h"
 
 namespace NMR {
 
+	// Vertices of one range of a block that is parsed by CModelReader_RawBlockParser
+	class CModelReaderNode100_VertexRange : public CModelReader_RawRange {
+	private:
+		CModelReaderNode100_Vertex m_VertexNode;
+		std::vector<NVEC3> m_Vertices;
+	public:
+		CModelReaderNode100_VertexRange();
+
+		virtual void beginElement();
+		virtual nfBool onAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pszName, _In_z_ const nfChar * pszValue);
+		virtual void endElement();
+
+		const std::vector<NVEC3> & getVertices();
+	};
+
 	class CModelReaderNode100_Vertices : public CModelReaderNode {
 	private:
 		CMesh * m_pMesh;
 		std::string m_sBinaryStreamPath;
+
+		PModelReaderNode100_Vertex m_pVertexNode;
 	protected:
 		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
-		virtual void OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
+		virtual void OnTokenizedNSChildElement(_In_ nfUint32 nNameSpaceID, _In_ eXmlToken Token, _In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
 	public:
 		CModelReaderNode100_Vertices() = delete;
 		CModelReaderNode100_Vertices(_In_ CMesh * pMesh, _In_ std::string sBinaryStreamPath, _In_ PModelReaderWarnings pWarnings);
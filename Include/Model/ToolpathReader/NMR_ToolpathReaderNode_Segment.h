@@ -33,6 +33,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Model/Reader/NMR_ModelReaderNode.h"
 #include "Model/Reader/NMR_ModelReaderWarnings.h"
 #include "Model/Classes/NMR_ModelToolpathLayerReadData.h"
+#include "Model/ToolpathReader/NMR_ToolpathReaderNode_Hatch.h"
+#include "Model/ToolpathReader/NMR_ToolpathReaderNode_Point.h"
+#include "Model/ToolpathReader/NMR_ToolpathReaderNode_ZHatch.h"
+#include "Model/ToolpathReader/NMR_ToolpathReaderNode_ZPoint.h"
 
 
 namespace NMR {
@@ -47,7 +51,13 @@ namespace NMR {
 		nfBool m_bHasSegmentType;
 		std::string m_sBinaryStreamPath;
 
-		virtual void OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
+		// Leaf nodes of the child elements
+		PToolpathReaderNode_Hatch m_pHatchNode;
+		PToolpathReaderNode_Point m_pPointNode;
+		PToolpathReaderNode_ZHatch m_pZHatchNode;
+		PToolpathReaderNode_ZPoint m_pZPointNode;
+
+		virtual void OnTokenizedNSChildElement(_In_ nfUint32 nNameSpaceID, _In_ eXmlToken Token, _In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader);
 		virtual void OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue);
 		virtual void OnNSAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue, _In_z_ const nfChar * pNameSpace);
 	public:
@@ -45,6 +45,7 @@ namespace NMR {
 	class CModelWriter {
 	private:
 		nfUint32 m_nDecimalPrecision;
+		nfBool m_bMeshReordering;
 	protected:
 		PModel m_pModel;
 		PProgressMonitor m_pProgressMonitor;
@@ -67,6 +68,10 @@ namespace NMR {
 		void SetDecimalPrecision(nfUint32);
 		nfUint32 GetDecimalPrecision();
 
+		// Reorders faces and nodes of meshes for locality when writing them
+		void SetMeshReordering(nfBool bMeshReordering);
+		nfBool GetMeshReordering();
+
 		CModel * getModel ();
 
 		void registerBinaryStream (const std::string &sPath, const std::string & sUUID, PChunkedBinaryStreamWriter pStreamWriter);
@@ -39,6 +39,7 @@ This is the class for exporting the 3mf mesh node.
 #include "Model/Classes/NMR_ModelMeshObject.h" 
 
 #include "Common/MeshInformation/NMR_MeshInformation_Properties.h"
+#include "Common/Mesh/NMR_MeshReordering.h"
 
 #include "Common/Platform/NMR_XmlWriter.h"
 #include <array>
@@ -66,6 +67,7 @@ namespace NMR {
 
 		nfBool m_bWriteMaterialExtension;
 		nfBool m_bWriteBeamLatticeExtension;
+		nfBool m_bReorderMesh;
 
 		// Internal functions for an efficient and buffered output of raw XML data
 		std::array<nfChar, MODELWRITERMESH100_LINEBUFFERSIZE> m_VertexLine;
@@ -96,10 +98,10 @@ namespace NMR {
 		__NMR_INLINE void putBeamRefString(_In_ const nfChar * pszString);
 		__NMR_INLINE void putBeamRefUInt32(_In_ const nfUint32 nValue);
 
-		__NMR_INLINE void writeVertexData(_In_ MESHNODE * pNode);
-		__NMR_INLINE void writeFaceData_Plain(_In_ MESHFACE * pFace, _In_opt_ const nfChar * pszAdditionalString);
-		__NMR_INLINE void writeFaceData_OneProperty(_In_ MESHFACE * pFace, _In_ const ModelResourceID nPropertyID, _In_ const ModelResourceIndex nPropertyIndex, _In_opt_ const nfChar * pszAdditionalString);
-		__NMR_INLINE void writeFaceData_ThreeProperties(_In_ MESHFACE * pFace, _In_ const ModelResourceID nPropertyID, _In_ const ModelResourceIndex nPropertyIndex1, _In_ const ModelResourceIndex nPropertyIndex2, _In_ const ModelResourceIndex nPropertyIndex3, _In_opt_ const nfChar * pszAdditionalString);
+		__NMR_INLINE void writeVertexData(_In_ const NVEC3 & vPosition);
+		__NMR_INLINE void writeFaceData_Plain(_In_ const nfInt32 * pNodeIndices, _In_opt_ const nfChar * pszAdditionalString);
+		__NMR_INLINE void writeFaceData_OneProperty(_In_ const nfInt32 * pNodeIndices, _In_ const ModelResourceID nPropertyID, _In_ const ModelResourceIndex nPropertyIndex, _In_opt_ const nfChar * pszAdditionalString);
+		__NMR_INLINE void writeFaceData_ThreeProperties(_In_ const nfInt32 * pNodeIndices, _In_ const ModelResourceID nPropertyID, _In_ const ModelResourceIndex nPropertyIndex1, _In_ const ModelResourceIndex nPropertyIndex2, _In_ const ModelResourceIndex nPropertyIndex3, _In_opt_ const nfChar * pszAdditionalString);
 		__NMR_INLINE void writeBeamData(_In_ MESHBEAM * pBeam, _In_ nfDouble dRadius, _In_ eModelBeamLatticeCapMode eDefaultCapMode);
 		__NMR_INLINE void writeRefData(_In_ INT nRefID);
 	public:
@@ -107,6 +109,9 @@ namespace NMR {
 		CModelWriterNode100_Mesh(_In_ CModelMeshObject * pModelMeshObject, _In_ CXmlWriter * pXMLWriter, _In_ PProgressMonitor pProgressMonitor,
 			_In_ PMeshInformation_PropertyIndexMapping pPropertyIndexMapping, _In_ int nPosAfterDecPoint, _In_ nfBool bWriteMaterialExtension, _In_ nfBool m_bWriteBeamLatticeExtension, CChunkedBinaryStreamWriter * pBinaryStreamWriter, std::string sBinaryStreamPath);
 		virtual void writeToXML();
+
+		// Writes faces and nodes in the order of CMeshReordering, the mesh itself is not changed
+		void setReorderMesh(_In_ nfBool bValue);
 	};
 
 }
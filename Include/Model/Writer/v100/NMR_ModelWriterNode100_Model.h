@@ -61,6 +61,7 @@ namespace NMR {
 		nfBool m_bWriteObjects;
 		nfBool m_bWriteToolpaths;
 		nfBool m_bWriteLZMAExtension;
+		nfBool m_bReorderMeshes;
 		nfBool m_bIsRootModel;
 		nfBool m_bWriteCustomNamespaces;
 
@@ -104,6 +105,7 @@ namespace NMR {
 		virtual void writeToXML();
 
 		void setWriteLZMAExtension(nfBool bValue);
+		void setReorderMeshes(nfBool bValue);
 	};
 
 }
@@ -35,10 +35,15 @@ Abstract: This is a stub class definition of CMeshObject
 // Include custom headers here.
 
 #include "Common/MeshInformation/NMR_MeshInformation_Properties.h"
+#include "Common/NMR_StringUtils.h"
 #include <cmath>
 
 using namespace Lib3MF::Impl;
 
+// The bulk calls copy positions and triangles as plain arrays of coordinates and node indices
+static_assert(sizeof(sLib3MFPosition) == 3 * sizeof(NMR::nfFloat), "sLib3MFPosition must consist of three coordinates");
+static_assert(sizeof(sLib3MFTriangle) == 3 * sizeof(NMR::nfInt32), "sLib3MFTriangle must consist of three node indices");
+
 /*************************************************************************************************************************
  Class definition of CMeshObject 
  **************************************************************************************************************************/
@@ -105,25 +110,22 @@ Lib3MF_uint32 CMeshObject::GetTriangleCount ()
 
 void CMeshObject::SetVertex (const Lib3MF_uint32 nIndex, const sLib3MFPosition Coordinates)
 {
-	NMR::MESHNODE* node = mesh()->getNode(nIndex);
-	node->m_position.m_fields[0] = Coordinates.m_Coordinates[0];
-	node->m_position.m_fields[1] = Coordinates.m_Coordinates[1];
-	node->m_position.m_fields[2] = Coordinates.m_Coordinates[2];
+	mesh()->setNodePosition(nIndex, NMR::fnVEC3_make(Coordinates.m_Coordinates[0], Coordinates.m_Coordinates[1], Coordinates.m_Coordinates[2]));
 }
 
 sLib3MFPosition CMeshObject::GetVertex(const Lib3MF_uint32 nIndex)
 {
-	NMR::MESHNODE* node = mesh()->getNode(nIndex);
+	NMR::NVEC3 vPosition = mesh()->getNodePosition(nIndex);
 	sLib3MFPosition pos;
-	pos.m_Coordinates[0] = node->m_position.m_fields[0];
-	pos.m_Coordinates[1] = node->m_position.m_fields[1];
-	pos.m_Coordinates[2] = node->m_position.m_fields[2];
+	pos.m_Coordinates[0] = vPosition.m_fields[0];
+	pos.m_Coordinates[1] = vPosition.m_fields[1];
+	pos.m_Coordinates[2] = vPosition.m_fields[2];
 	return pos;
 }
 
 Lib3MF_uint32 CMeshObject::AddVertex (const sLib3MFPosition Coordinates)
 {
-	return mesh()->addNode(Coordinates.m_Coordinates[0], Coordinates.m_Coordinates[1], Coordinates.m_Coordinates[2])->m_index;
+	return mesh()->appendNode(NMR::fnVEC3_make(Coordinates.m_Coordinates[0], Coordinates.m_Coordinates[1], Coordinates.m_Coordinates[2]));
 }
 
 void CMeshObject::GetVertices(Lib3MF_uint64 nVerticesBufferSize, Lib3MF_uint64* pVerticesNeededCount, sLib3MFPosition * pVerticesBuffer)
@@ -134,40 +136,36 @@ void CMeshObject::GetVertices(Lib3MF_uint64 nVerticesBufferSize, Lib3MF_uint64*
 
 	if (nVerticesBufferSize >= nodeCount && pVerticesBuffer)
 	{
-		for (Lib3MF_uint32 i = 0; i < nodeCount; i++)
-		{
-			const NMR::MESHNODE* node = mesh()->getNode(i);
-			pVerticesBuffer[i].m_Coordinates[0] = node->m_position.m_fields[0];
-			pVerticesBuffer[i].m_Coordinates[1] = node->m_position.m_fields[1];
-			pVerticesBuffer[i].m_Coordinates[2] = node->m_position.m_fields[2];
-		}
+		mesh()->copyNodePositions(0, nodeCount, &pVerticesBuffer[0].m_Coordinates[0]);
 	}
 }
 
 sLib3MFTriangle CMeshObject::GetTriangle (const Lib3MF_uint32 nIndex)
 {
 	sLib3MFTriangle t;
-	NMR::MESHFACE* mf = mesh()->getFace(nIndex);
+	NMR::nfInt32 NodeIndices[3];
+	mesh()->getFaceNodeIndices(nIndex, NodeIndices);
 
-	t.m_Indices[0] = mf->m_nodeindices[0];
-	t.m_Indices[1] = mf->m_nodeindices[1];
-	t.m_Indices[2] = mf->m_nodeindices[2];
+	t.m_Indices[0] = NodeIndices[0];
+	t.m_Indices[1] = NodeIndices[1];
+	t.m_Indices[2] = NodeIndices[2];
 
 	return t;
 }
 
 void CMeshObject::SetTriangle (const Lib3MF_uint32 nIndex, const sLib3MFTriangle Indices)
 {
-	NMR::MESHFACE* mf = mesh()->getFace(nIndex);
+	NMR::nfInt32 NodeIndices[3];
+	NodeIndices[0] = Indices.m_Indices[0];
+	NodeIndices[1] = Indices.m_Indices[1];
+	NodeIndices[2] = Indices.m_Indices[2];
 
-	mf->m_nodeindices[0] = Indices.m_Indices[0];
-	mf->m_nodeindices[1] = Indices.m_Indices[1];
-	mf->m_nodeindices[2] = Indices.m_Indices[2];
+	mesh()->setFaceNodeIndices(nIndex, NodeIndices);
 }
 
 Lib3MF_uint32 CMeshObject::AddTriangle(const sLib3MFTriangle Indices)
 {
-	return mesh()->addFace(Indices.m_Indices[0], Indices.m_Indices[1], Indices.m_Indices[2])->m_index;
+	return mesh()->appendFace(Indices.m_Indices[0], Indices.m_Indices[1], Indices.m_Indices[2]);
 }
 
 void CMeshObject::GetTriangleIndices (Lib3MF_uint64 nIndicesBufferSize, Lib3MF_uint64* pIndicesNeededCount, sLib3MFTriangle * pIndicesBuffer)
@@ -178,13 +176,7 @@ void CMeshObject::GetTriangleIndices (Lib3MF_uint64 nIndicesBufferSize, Lib3MF_u
 
 	if (nIndicesBufferSize >= faceCount && pIndicesBuffer)
 	{
-		for (Lib3MF_uint32 i = 0; i < faceCount; i++)
-		{
-			const NMR::MESHFACE* face = mesh()->getFace(i);
-			pIndicesBuffer[i].m_Indices[0] = face->m_nodeindices[0];
-			pIndicesBuffer[i].m_Indices[1] = face->m_nodeindices[1];
-			pIndicesBuffer[i].m_Indices[2] = face->m_nodeindices[2];
-		}
+		mesh()->copyFaceNodeIndices(0, faceCount, reinterpret_cast<NMR::nfInt32*>(&pIndicesBuffer[0].m_Indices[0]));
 	}
 }
 
@@ -232,7 +224,7 @@ void CMeshObject::GetTriangleProperties(const Lib3MF_uint32 nIndex, sLib3MFTrian
 {
 	NMR::CMeshInformation_Properties * pInformation = getMeshInformationProperties();
 
-	NMR::MESHINFORMATION_PROPERTIES * pFaceData = (NMR::MESHINFORMATION_PROPERTIES*)pInformation->getFaceData(nIndex);
+	const NMR::MESHINFORMATION_PROPERTIES * pFaceData = (const NMR::MESHINFORMATION_PROPERTIES*)pInformation->readFaceData(nIndex);
 	if (pFaceData != nullptr) {
 		sProperty.m_ResourceID = pFaceData->m_nResourceID;
 		for (unsigned j = 0; j < 3; j++) {
@@ -304,7 +296,7 @@ void CMeshObject::GetAllTriangleProperties(Lib3MF_uint64 nPropertiesArrayBufferS
 		uint32_t nIndex;
 		for (nIndex = 0; nIndex < nFaceCount; nIndex++) {
 
-			NMR::MESHINFORMATION_PROPERTIES * pFaceData = (NMR::MESHINFORMATION_PROPERTIES*)pInformation->getFaceData(nIndex);
+			const NMR::MESHINFORMATION_PROPERTIES * pFaceData = (const NMR::MESHINFORMATION_PROPERTIES*)pInformation->readFaceData(nIndex);
 			if (pFaceData != nullptr) {
 				pProperty->m_ResourceID = pFaceData->m_nResourceID;
 				for (unsigned j = 0; j < 3; j++) {
@@ -331,43 +323,66 @@ void CMeshObject::SetGeometry(const Lib3MF_uint64 nVerticesBufferSize, const sLi
 	// Clear old mesh
 	pMesh->clear();
 
-	// Rebuild Mesh Coordinates
-	const sLib3MFPosition * pVertex = pVerticesBuffer;
-	for (Lib3MF_uint64 nIndex = 0; nIndex < nVerticesBufferSize; nIndex++) {
-		for (int j = 0; j < 3; j++) {
-			if (std::fabs(pVertex->m_Coordinates[j]) > NMR_MESH_MAXCOORDINATE)
-				throw ELib3MFInterfaceException(LIB3MF_ERROR_INVALIDPARAM);
+	if (nVerticesBufferSize > NMR_MESH_MAXNODECOUNT)
+		throw ELib3MFInterfaceException(NMR_ERROR_TOOMANYNODES);
+	if (nIndicesBufferSize > NMR_MESH_MAXFACECOUNT)
+		throw ELib3MFInterfaceException(NMR_ERROR_TOOMANYFACES);
+
+	// Rebuild Mesh Coordinates and Faces. Both are validated as a whole before they are added.
+	try {
+		if (nVerticesBufferSize > 0)
+			pMesh->addNodes(&pVerticesBuffer[0].m_Coordinates[0], (NMR::nfUint32)nVerticesBufferSize);
+		if (nIndicesBufferSize > 0)
+			pMesh->addFaces(reinterpret_cast<const NMR::nfInt32*>(&pIndicesBuffer[0].m_Indices[0]), (NMR::nfUint32)nIndicesBufferSize);
+	}
+	catch (NMR::CNMRException & e) {
+		switch (e.getErrorCode()) {
+		case NMR_ERROR_INVALIDCOORDINATES:
+		case NMR_ERROR_INVALIDNODEINDEX:
+		case NMR_ERROR_DUPLICATENODE:
+			throw ELib3MFInterfaceException(LIB3MF_ERROR_INVALIDPARAM);
+		default:
+			throw;
 		}
-		pMesh->addNode(pVertex->m_Coordinates[0], pVertex->m_Coordinates[1], pVertex->m_Coordinates[2]);
-
-		pVertex++;
 	}
+}
 
-	// Rebuild Mesh Faces
-	const sLib3MFTriangle * pTriangle = pIndicesBuffer;
-	for (Lib3MF_uint64 nIndex = 0; nIndex < nIndicesBufferSize; nIndex++) {
-		NMR::MESHNODE * pNodes[3];
-
-		for (int j = 0; j < 3; j++) {
-			if (pTriangle->m_Indices[j] >= nVerticesBufferSize)
-				throw ELib3MFInterfaceException(LIB3MF_ERROR_INVALIDPARAM);
-			pNodes[j] = pMesh->getNode(pTriangle->m_Indices[j]);
-		}
+bool CMeshObject::IsManifoldAndOriented ()
+{
+	return meshObject()->isManifoldAndOriented();
+}
 
-		if ((pTriangle->m_Indices[0] == pTriangle->m_Indices[1]) ||
-			(pTriangle->m_Indices[0] == pTriangle->m_Indices[2]) ||
-			(pTriangle->m_Indices[1] == pTriangle->m_Indices[2]))
-			throw ELib3MFInterfaceException(LIB3MF_ERROR_INVALIDPARAM);
+void CMeshObject::SetFileBackedStorageActive(const bool bFileBackedStorageActive, const std::string & sDirectory)
+{
+	NMR::CMesh * pMesh = meshObject()->getMesh();
+	if (bFileBackedStorageActive)
+		pMesh->setMappedStorage(std::make_shared<NMR::CMeshMappedStorage>(NMR::fnUTF8toUTF16(sDirectory)));
+	else
+		pMesh->setMappedStorage(nullptr);
+}
 
-		pMesh->addFace(pNodes[0], pNodes[1], pNodes[2]);
+bool CMeshObject::GetFileBackedStorageActive()
+{
+	return meshObject()->getMesh()->getMappedStorage() != nullptr;
+}
 
-		pTriangle++;
+void CMeshObject::SetQuantizedStorageActive(const bool bQuantizedStorageActive, const sLib3MFPosition Origin, const Lib3MF_double dUnits, const Lib3MF_uint32 nBitCount)
+{
+	NMR::CMesh * pMesh = meshObject()->getMesh();
+	if (bQuantizedStorageActive) {
+		NMR::MESHQUANTIZATION Quantization;
+		Quantization.m_vOrigin = NMR::fnVEC3_make(Origin.m_Coordinates[0], Origin.m_Coordinates[1], Origin.m_Coordinates[2]);
+		Quantization.m_fUnits = (NMR::nfFloat)dUnits;
+		Quantization.m_nBitCount = nBitCount;
+		pMesh->quantize(Quantization);
 	}
+	else if (pMesh->getStorageMode() == NMR::MESHSTORAGEMODE_QUANTIZED)
+		pMesh->setStorageMode(NMR::MESHSTORAGEMODE_SOA);
 }
 
-bool CMeshObject::IsManifoldAndOriented ()
+bool CMeshObject::GetQuantizedStorageActive()
 {
-	return meshObject()->isManifoldAndOriented();
+	return meshObject()->getMesh()->getStorageMode() == NMR::MESHSTORAGEMODE_QUANTIZED;
 }
 
 bool CMeshObject::IsMeshObject()
@@ -449,6 +449,19 @@ IMeshObject * CModel::AddMeshObject ()
 	return new CMeshObject(pNewResource);
 }
 
+IMeshObject * CModel::AddMeshObjectCopy (IMeshObject* pSourceMeshObject)
+{
+	CMeshObject * pSourceMeshObjectClass = dynamic_cast<CMeshObject *> (pSourceMeshObject);
+	if (!pSourceMeshObjectClass)
+		throw ELib3MFInterfaceException(LIB3MF_ERROR_INVALIDOBJECT);
+
+	NMR::ModelResourceID NewResourceID = model().generateResourceID();
+	NMR::PModelMeshObject pNewResource = std::make_shared<NMR::CModelMeshObject>(NewResourceID, &model(), pSourceMeshObjectClass->meshObject().get());
+
+	model().addResource(pNewResource);
+	return new CMeshObject(pNewResource);
+}
+
 IComponentsObject * CModel::AddComponentsObject ()
 {
 	NMR::ModelResourceID NewResourceID = model().generateResourceID();
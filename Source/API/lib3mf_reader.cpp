@@ -35,6 +35,7 @@ Abstract: This is a stub class definition of CReader
 #include "Common/Platform/NMR_Platform.h"
 #include "Common/Platform/NMR_ImportStream_Shared_Memory.h"
 #include "Common/Platform/NMR_ImportStream_Callback.h"
+#include "Common/NMR_StringUtils.h"
 
 using namespace Lib3MF::Impl;
 
@@ -70,7 +71,7 @@ NMR::CModelReader& CReader::reader()
 
 void CReader::ReadFromFile (const std::string & sFilename)
 {
-	NMR::PImportStream pImportStream = NMR::fnCreateImportStreamInstance(sFilename.c_str());
+	NMR::PImportStream pImportStream = NMR::fnCreateImportStreamInstance(sFilename.c_str(), true);
 
 	try {
 		reader().readStream(pImportStream);
@@ -164,6 +165,34 @@ bool CReader::GetStrictModeActive ()
 	return reader().getWarnings()->getCriticalWarningLevel() == NMR::mrwInvalidOptionalValue;
 }
 
+void CReader::SetFileBackedMeshStorageActive (const bool bFileBackedMeshStorageActive, const std::string & sDirectory)
+{
+	if (bFileBackedMeshStorageActive)
+		reader().setMeshMappedStorage(std::make_shared<NMR::CMeshMappedStorage>(NMR::fnUTF8toUTF16(sDirectory)));
+	else
+		reader().setMeshMappedStorage(nullptr);
+}
+
+bool CReader::GetFileBackedMeshStorageActive ()
+{
+	return reader().getMeshMappedStorage() != nullptr;
+}
+
+void CReader::SetParallelMeshParsingActive (const bool bParallelMeshParsingActive)
+{
+	NMR::CModelReader_3MF * pReader3MF = dynamic_cast<NMR::CModelReader_3MF *> (m_pReader.get());
+	if (pReader3MF)
+		pReader3MF->setParallelMeshParsing(bParallelMeshParsingActive);
+	else if (bParallelMeshParsingActive)
+		throw ELib3MFInterfaceException(LIB3MF_ERROR_NOTIMPLEMENTED);
+}
+
+bool CReader::GetParallelMeshParsingActive ()
+{
+	NMR::CModelReader_3MF * pReader3MF = dynamic_cast<NMR::CModelReader_3MF *> (m_pReader.get());
+	return pReader3MF && pReader3MF->getParallelMeshParsing();
+}
+
 std::string CReader::GetWarning (const Lib3MF_uint32 nIndex, Lib3MF_uint32 & nErrorCode)
 {
 	auto warning = reader().getWarnings()->getWarning(nIndex);
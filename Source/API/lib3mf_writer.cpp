@@ -177,6 +177,16 @@ void CWriter::SetDecimalPrecision(const Lib3MF_uint32 nDecimalPrecision)
 	m_pWriter->SetDecimalPrecision(nDecimalPrecision);
 }
 
+void CWriter::SetMeshReorderingActive(const bool bMeshReorderingActive)
+{
+	m_pWriter->SetMeshReordering(bMeshReorderingActive);
+}
+
+bool CWriter::GetMeshReorderingActive()
+{
+	return m_pWriter->GetMeshReordering();
+}
+
 
 IBinaryStream * CWriter::CreateBinaryStream(const std::string & sPath)
 {
@@ -45,15 +45,25 @@ NMR::CProgressMonitor::CProgressMonitor()
 	m_eProgressIdentifier = ProgressIdentifier::PROGRESS_QUERYCANCELED;
 }
 
-bool NMR::CProgressMonitor::QueryCancelled(bool throwIfCancelled)
+bool NMR::CProgressMonitor::QueryCallback(ProgressIdentifier identifier, bool throwIfCancelled)
 {
+	if (m_pCancelFlag && m_pCancelFlag->load())
+	{
+		if (throwIfCancelled)
+			throw CNMRException(NMR_USERABORTED);
+		return true;
+	}
+
 	if (m_progressCallback)
 	{
 		std::unique_lock<std::mutex> lock(m_callbackMutex, std::try_to_lock);
 		if (lock) // If another progress callback is happening right _now_, just drop this one
 		{
 			int nProgress = (int)(100 * m_dProgress / m_dProgressMax);
-			m_lastCallbackResult = m_progressCallback(nProgress, ProgressIdentifier::PROGRESS_QUERYCANCELED, m_userData);
+			m_lastCallbackResult = m_progressCallback(nProgress, identifier, m_userData);
+
+			if (m_lastCallbackResult && m_pCancelFlag)
+				m_pCancelFlag->store(true);
 
 			if (throwIfCancelled && m_lastCallbackResult)
 				throw CNMRException(NMR_USERABORTED);
@@ -64,23 +74,14 @@ bool NMR::CProgressMonitor::QueryCancelled(bool throwIfCancelled)
 	return false;
 }
 
-bool NMR::CProgressMonitor::ReportProgressAndQueryCancelled(bool throwIfCancelled)
+bool NMR::CProgressMonitor::QueryCancelled(bool throwIfCancelled)
 {
-	if (m_progressCallback)
-	{
-		std::unique_lock<std::mutex> lock(m_callbackMutex, std::try_to_lock);
-		if (lock) // If another progress callback is happening right _now_, just drop this one
-		{
-			int nProgress = (int)(100 * m_dProgress / m_dProgressMax);
-			m_lastCallbackResult = m_progressCallback(nProgress, m_eProgressIdentifier, m_userData);
-
-			if (throwIfCancelled && m_lastCallbackResult)
-				throw CNMRException(NMR_USERABORTED);
+	return QueryCallback(ProgressIdentifier::PROGRESS_QUERYCANCELED, throwIfCancelled);
+}
 
-			return m_lastCallbackResult;
-		}
-	}
-	return false;
+bool NMR::CProgressMonitor::ReportProgressAndQueryCancelled(bool throwIfCancelled)
+{
+	return QueryCallback(m_eProgressIdentifier, throwIfCancelled);
 }
 
 bool NMR::CProgressMonitor::WasAborted()
@@ -127,6 +128,16 @@ void NMR::CProgressMonitor::ClearProgressCallback()
 	SetProgressCallback(nullptr, nullptr);
 }
 
+void NMR::CProgressMonitor::SetCancelFlag(std::shared_ptr<std::atomic<bool>> pCancelFlag)
+{
+	m_pCancelFlag = pCancelFlag;
+}
+
+std::shared_ptr<std::atomic<bool>> NMR::CProgressMonitor::GetCancelFlag()
+{
+	return m_pCancelFlag;
+}
+
 void NMR::CProgressMonitor::GetProgressMessage(NMR::ProgressIdentifier progressIdentifier, std::string& progressString) {
 	switch (progressIdentifier) {
 		case PROGRESS_QUERYCANCELED: progressString = ""; break;
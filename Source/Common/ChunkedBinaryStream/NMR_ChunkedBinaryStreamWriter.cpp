@@ -32,6 +32,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Libraries/lzma/LzmaLib.h"
 
+#include <cstring>
 #include <vector>
 
 
@@ -282,6 +283,74 @@ namespace NMR {
 
 	}
 
+	nfUint32 CChunkedBinaryStreamWriter::addQuantizedFloatArray(const nfInt32 * pValues, nfUint32 nLength, eChunkedBinaryPredictionType predictionType, nfFloat fDiscretizationUnits)
+	{
+		nfUint32 nIndex;
+
+		if (fDiscretizationUnits <= 0.0f)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		if (m_bIsFinished)
+			throw CNMRException(NMR_ERROR_STREAMWRITERALREADYFINISHED);
+
+		if (pValues == nullptr)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+		if (nLength == 0)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		// Same limit as for the discretized values of addFloatArray, checked before anything is added
+		for (nIndex = 0; nIndex < nLength; nIndex++) {
+			if ((pValues[nIndex] > BINARYCHUNKFILE_MAXFLOATUNITS) || (pValues[nIndex] < -BINARYCHUNKFILE_MAXFLOATUNITS))
+				throw CNMRException(NMR_ERROR_BINARYCHUNK_DISCRETIZATIONVALUEOUTOFRANGE);
+		}
+
+		if (m_CurrentChunk == nullptr)
+			beginChunk();
+
+		unsigned int nElementID = m_elementIDCounter;
+		m_elementIDCounter++;
+
+		m_bIsEmpty = false;
+
+		BINARYCHUNKFILEENTRY Entry;
+		Entry.m_EntryID = nElementID;
+		Entry.m_SizeInBytes = (nLength * 4) + 4;
+		Entry.m_PositionInChunk = m_CurrentChunk->m_UncompressedDataSize;
+
+		// Add Discretization units, as the bits of the float
+		nfInt32 nDiscretizationUnits;
+		memcpy(&nDiscretizationUnits, &fDiscretizationUnits, sizeof(nDiscretizationUnits));
+		m_CurrentChunkData.push_back(nDiscretizationUnits);
+
+		switch (predictionType) {
+		case eptNoPredicition:
+			Entry.m_EntryType = BINARYCHUNKFILEENTRYTYPE_FLOAT32ARRAY_NOPREDICTION;
+			for (nIndex = 0; nIndex < nLength; nIndex++)
+				m_CurrentChunkData.push_back(pValues[nIndex]);
+
+			break;
+		case eptDeltaPredicition:
+			Entry.m_EntryType = BINARYCHUNKFILEENTRYTYPE_FLOAT32ARRAY_DELTAPREDICTION;
+			m_CurrentChunkData.push_back(pValues[0]);
+			// Deltas wrap around like the sums of the reader
+			for (nIndex = 1; nIndex < nLength; nIndex++)
+				m_CurrentChunkData.push_back((nfInt32)((nfUint32)pValues[nIndex] - (nfUint32)pValues[nIndex - 1]));
+
+			break;
+		default:
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		};
+
+		m_CurrentChunkEntries.push_back(Entry);
+
+		m_CurrentChunk->m_EntryCount++;
+		m_CurrentChunk->m_UncompressedDataSize += Entry.m_SizeInBytes;
+
+		return nElementID;
+
+	}
+
 	void CChunkedBinaryStreamWriter::writeHeader()
 	{
 		if (m_bIsFinished)
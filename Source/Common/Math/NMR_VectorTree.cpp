@@ -26,8 +26,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 Abstract:
 
-NMR_VectorTree.cpp implements a n*log(n) lookup tree class to identify vectors
-by their position.
+NMR_VectorTree.cpp implements a lookup class to identify vectors by their position.
 
 --*/
 
@@ -35,22 +34,9 @@ by their position.
 #include "Common/Math/NMR_Vector.h" 
 #include "Common/NMR_Exception.h" 
 #include <cmath>
-#include <map>
 
 namespace NMR {
 
-	bool operator< (_In_ const VECTORTREEENTRY & entry1, _In_ const VECTORTREEENTRY & entry2)
-	{
-		for (int i = 0; i < 3; i++) {
-			if (entry1.m_position.m_fields[i] < entry2.m_position.m_fields[i])
-				return true;
-			if (entry1.m_position.m_fields[i] > entry2.m_position.m_fields[i])
-				return false;
-		}
-
-		return false;
-	}
-
 	CVectorTree::CVectorTree()
 	{
 		setUnits(NMR_VECTOR_DEFAULTUNITS);
@@ -70,7 +56,7 @@ namespace NMR {
 	{
 		if ((fUnits < NMR_VECTOR_MINUNITS) || (fUnits > NMR_VECTOR_MAXUNITS))
 			throw CNMRException(NMR_ERROR_INVALIDUNITS);
-		if (m_entries.size() > 0)
+		if (m_Table.getCount() > 0)
 			throw CNMRException(NMR_ERROR_COULDNOTSETUNITS);
 
 		m_fUnits = fUnits;
@@ -87,17 +73,7 @@ namespace NMR {
 
 	_Success_(return) nfBool CVectorTree::findVector3(_In_ NVEC3 vVector, _Out_opt_ nfUint32 & value)
 	{
-		VECTORTREEENTRY entry;
-		entry.m_position = fnVEC3I_floor(vVector, m_fUnits);
-
-		std::map <VECTORTREEENTRY, nfUint32>::iterator iter = m_entries.find(entry);
-
-		if (iter != m_entries.end()) {
-			value = iter->second;
-			return true;
-		}
-		else
-			return false;
+		return m_Table.find(fnVEC3I_floor(vVector, m_fUnits), value);
 	}
 
 	_Success_(return) nfBool CVectorTree::findIntVector2(_In_ NVEC2I vVector, _Out_opt_ nfUint32 & value)
@@ -111,17 +87,7 @@ namespace NMR {
 
 	_Success_(return) nfBool CVectorTree::findIntVector3(_In_ NVEC3I vVector, _Out_opt_ nfUint32 & value)
 	{
-		VECTORTREEENTRY entry;
-		entry.m_position = vVector;
-
-		std::map <VECTORTREEENTRY, nfUint32>::iterator iter = m_entries.find(entry);
-
-		if (iter != m_entries.end()) {
-			value = iter->second;
-			return true;
-		}
-		else
-			return false;
+		return m_Table.find(vVector, value);
 	}
 
 	void CVectorTree::addVector2(_In_ NVEC2 vVector, _In_ nfUint32 value)
@@ -135,9 +101,7 @@ namespace NMR {
 
 	void CVectorTree::addVector3(_In_ NVEC3 vVector, _In_ nfUint32 value)
 	{
-		VECTORTREEENTRY entry;
-		entry.m_position = fnVEC3I_floor(vVector, m_fUnits);
-		m_entries.insert(std::make_pair(entry, value));
+		m_Table.insert(fnVEC3I_floor(vVector, m_fUnits), value);
 	}
 
 	void CVectorTree::addIntVector2(_In_ NVEC2I vVector, _In_ nfUint32 value)
@@ -151,9 +115,7 @@ namespace NMR {
 
 	void CVectorTree::addIntVector3(_In_ NVEC3I vVector, _In_ nfUint32 value)
 	{
-		VECTORTREEENTRY entry;
-		entry.m_position = vVector;
-		m_entries.insert(std::make_pair(entry, value));
+		m_Table.insert(vVector, value);
 	}
 
 	void CVectorTree::removeVector2(_In_ NVEC2 vVector)
@@ -167,9 +129,7 @@ namespace NMR {
 
 	void CVectorTree::removeVector3(_In_ NVEC3 vVector)
 	{
-		VECTORTREEENTRY entry;
-		entry.m_position = fnVEC3I_floor(vVector, m_fUnits);
-		m_entries.erase(entry);
+		m_Table.remove(fnVEC3I_floor(vVector, m_fUnits));
 	}
 
 	void CVectorTree::removeIntVector2(_In_ NVEC2I vVector)
@@ -183,9 +143,12 @@ namespace NMR {
 
 	void CVectorTree::removeIntVector3(_In_ NVEC3I vVector)
 	{
-		VECTORTREEENTRY entry;
-		entry.m_position = vVector;
-		m_entries.erase(entry);
+		m_Table.remove(vVector);
+	}
+
+	void CVectorTree::reserve(_In_ nfUint32 nCount)
+	{
+		m_Table.reserve(nCount);
 	}
 
 }
@@ -0,0 +1,259 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_VertexWelding.cpp implements the vertex welding hash table and the sort based
+vertex welding.
+
+--*/
+
+#include "Common/Math/NMR_VertexWelding.h"
+#include "Common/Math/NMR_Vector.h"
+#include "Common/NMR_Exception.h"
+#include "Common/NMR_ParallelFor.h"
+
+#include <algorithm>
+
+namespace NMR {
+
+	typedef struct {
+		NVEC3I m_position;
+		nfUint32 m_nIndex;
+	} VERTEXWELDINGKEY;
+
+	static inline nfBool fnVertexWeldingIsEqual(_In_ const NVEC3I & vPosition1, _In_ const NVEC3I & vPosition2)
+	{
+		return (vPosition1.m_fields[0] == vPosition2.m_fields[0]) && (vPosition1.m_fields[1] == vPosition2.m_fields[1]) &&
+			(vPosition1.m_fields[2] == vPosition2.m_fields[2]);
+	}
+
+	static bool fnVertexWeldingKeyLess(_In_ const VERTEXWELDINGKEY & Key1, _In_ const VERTEXWELDINGKEY & Key2)
+	{
+		for (int i = 0; i < 3; i++) {
+			if (Key1.m_position.m_fields[i] != Key2.m_position.m_fields[i])
+				return Key1.m_position.m_fields[i] < Key2.m_position.m_fields[i];
+		}
+		return Key1.m_nIndex < Key2.m_nIndex;
+	}
+
+	CVertexWeldingTable::CVertexWeldingTable()
+		: m_nCount(0), m_nMask(0)
+	{
+	}
+
+	size_t CVertexWeldingTable::getHomeSlot(_In_ const NVEC3I & vPosition)
+	{
+		nfUint64 nHash = (nfUint64)(nfUint32)vPosition.m_fields[0] * 0x9E3779B97F4A7C15ull;
+		nHash ^= (nfUint64)(nfUint32)vPosition.m_fields[1] * 0xC2B2AE3D27D4EB4Full;
+		nHash ^= (nfUint64)(nfUint32)vPosition.m_fields[2] * 0x165667B19E3779F9ull;
+		nHash ^= nHash >> 29;
+		nHash *= 0xBF58476D1CE4E5B9ull;
+		nHash ^= nHash >> 32;
+		return (size_t)nHash & m_nMask;
+	}
+
+	size_t CVertexWeldingTable::findSlot(_In_ const NVEC3I & vPosition)
+	{
+		// The table is at most half full, so there is always an empty slot
+		size_t nSlot = getHomeSlot(vPosition);
+		while ((m_Entries[nSlot].m_nValue != NMR_VERTEXWELDING_EMPTYVALUE) && !fnVertexWeldingIsEqual(m_Entries[nSlot].m_position, vPosition))
+			nSlot = (nSlot + 1) & m_nMask;
+		return nSlot;
+	}
+
+	void CVertexWeldingTable::rehash(_In_ size_t nCapacity)
+	{
+		VERTEXWELDINGENTRY EmptyEntry;
+		EmptyEntry.m_position.m_fields[0] = 0;
+		EmptyEntry.m_position.m_fields[1] = 0;
+		EmptyEntry.m_position.m_fields[2] = 0;
+		EmptyEntry.m_nValue = NMR_VERTEXWELDING_EMPTYVALUE;
+
+		std::vector<VERTEXWELDINGENTRY> OldEntries(nCapacity, EmptyEntry);
+		m_Entries.swap(OldEntries);
+		m_nMask = nCapacity - 1;
+
+		for (auto iEntry = OldEntries.begin(); iEntry != OldEntries.end(); iEntry++) {
+			if (iEntry->m_nValue != NMR_VERTEXWELDING_EMPTYVALUE)
+				m_Entries[findSlot(iEntry->m_position)] = *iEntry;
+		}
+	}
+
+	void CVertexWeldingTable::reserve(_In_ nfUint32 nCount)
+	{
+		size_t nCapacity = NMR_VERTEXWELDING_MINCAPACITY;
+		while (nCapacity < (size_t)nCount * 2)
+			nCapacity *= 2;
+
+		if (nCapacity > m_Entries.size())
+			rehash(nCapacity);
+	}
+
+	nfUint32 CVertexWeldingTable::getCount()
+	{
+		return m_nCount;
+	}
+
+	void CVertexWeldingTable::clear()
+	{
+		m_Entries.clear();
+		m_nCount = 0;
+		m_nMask = 0;
+	}
+
+	_Success_(return) nfBool CVertexWeldingTable::find(_In_ const NVEC3I & vPosition, _Out_ nfUint32 & nValue)
+	{
+		if (m_nCount == 0)
+			return false;
+
+		const VERTEXWELDINGENTRY & Entry = m_Entries[findSlot(vPosition)];
+		if (Entry.m_nValue == NMR_VERTEXWELDING_EMPTYVALUE)
+			return false;
+
+		nValue = Entry.m_nValue;
+		return true;
+	}
+
+	nfBool CVertexWeldingTable::addEntry(_In_ const NVEC3I & vPosition, _In_ nfUint32 nValue, _Out_ nfUint32 & nStoredValue)
+	{
+		if (nValue == NMR_VERTEXWELDING_EMPTYVALUE)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		if (((size_t)m_nCount + 1) * 2 > m_Entries.size())
+			rehash(std::max(m_Entries.size() * 2, (size_t)NMR_VERTEXWELDING_MINCAPACITY));
+
+		VERTEXWELDINGENTRY & Entry = m_Entries[findSlot(vPosition)];
+		if (Entry.m_nValue != NMR_VERTEXWELDING_EMPTYVALUE) {
+			nStoredValue = Entry.m_nValue;
+			return false;
+		}
+
+		Entry.m_position = vPosition;
+		Entry.m_nValue = nValue;
+		m_nCount++;
+		nStoredValue = nValue;
+		return true;
+	}
+
+	nfBool CVertexWeldingTable::insert(_In_ const NVEC3I & vPosition, _In_ nfUint32 nValue)
+	{
+		nfUint32 nStoredValue;
+		return addEntry(vPosition, nValue, nStoredValue);
+	}
+
+	nfUint32 CVertexWeldingTable::findOrInsert(_In_ const NVEC3I & vPosition, _In_ nfUint32 nValue)
+	{
+		nfUint32 nStoredValue;
+		addEntry(vPosition, nValue, nStoredValue);
+		return nStoredValue;
+	}
+
+	void CVertexWeldingTable::remove(_In_ const NVEC3I & vPosition)
+	{
+		if (m_nCount == 0)
+			return;
+
+		size_t nHole = findSlot(vPosition);
+		if (m_Entries[nHole].m_nValue == NMR_VERTEXWELDING_EMPTYVALUE)
+			return;
+
+		// Shift the following entries back, unless that would move them in front of their home slot
+		size_t nNext = (nHole + 1) & m_nMask;
+		while (m_Entries[nNext].m_nValue != NMR_VERTEXWELDING_EMPTYVALUE) {
+			size_t nHome = getHomeSlot(m_Entries[nNext].m_position);
+			if (((nNext - nHome) & m_nMask) >= ((nNext - nHole) & m_nMask)) {
+				m_Entries[nHole] = m_Entries[nNext];
+				nHole = nNext;
+			}
+			nNext = (nNext + 1) & m_nMask;
+		}
+
+		m_Entries[nHole].m_nValue = NMR_VERTEXWELDING_EMPTYVALUE;
+		m_nCount--;
+	}
+
+	void fnVertexWeldSorted(_In_ const NVEC3 * pPositions, _In_ nfUint32 nCount, _In_ nfFloat fUnits,
+		_Out_ std::vector<nfUint32> & WeldedIndices, _Out_ std::vector<nfUint32> & UniqueIndices)
+	{
+		WeldedIndices.clear();
+		UniqueIndices.clear();
+		if (nCount == 0)
+			return;
+		if (!pPositions)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		// Chunks compute and sort their keys, neighbouring chunks are then merged until one is left
+		std::vector<VERTEXWELDINGKEY> Keys(nCount);
+		nfUint32 nChunkCount = fnParallelGetChunkCount(nCount, NMR_VERTEXWELDING_PARALLELCHUNKSIZE);
+		auto getChunkStart = [nCount, nChunkCount, &Keys](nfUint32 nChunkIndex) {
+			return Keys.begin() + (size_t)fnParallelGetChunkStart(nCount, nChunkCount, nChunkIndex);
+		};
+
+		fnParallelForChunks(nChunkCount, [&](nfUint32 nChunkIndex) {
+			auto iEnd = getChunkStart(nChunkIndex + 1);
+			for (auto iKey = getChunkStart(nChunkIndex); iKey != iEnd; iKey++) {
+				nfUint32 nIndex = (nfUint32)(iKey - Keys.begin());
+				iKey->m_position = fnVEC3I_floor(pPositions[nIndex], fUnits);
+				iKey->m_nIndex = nIndex;
+			}
+			std::sort(getChunkStart(nChunkIndex), iEnd, fnVertexWeldingKeyLess);
+		});
+
+		for (nfUint32 nWidth = 1; nWidth < nChunkCount; nWidth *= 2) {
+			nfUint32 nMergeCount = (nChunkCount + 2 * nWidth - 1) / (2 * nWidth);
+			fnParallelForChunks(nMergeCount, [&](nfUint32 nMergeIndex) {
+				nfUint32 nFirst = nMergeIndex * 2 * nWidth;
+				nfUint32 nMiddle = std::min(nFirst + nWidth, nChunkCount);
+				nfUint32 nLast = std::min(nFirst + 2 * nWidth, nChunkCount);
+				if (nMiddle < nLast)
+					std::inplace_merge(getChunkStart(nFirst), getChunkStart(nMiddle), getChunkStart(nLast), fnVertexWeldingKeyLess);
+			});
+		}
+
+		// Equal positions are adjacent now, the first of each run has the smallest index
+		WeldedIndices.resize(nCount);
+		size_t nRunStart = 0;
+		for (size_t nIndex = 0; nIndex < Keys.size(); nIndex++) {
+			if (!fnVertexWeldingIsEqual(Keys[nIndex].m_position, Keys[nRunStart].m_position))
+				nRunStart = nIndex;
+			WeldedIndices[Keys[nIndex].m_nIndex] = Keys[nRunStart].m_nIndex;
+		}
+
+		// Number the welded vertices by their first position, which precedes all others of the run
+		for (nfUint32 nIndex = 0; nIndex < nCount; nIndex++) {
+			nfUint32 nFirstIndex = WeldedIndices[nIndex];
+			if (nFirstIndex == nIndex) {
+				WeldedIndices[nIndex] = (nfUint32)UniqueIndices.size();
+				UniqueIndices.push_back(nIndex);
+			}
+			else {
+				WeldedIndices[nIndex] = WeldedIndices[nFirstIndex];
+			}
+		}
+	}
+
+}
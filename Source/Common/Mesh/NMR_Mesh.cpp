@@ -40,23 +40,95 @@ structure.
 --*/
 
 #include "Common/Mesh/NMR_Mesh.h"
+#include "Common/Mesh/NMR_MeshKernels.h"
 #include "Common/Math/NMR_Matrix.h" 
+#include "Common/Math/NMR_Vector.h"
 #include "Common/NMR_Exception.h" 
+#include "Common/NMR_ParallelFor.h"
 #include "Common/MeshInformation/NMR_MeshInformation_Properties.h"
 #include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 
 namespace NMR {
 
-	CMesh::CMesh(): m_BeamLattice(this->m_Nodes)
+	// The mesh kernels read blocks of node and face records as plain coordinate and index arrays
+	static_assert(sizeof(MESHNODE) == 3 * sizeof(nfFloat), "MESHNODE must consist of its three coordinates");
+	static_assert(sizeof(MESHFACE) == 3 * sizeof(nfInt32), "MESHFACE must consist of its three node indices");
+
+	// Rounds a coordinate to the nearest multiple of the units, relative to the origin. Fails if the multiple does not fit into T,
+	// or is beyond NMR_MESH_MAXQUANTIZEDVALUE, so that every quantized mesh can be written to binary vertex streams.
+	template <typename T> static nfBool fnMeshQuantizeValue(_In_ nfFloat fValue, _In_ nfFloat fOrigin, _In_ nfFloat fUnits, _Out_ T & nValue)
+	{
+		const nfDouble dMinValue = std::max((nfDouble)std::numeric_limits<T>::min(), -(nfDouble)NMR_MESH_MAXQUANTIZEDVALUE);
+		const nfDouble dMaxValue = std::min((nfDouble)std::numeric_limits<T>::max(), (nfDouble)NMR_MESH_MAXQUANTIZEDVALUE);
+		nfDouble dValue = floor(((nfDouble)fValue - (nfDouble)fOrigin) / (nfDouble)fUnits + 0.5);
+		// Written as a negation, so that NaN fails as well
+		if (!((dValue >= dMinValue) && (dValue <= dMaxValue)))
+			return false;
+		nValue = (T)dValue;
+		return true;
+	}
+
+	// Quantizes x, y, z triples into [nIndex, nIndex + nCount) of the axis arrays, after checking all of them
+	template <typename T> static void fnMeshQuantizeTriples(_In_ const nfFloat * pCoordinates, _In_ nfUint32 nCount, _In_ const MESHQUANTIZATION & Quantization,
+		_Inout_ std::vector<T, CMeshArrayAllocator<T>> * pTargets, _In_ nfUint32 nIndex)
 	{
-		// empty on purpose
+		nfUint32 nIdx, j;
+		T nValue;
+		for (j = 0; j < 3; j++) {
+			for (nIdx = 0; nIdx < nCount; nIdx++)
+				if (!fnMeshQuantizeValue(pCoordinates[(size_t)nIdx * 3 + j], Quantization.m_vOrigin.m_fields[j], Quantization.m_fUnits, nValue))
+					throw CNMRException(NMR_ERROR_QUANTIZEDCOORDINATEOUTOFRANGE);
+		}
+
+		for (j = 0; j < 3; j++) {
+			T * pTarget = &pTargets[j][nIndex];
+			for (nIdx = 0; nIdx < nCount; nIdx++)
+				fnMeshQuantizeValue(pCoordinates[(size_t)nIdx * 3 + j], Quantization.m_vOrigin.m_fields[j], Quantization.m_fUnits, pTarget[nIdx]);
+		}
+	}
+
+	// Reads [nIndex, nIndex + nCount) of the axis arrays back as x, y, z triples. The arithmetic is the one of the
+	// binary stream reader, so that quantized coordinates read back from a binary stream are the same.
+	template <typename T> static void fnMeshDequantizeTriples(_In_ const std::vector<T, CMeshArrayAllocator<T>> * pSources, _In_ nfUint32 nIndex, _In_ nfUint32 nCount,
+		_In_ const MESHQUANTIZATION & Quantization, _Out_ nfFloat * pCoordinates)
+	{
+		for (nfUint32 j = 0; j < 3; j++) {
+			const T * pSource = pSources[j].data() + nIndex;
+			const nfFloat fOrigin = Quantization.m_vOrigin.m_fields[j];
+			const nfFloat fUnits = Quantization.m_fUnits;
+			for (nfUint32 nIdx = 0; nIdx < nCount; nIdx++) {
+				nfFloat fOffset = (nfFloat)pSource[nIdx] * fUnits;
+				pCoordinates[(size_t)nIdx * 3 + j] = fOffset + fOrigin;
+			}
+		}
 	}
 
-	CMesh::CMesh(_In_opt_ CMesh * pMesh) : m_BeamLattice(this->m_Nodes)
+	static MESHQUANTIZATION fnMeshDefaultQuantization()
+	{
+		MESHQUANTIZATION Quantization;
+		Quantization.m_vOrigin = fnVEC3_make(0.0f, 0.0f, 0.0f);
+		Quantization.m_fUnits = NMR_MESH_DEFAULTQUANTIZATIONUNITS;
+		Quantization.m_nBitCount = 32;
+		return Quantization;
+	}
+
+	CMesh::CMesh(): m_BeamLattice(this->m_Nodes), m_StorageMode(MESHSTORAGEMODE_PAGED), m_Quantization(fnMeshDefaultQuantization())
+	{
+		resetBuffers();
+	}
+
+	CMesh::CMesh(_In_opt_ CMesh * pMesh) : m_BeamLattice(this->m_Nodes), m_StorageMode(MESHSTORAGEMODE_PAGED), m_Quantization(fnMeshDefaultQuantization())
 	{
 		if (!pMesh)
 			throw CNMRException(NMR_ERROR_INVALIDPARAM);
 
+		m_pMappedStorage = pMesh->m_pMappedStorage;
+		m_Quantization = pMesh->m_Quantization;
+		resetBuffers();
+
 		mergeMesh(pMesh);
 	}
 
@@ -70,12 +142,10 @@ namespace NMR {
 		if (!pMesh)
 			throw CNMRException(NMR_ERROR_INVALIDPARAM);
 
-		nfInt32 nIdx, nNodeCount, nFaceCount, nBeamCount, j;
-		MESHNODE * pNode;
-		MESHFACE * pFace;
-		MESHBEAM * pBeam;
-		MESHNODE * pFaceNodes[3];
-		MESHNODE * pBeamNodes[2];
+		if (shareMesh(pMesh, mMatrix))
+			return;
+
+		nfInt32 nIdx, nNodeCount, nFaceCount, nBeamCount;
 
 		// Copy Mesh Information
 		CMeshInformationHandler * pOtherMeshInformationHandler = pMesh->getMeshInformationHandler();
@@ -89,13 +159,20 @@ namespace NMR {
 		nBeamCount = pMesh->getBeamCount();
 
 		if (nNodeCount > 0) {
-			std::vector<MESHNODE *> aNewNodes;
-			aNewNodes.resize(nNodeCount);
+			reserveNodes(getNodeCount() + nNodeCount);
+			reserveFaces(getFaceCount() + nFaceCount);
+			reserveBeams(getBeamCount() + nBeamCount);
 
-			for (nIdx = 0; nIdx < nNodeCount; nIdx++) {
-				pNode = pMesh->getNode(nIdx);
-				NVEC3 vPosition = fnMATRIX3_apply(mMatrix, pNode->m_position);
-				aNewNodes[nIdx] = addNode(vPosition);
+			// New nodes are appended in order, so node indices only get shifted
+			nfInt32 nNodeOffset = (nfInt32) getNodeCount();
+
+			nfBool bBothSoA = (m_StorageMode == MESHSTORAGEMODE_SOA) && (pMesh->m_StorageMode == MESHSTORAGEMODE_SOA);
+			nfBool bBothIndexArrays = (m_StorageMode != MESHSTORAGEMODE_PAGED) && (pMesh->m_StorageMode != MESHSTORAGEMODE_PAGED);
+			if (bBothSoA) {
+				mergeNodesSoA(pMesh, mMatrix);
+			}
+			else {
+				mergeNodesBatched(pMesh, mMatrix);
 			}
 
 			if (nFaceCount > 0) {
@@ -103,34 +180,519 @@ namespace NMR {
 					m_pMeshInformationHandler->cloneDefaultInfosFrom(pOtherMeshInformationHandler);
 				}
 
-				for (nIdx = 0; nIdx < nFaceCount; nIdx++) {
-					pFace = pMesh->getFace(nIdx);
-					for (j = 0; j < 3; j++) {
-						if ((pFace->m_nodeindices[j] < 0) || (pFace->m_nodeindices[j] >= nNodeCount))
-							throw CNMRException(NMR_ERROR_INVALIDNODEINDEX);
-
-						pFaceNodes[j] = aNewNodes[pFace->m_nodeindices[j]];
+				if (bBothIndexArrays && !m_pMeshInformationHandler) {
+					// Validate all indices first, then shift them in a single pass
+					const nfInt32 * pSourceIndices = pMesh->m_pFaceBuffer->m_NodeIndices.data();
+					size_t nIndexCount = (size_t)nFaceCount * 3;
+
+					nfUint32 nInvalid = 0;
+					for (size_t nIndex = 0; nIndex < nIndexCount; nIndex++)
+						nInvalid |= ((nfUint32)pSourceIndices[nIndex] >= (nfUint32)nNodeCount);
+					if (nInvalid)
+						throw CNMRException(NMR_ERROR_INVALIDNODEINDEX);
+
+					nfUint32 nDuplicate = 0;
+					for (nIdx = 0; nIdx < nFaceCount; nIdx++) {
+						const nfInt32 * pFaceIndices = &pSourceIndices[(size_t)nIdx * 3];
+						nDuplicate |= (pFaceIndices[0] == pFaceIndices[1]) | (pFaceIndices[0] == pFaceIndices[2]) | (pFaceIndices[1] == pFaceIndices[2]);
 					}
+					if (nDuplicate)
+						throw CNMRException(NMR_ERROR_DUPLICATENODE);
+
+					if ((nfUint64)getFaceCount() + nFaceCount > NMR_MESH_MAXFACECOUNT)
+						throw CNMRException(NMR_ERROR_TOOMANYFACES);
+
+					MESHINDEXARRAY & TargetIndices = writeFaceBuffer()->m_NodeIndices;
+					size_t nStart = TargetIndices.size();
+					TargetIndices.resize(nStart + nIndexCount);
+					// Resizing may have moved the source, if a mesh is merged into itself
+					pSourceIndices = pMesh->m_pFaceBuffer->m_NodeIndices.data();
+					nfInt32 * pTargetIndices = &TargetIndices[nStart];
+					for (size_t nIndex = 0; nIndex < nIndexCount; nIndex++)
+						pTargetIndices[nIndex] = pSourceIndices[nIndex] + nNodeOffset;
+				}
+				else {
+					mergeFacesBatched(pMesh, nNodeCount, nNodeOffset, pOtherMeshInformationHandler);
+				}
+			}
+			if (nBeamCount > 0) {
+				mergeBeams(pMesh, nNodeCount, nNodeOffset);
+			}
+
+		}
+	}
+
+	nfBool CMesh::shareMesh(_In_ CMesh * pMesh, _In_ const NMATRIX3 & mMatrix)
+	{
+		if ((pMesh == this) || (pMesh->getNodeCount() == 0))
+			return false;
+		if ((getNodeCount() > 0) || (getFaceCount() > 0) || (getBeamCount() > 0) || m_pMeshInformationHandler)
+			return false;
+		// The shared arrays would keep the storage of the source mesh
+		if (m_pMappedStorage != pMesh->m_pMappedStorage)
+			return false;
+
+		// Only the exact identity leaves all coordinates as they are
+		NMATRIX3 mIdentity = fnMATRIX3_identity();
+		for (nfUint32 i = 0; i < 3; i++)
+			for (nfUint32 j = 0; j < 4; j++)
+				if (mMatrix.m_fields[i][j] != mIdentity.m_fields[i][j])
+					return false;
+
+		// A mesh which does not pass is merged as usual, which raises the according error
+		if (!pMesh->checkSanity())
+			return false;
+
+		// Shared storage consists of the arrays, so the source mesh gives up its paged storage
+		if (pMesh->m_StorageMode == MESHSTORAGEMODE_PAGED)
+			pMesh->setStorageMode(MESHSTORAGEMODE_SOA);
+		setStorageMode(MESHSTORAGEMODE_SOA);
+		m_Quantization = pMesh->m_Quantization;
+		setStorageMode(pMesh->m_StorageMode);
+		m_pNodeBuffer = pMesh->m_pNodeBuffer;
+		m_pFaceBuffer = pMesh->m_pFaceBuffer;
+		m_OutboxCache = pMesh->m_OutboxCache;
+
+		CMeshInformationHandler * pOtherMeshInformationHandler = pMesh->getMeshInformationHandler();
+		if (pOtherMeshInformationHandler) {
+			createMeshInformationHandler();
+			m_pMeshInformationHandler->shareInfoTableFrom(pOtherMeshInformationHandler);
+			if (getFaceCount() > 0)
+				m_pMeshInformationHandler->cloneDefaultInfosFrom(pOtherMeshInformationHandler);
+		}
+
+		// Beams always stay paged, and are copied
+		nfUint32 nBeamCount = pMesh->getBeamCount();
+		if (nBeamCount > 0) {
+			reserveBeams(nBeamCount);
+			mergeBeams(pMesh, getNodeCount(), 0);
+		}
+
+		return true;
+	}
 
-					MESHFACE * pNewFace = addFace(pFaceNodes[0], pFaceNodes[1], pFaceNodes[2]);
-					if (m_pMeshInformationHandler && pOtherMeshInformationHandler) {
-						m_pMeshInformationHandler->cloneFaceInfosFrom(pNewFace->m_index, pOtherMeshInformationHandler, pFace->m_index);
+	void CMesh::resetBuffers()
+	{
+		m_pNodeBuffer = std::make_shared<MESHNODEBUFFER>();
+		for (nfUint32 j = 0; j < 3; j++) {
+			m_pNodeBuffer->m_Coordinates[j] = MESHCOORDINATEARRAY(CMeshArrayAllocator<nfFloat>(m_pMappedStorage));
+			m_pNodeBuffer->m_Quantized16[j] = MESHQUANTIZED16ARRAY(CMeshArrayAllocator<nfInt16>(m_pMappedStorage));
+			m_pNodeBuffer->m_Quantized32[j] = MESHQUANTIZED32ARRAY(CMeshArrayAllocator<nfInt32>(m_pMappedStorage));
+		}
+
+		m_pFaceBuffer = std::make_shared<MESHFACEBUFFER>();
+		m_pFaceBuffer->m_NodeIndices = MESHINDEXARRAY(CMeshArrayAllocator<nfInt32>(m_pMappedStorage));
+	}
+
+	_Ret_notnull_ MESHNODEBUFFER * CMesh::writeNodeBuffer()
+	{
+		if (m_pNodeBuffer.use_count() > 1)
+			m_pNodeBuffer = std::make_shared<MESHNODEBUFFER>(*m_pNodeBuffer);
+		return m_pNodeBuffer.get();
+	}
+
+	_Ret_notnull_ MESHFACEBUFFER * CMesh::writeFaceBuffer()
+	{
+		if (m_pFaceBuffer.use_count() > 1)
+			m_pFaceBuffer = std::make_shared<MESHFACEBUFFER>(*m_pFaceBuffer);
+		return m_pFaceBuffer.get();
+	}
+
+	// Calls Function(nInstance, nLocalStart, nCount) for the part of every instance that overlaps [nStart, nEnd),
+	// where instance k covers [Starts[k], Starts[k + 1]).
+	template <typename F> static void fnMeshForEachInstanceRange(_In_ const std::vector<nfUint32> & Starts, _In_ nfUint32 nStart, _In_ nfUint32 nEnd, _In_ F Function)
+	{
+		size_t nInstance = (size_t)(std::upper_bound(Starts.begin(), Starts.end(), nStart) - Starts.begin()) - 1;
+		while (nStart < nEnd) {
+			nfUint32 nInstanceEnd = std::min(Starts[nInstance + 1], nEnd);
+			if (nInstanceEnd > nStart)
+				Function(nInstance, nStart - Starts[nInstance], nInstanceEnd - nStart);
+			nStart = std::max(nStart, nInstanceEnd);
+			nInstance++;
+		}
+	}
+
+	void CMesh::mergeMeshes(_In_ const std::vector<MESHMERGEINSTANCE> & Instances)
+	{
+		size_t nInstanceCount = Instances.size();
+		nfBool bMergesItself = false;
+
+		// A single untransformed mesh may be shared instead of copied
+		if ((nInstanceCount == 1) && Instances[0].m_pMesh && shareMesh(Instances[0].m_pMesh, Instances[0].m_mMatrix))
+			return;
+
+		// Prefix sums of the node and face counts give every instance its own range in the merged mesh.
+		// mergeMesh skips the faces and beams of meshes without nodes, so they are not counted.
+		std::vector<nfUint32> NodeStarts(nInstanceCount + 1, 0);
+		std::vector<nfUint32> FaceStarts(nInstanceCount + 1, 0);
+		nfUint64 nNodeTotal = 0;
+		nfUint64 nFaceTotal = 0;
+		nfUint64 nBeamTotal = 0;
+		for (size_t nInstance = 0; nInstance < nInstanceCount; nInstance++) {
+			CMesh * pMesh = Instances[nInstance].m_pMesh;
+			if (!pMesh)
+				throw CNMRException(NMR_ERROR_INVALIDPARAM);
+			bMergesItself |= (pMesh == this);
+
+			nfUint32 nNodeCount = pMesh->getNodeCount();
+			nNodeTotal += nNodeCount;
+			if (nNodeCount > 0) {
+				nFaceTotal += pMesh->getFaceCount();
+				nBeamTotal += pMesh->getBeamCount();
+			}
+			if ((nNodeTotal > NMR_MESH_MAXNODECOUNT) || (nFaceTotal > NMR_MESH_MAXFACECOUNT))
+				break;
+			NodeStarts[nInstance + 1] = (nfUint32)nNodeTotal;
+			FaceStarts[nInstance + 1] = (nfUint32)nFaceTotal;
+		}
+
+		// Small merges, and merges which would overflow, take the serial path
+		nfUint32 nNodeChunkCount = fnParallelGetChunkCount((nfUint32)std::min(nNodeTotal, (nfUint64)NMR_MESH_MAXNODECOUNT), NMR_MESH_PARALLELCHUNKSIZE);
+		nfUint32 nFaceChunkCount = fnParallelGetChunkCount((nfUint32)std::min(nFaceTotal, (nfUint64)NMR_MESH_MAXFACECOUNT), NMR_MESH_PARALLELCHUNKSIZE);
+		if (bMergesItself || ((nNodeChunkCount <= 1) && (nFaceChunkCount <= 1)) ||
+			((nfUint64)getNodeCount() + nNodeTotal > NMR_MESH_MAXNODECOUNT) || ((nfUint64)getFaceCount() + nFaceTotal > NMR_MESH_MAXFACECOUNT)) {
+			for (auto iInstance = Instances.begin(); iInstance != Instances.end(); iInstance++)
+				mergeMesh(iInstance->m_pMesh, iInstance->m_mMatrix);
+			return;
+		}
+
+		nfUint32 nOldNodeCount = getNodeCount();
+		nfUint32 nOldFaceCount = getFaceCount();
+
+		// Copy all nodes and faces in parallel into the presized ranges
+		try {
+			resizeNodes(nOldNodeCount + nNodeTotal);
+			resizeFaces(nOldFaceCount + nFaceTotal);
+
+			fnParallelForChunks(nNodeChunkCount, [&](nfUint32 nChunkIndex) {
+				nfUint32 nStart = fnParallelGetChunkStart((nfUint32)nNodeTotal, nNodeChunkCount, nChunkIndex);
+				nfUint32 nEnd = fnParallelGetChunkStart((nfUint32)nNodeTotal, nNodeChunkCount, nChunkIndex + 1);
+				fnMeshForEachInstanceRange(NodeStarts, nStart, nEnd, [&](size_t nInstance, nfUint32 nLocalStart, nfUint32 nCount) {
+					mergeNodeRange(Instances[nInstance].m_pMesh, Instances[nInstance].m_mMatrix, nLocalStart,
+						nOldNodeCount + NodeStarts[nInstance] + nLocalStart, nCount);
+				});
+			});
+
+			fnParallelForChunks(nFaceChunkCount, [&](nfUint32 nChunkIndex) {
+				nfUint32 nStart = fnParallelGetChunkStart((nfUint32)nFaceTotal, nFaceChunkCount, nChunkIndex);
+				nfUint32 nEnd = fnParallelGetChunkStart((nfUint32)nFaceTotal, nFaceChunkCount, nChunkIndex + 1);
+				fnMeshForEachInstanceRange(FaceStarts, nStart, nEnd, [&](size_t nInstance, nfUint32 nLocalStart, nfUint32 nCount) {
+					CMesh * pMesh = Instances[nInstance].m_pMesh;
+					mergeFaceRange(pMesh, pMesh->getNodeCount(), (nfInt32)(nOldNodeCount + NodeStarts[nInstance]), nLocalStart,
+						nOldFaceCount + FaceStarts[nInstance] + nLocalStart, nCount);
+				});
+			});
+		}
+		catch (...) {
+			resizeFaces(nOldFaceCount);
+			resizeNodes(nOldNodeCount);
+			throw;
+		}
+
+		// Set up the mesh information in the order of the serial merge, then clone the face information in parallel
+		nfBool bClonesFaceInformation = false;
+		for (size_t nInstance = 0; nInstance < nInstanceCount; nInstance++) {
+			CMeshInformationHandler * pOtherMeshInformationHandler = Instances[nInstance].m_pMesh->getMeshInformationHandler();
+			if (pOtherMeshInformationHandler) {
+				createMeshInformationHandler();
+				m_pMeshInformationHandler->addInfoTableFrom(pOtherMeshInformationHandler, nOldFaceCount + FaceStarts[nInstance]);
+			}
+
+			if (m_pMeshInformationHandler) {
+				nfUint32 nFaceStart = nOldFaceCount + FaceStarts[nInstance];
+				nfUint32 nFaceEnd = nOldFaceCount + FaceStarts[nInstance + 1];
+				if ((nFaceEnd > nFaceStart) && pOtherMeshInformationHandler) {
+					m_pMeshInformationHandler->cloneDefaultInfosFrom(pOtherMeshInformationHandler);
+					bClonesFaceInformation = true;
+				}
+				for (nfUint32 nFaceIndex = nFaceStart; nFaceIndex < nFaceEnd; nFaceIndex++)
+					m_pMeshInformationHandler->addFace(nFaceIndex + 1);
+			}
+		}
+
+		if (bClonesFaceInformation) {
+			fnParallelForChunks(nFaceChunkCount, [&](nfUint32 nChunkIndex) {
+				nfUint32 nStart = fnParallelGetChunkStart((nfUint32)nFaceTotal, nFaceChunkCount, nChunkIndex);
+				nfUint32 nEnd = fnParallelGetChunkStart((nfUint32)nFaceTotal, nFaceChunkCount, nChunkIndex + 1);
+				fnMeshForEachInstanceRange(FaceStarts, nStart, nEnd, [&](size_t nInstance, nfUint32 nLocalStart, nfUint32 nCount) {
+					CMeshInformationHandler * pOtherMeshInformationHandler = Instances[nInstance].m_pMesh->getMeshInformationHandler();
+					if (pOtherMeshInformationHandler)
+						m_pMeshInformationHandler->cloneFaceInfoRangeFrom(nOldFaceCount + FaceStarts[nInstance] + nLocalStart, pOtherMeshInformationHandler, nLocalStart, nCount);
+				});
+			});
+		}
+
+		// Beams are few in comparison, and are added serially
+		if (nBeamTotal > 0) {
+			reserveBeams((nfUint32)std::min((nfUint64)getBeamCount() + nBeamTotal, (nfUint64)NMR_MESH_MAXBEAMCOUNT));
+			for (size_t nInstance = 0; nInstance < nInstanceCount; nInstance++) {
+				CMesh * pMesh = Instances[nInstance].m_pMesh;
+				if ((NodeStarts[nInstance + 1] > NodeStarts[nInstance]) && (pMesh->getBeamCount() > 0))
+					mergeBeams(pMesh, pMesh->getNodeCount(), (nfInt32)(nOldNodeCount + NodeStarts[nInstance]));
+			}
+		}
+	}
+
+	void CMesh::mergeNodesSoA(_In_ CMesh * pMesh, _In_ const NMATRIX3 & mMatrix)
+	{
+		nfUint32 nNodeCount = pMesh->getNodeCount();
+		nfUint32 nOldNodeCount = getNodeCount();
+		if ((nfUint64)nOldNodeCount + nNodeCount > NMR_MESH_MAXNODECOUNT)
+			throw CNMRException(NMR_ERROR_TOOMANYNODES);
+		m_OutboxCache.invalidate();
+
+		MESHNODEBUFFER * pNodeBuffer = writeNodeBuffer();
+		for (nfUint32 j = 0; j < 3; j++)
+			pNodeBuffer->m_Coordinates[j].resize((size_t)nOldNodeCount + nNodeCount);
+
+		const nfFloat * pSourceX = pMesh->m_pNodeBuffer->m_Coordinates[0].data();
+		const nfFloat * pSourceY = pMesh->m_pNodeBuffer->m_Coordinates[1].data();
+		const nfFloat * pSourceZ = pMesh->m_pNodeBuffer->m_Coordinates[2].data();
+
+		// Same arithmetic as fnMATRIX3_apply, one target array at a time
+		nfFloat fMaxAbs = 0.0f;
+		for (nfUint32 j = 0; j < 3; j++) {
+			const nfFloat fM0 = mMatrix.m_fields[j][0];
+			const nfFloat fM1 = mMatrix.m_fields[j][1];
+			const nfFloat fM2 = mMatrix.m_fields[j][2];
+			const nfFloat fM3 = mMatrix.m_fields[j][3];
+			nfFloat * pTarget = &pNodeBuffer->m_Coordinates[j][nOldNodeCount];
+
+			for (nfUint32 nIdx = 0; nIdx < nNodeCount; nIdx++) {
+				nfFloat fValue = fM0 * pSourceX[nIdx] + fM1 * pSourceY[nIdx] + fM2 * pSourceZ[nIdx] + fM3;
+				pTarget[nIdx] = fValue;
+				fMaxAbs = std::max(fMaxAbs, std::fabs(fValue));
+			}
+		}
+
+		if (fMaxAbs > NMR_MESH_MAXCOORDINATE) {
+			for (nfUint32 j = 0; j < 3; j++)
+				pNodeBuffer->m_Coordinates[j].resize(nOldNodeCount);
+			throw CNMRException(NMR_ERROR_INVALIDCOORDINATES);
+		}
+	}
+
+	void CMesh::mergeNodesBatched(_In_ CMesh * pMesh, _In_ const NMATRIX3 & mMatrix)
+	{
+		nfUint32 nOldNodeCount = getNodeCount();
+		nfUint32 nNodeCount = pMesh->getNodeCount();
+		resizeNodes((nfUint64)nOldNodeCount + nNodeCount);
+
+		try {
+			mergeNodeRange(pMesh, mMatrix, 0, nOldNodeCount, nNodeCount);
+		}
+		catch (...) {
+			resizeNodes(nOldNodeCount);
+			throw;
+		}
+	}
+
+	void CMesh::mergeFacesBatched(_In_ CMesh * pMesh, _In_ nfUint32 nSourceNodeCount, _In_ nfInt32 nNodeOffset, _In_opt_ CMeshInformationHandler * pOtherMeshInformationHandler)
+	{
+		nfUint32 nOldFaceCount = getFaceCount();
+		nfUint32 nFaceCount = pMesh->getFaceCount();
+		resizeFaces((nfUint64)nOldFaceCount + nFaceCount);
+
+		try {
+			mergeFaceRange(pMesh, nSourceNodeCount, nNodeOffset, 0, nOldFaceCount, nFaceCount);
+		}
+		catch (...) {
+			resizeFaces(nOldFaceCount);
+			throw;
+		}
+
+		if (m_pMeshInformationHandler) {
+			for (nfUint32 nIdx = 1; nIdx <= nFaceCount; nIdx++)
+				m_pMeshInformationHandler->addFace(nOldFaceCount + nIdx);
+			if (pOtherMeshInformationHandler)
+				m_pMeshInformationHandler->cloneFaceInfoRangeFrom(nOldFaceCount, pOtherMeshInformationHandler, 0, nFaceCount);
+		}
+	}
+
+	void CMesh::mergeBeams(_In_ CMesh * pMesh, _In_ nfUint32 nSourceNodeCount, _In_ nfInt32 nNodeOffset)
+	{
+		nfUint32 nBeamCount = pMesh->getBeamCount();
+		nfInt32 BeamNodes[2];
+
+		for (nfUint32 nIdx = 0; nIdx < nBeamCount; nIdx++) {
+			MESHBEAM * pBeam = pMesh->getBeam(nIdx);
+			for (nfUint32 j = 0; j < 2; j++) {
+				if ((pBeam->m_nodeindices[j] < 0) || ((nfUint32)pBeam->m_nodeindices[j] >= nSourceNodeCount))
+					throw CNMRException(NMR_ERROR_INVALIDNODEINDEX);
+
+				BeamNodes[j] = pBeam->m_nodeindices[j] + nNodeOffset;
+			}
+			addBeam(BeamNodes[0], BeamNodes[1], pBeam->m_radius[0], pBeam->m_radius[1], pBeam->m_capMode[0], pBeam->m_capMode[1]);
+		}
+	}
+
+	void CMesh::resizeNodes(_In_ nfUint64 nNodeCount)
+	{
+		if (nNodeCount > NMR_MESH_MAXNODECOUNT)
+			throw CNMRException(NMR_ERROR_TOOMANYNODES);
+		m_OutboxCache.invalidate();
+
+		if (m_StorageMode == MESHSTORAGEMODE_SOA) {
+			MESHNODEBUFFER * pNodeBuffer = writeNodeBuffer();
+			for (nfUint32 j = 0; j < 3; j++)
+				pNodeBuffer->m_Coordinates[j].resize((size_t)nNodeCount);
+			return;
+		}
+		if (m_StorageMode == MESHSTORAGEMODE_QUANTIZED) {
+			resizeQuantizedNodes(writeNodeBuffer(), (size_t)nNodeCount);
+			return;
+		}
+
+		m_Nodes.truncate((nfUint32)nNodeCount);
+		m_Nodes.reserve((nfUint32)nNodeCount);
+		while (m_Nodes.getCount() < nNodeCount) {
+			nfUint32 nAllocatedCount;
+			m_Nodes.allocRange((nfUint32)nNodeCount - m_Nodes.getCount(), nAllocatedCount);
+		}
+	}
+
+	void CMesh::resizeFaces(_In_ nfUint64 nFaceCount)
+	{
+		if (nFaceCount > NMR_MESH_MAXFACECOUNT)
+			throw CNMRException(NMR_ERROR_TOOMANYFACES);
+
+		if (m_StorageMode != MESHSTORAGEMODE_PAGED) {
+			writeFaceBuffer()->m_NodeIndices.resize((size_t)nFaceCount * 3);
+			return;
+		}
+
+		m_Faces.truncate((nfUint32)nFaceCount);
+		m_Faces.reserve((nfUint32)nFaceCount);
+		while (m_Faces.getCount() < nFaceCount) {
+			nfUint32 nAllocatedCount;
+			m_Faces.allocRange((nfUint32)nFaceCount - m_Faces.getCount(), nAllocatedCount);
+		}
+	}
+
+	void CMesh::mergeNodeRange(_In_ CMesh * pMesh, _In_ const NMATRIX3 & mMatrix, _In_ nfUint32 nSourceIndex, _In_ nfUint32 nTargetIndex, _In_ nfUint32 nCount)
+	{
+		std::vector<nfFloat> Coordinates((size_t)std::min(nCount, (nfUint32)NMR_MESH_MERGEBATCHSIZE) * 3);
+		std::vector<nfFloat> SourceCoordinates;
+		if (pMesh->m_StorageMode == MESHSTORAGEMODE_QUANTIZED)
+			SourceCoordinates.resize(Coordinates.size());
+
+		// Transform contiguous spans of the source into the buffer, and store the buffer in the target
+		while (nCount > 0) {
+			nfUint32 nBatchCount;
+			const nfFloat * pX;
+			const nfFloat * pY;
+			const nfFloat * pZ;
+			size_t nStride;
+
+			if (pMesh->m_StorageMode == MESHSTORAGEMODE_SOA) {
+				nBatchCount = nCount;
+				pX = &pMesh->m_pNodeBuffer->m_Coordinates[0][nSourceIndex];
+				pY = &pMesh->m_pNodeBuffer->m_Coordinates[1][nSourceIndex];
+				pZ = &pMesh->m_pNodeBuffer->m_Coordinates[2][nSourceIndex];
+				nStride = 1;
+			}
+			else if (pMesh->m_StorageMode == MESHSTORAGEMODE_QUANTIZED) {
+				nBatchCount = std::min(nCount, (nfUint32)NMR_MESH_MERGEBATCHSIZE);
+				pMesh->dequantizeNodes(nSourceIndex, nBatchCount, SourceCoordinates.data());
+				pX = &SourceCoordinates[0];
+				pY = &SourceCoordinates[1];
+				pZ = &SourceCoordinates[2];
+				nStride = 3;
+			}
+			else {
+				const MESHNODE * pNodes = pMesh->m_Nodes.getRange(nSourceIndex, nBatchCount);
+				pX = &pNodes->m_position.m_fields[0];
+				pY = &pNodes->m_position.m_fields[1];
+				pZ = &pNodes->m_position.m_fields[2];
+				nStride = sizeof(MESHNODE) / sizeof(nfFloat);
+			}
+
+			nBatchCount = std::min(std::min(nBatchCount, nCount), (nfUint32)NMR_MESH_MERGEBATCHSIZE);
+			fnMeshKernelTransformPositions(pX, pY, pZ, nStride, nBatchCount, mMatrix, Coordinates.data());
+			if (fnMeshKernelExceedsLimit(Coordinates.data(), (size_t)nBatchCount * 3, NMR_MESH_MAXCOORDINATE))
+				throw CNMRException(NMR_ERROR_INVALIDCOORDINATES);
+
+			const nfFloat * pCoordinates = Coordinates.data();
+			if (m_StorageMode == MESHSTORAGEMODE_SOA) {
+				// resizeNodes has made the buffer unique already, so that ranges can be written from several threads
+				for (nfUint32 j = 0; j < 3; j++) {
+					nfFloat * pTarget = &m_pNodeBuffer->m_Coordinates[j][nTargetIndex];
+					for (nfUint32 nIdx = 0; nIdx < nBatchCount; nIdx++)
+						pTarget[nIdx] = pCoordinates[(size_t)nIdx * 3 + j];
+				}
+			}
+			else if (m_StorageMode == MESHSTORAGEMODE_QUANTIZED) {
+				quantizeNodes(m_pNodeBuffer.get(), nTargetIndex, nBatchCount, pCoordinates);
+			}
+			else {
+				nfUint32 nStored = 0;
+				while (nStored < nBatchCount) {
+					nfUint32 nContiguousCount;
+					MESHNODE * pNodes = m_Nodes.getRange(nTargetIndex + nStored, nContiguousCount);
+					nContiguousCount = std::min(nContiguousCount, nBatchCount - nStored);
+					for (nfUint32 nIdx = 0; nIdx < nContiguousCount; nIdx++) {
+						pNodes[nIdx].m_position.m_fields[0] = pCoordinates[0];
+						pNodes[nIdx].m_position.m_fields[1] = pCoordinates[1];
+						pNodes[nIdx].m_position.m_fields[2] = pCoordinates[2];
+						pCoordinates += 3;
 					}
+					nStored += nContiguousCount;
 				}
 			}
-			if (nBeamCount > 0) {
-				for (nIdx = 0; nIdx < nBeamCount; nIdx++) {
-					pBeam = pMesh->getBeam(nIdx);
-					for (j = 0; j < 2; j++) {
-						if ((pBeam->m_nodeindices[j] < 0) || (pBeam->m_nodeindices[j] >= nNodeCount))
-							throw CNMRException(NMR_ERROR_INVALIDNODEINDEX);
 
-						pBeamNodes[j] = aNewNodes[pBeam->m_nodeindices[j]];
+			nSourceIndex += nBatchCount;
+			nTargetIndex += nBatchCount;
+			nCount -= nBatchCount;
+		}
+	}
+
+	void CMesh::mergeFaceRange(_In_ CMesh * pMesh, _In_ nfUint32 nSourceNodeCount, _In_ nfInt32 nNodeOffset, _In_ nfUint32 nSourceIndex, _In_ nfUint32 nTargetIndex, _In_ nfUint32 nCount)
+	{
+		std::vector<nfInt32> NodeIndices((size_t)std::min(nCount, (nfUint32)NMR_MESH_MERGEBATCHSIZE) * 3);
+
+		// Offset the node indices of a batch of faces, after validating them like addFaces does
+		while (nCount > 0) {
+			nfUint32 nBatchCount = std::min(nCount, (nfUint32)NMR_MESH_MERGEBATCHSIZE);
+			pMesh->copyFaceNodeIndices(nSourceIndex, nBatchCount, NodeIndices.data());
+
+			nfUint32 nInvalid = 0;
+			nfUint32 nDuplicate = 0;
+			for (nfUint32 nIdx = 0; nIdx < nBatchCount; nIdx++) {
+				nfInt32 * pFaceIndices = &NodeIndices[(size_t)nIdx * 3];
+				nInvalid |= ((nfUint32)pFaceIndices[0] >= nSourceNodeCount) | ((nfUint32)pFaceIndices[1] >= nSourceNodeCount) | ((nfUint32)pFaceIndices[2] >= nSourceNodeCount);
+				nDuplicate |= (pFaceIndices[0] == pFaceIndices[1]) | (pFaceIndices[0] == pFaceIndices[2]) | (pFaceIndices[1] == pFaceIndices[2]);
+				pFaceIndices[0] += nNodeOffset;
+				pFaceIndices[1] += nNodeOffset;
+				pFaceIndices[2] += nNodeOffset;
+			}
+			if (nInvalid)
+				throw CNMRException(NMR_ERROR_INVALIDNODEINDEX);
+			if (nDuplicate)
+				throw CNMRException(NMR_ERROR_DUPLICATENODE);
+
+			const nfInt32 * pNodeIndices = NodeIndices.data();
+			if (m_StorageMode != MESHSTORAGEMODE_PAGED) {
+				memcpy(&m_pFaceBuffer->m_NodeIndices[(size_t)nTargetIndex * 3], pNodeIndices, (size_t)nBatchCount * 3 * sizeof(nfInt32));
+			}
+			else {
+				nfUint32 nStored = 0;
+				while (nStored < nBatchCount) {
+					nfUint32 nContiguousCount;
+					MESHFACE * pFaces = m_Faces.getRange(nTargetIndex + nStored, nContiguousCount);
+					nContiguousCount = std::min(nContiguousCount, nBatchCount - nStored);
+					for (nfUint32 nIdx = 0; nIdx < nContiguousCount; nIdx++) {
+						pFaces[nIdx].m_nodeindices[0] = pNodeIndices[0];
+						pFaces[nIdx].m_nodeindices[1] = pNodeIndices[1];
+						pFaces[nIdx].m_nodeindices[2] = pNodeIndices[2];
+						pNodeIndices += 3;
 					}
-					addBeam(pBeamNodes[0], pBeamNodes[1], pBeam->m_radius[0], pBeam->m_radius[1], pBeam->m_capMode[0], pBeam->m_capMode[1]);
+					nStored += nContiguousCount;
 				}
 			}
 
+			nSourceIndex += nBatchCount;
+			nTargetIndex += nBatchCount;
+			nCount -= nBatchCount;
 		}
 	}
 
@@ -155,6 +717,8 @@ namespace NMR {
 		MESHNODE * pNode;
 		nfUint32 j;
 
+		setStorageMode(MESHSTORAGEMODE_PAGED);
+
 		// Check Position Validity
 		for (j = 0; j < 3; j++)
 			if (fabs(vPosition.m_fields[j]) > NMR_MESH_MAXCOORDINATE)
@@ -164,11 +728,11 @@ namespace NMR {
 		nfUint32 nNodeCount = getNodeCount();
 		if (nNodeCount >= NMR_MESH_MAXNODECOUNT)
 			throw CNMRException(NMR_ERROR_TOOMANYNODES);
+		m_OutboxCache.invalidate();
 
 		// Allocate Data
 		nfUint32 nNewIndex;
 		pNode = m_Nodes.allocData(nNewIndex);
-		pNode->m_index = nNewIndex;
 		pNode->m_position = vPosition;
 
 		return pNode;
@@ -177,6 +741,8 @@ namespace NMR {
 	{
 		MESHNODE * pNode;
 
+		setStorageMode(MESHSTORAGEMODE_PAGED);
+
 		// Check Position Validity
 		if (fabs(posX) > NMR_MESH_MAXCOORDINATE)
 			throw CNMRException(NMR_ERROR_INVALIDCOORDINATES);
@@ -189,11 +755,11 @@ namespace NMR {
 		nfUint32 nNodeCount = getNodeCount();
 		if (nNodeCount >= NMR_MESH_MAXNODECOUNT)
 			throw CNMRException(NMR_ERROR_TOOMANYNODES);
+		m_OutboxCache.invalidate();
 
 		// Allocate Data
 		nfUint32 nNewIndex;
 		pNode = m_Nodes.allocData(nNewIndex);
-		pNode->m_index = nNewIndex;
 		pNode->m_position.m_values.x = posX;
 		pNode->m_position.m_values.y = posY;
 		pNode->m_position.m_values.z = posZ;
@@ -209,49 +775,221 @@ namespace NMR {
 		if ((pNode1 == pNode2) || (pNode1 == pNode3) || (pNode2 == pNode3))
 			throw CNMRException(NMR_ERROR_DUPLICATENODE);
 
+		setStorageMode(MESHSTORAGEMODE_PAGED);
+
+		return addFace((nfInt32)getNodeIndex(pNode1), (nfInt32)getNodeIndex(pNode2), (nfInt32)getNodeIndex(pNode3));
+	}
+	
+	_Ret_notnull_ MESHFACE * CMesh::addFace(_In_ nfInt32 nNodeIndex1, _In_ nfInt32 nNodeIndex2, _In_ nfInt32 nNodeIndex3)
+	{
+		if ((nNodeIndex1 == nNodeIndex2) || (nNodeIndex1 == nNodeIndex3) || (nNodeIndex2 == nNodeIndex3))
+			throw CNMRException(NMR_ERROR_DUPLICATENODE);
+
+		setStorageMode(MESHSTORAGEMODE_PAGED);
+
 		MESHFACE * pFace;
-		nfUint32 nFaceCount = getFaceCount ();
+		nfUint32 nFaceCount = getFaceCount();
 
 		if (nFaceCount >= NMR_MESH_MAXFACECOUNT)
 			throw CNMRException(NMR_ERROR_TOOMANYFACES);
 
 		nfUint32 nNewIndex;
 
-		pFace = m_Faces.allocData (nNewIndex);
-		pFace->m_nodeindices[0] = pNode1->m_index;
-		pFace->m_nodeindices[1] = pNode2->m_index;
-		pFace->m_nodeindices[2] = pNode3->m_index;
-		pFace->m_index = nNewIndex;
+		pFace = m_Faces.allocData(nNewIndex);
+		pFace->m_nodeindices[0] = nNodeIndex1;
+		pFace->m_nodeindices[1] = nNodeIndex2;
+		pFace->m_nodeindices[2] = nNodeIndex3;
 
 		if (m_pMeshInformationHandler)
 			m_pMeshInformationHandler->addFace(getFaceCount());
 
 		return pFace;
 	}
-	
-	_Ret_notnull_ MESHFACE * CMesh::addFace(_In_ nfInt32 nNodeIndex1, _In_ nfInt32 nNodeIndex2, _In_ nfInt32 nNodeIndex3)
+
+	nfUint32 CMesh::appendNode(_In_ const NVEC3 vPosition)
+	{
+		nfUint32 j;
+
+		// Check Position Validity
+		for (j = 0; j < 3; j++)
+			if (fabs(vPosition.m_fields[j]) > NMR_MESH_MAXCOORDINATE)
+				throw CNMRException(NMR_ERROR_INVALIDCOORDINATES);
+
+		// Check Node Quota
+		nfUint32 nNodeCount = getNodeCount();
+		if (nNodeCount >= NMR_MESH_MAXNODECOUNT)
+			throw CNMRException(NMR_ERROR_TOOMANYNODES);
+		m_OutboxCache.invalidate();
+
+		if (m_StorageMode == MESHSTORAGEMODE_SOA) {
+			MESHNODEBUFFER * pNodeBuffer = writeNodeBuffer();
+			for (j = 0; j < 3; j++)
+				pNodeBuffer->m_Coordinates[j].push_back(vPosition.m_fields[j]);
+			return nNodeCount;
+		}
+		if (m_StorageMode == MESHSTORAGEMODE_QUANTIZED) {
+			MESHNODEBUFFER * pNodeBuffer = writeNodeBuffer();
+			resizeQuantizedNodes(pNodeBuffer, (size_t)nNodeCount + 1);
+			try {
+				quantizeNodes(pNodeBuffer, nNodeCount, 1, vPosition.m_fields);
+			}
+			catch (...) {
+				resizeQuantizedNodes(pNodeBuffer, nNodeCount);
+				throw;
+			}
+			return nNodeCount;
+		}
+
+		nfUint32 nNewIndex;
+		MESHNODE * pNode = m_Nodes.allocData(nNewIndex);
+		pNode->m_position = vPosition;
+
+		return nNewIndex;
+	}
+
+	nfUint32 CMesh::appendFace(_In_ nfInt32 nNodeIndex1, _In_ nfInt32 nNodeIndex2, _In_ nfInt32 nNodeIndex3)
 	{
 		if ((nNodeIndex1 == nNodeIndex2) || (nNodeIndex1 == nNodeIndex3) || (nNodeIndex2 == nNodeIndex3))
 			throw CNMRException(NMR_ERROR_DUPLICATENODE);
 
-		MESHFACE * pFace;
 		nfUint32 nFaceCount = getFaceCount();
-
 		if (nFaceCount >= NMR_MESH_MAXFACECOUNT)
 			throw CNMRException(NMR_ERROR_TOOMANYFACES);
 
 		nfUint32 nNewIndex;
-
-		pFace = m_Faces.allocData(nNewIndex);
-		pFace->m_nodeindices[0] = nNodeIndex1;
-		pFace->m_nodeindices[1] = nNodeIndex2;
-		pFace->m_nodeindices[2] = nNodeIndex3;
-		pFace->m_index = nNewIndex;
+		if (m_StorageMode != MESHSTORAGEMODE_PAGED) {
+			MESHINDEXARRAY & NodeIndices = writeFaceBuffer()->m_NodeIndices;
+			NodeIndices.push_back(nNodeIndex1);
+			NodeIndices.push_back(nNodeIndex2);
+			NodeIndices.push_back(nNodeIndex3);
+			nNewIndex = nFaceCount;
+		}
+		else {
+			MESHFACE * pFace = m_Faces.allocData(nNewIndex);
+			pFace->m_nodeindices[0] = nNodeIndex1;
+			pFace->m_nodeindices[1] = nNodeIndex2;
+			pFace->m_nodeindices[2] = nNodeIndex3;
+		}
 
 		if (m_pMeshInformationHandler)
 			m_pMeshInformationHandler->addFace(getFaceCount());
 
-		return pFace;
+		return nNewIndex;
+	}
+
+	nfUint32 CMesh::addNodes(_In_ const nfFloat * pCoordinates, _In_ nfUint32 nCount)
+	{
+		nfUint32 nFirstIndex = getNodeCount();
+		if (nCount == 0)
+			return nFirstIndex;
+		if (!pCoordinates)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		// Check Position Validity, without branching per coordinate
+		size_t nCoordinateCount = (size_t)nCount * 3;
+		nfFloat fMaxAbs = 0.0f;
+		for (size_t nIndex = 0; nIndex < nCoordinateCount; nIndex++)
+			fMaxAbs = std::max(fMaxAbs, (nfFloat)fabs(pCoordinates[nIndex]));
+		if (fMaxAbs > NMR_MESH_MAXCOORDINATE)
+			throw CNMRException(NMR_ERROR_INVALIDCOORDINATES);
+
+		// Check Node Quota
+		if ((nfUint64)nFirstIndex + nCount > NMR_MESH_MAXNODECOUNT)
+			throw CNMRException(NMR_ERROR_TOOMANYNODES);
+		m_OutboxCache.invalidate();
+
+		nfUint32 nIdx, j;
+		if (m_StorageMode == MESHSTORAGEMODE_SOA) {
+			MESHNODEBUFFER * pNodeBuffer = writeNodeBuffer();
+			for (j = 0; j < 3; j++) {
+				MESHCOORDINATEARRAY & Target = pNodeBuffer->m_Coordinates[j];
+				Target.resize((size_t)nFirstIndex + nCount);
+				for (nIdx = 0; nIdx < nCount; nIdx++)
+					Target[(size_t)nFirstIndex + nIdx] = pCoordinates[(size_t)nIdx * 3 + j];
+			}
+			return nFirstIndex;
+		}
+		if (m_StorageMode == MESHSTORAGEMODE_QUANTIZED) {
+			MESHNODEBUFFER * pNodeBuffer = writeNodeBuffer();
+			resizeQuantizedNodes(pNodeBuffer, (size_t)nFirstIndex + nCount);
+			try {
+				quantizeNodes(pNodeBuffer, nFirstIndex, nCount, pCoordinates);
+			}
+			catch (...) {
+				resizeQuantizedNodes(pNodeBuffer, nFirstIndex);
+				throw;
+			}
+			return nFirstIndex;
+		}
+
+		m_Nodes.reserve(nFirstIndex + nCount);
+		while (nCount > 0) {
+			nfUint32 nAllocatedCount;
+			MESHNODE * pNodes = m_Nodes.allocRange(nCount, nAllocatedCount);
+			for (nIdx = 0; nIdx < nAllocatedCount; nIdx++) {
+				for (j = 0; j < 3; j++)
+					pNodes[nIdx].m_position.m_fields[j] = pCoordinates[j];
+				pCoordinates += 3;
+			}
+			nCount -= nAllocatedCount;
+		}
+
+		return nFirstIndex;
+	}
+
+	nfUint32 CMesh::addFaces(_In_ const nfInt32 * pNodeIndices, _In_ nfUint32 nCount)
+	{
+		nfUint32 nFirstIndex = getFaceCount();
+		if (nCount == 0)
+			return nFirstIndex;
+		if (!pNodeIndices)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		// Validate all faces first, without branching per face
+		nfUint32 nNodeCount = getNodeCount();
+		nfUint32 nIdx;
+		nfUint32 nInvalid = 0;
+		nfUint32 nDuplicate = 0;
+		for (nIdx = 0; nIdx < nCount; nIdx++) {
+			const nfInt32 * pFaceIndices = &pNodeIndices[(size_t)nIdx * 3];
+			nInvalid |= ((nfUint32)pFaceIndices[0] >= nNodeCount) | ((nfUint32)pFaceIndices[1] >= nNodeCount) | ((nfUint32)pFaceIndices[2] >= nNodeCount);
+			nDuplicate |= (pFaceIndices[0] == pFaceIndices[1]) | (pFaceIndices[0] == pFaceIndices[2]) | (pFaceIndices[1] == pFaceIndices[2]);
+		}
+		if (nInvalid)
+			throw CNMRException(NMR_ERROR_INVALIDNODEINDEX);
+		if (nDuplicate)
+			throw CNMRException(NMR_ERROR_DUPLICATENODE);
+
+		// Check Face Quota
+		if ((nfUint64)nFirstIndex + nCount > NMR_MESH_MAXFACECOUNT)
+			throw CNMRException(NMR_ERROR_TOOMANYFACES);
+
+		if (m_StorageMode != MESHSTORAGEMODE_PAGED) {
+			MESHINDEXARRAY & NodeIndices = writeFaceBuffer()->m_NodeIndices;
+			NodeIndices.insert(NodeIndices.end(), pNodeIndices, pNodeIndices + (size_t)nCount * 3);
+		}
+		else {
+			m_Faces.reserve(nFirstIndex + nCount);
+			nfUint32 nRemaining = nCount;
+			while (nRemaining > 0) {
+				nfUint32 nAllocatedCount;
+				MESHFACE * pFaces = m_Faces.allocRange(nRemaining, nAllocatedCount);
+				for (nIdx = 0; nIdx < nAllocatedCount; nIdx++) {
+					pFaces[nIdx].m_nodeindices[0] = pNodeIndices[0];
+					pFaces[nIdx].m_nodeindices[1] = pNodeIndices[1];
+					pFaces[nIdx].m_nodeindices[2] = pNodeIndices[2];
+					pNodeIndices += 3;
+				}
+				nRemaining -= nAllocatedCount;
+			}
+		}
+
+		if (m_pMeshInformationHandler) {
+			for (nIdx = 1; nIdx <= nCount; nIdx++)
+				m_pMeshInformationHandler->addFace(nFirstIndex + nIdx);
+		}
+
+		return nFirstIndex;
 	}
 
 	_Ret_notnull_ MESHBEAM * CMesh::addBeam(_In_ MESHNODE * pNode1, _In_ MESHNODE * pNode2,
@@ -264,6 +1002,18 @@ namespace NMR {
 		if (pNode1 == pNode2)
 			throw CNMRException(NMR_ERROR_DUPLICATENODE);
 
+		setStorageMode(MESHSTORAGEMODE_PAGED);
+
+		return addBeam((nfInt32)getNodeIndex(pNode1), (nfInt32)getNodeIndex(pNode2), dRadius1, dRadius2, eCapMode1, eCapMode2);
+	}
+
+	_Ret_notnull_ MESHBEAM * CMesh::addBeam(_In_ nfInt32 nNodeIndex1, _In_ nfInt32 nNodeIndex2,
+		_In_ nfDouble dRadius1, _In_ nfDouble dRadius2,
+		_In_ nfInt32 eCapMode1, _In_ nfInt32 eCapMode2)
+	{
+		if (nNodeIndex1 == nNodeIndex2)
+			throw CNMRException(NMR_ERROR_DUPLICATENODE);
+
 		MESHBEAM * pBeam;
 		nfUint32 nBeamCount = getBeamCount();
 
@@ -273,8 +1023,8 @@ namespace NMR {
 		nfUint32 nNewIndex;
 
 		pBeam = m_BeamLattice.m_Beams.allocData(nNewIndex);
-		pBeam->m_nodeindices[0] = pNode1->m_index;
-		pBeam->m_nodeindices[1] = pNode2->m_index;
+		pBeam->m_nodeindices[0] = nNodeIndex1;
+		pBeam->m_nodeindices[1] = nNodeIndex2;
 		pBeam->m_index = nNewIndex;
 		pBeam->m_radius[0] = dRadius1;
 		pBeam->m_radius[1] = dRadius2;
@@ -292,12 +1042,62 @@ namespace NMR {
 	}
 
 
+	void CMesh::reserveNodes(_In_ nfUint32 nNodeCount)
+	{
+		nNodeCount = std::min(nNodeCount, (nfUint32)NMR_MESH_MAXNODECOUNT);
+		if (m_StorageMode == MESHSTORAGEMODE_SOA) {
+			MESHNODEBUFFER * pNodeBuffer = writeNodeBuffer();
+			for (nfUint32 j = 0; j < 3; j++)
+				pNodeBuffer->m_Coordinates[j].reserve(nNodeCount);
+		}
+		else if (m_StorageMode == MESHSTORAGEMODE_QUANTIZED) {
+			MESHNODEBUFFER * pNodeBuffer = writeNodeBuffer();
+			for (nfUint32 j = 0; j < 3; j++) {
+				if (m_Quantization.m_nBitCount == 16)
+					pNodeBuffer->m_Quantized16[j].reserve(nNodeCount);
+				else
+					pNodeBuffer->m_Quantized32[j].reserve(nNodeCount);
+			}
+		}
+		else
+			m_Nodes.reserve(nNodeCount);
+	}
+
+	void CMesh::reserveFaces(_In_ nfUint32 nFaceCount)
+	{
+		nFaceCount = std::min(nFaceCount, (nfUint32)NMR_MESH_MAXFACECOUNT);
+		if (m_StorageMode != MESHSTORAGEMODE_PAGED)
+			writeFaceBuffer()->m_NodeIndices.reserve((size_t)nFaceCount * 3);
+		else
+			m_Faces.reserve(nFaceCount);
+		if (m_pMeshInformationHandler)
+			m_pMeshInformationHandler->reserveFaces(nFaceCount);
+	}
+
+	void CMesh::reserveBeams(_In_ nfUint32 nBeamCount)
+	{
+		m_BeamLattice.m_Beams.reserve(std::min(nBeamCount, (nfUint32)NMR_MESH_MAXBEAMCOUNT));
+	}
+
+	nfUint32 CMesh::getFaceCapacity()
+	{
+		if (m_StorageMode != MESHSTORAGEMODE_PAGED)
+			return (nfUint32)std::min(m_pFaceBuffer->m_NodeIndices.capacity() / 3, (size_t)NMR_MESH_MAXFACECOUNT);
+		return m_Faces.getCapacity();
+	}
+
 	nfUint32 CMesh::getNodeCount()	{
+		if (m_StorageMode == MESHSTORAGEMODE_SOA)
+			return (nfUint32)m_pNodeBuffer->m_Coordinates[0].size();
+		if (m_StorageMode == MESHSTORAGEMODE_QUANTIZED)
+			return (nfUint32)((m_Quantization.m_nBitCount == 16) ? m_pNodeBuffer->m_Quantized16[0].size() : m_pNodeBuffer->m_Quantized32[0].size());
 		return m_Nodes.getCount ();
 	}
 
 	nfUint32 CMesh::getFaceCount()
 	{
+		if (m_StorageMode != MESHSTORAGEMODE_PAGED)
+			return (nfUint32)(m_pFaceBuffer->m_NodeIndices.size() / 3);
 		return m_Faces.getCount ();
 	}
 
@@ -313,14 +1113,436 @@ namespace NMR {
 
 	_Ret_notnull_ MESHNODE * CMesh::getNode(_In_ nfUint32 nIdx)
 	{
+		setStorageMode(MESHSTORAGEMODE_PAGED);
+		m_OutboxCache.invalidate();
 		return m_Nodes.getData(nIdx);
 	}
 
 	_Ret_notnull_ MESHFACE * CMesh::getFace(_In_ nfUint32 nIdx)
 	{
+		setStorageMode(MESHSTORAGEMODE_PAGED);
 		return m_Faces.getData(nIdx);
 	}
 
+	nfUint32 CMesh::getNodeIndex(_In_ const MESHNODE * pNode)
+	{
+		if (!pNode)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+		return m_Nodes.getIndex(pNode);
+	}
+
+	nfUint32 CMesh::getFaceIndex(_In_ const MESHFACE * pFace)
+	{
+		if (!pFace)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+		return m_Faces.getIndex(pFace);
+	}
+
+	void CMesh::setStorageMode(_In_ eMeshStorageMode eStorageMode)
+	{
+		if (eStorageMode == m_StorageMode)
+			return;
+		if ((eStorageMode != MESHSTORAGEMODE_PAGED) && (eStorageMode != MESHSTORAGEMODE_SOA) && (eStorageMode != MESHSTORAGEMODE_QUANTIZED))
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		nfUint32 nNodeCount = getNodeCount();
+		nfUint32 nFaceCount = getFaceCount();
+		nfUint32 nIdx, j;
+
+		if (eStorageMode == MESHSTORAGEMODE_PAGED) {
+			// Node positions are read in the previous storage mode
+			m_Nodes.reserve(nNodeCount);
+			nIdx = 0;
+			while (nIdx < nNodeCount) {
+				nfUint32 nAllocatedCount;
+				MESHNODE * pNodes = m_Nodes.allocRange(nNodeCount - nIdx, nAllocatedCount);
+				copyNodePositions(nIdx, nAllocatedCount, pNodes->m_position.m_fields);
+				nIdx += nAllocatedCount;
+			}
+
+			m_Faces.reserve(nFaceCount);
+			for (nIdx = 0; nIdx < nFaceCount; nIdx++) {
+				nfUint32 nNewIndex;
+				MESHFACE * pFace = m_Faces.allocData(nNewIndex);
+				for (j = 0; j < 3; j++)
+					pFace->m_nodeindices[j] = m_pFaceBuffer->m_NodeIndices[(size_t)nIdx * 3 + j];
+			}
+
+			// Releases the arrays, or leaves them to the meshes which share them
+			resetBuffers();
+			m_StorageMode = eStorageMode;
+			return;
+		}
+
+		if (eStorageMode == MESHSTORAGEMODE_QUANTIZED)
+			checkQuantization(m_Quantization);
+
+		// Fill the arrays of the new mode batch by batch, before the previous storage is released
+		MESHNODEBUFFER * pNodeBuffer = writeNodeBuffer();
+		std::vector<nfFloat> Coordinates((size_t)std::min(nNodeCount, (nfUint32)NMR_MESH_MERGEBATCHSIZE) * 3);
+		try {
+			if (eStorageMode == MESHSTORAGEMODE_SOA) {
+				for (j = 0; j < 3; j++)
+					pNodeBuffer->m_Coordinates[j].resize(nNodeCount);
+			}
+			else
+				resizeQuantizedNodes(pNodeBuffer, nNodeCount);
+
+			for (nIdx = 0; nIdx < nNodeCount; nIdx += NMR_MESH_MERGEBATCHSIZE) {
+				nfUint32 nBatchCount = std::min(nNodeCount - nIdx, (nfUint32)NMR_MESH_MERGEBATCHSIZE);
+				copyNodePositions(nIdx, nBatchCount, Coordinates.data());
+				if (eStorageMode == MESHSTORAGEMODE_SOA) {
+					for (j = 0; j < 3; j++) {
+						nfFloat * pTarget = &pNodeBuffer->m_Coordinates[j][nIdx];
+						for (nfUint32 nBatchIdx = 0; nBatchIdx < nBatchCount; nBatchIdx++)
+							pTarget[nBatchIdx] = Coordinates[(size_t)nBatchIdx * 3 + j];
+					}
+				}
+				else
+					quantizeNodes(pNodeBuffer, nIdx, nBatchCount, Coordinates.data());
+			}
+		}
+		catch (...) {
+			// The mesh stays in its previous storage mode
+			for (j = 0; j < 3; j++) {
+				if (eStorageMode == MESHSTORAGEMODE_SOA)
+					MESHCOORDINATEARRAY(pNodeBuffer->m_Coordinates[j].get_allocator()).swap(pNodeBuffer->m_Coordinates[j]);
+				else {
+					MESHQUANTIZED16ARRAY(pNodeBuffer->m_Quantized16[j].get_allocator()).swap(pNodeBuffer->m_Quantized16[j]);
+					MESHQUANTIZED32ARRAY(pNodeBuffer->m_Quantized32[j].get_allocator()).swap(pNodeBuffer->m_Quantized32[j]);
+				}
+			}
+			throw;
+		}
+
+		if (m_StorageMode == MESHSTORAGEMODE_PAGED) {
+			MESHINDEXARRAY & NodeIndices = writeFaceBuffer()->m_NodeIndices;
+			NodeIndices.resize((size_t)nFaceCount * 3);
+			for (nIdx = 0; nIdx < nFaceCount; nIdx++) {
+				MESHFACE * pFace = m_Faces.getData(nIdx);
+				for (j = 0; j < 3; j++)
+					NodeIndices[(size_t)nIdx * 3 + j] = pFace->m_nodeindices[j];
+			}
+
+			m_Nodes.clearAllData();
+			m_Faces.clearAllData();
+		}
+		else {
+			// Node indices are stored the same way in both array modes, only the node arrays of the previous mode are released
+			for (j = 0; j < 3; j++) {
+				if (m_StorageMode == MESHSTORAGEMODE_SOA)
+					MESHCOORDINATEARRAY(pNodeBuffer->m_Coordinates[j].get_allocator()).swap(pNodeBuffer->m_Coordinates[j]);
+				else {
+					MESHQUANTIZED16ARRAY(pNodeBuffer->m_Quantized16[j].get_allocator()).swap(pNodeBuffer->m_Quantized16[j]);
+					MESHQUANTIZED32ARRAY(pNodeBuffer->m_Quantized32[j].get_allocator()).swap(pNodeBuffer->m_Quantized32[j]);
+				}
+			}
+		}
+
+		m_StorageMode = eStorageMode;
+	}
+
+	eMeshStorageMode CMesh::getStorageMode()
+	{
+		return m_StorageMode;
+	}
+
+	void CMesh::setMappedStorage(_In_opt_ PMeshMappedStorage pStorage)
+	{
+		if (pStorage == m_pMappedStorage)
+			return;
+
+		// Copies the arrays, which are empty in paged storage, and releases or unshares the previous ones
+		std::shared_ptr<MESHNODEBUFFER> pNodeBuffer = m_pNodeBuffer;
+		std::shared_ptr<MESHFACEBUFFER> pFaceBuffer = m_pFaceBuffer;
+		m_pMappedStorage = pStorage;
+		resetBuffers();
+
+		for (nfUint32 j = 0; j < 3; j++)
+			m_pNodeBuffer->m_Coordinates[j].assign(pNodeBuffer->m_Coordinates[j].begin(), pNodeBuffer->m_Coordinates[j].end());
+		for (nfUint32 j = 0; j < 3; j++) {
+			m_pNodeBuffer->m_Quantized16[j].assign(pNodeBuffer->m_Quantized16[j].begin(), pNodeBuffer->m_Quantized16[j].end());
+			m_pNodeBuffer->m_Quantized32[j].assign(pNodeBuffer->m_Quantized32[j].begin(), pNodeBuffer->m_Quantized32[j].end());
+		}
+		m_pFaceBuffer->m_NodeIndices.assign(pFaceBuffer->m_NodeIndices.begin(), pFaceBuffer->m_NodeIndices.end());
+
+		// Quantized storage keeps its arrays in the mapped storage as well
+		if (m_pMappedStorage && (m_StorageMode == MESHSTORAGEMODE_PAGED))
+			setStorageMode(MESHSTORAGEMODE_SOA);
+	}
+
+	_Ret_maybenull_ PMeshMappedStorage CMesh::getMappedStorage()
+	{
+		return m_pMappedStorage;
+	}
+
+	void CMesh::setArena(_In_opt_ PMonotonicArena pArena)
+	{
+		// Node and face blocks come from an arena of the mesh, which is freed once they leave paged storage.
+		// Its first block holds the first node and face block.
+		PMonotonicArena pStorageArena;
+		if (pArena && (m_StorageMode == MESHSTORAGEMODE_PAGED))
+			pStorageArena = std::make_shared<CMonotonicArena>(m_Nodes.getBlockSize() * sizeof(MESHNODE) + m_Faces.getBlockSize() * sizeof(MESHFACE));
+
+		m_Nodes.setArena(pStorageArena);
+		m_Faces.setArena(pStorageArena);
+		m_BeamLattice.m_Beams.setArena(pArena);
+		m_pArena = pArena;
+	}
+
+	_Ret_maybenull_ PMonotonicArena CMesh::getArena()
+	{
+		return m_pArena;
+	}
+
+	void CMesh::quantize(_In_ const MESHQUANTIZATION & Quantization)
+	{
+		// Checked before the mesh is changed at all
+		checkQuantization(Quantization);
+
+		if (m_StorageMode == MESHSTORAGEMODE_QUANTIZED)
+			setStorageMode(MESHSTORAGEMODE_SOA);
+		m_Quantization = Quantization;
+		setStorageMode(MESHSTORAGEMODE_QUANTIZED);
+	}
+
+	const MESHQUANTIZATION & CMesh::getQuantization()
+	{
+		return m_Quantization;
+	}
+
+	void CMesh::copyQuantizedNodeCoordinates(_In_ nfUint32 nStartIndex, _In_ nfUint32 nCount, _Out_ nfInt32 * pValues)
+	{
+		__NMRASSERT(pValues);
+		if (m_StorageMode != MESHSTORAGEMODE_QUANTIZED)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+		if ((nfUint64)nStartIndex + nCount > getNodeCount())
+			throw CNMRException(NMR_ERROR_INVALIDINDEX);
+
+		for (nfUint32 j = 0; j < 3; j++) {
+			for (nfUint32 nIdx = 0; nIdx < nCount; nIdx++) {
+				if (m_Quantization.m_nBitCount == 16)
+					pValues[(size_t)nIdx * 3 + j] = m_pNodeBuffer->m_Quantized16[j][(size_t)nStartIndex + nIdx];
+				else
+					pValues[(size_t)nIdx * 3 + j] = m_pNodeBuffer->m_Quantized32[j][(size_t)nStartIndex + nIdx];
+			}
+		}
+	}
+
+	void CMesh::checkQuantization(_In_ const MESHQUANTIZATION & Quantization)
+	{
+		if (!(Quantization.m_fUnits > 0.0f) || std::isinf(Quantization.m_fUnits))
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+		if ((Quantization.m_nBitCount != 16) && (Quantization.m_nBitCount != 32))
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+		for (nfUint32 j = 0; j < 3; j++)
+			if (!(fabs(Quantization.m_vOrigin.m_fields[j]) <= NMR_MESH_MAXCOORDINATE))
+				throw CNMRException(NMR_ERROR_INVALIDCOORDINATES);
+
+		if (getNodeCount() == 0)
+			return;
+
+		// Rounding keeps the order of the coordinates, so all nodes fit if the corners of their bounds fit
+		NOUTBOX3 oOutbox;
+		fnOutboxInitialize(oOutbox);
+		extendOutbox(oOutbox, fnMATRIX3_identity());
+		for (nfUint32 j = 0; j < 3; j++) {
+			nfBool bFits;
+			if (Quantization.m_nBitCount == 16) {
+				nfInt16 nValue;
+				bFits = fnMeshQuantizeValue(oOutbox.m_min.m_fields[j], Quantization.m_vOrigin.m_fields[j], Quantization.m_fUnits, nValue) &&
+					fnMeshQuantizeValue(oOutbox.m_max.m_fields[j], Quantization.m_vOrigin.m_fields[j], Quantization.m_fUnits, nValue);
+			}
+			else {
+				nfInt32 nValue;
+				bFits = fnMeshQuantizeValue(oOutbox.m_min.m_fields[j], Quantization.m_vOrigin.m_fields[j], Quantization.m_fUnits, nValue) &&
+					fnMeshQuantizeValue(oOutbox.m_max.m_fields[j], Quantization.m_vOrigin.m_fields[j], Quantization.m_fUnits, nValue);
+			}
+			if (!bFits)
+				throw CNMRException(NMR_ERROR_QUANTIZEDCOORDINATEOUTOFRANGE);
+		}
+	}
+
+	void CMesh::resizeQuantizedNodes(_In_ MESHNODEBUFFER * pNodeBuffer, _In_ size_t nNodeCount)
+	{
+		for (nfUint32 j = 0; j < 3; j++) {
+			if (m_Quantization.m_nBitCount == 16)
+				pNodeBuffer->m_Quantized16[j].resize(nNodeCount);
+			else
+				pNodeBuffer->m_Quantized32[j].resize(nNodeCount);
+		}
+	}
+
+	void CMesh::quantizeNodes(_In_ MESHNODEBUFFER * pNodeBuffer, _In_ nfUint32 nIndex, _In_ nfUint32 nCount, _In_ const nfFloat * pCoordinates)
+	{
+		if (nCount == 0)
+			return;
+		if (m_Quantization.m_nBitCount == 16)
+			fnMeshQuantizeTriples(pCoordinates, nCount, m_Quantization, pNodeBuffer->m_Quantized16, nIndex);
+		else
+			fnMeshQuantizeTriples(pCoordinates, nCount, m_Quantization, pNodeBuffer->m_Quantized32, nIndex);
+	}
+
+	void CMesh::dequantizeNodes(_In_ nfUint32 nIndex, _In_ nfUint32 nCount, _Out_ nfFloat * pCoordinates)
+	{
+		if (m_Quantization.m_nBitCount == 16)
+			fnMeshDequantizeTriples(m_pNodeBuffer->m_Quantized16, nIndex, nCount, m_Quantization, pCoordinates);
+		else
+			fnMeshDequantizeTriples(m_pNodeBuffer->m_Quantized32, nIndex, nCount, m_Quantization, pCoordinates);
+	}
+
+	NVEC3 CMesh::getNodePosition(_In_ nfUint32 nIdx)
+	{
+		if (m_StorageMode == MESHSTORAGEMODE_SOA) {
+			if (nIdx >= getNodeCount())
+				throw CNMRException(NMR_ERROR_INVALIDINDEX);
+			const MESHNODEBUFFER * pNodeBuffer = m_pNodeBuffer.get();
+			return fnVEC3_make(pNodeBuffer->m_Coordinates[0][nIdx], pNodeBuffer->m_Coordinates[1][nIdx], pNodeBuffer->m_Coordinates[2][nIdx]);
+		}
+		if (m_StorageMode == MESHSTORAGEMODE_QUANTIZED) {
+			if (nIdx >= getNodeCount())
+				throw CNMRException(NMR_ERROR_INVALIDINDEX);
+			NVEC3 vPosition;
+			dequantizeNodes(nIdx, 1, vPosition.m_fields);
+			return vPosition;
+		}
+		return m_Nodes.getData(nIdx)->m_position;
+	}
+
+	void CMesh::setNodePosition(_In_ nfUint32 nIdx, _In_ const NVEC3 vPosition)
+	{
+		m_OutboxCache.invalidate();
+		if (m_StorageMode == MESHSTORAGEMODE_SOA) {
+			if (nIdx >= getNodeCount())
+				throw CNMRException(NMR_ERROR_INVALIDINDEX);
+			MESHNODEBUFFER * pNodeBuffer = writeNodeBuffer();
+			for (nfUint32 j = 0; j < 3; j++)
+				pNodeBuffer->m_Coordinates[j][nIdx] = vPosition.m_fields[j];
+		}
+		else if (m_StorageMode == MESHSTORAGEMODE_QUANTIZED) {
+			if (nIdx >= getNodeCount())
+				throw CNMRException(NMR_ERROR_INVALIDINDEX);
+			quantizeNodes(writeNodeBuffer(), nIdx, 1, vPosition.m_fields);
+		}
+		else
+			m_Nodes.getData(nIdx)->m_position = vPosition;
+	}
+
+	void CMesh::getFaceNodeIndices(_In_ nfUint32 nIdx, _Out_ nfInt32 * pNodeIndices)
+	{
+		__NMRASSERT(pNodeIndices);
+		const nfInt32 * pSource;
+		if (m_StorageMode != MESHSTORAGEMODE_PAGED) {
+			if (nIdx >= getFaceCount())
+				throw CNMRException(NMR_ERROR_INVALIDINDEX);
+			pSource = &m_pFaceBuffer->m_NodeIndices[(size_t)nIdx * 3];
+		}
+		else
+			pSource = m_Faces.getData(nIdx)->m_nodeindices;
+
+		pNodeIndices[0] = pSource[0];
+		pNodeIndices[1] = pSource[1];
+		pNodeIndices[2] = pSource[2];
+	}
+
+	void CMesh::setFaceNodeIndices(_In_ nfUint32 nIdx, _In_ const nfInt32 * pNodeIndices)
+	{
+		__NMRASSERT(pNodeIndices);
+		nfInt32 * pTarget;
+		if (m_StorageMode != MESHSTORAGEMODE_PAGED) {
+			if (nIdx >= getFaceCount())
+				throw CNMRException(NMR_ERROR_INVALIDINDEX);
+			pTarget = &writeFaceBuffer()->m_NodeIndices[(size_t)nIdx * 3];
+		}
+		else
+			pTarget = m_Faces.getData(nIdx)->m_nodeindices;
+
+		pTarget[0] = pNodeIndices[0];
+		pTarget[1] = pNodeIndices[1];
+		pTarget[2] = pNodeIndices[2];
+	}
+
+	void CMesh::copyNodePositions(_In_ nfUint32 nStartIndex, _In_ nfUint32 nCount, _Out_ nfFloat * pCoordinates)
+	{
+		__NMRASSERT(pCoordinates);
+		if ((nfUint64)nStartIndex + nCount > getNodeCount())
+			throw CNMRException(NMR_ERROR_INVALIDINDEX);
+
+		nfUint32 nIdx, j;
+		if (m_StorageMode == MESHSTORAGEMODE_SOA) {
+			for (j = 0; j < 3; j++) {
+				const nfFloat * pSource = &m_pNodeBuffer->m_Coordinates[j][nStartIndex];
+				for (nIdx = 0; nIdx < nCount; nIdx++)
+					pCoordinates[(size_t)nIdx * 3 + j] = pSource[nIdx];
+			}
+			return;
+		}
+		if (m_StorageMode == MESHSTORAGEMODE_QUANTIZED) {
+			dequantizeNodes(nStartIndex, nCount, pCoordinates);
+			return;
+		}
+
+		// Walk the paged storage block by block
+		nfUint32 nEndIndex = nStartIndex + nCount;
+		while (nStartIndex < nEndIndex) {
+			nfUint32 nContiguousCount;
+			const MESHNODE * pNodes = m_Nodes.getRange(nStartIndex, nContiguousCount);
+			nContiguousCount = std::min(nContiguousCount, nEndIndex - nStartIndex);
+
+			for (nIdx = 0; nIdx < nContiguousCount; nIdx++) {
+				pCoordinates[0] = pNodes[nIdx].m_position.m_fields[0];
+				pCoordinates[1] = pNodes[nIdx].m_position.m_fields[1];
+				pCoordinates[2] = pNodes[nIdx].m_position.m_fields[2];
+				pCoordinates += 3;
+			}
+			nStartIndex += nContiguousCount;
+		}
+	}
+
+	void CMesh::copyFaceNodeIndices(_In_ nfUint32 nStartIndex, _In_ nfUint32 nCount, _Out_ nfInt32 * pNodeIndices)
+	{
+		__NMRASSERT(pNodeIndices);
+		if ((nfUint64)nStartIndex + nCount > getFaceCount())
+			throw CNMRException(NMR_ERROR_INVALIDINDEX);
+
+		if (m_StorageMode != MESHSTORAGEMODE_PAGED) {
+			if (nCount > 0)
+				memcpy(pNodeIndices, &m_pFaceBuffer->m_NodeIndices[(size_t)nStartIndex * 3], (size_t)nCount * 3 * sizeof(nfInt32));
+			return;
+		}
+
+		nfUint32 nEndIndex = nStartIndex + nCount;
+		while (nStartIndex < nEndIndex) {
+			nfUint32 nContiguousCount;
+			const MESHFACE * pFaces = m_Faces.getRange(nStartIndex, nContiguousCount);
+			nContiguousCount = std::min(nContiguousCount, nEndIndex - nStartIndex);
+
+			for (nfUint32 nIdx = 0; nIdx < nContiguousCount; nIdx++) {
+				pNodeIndices[0] = pFaces[nIdx].m_nodeindices[0];
+				pNodeIndices[1] = pFaces[nIdx].m_nodeindices[1];
+				pNodeIndices[2] = pFaces[nIdx].m_nodeindices[2];
+				pNodeIndices += 3;
+			}
+			nStartIndex += nContiguousCount;
+		}
+	}
+
+	_Ret_maybenull_ const nfFloat * CMesh::getNodeCoordinates(_In_ nfUint32 nAxis)
+	{
+		if (nAxis >= 3)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+		if (m_StorageMode != MESHSTORAGEMODE_SOA)
+			return nullptr;
+		return m_pNodeBuffer->m_Coordinates[nAxis].data();
+	}
+
+	_Ret_maybenull_ const nfInt32 * CMesh::getFaceNodeIndexArray()
+	{
+		if (m_StorageMode == MESHSTORAGEMODE_PAGED)
+			return nullptr;
+		return m_pFaceBuffer->m_NodeIndices.data();
+	}
+
 	_Ret_notnull_ MESHBEAM * CMesh::getBeam(_In_ nfUint32 nIdx)
 	{
 		return m_BeamLattice.m_Beams.getData(nIdx);
@@ -375,24 +1597,20 @@ namespace NMR {
 		if (nBeamCount > NMR_MESH_MAXBEAMCOUNT)
 			return false;
 
-		for (nIdx = 0; nIdx < nNodeCount; nIdx++) {
-			MESHNODE * node = getNode(nIdx);
-			if (node->m_index != (nfInt32) nIdx)
-				return false;
-			for (j = 0; j < 3; j++)
-				if (fabs(node->m_position.m_fields[j]) > NMR_MESH_MAXCOORDINATE)
-					return false;
-		}
+		// Nodes and faces are checked in chunks on worker threads, each chunk takes its share of both
+		nfUint32 nChunkCount = fnParallelGetChunkCount(std::max(nNodeCount, nFaceCount), NMR_MESH_PARALLELCHUNKSIZE);
+		if (nChunkCount > 0) {
+			std::vector<nfUint32> ChunkIsInvalid(nChunkCount, 0);
+			fnParallelForChunks(nChunkCount, [&](nfUint32 nChunkIndex) {
+				nfUint32 nNodeStart = (nfUint32)fnParallelGetChunkStart(nNodeCount, nChunkCount, nChunkIndex);
+				nfUint32 nNodeEnd = (nfUint32)fnParallelGetChunkStart(nNodeCount, nChunkCount, nChunkIndex + 1);
+				nfUint32 nFaceStart = (nfUint32)fnParallelGetChunkStart(nFaceCount, nChunkCount, nChunkIndex);
+				nfUint32 nFaceEnd = (nfUint32)fnParallelGetChunkStart(nFaceCount, nChunkCount, nChunkIndex + 1);
 
-		for (nIdx = 0; nIdx < nFaceCount; nIdx++) {
-			MESHFACE * face = getFace(nIdx);
-			for (j = 0; j < 3; j++)
-				if ((face->m_nodeindices[j] < 0) || (((nfUint32)face->m_nodeindices[j]) >= nNodeCount))
-					return false;
+				ChunkIsInvalid[nChunkIndex] = hasInvalidNodes(nNodeStart, nNodeEnd) || hasInvalidFaces(nFaceStart, nFaceEnd, nNodeCount);
+			});
 
-			if ((face->m_nodeindices[0] == face->m_nodeindices[1]) ||
-				(face->m_nodeindices[0] == face->m_nodeindices[2]) ||
-				(face->m_nodeindices[1] == face->m_nodeindices[2]))
+			if (std::find(ChunkIsInvalid.begin(), ChunkIsInvalid.end(), 1u) != ChunkIsInvalid.end())
 				return false;
 		}
 
@@ -408,11 +1626,64 @@ namespace NMR {
 		return true;
 	}
 
+	nfBool CMesh::hasInvalidNodes(_In_ nfUint32 nStart, _In_ nfUint32 nEnd)
+	{
+		if (m_StorageMode == MESHSTORAGEMODE_SOA) {
+			for (nfUint32 j = 0; j < 3; j++)
+				if (fnMeshKernelExceedsLimit(m_pNodeBuffer->m_Coordinates[j].data() + nStart, nEnd - nStart, NMR_MESH_MAXCOORDINATE))
+					return true;
+			return false;
+		}
+		if (m_StorageMode == MESHSTORAGEMODE_QUANTIZED) {
+			std::vector<nfFloat> Coordinates((size_t)std::min(nEnd - nStart, (nfUint32)NMR_MESH_MERGEBATCHSIZE) * 3);
+			for (nfUint32 nIdx = nStart; nIdx < nEnd; nIdx += NMR_MESH_MERGEBATCHSIZE) {
+				nfUint32 nBatchCount = std::min(nEnd - nIdx, (nfUint32)NMR_MESH_MERGEBATCHSIZE);
+				dequantizeNodes(nIdx, nBatchCount, Coordinates.data());
+				if (fnMeshKernelExceedsLimit(Coordinates.data(), (size_t)nBatchCount * 3, NMR_MESH_MAXCOORDINATE))
+					return true;
+			}
+			return false;
+		}
+
+		nfUint32 nIdx = nStart;
+		while (nIdx < nEnd) {
+			nfUint32 nContiguousCount;
+			MESHNODE * pNodes = m_Nodes.getRange(nIdx, nContiguousCount);
+			nContiguousCount = std::min(nContiguousCount, nEnd - nIdx);
+
+			if (fnMeshKernelExceedsLimit(pNodes->m_position.m_fields, (size_t)nContiguousCount * 3, NMR_MESH_MAXCOORDINATE))
+				return true;
+			nIdx += nContiguousCount;
+		}
+		return false;
+	}
+
+	nfBool CMesh::hasInvalidFaces(_In_ nfUint32 nStart, _In_ nfUint32 nEnd, _In_ nfUint32 nNodeCount)
+	{
+		if (m_StorageMode != MESHSTORAGEMODE_PAGED)
+			return fnMeshKernelHasInvalidFaces(m_pFaceBuffer->m_NodeIndices.data() + (size_t)nStart * 3, nEnd - nStart, nNodeCount);
+
+		nfUint32 nIdx = nStart;
+		while (nIdx < nEnd) {
+			nfUint32 nContiguousCount;
+			MESHFACE * pFaces = m_Faces.getRange(nIdx, nContiguousCount);
+			nContiguousCount = std::min(nContiguousCount, nEnd - nIdx);
+
+			if (fnMeshKernelHasInvalidFaces(pFaces->m_nodeindices, nContiguousCount, nNodeCount))
+				return true;
+			nIdx += nContiguousCount;
+		}
+		return false;
+	}
+
 	void CMesh::clear()
 	{
 		m_pMeshInformationHandler.reset();
+		m_OutboxCache.invalidate();
 		m_Faces.clearAllData();
 		m_Nodes.clearAllData();
+		m_pArena.reset();
+		resetBuffers();
 		clearBeamLattice();
 	}
 	
@@ -438,13 +1709,15 @@ namespace NMR {
 						throw CNMRException(NMR_ERROR_UNKNOWNMODELRESOURCE);
 					pDefaultData->m_nResourceID = nNewResourceID;
 				}
+				// Face records are only written if they change, so that they stay shared with the source mesh otherwise
 				for (NMR::nfUint32 nFaceIndex = 0; nFaceIndex < this->getFaceCount(); nFaceIndex++) {
-					NMR::MESHINFORMATION_PROPERTIES * pFaceData = (NMR::MESHINFORMATION_PROPERTIES*)pProperties->getFaceData(nFaceIndex);
+					const NMR::MESHINFORMATION_PROPERTIES * pFaceData = (const NMR::MESHINFORMATION_PROPERTIES*)pProperties->readFaceData(nFaceIndex);
 					if (pFaceData && pFaceData->m_nResourceID != 0) {
 						NMR::PackageResourceID nNewResourceID = oldToNewMapping[pFaceData->m_nResourceID];
 						if (nNewResourceID == 0)
 							throw CNMRException(NMR_ERROR_UNKNOWNMODELRESOURCE);
-						pFaceData->m_nResourceID = nNewResourceID;
+						if (nNewResourceID != pFaceData->m_nResourceID)
+							((NMR::MESHINFORMATION_PROPERTIES*)pProperties->getFaceData(nFaceIndex))->m_nResourceID = nNewResourceID;
 					}
 				}
 			}
@@ -466,15 +1739,98 @@ namespace NMR {
 
 	void CMesh::extendOutbox(_Out_ NOUTBOX3& vOutBox, _In_ const NMATRIX3 mAccumulatedMatrix)
 	{
-		if (fnMATRIX3_isIdentity(mAccumulatedMatrix)) {
-			for (nfUint32 iNode = 0; iNode < getNodeCount(); iNode++) {
-				fnOutboxMergeVector(vOutBox, getNode(iNode)->m_position);
+		if (getNodeCount() == 0)
+			return;
+
+		if (CMeshOutboxCache::isAxisAligned(mAccumulatedMatrix)) {
+			NOUTBOX3 oLocalOutbox;
+			if (!m_OutboxCache.getLocalOutbox(oLocalOutbox)) {
+				fnOutboxInitialize(oLocalOutbox);
+				mergeAllNodeBounds(oLocalOutbox, fnMATRIX3_identity());
+				m_OutboxCache.setLocalOutbox(oLocalOutbox);
 			}
+			m_OutboxCache.mergeLocalOutbox(mAccumulatedMatrix, vOutBox);
+			return;
 		}
-		else {
-			for (nfUint32 iNode = 0; iNode < getNodeCount(); iNode++) {
-				fnOutboxMergeVector(vOutBox, fnMATRIX3_apply(mAccumulatedMatrix, getNode(iNode)->m_position));
+
+		if (m_OutboxCache.mergeHullPoints(mAccumulatedMatrix, vOutBox))
+			return;
+		if (m_OutboxCache.countFullQuery()) {
+			m_OutboxCache.buildHullPoints(this);
+			if (m_OutboxCache.mergeHullPoints(mAccumulatedMatrix, vOutBox))
+				return;
+		}
+
+		mergeAllNodeBounds(vOutBox, mAccumulatedMatrix);
+	}
+
+	void CMesh::mergeAllNodeBounds(_Inout_ NOUTBOX3 & oOutbox, _In_ const NMATRIX3 & mMatrix)
+	{
+		nfUint32 nNodeCount = getNodeCount();
+		nfUint32 nChunkCount = fnParallelGetChunkCount(nNodeCount, NMR_MESH_PARALLELCHUNKSIZE);
+		if (nChunkCount == 0)
+			return;
+
+		nfBool bTransform = !fnMATRIX3_isIdentity(mMatrix);
+
+		// Every chunk starts with the given box, so merging the chunk boxes equals a single pass
+		std::vector<NOUTBOX3> ChunkOutboxes(nChunkCount, oOutbox);
+		fnParallelForChunks(nChunkCount, [&](nfUint32 nChunkIndex) {
+			nfUint32 nStart = (nfUint32)fnParallelGetChunkStart(nNodeCount, nChunkCount, nChunkIndex);
+			nfUint32 nEnd = (nfUint32)fnParallelGetChunkStart(nNodeCount, nChunkCount, nChunkIndex + 1);
+			mergeNodeBounds(nStart, nEnd, mMatrix, bTransform, ChunkOutboxes[nChunkIndex]);
+		});
+
+		for (auto iOutbox = ChunkOutboxes.begin(); iOutbox != ChunkOutboxes.end(); iOutbox++) {
+			for (nfUint32 j = 0; j < 3; j++) {
+				oOutbox.m_min.m_fields[j] = std::min(oOutbox.m_min.m_fields[j], iOutbox->m_min.m_fields[j]);
+				oOutbox.m_max.m_fields[j] = std::max(oOutbox.m_max.m_fields[j], iOutbox->m_max.m_fields[j]);
+			}
+		}
+	}
+
+	void CMesh::mergeNodeBounds(_In_ nfUint32 nStart, _In_ nfUint32 nEnd, _In_ const NMATRIX3 & mMatrix, _In_ nfBool bTransform, _Inout_ NOUTBOX3 & oOutbox)
+	{
+		if (m_StorageMode == MESHSTORAGEMODE_SOA) {
+			const nfFloat * pX = m_pNodeBuffer->m_Coordinates[0].data() + nStart;
+			const nfFloat * pY = m_pNodeBuffer->m_Coordinates[1].data() + nStart;
+			const nfFloat * pZ = m_pNodeBuffer->m_Coordinates[2].data() + nStart;
+			if (bTransform) {
+				fnMeshKernelMergeTransformedBounds(pX, pY, pZ, 1, nEnd - nStart, mMatrix, oOutbox);
 			}
+			else {
+				fnMeshKernelMergeAxisBounds(pX, nEnd - nStart, oOutbox.m_min.m_fields[0], oOutbox.m_max.m_fields[0]);
+				fnMeshKernelMergeAxisBounds(pY, nEnd - nStart, oOutbox.m_min.m_fields[1], oOutbox.m_max.m_fields[1]);
+				fnMeshKernelMergeAxisBounds(pZ, nEnd - nStart, oOutbox.m_min.m_fields[2], oOutbox.m_max.m_fields[2]);
+			}
+			return;
+		}
+		if (m_StorageMode == MESHSTORAGEMODE_QUANTIZED) {
+			std::vector<nfFloat> Coordinates((size_t)std::min(nEnd - nStart, (nfUint32)NMR_MESH_MERGEBATCHSIZE) * 3);
+			for (nfUint32 nIdx = nStart; nIdx < nEnd; nIdx += NMR_MESH_MERGEBATCHSIZE) {
+				nfUint32 nBatchCount = std::min(nEnd - nIdx, (nfUint32)NMR_MESH_MERGEBATCHSIZE);
+				dequantizeNodes(nIdx, nBatchCount, Coordinates.data());
+				const nfFloat * pCoordinates = Coordinates.data();
+				if (bTransform)
+					fnMeshKernelMergeTransformedBounds(pCoordinates, pCoordinates + 1, pCoordinates + 2, 3, nBatchCount, mMatrix, oOutbox);
+				else
+					fnMeshKernelMergeBounds(pCoordinates, nBatchCount, oOutbox);
+			}
+			return;
+		}
+
+		nfUint32 nIdx = nStart;
+		while (nIdx < nEnd) {
+			nfUint32 nContiguousCount;
+			MESHNODE * pNodes = m_Nodes.getRange(nIdx, nContiguousCount);
+			nContiguousCount = std::min(nContiguousCount, nEnd - nIdx);
+
+			const nfFloat * pCoordinates = pNodes->m_position.m_fields;
+			if (bTransform)
+				fnMeshKernelMergeTransformedBounds(pCoordinates, pCoordinates + 1, pCoordinates + 2, 3, nContiguousCount, mMatrix, oOutbox);
+			else
+				fnMeshKernelMergeBounds(pCoordinates, nContiguousCount, oOutbox);
+			nIdx += nContiguousCount;
 		}
 	}
 }
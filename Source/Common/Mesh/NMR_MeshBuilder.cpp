@@ -92,32 +92,32 @@ namespace NMR {
 		if (!pMesh)
 			throw CNMRException(NMR_ERROR_INVALIDPARAM);
 
-		std::vector<MESHNODE *> pNodes;
+		std::vector<nfUint32> NodeIndices;
 
 		nfUint32 nNodeCount = m_Nodes.getCount();
 		nfUint32 nFaceCount = m_Faces.getCount();
-		pNodes.resize(nNodeCount);
+		NodeIndices.resize(nNodeCount);
 
 		for (nIdx = 0; nIdx < nNodeCount; nIdx++) {
 			NVEC3 * pPosition = m_Nodes.getData(nIdx);
-			pNodes[nIdx] = pMesh->addNode(*pPosition);
+			NodeIndices[nIdx] = pMesh->appendNode(*pPosition);
 		}
 
 		for (nIdx = 0; nIdx < nFaceCount; nIdx++) {
 			NVEC3I * pFaceVec = m_Faces.getData(nIdx);		
-			MESHNODE * pNewNodes[3];
+			nfUint32 NewIndices[3];
 
 			for (j = 0; j < 3; j++) {
-				pNewNodes[j] = pNodes[pFaceVec->m_fields[j]];
+				NewIndices[j] = NodeIndices[pFaceVec->m_fields[j]];
 			}
 
-			if ((pNewNodes[0] == pNewNodes[1]) || (pNewNodes[0] == pNewNodes[2]) || (pNewNodes[1] == pNewNodes[2])) {
+			if ((NewIndices[0] == NewIndices[1]) || (NewIndices[0] == NewIndices[2]) || (NewIndices[1] == NewIndices[2])) {
 				if (!bIgnoreInvalidFaces)
 					throw CNMRException(NMR_ERROR_DUPLICATENODE);
 
 			}
 			else {
-				pMesh->addFace(pNewNodes[0], pNewNodes[1], pNewNodes[2]);
+				pMesh->appendFace(NewIndices[0], NewIndices[1], NewIndices[2]);
 			}
 		}
 	}
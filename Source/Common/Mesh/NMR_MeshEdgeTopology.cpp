@@ -0,0 +1,222 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_MeshEdgeTopology.cpp implements the class CMeshEdgeTopology.
+
+--*/
+
+#include "Common/Mesh/NMR_MeshEdgeTopology.h"
+#include "Common/Mesh/NMR_MeshTypes.h"
+#include "Common/NMR_Exception.h"
+#include "Common/NMR_ParallelFor.h"
+
+#include <algorithm>
+
+namespace NMR {
+
+	// Sorts the keys by their lowest nKeyBits bits. Every pass is a stable counting sort of one digit,
+	// chunks count and scatter their keys in parallel, and the offsets keep the chunks in order.
+	static void fnMeshEdgeTopologyRadixSort(_Inout_ std::vector<nfUint64> & Keys, _In_ nfUint32 nKeyBits)
+	{
+		const size_t nDigitCount = (size_t)1 << NMR_MESHEDGETOPOLOGY_RADIXBITS;
+		const nfUint64 nDigitMask = nDigitCount - 1;
+
+		nfUint64 nCount = Keys.size();
+		nfUint32 nChunkCount = fnParallelGetChunkCount(nCount, NMR_MESH_PARALLELCHUNKSIZE);
+		if (nChunkCount == 0)
+			return;
+
+		std::vector<nfUint64> SortedKeys(nCount);
+		std::vector<size_t> Offsets(nChunkCount * nDigitCount);
+
+		for (nfUint32 nShift = 0; nShift < nKeyBits; nShift += NMR_MESHEDGETOPOLOGY_RADIXBITS) {
+			fnParallelForChunks(nChunkCount, [&](nfUint32 nChunkIndex) {
+				size_t nEnd = (size_t)fnParallelGetChunkStart(nCount, nChunkCount, nChunkIndex + 1);
+				size_t * pCounts = &Offsets[nChunkIndex * nDigitCount];
+				std::fill(pCounts, pCounts + nDigitCount, 0);
+				for (size_t nIndex = (size_t)fnParallelGetChunkStart(nCount, nChunkCount, nChunkIndex); nIndex < nEnd; nIndex++)
+					pCounts[(Keys[nIndex] >> nShift) & nDigitMask]++;
+			});
+
+			size_t nOffset = 0;
+			for (size_t nDigit = 0; nDigit < nDigitCount; nDigit++) {
+				for (nfUint32 nChunkIndex = 0; nChunkIndex < nChunkCount; nChunkIndex++) {
+					size_t & nChunkOffset = Offsets[nChunkIndex * nDigitCount + nDigit];
+					size_t nDigitKeyCount = nChunkOffset;
+					nChunkOffset = nOffset;
+					nOffset += nDigitKeyCount;
+				}
+			}
+
+			fnParallelForChunks(nChunkCount, [&](nfUint32 nChunkIndex) {
+				size_t nEnd = (size_t)fnParallelGetChunkStart(nCount, nChunkCount, nChunkIndex + 1);
+				size_t * pOffsets = &Offsets[nChunkIndex * nDigitCount];
+				for (size_t nIndex = (size_t)fnParallelGetChunkStart(nCount, nChunkCount, nChunkIndex); nIndex < nEnd; nIndex++) {
+					nfUint64 nKey = Keys[nIndex];
+					SortedKeys[pOffsets[(nKey >> nShift) & nDigitMask]++] = nKey;
+				}
+			});
+
+			Keys.swap(SortedKeys);
+		}
+	}
+
+	CMeshEdgeTopology::CMeshEdgeTopology(_In_ CMesh * pMesh)
+		: m_nBoundaryEdgeCount(0), m_nNonManifoldEdgeCount(0), m_nMisorientedEdgeCount(0)
+	{
+		if (!pMesh)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		nfUint32 nNodeCount = pMesh->getNodeCount();
+		nfUint32 nFaceCount = pMesh->getFaceCount();
+
+		// A key holds the smaller node index, the larger node index and the direction in its lowest bit
+		nfUint32 nNodeBits = 1;
+		while ((nNodeBits < 31) && ((nfUint64)nNodeCount > (1ull << nNodeBits)))
+			nNodeBits++;
+		nfUint32 nKeyBits = 2 * nNodeBits + 1;
+
+		nfUint64 nHalfEdgeCount = (nfUint64)nFaceCount * 3;
+		std::vector<nfUint64> Keys((size_t)nHalfEdgeCount);
+
+		nfUint32 nChunkCount = fnParallelGetChunkCount(nFaceCount, NMR_MESH_PARALLELCHUNKSIZE);
+		std::vector<nfUint32> ChunkHasInvalidNodes(nChunkCount, 0);
+		fnParallelForChunks(nChunkCount, [&](nfUint32 nChunkIndex) {
+			nfUint32 nFaceIndex = (nfUint32)fnParallelGetChunkStart(nFaceCount, nChunkCount, nChunkIndex);
+			nfUint32 nFaceEnd = (nfUint32)fnParallelGetChunkStart(nFaceCount, nChunkCount, nChunkIndex + 1);
+			std::vector<nfInt32> NodeIndices((size_t)std::min(nFaceEnd - nFaceIndex, (nfUint32)NMR_MESHEDGETOPOLOGY_FACEBATCHSIZE) * 3);
+			nfUint64 * pKey = &Keys[(size_t)nFaceIndex * 3];
+			nfUint32 nInvalid = 0;
+
+			while (nFaceIndex < nFaceEnd) {
+				nfUint32 nBatchCount = std::min(nFaceEnd - nFaceIndex, (nfUint32)NMR_MESHEDGETOPOLOGY_FACEBATCHSIZE);
+				pMesh->copyFaceNodeIndices(nFaceIndex, nBatchCount, NodeIndices.data());
+
+				for (nfUint32 nIndex = 0; nIndex < nBatchCount * 3; nIndex++) {
+					nfUint32 nNodeIndex1 = (nfUint32)NodeIndices[nIndex];
+					nfUint32 nNodeIndex2 = (nfUint32)NodeIndices[(nIndex % 3 == 2) ? nIndex - 2 : nIndex + 1];
+					nInvalid |= (nNodeIndex1 >= nNodeCount);
+
+					nfUint64 nSmaller = std::min(nNodeIndex1, nNodeIndex2);
+					nfUint64 nLarger = std::max(nNodeIndex1, nNodeIndex2);
+					*pKey++ = (nSmaller << (nNodeBits + 1)) | (nLarger << 1) | (nNodeIndex1 > nNodeIndex2 ? 1 : 0);
+				}
+				nFaceIndex += nBatchCount;
+			}
+
+			ChunkHasInvalidNodes[nChunkIndex] = nInvalid;
+		});
+
+		if (std::find(ChunkHasInvalidNodes.begin(), ChunkHasInvalidNodes.end(), 1u) != ChunkHasInvalidNodes.end())
+			throw CNMRException(NMR_ERROR_INVALIDNODEINDEX);
+
+		fnMeshEdgeTopologyRadixSort(Keys, nKeyBits);
+
+		// Equal edges are adjacent now, negative half-edges follow the positive ones
+		const nfUint64 nNodeMask = (1ull << nNodeBits) - 1;
+		size_t nIndex = 0;
+		while (nIndex < Keys.size()) {
+			nfUint64 nEdgeKey = Keys[nIndex] >> 1;
+			MESHTOPOLOGYEDGE Edge;
+			Edge.m_nodeindices[0] = (nfInt32)(nEdgeKey >> nNodeBits);
+			Edge.m_nodeindices[1] = (nfInt32)(nEdgeKey & nNodeMask);
+			Edge.m_nPositiveCount = 0;
+			Edge.m_nNegativeCount = 0;
+
+			for (; (nIndex < Keys.size()) && ((Keys[nIndex] >> 1) == nEdgeKey); nIndex++) {
+				if (Keys[nIndex] & 1)
+					Edge.m_nNegativeCount++;
+				else
+					Edge.m_nPositiveCount++;
+			}
+
+			if (m_Edges.size() >= NMR_MESH_MAXEDGECOUNT)
+				throw CNMRException(NMR_ERROR_INVALIDEDGEINDEX);
+			m_Edges.push_back(Edge);
+
+			nfUint32 nFaceCountOfEdge = Edge.m_nPositiveCount + Edge.m_nNegativeCount;
+			if (nFaceCountOfEdge == 1)
+				m_nBoundaryEdgeCount++;
+			else if (nFaceCountOfEdge > 2)
+				m_nNonManifoldEdgeCount++;
+			else if (Edge.m_nPositiveCount != 1)
+				m_nMisorientedEdgeCount++;
+		}
+	}
+
+	nfUint32 CMeshEdgeTopology::getEdgeCount()
+	{
+		return (nfUint32)m_Edges.size();
+	}
+
+	const MESHTOPOLOGYEDGE & CMeshEdgeTopology::getEdge(_In_ nfUint32 nIdx)
+	{
+		if (nIdx >= m_Edges.size())
+			throw CNMRException(NMR_ERROR_INVALIDINDEX);
+		return m_Edges[nIdx];
+	}
+
+	nfUint32 CMeshEdgeTopology::getBoundaryEdgeCount()
+	{
+		return m_nBoundaryEdgeCount;
+	}
+
+	nfUint32 CMeshEdgeTopology::getNonManifoldEdgeCount()
+	{
+		return m_nNonManifoldEdgeCount;
+	}
+
+	nfUint32 CMeshEdgeTopology::getMisorientedEdgeCount()
+	{
+		return m_nMisorientedEdgeCount;
+	}
+
+	void CMeshEdgeTopology::getBoundaryEdges(_Out_ std::vector<nfUint32> & EdgeIndices)
+	{
+		EdgeIndices.clear();
+		EdgeIndices.reserve(m_nBoundaryEdgeCount);
+		for (nfUint32 nIdx = 0; nIdx < getEdgeCount(); nIdx++)
+			if (m_Edges[nIdx].m_nPositiveCount + m_Edges[nIdx].m_nNegativeCount == 1)
+				EdgeIndices.push_back(nIdx);
+	}
+
+	void CMeshEdgeTopology::getNonManifoldEdges(_Out_ std::vector<nfUint32> & EdgeIndices)
+	{
+		EdgeIndices.clear();
+		EdgeIndices.reserve(m_nNonManifoldEdgeCount);
+		for (nfUint32 nIdx = 0; nIdx < getEdgeCount(); nIdx++)
+			if (m_Edges[nIdx].m_nPositiveCount + m_Edges[nIdx].m_nNegativeCount > 2)
+				EdgeIndices.push_back(nIdx);
+	}
+
+	nfBool CMeshEdgeTopology::isManifoldAndOriented()
+	{
+		return (m_nBoundaryEdgeCount == 0) && (m_nNonManifoldEdgeCount == 0) && (m_nMisorientedEdgeCount == 0);
+	}
+
+}
@@ -0,0 +1,315 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_MeshKernels.cpp implements the inner loops of the mesh validation, bounding box
+computation and node transformation.
+
+The SSE2 paths give the same results as the scalar loops. Minima and maxima keep the
+accumulator as second operand, which ignores NaN values like std::min and std::max do,
+and transformations add up in the order of fnMATRIX3_apply.
+
+--*/
+
+#include "Common/Mesh/NMR_MeshKernels.h"
+#include "Common/Mesh/NMR_MeshTypes.h"
+#include "Common/Math/NMR_Matrix.h"
+#include "Common/Math/NMR_Vector.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+#define __NMR_MESHKERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace NMR {
+
+#ifdef __NMR_MESHKERNELS_SSE2
+
+	// Folds the lanes of minimum and maximum registers into scalars
+	static void fnMeshKernelFoldLanes(_In_ __m128 vMin, _In_ __m128 vMax, _Inout_ nfFloat & fMin, _Inout_ nfFloat & fMax)
+	{
+		nfFloat aMin[4];
+		nfFloat aMax[4];
+		_mm_storeu_ps(aMin, vMin);
+		_mm_storeu_ps(aMax, vMax);
+		for (nfUint32 nLane = 0; nLane < 4; nLane++) {
+			fMin = std::min(fMin, aMin[nLane]);
+			fMax = std::max(fMax, aMax[nLane]);
+		}
+	}
+
+#endif // __NMR_MESHKERNELS_SSE2
+
+	nfBool fnMeshKernelExceedsLimit(_In_ const nfFloat * pValues, _In_ size_t nCount, _In_ nfFloat fLimit)
+	{
+		size_t nIndex = 0;
+		nfBool bExceeds = false;
+
+#ifdef __NMR_MESHKERNELS_SSE2
+		const __m128 vAbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+		const __m128 vLimit = _mm_set1_ps(fLimit);
+		__m128 vExceeds = _mm_setzero_ps();
+		for (; nIndex + 4 <= nCount; nIndex += 4) {
+			__m128 vValues = _mm_and_ps(_mm_loadu_ps(&pValues[nIndex]), vAbsMask);
+			vExceeds = _mm_or_ps(vExceeds, _mm_cmpgt_ps(vValues, vLimit));
+		}
+		bExceeds = (_mm_movemask_ps(vExceeds) != 0);
+#endif // __NMR_MESHKERNELS_SSE2
+
+		for (; nIndex < nCount; nIndex++)
+			bExceeds = bExceeds || (fabs(pValues[nIndex]) > fLimit);
+
+		return bExceeds;
+	}
+
+	nfBool fnMeshKernelHasInvalidFaces(_In_ const nfInt32 * pNodeIndices, _In_ size_t nFaceCount, _In_ nfUint32 nNodeCount)
+	{
+		// Node counts do not exceed NMR_MESH_MAXNODECOUNT, so signed comparisons suffice
+		nfInt32 nMaxIndex = (nfInt32)std::min(nNodeCount, (nfUint32)NMR_MESH_MAXNODECOUNT) - 1;
+		size_t nFace = 0;
+		nfUint32 nInvalid = 0;
+
+#ifdef __NMR_MESHKERNELS_SSE2
+		const __m128i vZero = _mm_setzero_si128();
+		const __m128i vMaxIndex = _mm_set1_epi32(nMaxIndex);
+		__m128i vInvalid = _mm_setzero_si128();
+		for (; nFace + 4 <= nFaceCount; nFace += 4) {
+			// Transpose four faces into their first, second and third node indices
+			const nfInt32 * pIndices = &pNodeIndices[nFace * 3];
+			__m128i vIndex1 = _mm_setr_epi32(pIndices[0], pIndices[3], pIndices[6], pIndices[9]);
+			__m128i vIndex2 = _mm_setr_epi32(pIndices[1], pIndices[4], pIndices[7], pIndices[10]);
+			__m128i vIndex3 = _mm_setr_epi32(pIndices[2], pIndices[5], pIndices[8], pIndices[11]);
+
+			vInvalid = _mm_or_si128(vInvalid, _mm_or_si128(_mm_cmplt_epi32(vIndex1, vZero), _mm_cmpgt_epi32(vIndex1, vMaxIndex)));
+			vInvalid = _mm_or_si128(vInvalid, _mm_or_si128(_mm_cmplt_epi32(vIndex2, vZero), _mm_cmpgt_epi32(vIndex2, vMaxIndex)));
+			vInvalid = _mm_or_si128(vInvalid, _mm_or_si128(_mm_cmplt_epi32(vIndex3, vZero), _mm_cmpgt_epi32(vIndex3, vMaxIndex)));
+			vInvalid = _mm_or_si128(vInvalid, _mm_cmpeq_epi32(vIndex1, vIndex2));
+			vInvalid = _mm_or_si128(vInvalid, _mm_cmpeq_epi32(vIndex1, vIndex3));
+			vInvalid = _mm_or_si128(vInvalid, _mm_cmpeq_epi32(vIndex2, vIndex3));
+		}
+		nInvalid = (_mm_movemask_epi8(vInvalid) != 0);
+#endif // __NMR_MESHKERNELS_SSE2
+
+		for (; nFace < nFaceCount; nFace++) {
+			const nfInt32 * pIndices = &pNodeIndices[nFace * 3];
+			nInvalid |= (pIndices[0] < 0) | (pIndices[0] > nMaxIndex);
+			nInvalid |= (pIndices[1] < 0) | (pIndices[1] > nMaxIndex);
+			nInvalid |= (pIndices[2] < 0) | (pIndices[2] > nMaxIndex);
+			nInvalid |= (pIndices[0] == pIndices[1]) | (pIndices[0] == pIndices[2]) | (pIndices[1] == pIndices[2]);
+		}
+
+		return (nInvalid != 0);
+	}
+
+	void fnMeshKernelMergeAxisBounds(_In_ const nfFloat * pValues, _In_ size_t nCount, _Inout_ nfFloat & fMin, _Inout_ nfFloat & fMax)
+	{
+		size_t nIndex = 0;
+
+#ifdef __NMR_MESHKERNELS_SSE2
+		if (nCount >= 4) {
+			__m128 vMin = _mm_set1_ps(fMin);
+			__m128 vMax = _mm_set1_ps(fMax);
+			for (; nIndex + 4 <= nCount; nIndex += 4) {
+				__m128 vValues = _mm_loadu_ps(&pValues[nIndex]);
+				vMin = _mm_min_ps(vValues, vMin);
+				vMax = _mm_max_ps(vValues, vMax);
+			}
+			fnMeshKernelFoldLanes(vMin, vMax, fMin, fMax);
+		}
+#endif // __NMR_MESHKERNELS_SSE2
+
+		for (; nIndex < nCount; nIndex++) {
+			fMin = std::min(fMin, pValues[nIndex]);
+			fMax = std::max(fMax, pValues[nIndex]);
+		}
+	}
+
+	void fnMeshKernelMergeBounds(_In_ const nfFloat * pCoordinates, _In_ size_t nCount, _Inout_ NOUTBOX3 & oOutbox)
+	{
+		size_t nIndex = 0;
+
+#ifdef __NMR_MESHKERNELS_SSE2
+		if (nCount >= 4) {
+			// Four positions fill three registers, lane k of the three registers holds axis k % 3
+			nfFloat * pMin = oOutbox.m_min.m_fields;
+			nfFloat * pMax = oOutbox.m_max.m_fields;
+			nfFloat aMin[12], aMax[12];
+			for (nfUint32 nLane = 0; nLane < 12; nLane++) {
+				aMin[nLane] = pMin[nLane % 3];
+				aMax[nLane] = pMax[nLane % 3];
+			}
+
+			__m128 vMin[3], vMax[3];
+			for (nfUint32 nRegister = 0; nRegister < 3; nRegister++) {
+				vMin[nRegister] = _mm_loadu_ps(&aMin[nRegister * 4]);
+				vMax[nRegister] = _mm_loadu_ps(&aMax[nRegister * 4]);
+			}
+
+			for (; nIndex + 4 <= nCount; nIndex += 4) {
+				const nfFloat * pValues = &pCoordinates[nIndex * 3];
+				for (nfUint32 nRegister = 0; nRegister < 3; nRegister++) {
+					__m128 vValues = _mm_loadu_ps(&pValues[nRegister * 4]);
+					vMin[nRegister] = _mm_min_ps(vValues, vMin[nRegister]);
+					vMax[nRegister] = _mm_max_ps(vValues, vMax[nRegister]);
+				}
+			}
+
+			for (nfUint32 nRegister = 0; nRegister < 3; nRegister++) {
+				_mm_storeu_ps(&aMin[nRegister * 4], vMin[nRegister]);
+				_mm_storeu_ps(&aMax[nRegister * 4], vMax[nRegister]);
+			}
+			for (nfUint32 nLane = 0; nLane < 12; nLane++) {
+				pMin[nLane % 3] = std::min(pMin[nLane % 3], aMin[nLane]);
+				pMax[nLane % 3] = std::max(pMax[nLane % 3], aMax[nLane]);
+			}
+		}
+#endif // __NMR_MESHKERNELS_SSE2
+
+		for (; nIndex < nCount; nIndex++) {
+			for (nfUint32 nAxis = 0; nAxis < 3; nAxis++) {
+				nfFloat fValue = pCoordinates[nIndex * 3 + nAxis];
+				oOutbox.m_min.m_fields[nAxis] = std::min(oOutbox.m_min.m_fields[nAxis], fValue);
+				oOutbox.m_max.m_fields[nAxis] = std::max(oOutbox.m_max.m_fields[nAxis], fValue);
+			}
+		}
+	}
+
+	void fnMeshKernelMergeTransformedBounds(_In_ const nfFloat * pX, _In_ const nfFloat * pY, _In_ const nfFloat * pZ, _In_ size_t nStride,
+		_In_ size_t nCount, _In_ const NMATRIX3 & mMatrix, _Inout_ NOUTBOX3 & oOutbox)
+	{
+		size_t nIndex = 0;
+
+#ifdef __NMR_MESHKERNELS_SSE2
+		if (nCount >= 4) {
+			__m128 vMatrix[3][4];
+			__m128 vMin[3], vMax[3];
+			for (nfUint32 nAxis = 0; nAxis < 3; nAxis++) {
+				for (nfUint32 nColumn = 0; nColumn < 4; nColumn++)
+					vMatrix[nAxis][nColumn] = _mm_set1_ps(mMatrix.m_fields[nAxis][nColumn]);
+				vMin[nAxis] = _mm_set1_ps(oOutbox.m_min.m_fields[nAxis]);
+				vMax[nAxis] = _mm_set1_ps(oOutbox.m_max.m_fields[nAxis]);
+			}
+
+			for (; nIndex + 4 <= nCount; nIndex += 4) {
+				size_t nOffset = nIndex * nStride;
+				__m128 vX, vY, vZ;
+				if (nStride == 1) {
+					vX = _mm_loadu_ps(&pX[nOffset]);
+					vY = _mm_loadu_ps(&pY[nOffset]);
+					vZ = _mm_loadu_ps(&pZ[nOffset]);
+				}
+				else {
+					vX = _mm_setr_ps(pX[nOffset], pX[nOffset + nStride], pX[nOffset + 2 * nStride], pX[nOffset + 3 * nStride]);
+					vY = _mm_setr_ps(pY[nOffset], pY[nOffset + nStride], pY[nOffset + 2 * nStride], pY[nOffset + 3 * nStride]);
+					vZ = _mm_setr_ps(pZ[nOffset], pZ[nOffset + nStride], pZ[nOffset + 2 * nStride], pZ[nOffset + 3 * nStride]);
+				}
+
+				for (nfUint32 nAxis = 0; nAxis < 3; nAxis++) {
+					__m128 vValues = _mm_add_ps(_mm_mul_ps(vMatrix[nAxis][0], vX), _mm_mul_ps(vMatrix[nAxis][1], vY));
+					vValues = _mm_add_ps(_mm_add_ps(vValues, _mm_mul_ps(vMatrix[nAxis][2], vZ)), vMatrix[nAxis][3]);
+					vMin[nAxis] = _mm_min_ps(vValues, vMin[nAxis]);
+					vMax[nAxis] = _mm_max_ps(vValues, vMax[nAxis]);
+				}
+			}
+
+			for (nfUint32 nAxis = 0; nAxis < 3; nAxis++)
+				fnMeshKernelFoldLanes(vMin[nAxis], vMax[nAxis], oOutbox.m_min.m_fields[nAxis], oOutbox.m_max.m_fields[nAxis]);
+		}
+#endif // __NMR_MESHKERNELS_SSE2
+
+		for (; nIndex < nCount; nIndex++) {
+			size_t nOffset = nIndex * nStride;
+			NVEC3 vPosition = fnMATRIX3_apply(mMatrix, fnVEC3_make(pX[nOffset], pY[nOffset], pZ[nOffset]));
+			for (nfUint32 nAxis = 0; nAxis < 3; nAxis++) {
+				oOutbox.m_min.m_fields[nAxis] = std::min(oOutbox.m_min.m_fields[nAxis], vPosition.m_fields[nAxis]);
+				oOutbox.m_max.m_fields[nAxis] = std::max(oOutbox.m_max.m_fields[nAxis], vPosition.m_fields[nAxis]);
+			}
+		}
+	}
+
+	void fnMeshKernelTransformPositions(_In_ const nfFloat * pX, _In_ const nfFloat * pY, _In_ const nfFloat * pZ, _In_ size_t nStride,
+		_In_ size_t nCount, _In_ const NMATRIX3 & mMatrix, _Out_ nfFloat * pTarget)
+	{
+		size_t nIndex = 0;
+
+#ifdef __NMR_MESHKERNELS_SSE2
+		if (nCount >= 4) {
+			__m128 vMatrix[3][4];
+			for (nfUint32 nAxis = 0; nAxis < 3; nAxis++) {
+				for (nfUint32 nColumn = 0; nColumn < 4; nColumn++)
+					vMatrix[nAxis][nColumn] = _mm_set1_ps(mMatrix.m_fields[nAxis][nColumn]);
+			}
+
+			for (; nIndex + 4 <= nCount; nIndex += 4) {
+				size_t nOffset = nIndex * nStride;
+				__m128 vX, vY, vZ;
+				if (nStride == 1) {
+					vX = _mm_loadu_ps(&pX[nOffset]);
+					vY = _mm_loadu_ps(&pY[nOffset]);
+					vZ = _mm_loadu_ps(&pZ[nOffset]);
+				}
+				else {
+					vX = _mm_setr_ps(pX[nOffset], pX[nOffset + nStride], pX[nOffset + 2 * nStride], pX[nOffset + 3 * nStride]);
+					vY = _mm_setr_ps(pY[nOffset], pY[nOffset + nStride], pY[nOffset + 2 * nStride], pY[nOffset + 3 * nStride]);
+					vZ = _mm_setr_ps(pZ[nOffset], pZ[nOffset + nStride], pZ[nOffset + 2 * nStride], pZ[nOffset + 3 * nStride]);
+				}
+
+				__m128 vResult[3];
+				for (nfUint32 nAxis = 0; nAxis < 3; nAxis++) {
+					__m128 vValues = _mm_add_ps(_mm_mul_ps(vMatrix[nAxis][0], vX), _mm_mul_ps(vMatrix[nAxis][1], vY));
+					vResult[nAxis] = _mm_add_ps(_mm_add_ps(vValues, _mm_mul_ps(vMatrix[nAxis][2], vZ)), vMatrix[nAxis][3]);
+				}
+
+				// Interleave x0 x1 x2 x3, y0 .. y3 and z0 .. z3 into x0 y0 z0 x1, y1 z1 x2 y2 and z2 x3 y3 z3
+				__m128 vXYLow = _mm_unpacklo_ps(vResult[0], vResult[1]);
+				__m128 vXYHigh = _mm_unpackhi_ps(vResult[0], vResult[1]);
+				__m128 vZ0X1 = _mm_shuffle_ps(vResult[2], vXYLow, _MM_SHUFFLE(2, 2, 0, 0));
+				__m128 vY1Z1 = _mm_shuffle_ps(vXYLow, vResult[2], _MM_SHUFFLE(1, 1, 3, 3));
+				__m128 vZ2X3 = _mm_shuffle_ps(vResult[2], vXYHigh, _MM_SHUFFLE(2, 2, 2, 2));
+				__m128 vY3Z3 = _mm_shuffle_ps(vXYHigh, vResult[2], _MM_SHUFFLE(3, 3, 3, 3));
+
+				nfFloat * pOutput = &pTarget[nIndex * 3];
+				_mm_storeu_ps(&pOutput[0], _mm_shuffle_ps(vXYLow, vZ0X1, _MM_SHUFFLE(2, 0, 1, 0)));
+				_mm_storeu_ps(&pOutput[4], _mm_shuffle_ps(vY1Z1, vXYHigh, _MM_SHUFFLE(1, 0, 2, 0)));
+				_mm_storeu_ps(&pOutput[8], _mm_shuffle_ps(vZ2X3, vY3Z3, _MM_SHUFFLE(2, 0, 2, 0)));
+			}
+		}
+#endif // __NMR_MESHKERNELS_SSE2
+
+		for (; nIndex < nCount; nIndex++) {
+			size_t nOffset = nIndex * nStride;
+			NVEC3 vPosition = fnMATRIX3_apply(mMatrix, fnVEC3_make(pX[nOffset], pY[nOffset], pZ[nOffset]));
+			pTarget[nIndex * 3] = vPosition.m_fields[0];
+			pTarget[nIndex * 3 + 1] = vPosition.m_fields[1];
+			pTarget[nIndex * 3 + 2] = vPosition.m_fields[2];
+		}
+	}
+
+}
@@ -0,0 +1,75 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_MeshMappedStorage.cpp implements the CMeshMappedStorage Class.
+Mapped storage places the large node and face arrays of meshes in memory mapped temporary files,
+so that the operating system can page them out to disk instead of keeping them in memory.
+
+--*/
+
+#include "Common/Mesh/NMR_MeshMappedStorage.h"
+
+namespace NMR {
+
+	CMeshMappedStorage::CMeshMappedStorage(_In_ const std::wstring & sDirectory)
+		: m_sDirectory(sDirectory)
+	{
+	}
+
+	std::wstring CMeshMappedStorage::getDirectory()
+	{
+		return m_sDirectory;
+	}
+
+	_Ret_notnull_ void * CMeshMappedStorage::allocate(_In_ size_t cbSize)
+	{
+		PMappedTemporaryFile pFile = std::make_shared<CMappedTemporaryFile>(m_sDirectory, (nfUint64)cbSize);
+		void * pData = pFile->getData();
+
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_Files.insert(std::make_pair(pData, pFile));
+		return pData;
+	}
+
+	void CMeshMappedStorage::deallocate(_In_ void * pData)
+	{
+		PMappedTemporaryFile pFile;
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			auto iFile = m_Files.find(pData);
+			// Called from destructors, so unknown arrays are not reported
+			__NMRASSERT(iFile != m_Files.end());
+			if (iFile == m_Files.end())
+				return;
+			pFile = iFile->second;
+			m_Files.erase(iFile);
+		}
+		// The file is unmapped here, outside of the lock
+	}
+
+}
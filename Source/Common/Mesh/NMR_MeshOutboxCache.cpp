@@ -0,0 +1,579 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_MeshOutboxCache.cpp implements the class CMeshOutboxCache.
+
+--*/
+
+#include "Common/Mesh/NMR_MeshOutboxCache.h"
+#include "Common/Mesh/NMR_Mesh.h"
+#include "Common/Mesh/NMR_MeshKernels.h"
+#include "Common/Mesh/NMR_MeshTypes.h"
+#include "Common/Math/NMR_Vector.h"
+#include "Common/NMR_ParallelFor.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+#define NMR_MESHOUTBOXCACHE_CUBEDIRECTIONCOUNT 13
+#define NMR_MESHOUTBOXCACHE_SPHEREDIRECTIONCOUNT 64
+#define NMR_MESHOUTBOXCACHE_MAXTETRAHEDRONCOUNT 512
+// Directions are looked up in a grid of this many cells per side on each face of a cube
+#define NMR_MESHOUTBOXCACHE_DIRECTIONGRIDSIZE 16
+
+namespace NMR {
+
+	// The axes, the face diagonals and the space diagonals of a cube
+	static const double fnMeshOutboxCacheCubeDirections[NMR_MESHOUTBOXCACHE_CUBEDIRECTIONCOUNT][3] = {
+		{ 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+		{ 1, 1, 0 }, { 1, -1, 0 }, { 1, 0, 1 }, { 1, 0, -1 }, { 0, 1, 1 }, { 0, 1, -1 },
+		{ 1, 1, 1 }, { 1, 1, -1 }, { 1, -1, 1 }, { 1, -1, -1 }
+	};
+
+	typedef struct {
+		double m_dValue;
+		nfFloat m_fPosition[3];
+	} MESHOUTBOXEXTREME;
+
+	// Maps a position relative to the common apex to the barycentric coordinates of the three other corners
+	typedef struct {
+		double m_dInverse[3][3];
+	} MESHOUTBOXTETRAHEDRON;
+
+	// Convex hull of a few points, as a fan of tetrahedra around their centroid
+	typedef struct {
+		double m_dCenter[3];
+		// Squared radius of a ball around the centroid, which lies inside of the hull shrunk by the distance margin. 0 if unknown.
+		double m_dInnerRadiusSquared;
+		// Barycentric weight of the centroid, above which a position lies at least the distance margin inside of the hull
+		double m_dCenterMargin;
+		std::vector<MESHOUTBOXTETRAHEDRON> m_Tetrahedra;
+		// Tetrahedra whose cone around the centroid meets the directions of a grid cell, see fnMeshOutboxCacheGetCell.
+		// The tetrahedra of cell i are m_CellTetrahedra[m_CellOffsets[i], m_CellOffsets[i + 1]).
+		std::vector<nfUint32> m_CellOffsets;
+		std::vector<nfUint32> m_CellTetrahedra;
+	} MESHOUTBOXHULL;
+
+	// Copies the positions [nStart, nStart + nCount) as x, y and z triples
+	typedef std::function<void(nfUint32 nStart, nfUint32 nCount, nfFloat * pPositions)> MESHOUTBOXPOSITIONSOURCE;
+
+	static void fnMeshOutboxCacheCross(_In_ const double * pA, _In_ const double * pB, _Out_ double * pResult)
+	{
+		pResult[0] = pA[1] * pB[2] - pA[2] * pB[1];
+		pResult[1] = pA[2] * pB[0] - pA[0] * pB[2];
+		pResult[2] = pA[0] * pB[1] - pA[1] * pB[0];
+	}
+
+	static double fnMeshOutboxCacheDot(_In_ const double * pA, _In_ const double * pB)
+	{
+		return pA[0] * pB[0] + pA[1] * pB[1] + pA[2] * pB[2];
+	}
+
+	// Directions of a Fibonacci lattice on the upper half of the unit sphere
+	static std::vector<double> fnMeshOutboxCacheSphereDirections()
+	{
+		const double dGoldenAngle = 3.14159265358979323846 * (3.0 - sqrt(5.0));
+		std::vector<double> Directions(NMR_MESHOUTBOXCACHE_SPHEREDIRECTIONCOUNT * 3);
+		for (nfUint32 nDirection = 0; nDirection < NMR_MESHOUTBOXCACHE_SPHEREDIRECTIONCOUNT; nDirection++) {
+			double dZ = 1.0 - (nDirection + 0.5) / NMR_MESHOUTBOXCACHE_SPHEREDIRECTIONCOUNT;
+			double dRadius = sqrt(1.0 - dZ * dZ);
+			double dAngle = dGoldenAngle * nDirection;
+			Directions[nDirection * 3] = dRadius * cos(dAngle);
+			Directions[nDirection * 3 + 1] = dRadius * sin(dAngle);
+			Directions[nDirection * 3 + 2] = dZ;
+		}
+		return Directions;
+	}
+
+	// Keeps the position with the largest value along each direction in pExtremes[0, nDirectionCount),
+	// and along each negated direction in pExtremes[nDirectionCount, 2 * nDirectionCount)
+	static void fnMeshOutboxCacheMergeExtremes(_In_ const nfFloat * pPosition, _In_ const std::vector<double> & Directions,
+		_Inout_ MESHOUTBOXEXTREME * pExtremes)
+	{
+		size_t nDirectionCount = Directions.size() / 3;
+		for (size_t nDirection = 0; nDirection < nDirectionCount; nDirection++) {
+			const double * pDirection = &Directions[nDirection * 3];
+			double dValue = pDirection[0] * pPosition[0] + pDirection[1] * pPosition[1] + pDirection[2] * pPosition[2];
+			MESHOUTBOXEXTREME * pMax = &pExtremes[nDirection];
+			MESHOUTBOXEXTREME * pMin = &pExtremes[nDirection + nDirectionCount];
+			if (dValue > pMax->m_dValue) {
+				pMax->m_dValue = dValue;
+				std::copy(pPosition, pPosition + 3, pMax->m_fPosition);
+			}
+			if (-dValue > pMin->m_dValue) {
+				pMin->m_dValue = -dValue;
+				std::copy(pPosition, pPosition + 3, pMin->m_fPosition);
+			}
+		}
+	}
+
+	// Projects a direction onto the face of a cube with the largest coordinate, and returns the grid cell there
+	static nfUint32 fnMeshOutboxCacheGetCell(_In_ const double * pDirection)
+	{
+		const nfUint32 nGridSize = NMR_MESHOUTBOXCACHE_DIRECTIONGRIDSIZE;
+		nfUint32 nAxis = 0;
+		for (nfUint32 j = 1; j < 3; j++) {
+			if (fabs(pDirection[j]) > fabs(pDirection[nAxis]))
+				nAxis = j;
+		}
+		double dMajor = fabs(pDirection[nAxis]);
+		if (dMajor <= 0.0)
+			return 0;
+
+		nfUint32 nFace = nAxis * 2 + ((pDirection[nAxis] < 0.0) ? 1 : 0);
+		nfUint32 nCell = nFace;
+		for (nfUint32 nMinor = 1; nMinor < 3; nMinor++) {
+			double dCoordinate = (pDirection[(nAxis + nMinor) % 3] / dMajor + 1.0) * 0.5 * nGridSize;
+			nCell = nCell * nGridSize + std::min((nfUint32)std::max(dCoordinate, 0.0), nGridSize - 1);
+		}
+		return nCell;
+	}
+
+	// Samples the corners, edge midpoints and centers of all grid cells and lists the tetrahedra containing
+	// the sampled directions. A cone which meets a cell between the samples may be missed, which only
+	// keeps positions which could have been left out.
+	static void fnMeshOutboxCacheBuildCells(_Inout_ MESHOUTBOXHULL & Hull)
+	{
+		const nfUint32 nGridSize = NMR_MESHOUTBOXCACHE_DIRECTIONGRIDSIZE;
+		const nfUint32 nCellCount = 6 * nGridSize * nGridSize;
+		std::vector<std::vector<nfUint32>> CellTetrahedra(nCellCount);
+
+		for (nfUint32 nFace = 0; nFace < 6; nFace++) {
+			nfUint32 nAxis = nFace / 2;
+			for (nfUint32 nSampleU = 0; nSampleU <= 2 * nGridSize; nSampleU++) {
+				for (nfUint32 nSampleV = 0; nSampleV <= 2 * nGridSize; nSampleV++) {
+					double vDirection[3];
+					vDirection[nAxis] = (nFace % 2) ? -1.0 : 1.0;
+					vDirection[(nAxis + 1) % 3] = (double)nSampleU / nGridSize - 1.0;
+					vDirection[(nAxis + 2) % 3] = (double)nSampleV / nGridSize - 1.0;
+
+					nfUint32 nTetrahedron = 0;
+					for (auto iTetrahedron = Hull.m_Tetrahedra.begin(); iTetrahedron != Hull.m_Tetrahedra.end(); iTetrahedron++, nTetrahedron++) {
+						if ((fnMeshOutboxCacheDot(iTetrahedron->m_dInverse[0], vDirection) < 0.0) ||
+							(fnMeshOutboxCacheDot(iTetrahedron->m_dInverse[1], vDirection) < 0.0) ||
+							(fnMeshOutboxCacheDot(iTetrahedron->m_dInverse[2], vDirection) < 0.0))
+							continue;
+
+						// A sample on a cell border belongs to the cells on both sides
+						for (nfUint32 nCellU = (nSampleU > 0) ? (nSampleU - 1) / 2 : 0; nCellU <= std::min(nSampleU / 2, nGridSize - 1); nCellU++) {
+							for (nfUint32 nCellV = (nSampleV > 0) ? (nSampleV - 1) / 2 : 0; nCellV <= std::min(nSampleV / 2, nGridSize - 1); nCellV++) {
+								std::vector<nfUint32> & Tetrahedra = CellTetrahedra[(nFace * nGridSize + nCellU) * nGridSize + nCellV];
+								if (std::find(Tetrahedra.begin(), Tetrahedra.end(), nTetrahedron) == Tetrahedra.end())
+									Tetrahedra.push_back(nTetrahedron);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		Hull.m_CellOffsets.resize(nCellCount + 1);
+		Hull.m_CellTetrahedra.clear();
+		for (nfUint32 nCell = 0; nCell < nCellCount; nCell++) {
+			Hull.m_CellOffsets[nCell] = (nfUint32)Hull.m_CellTetrahedra.size();
+			Hull.m_CellTetrahedra.insert(Hull.m_CellTetrahedra.end(), CellTetrahedra[nCell].begin(), CellTetrahedra[nCell].end());
+		}
+		Hull.m_CellOffsets[nCellCount] = (nfUint32)Hull.m_CellTetrahedra.size();
+	}
+
+	// Spans tetrahedra between the centroid of the points and every triangle of their convex hull.
+	// Hull triangles are found by testing all triples, which is fine for the few extreme points.
+	// Missing triangles only cost hull points which could have been left out, but the inner ball
+	// relies on all hull planes, so it is not used if the number of tetrahedra is exceeded.
+	//
+	// A position with the barycentric weight w of the centroid lies at least w times the distance
+	// of the centroid to the hull boundary inside of the hull. This distance is the inner radius,
+	// or, without all hull planes, at least the smallest width of a tetrahedron divided by the
+	// number of points, since the centroid is their average.
+	static void fnMeshOutboxCacheBuildHull(_In_ const std::vector<NVEC3> & Points, _In_ double dDistanceMargin, _Out_ MESHOUTBOXHULL & Hull)
+	{
+		std::vector<MESHOUTBOXTETRAHEDRON> & Tetrahedra = Hull.m_Tetrahedra;
+		double * pCenter = Hull.m_dCenter;
+		Tetrahedra.clear();
+		pCenter[0] = pCenter[1] = pCenter[2] = 0.0;
+		Hull.m_dInnerRadiusSquared = 0.0;
+		Hull.m_dCenterMargin = 1.0;
+		Hull.m_CellOffsets.assign(6 * NMR_MESHOUTBOXCACHE_DIRECTIONGRIDSIZE * NMR_MESHOUTBOXCACHE_DIRECTIONGRIDSIZE + 1, 0);
+		Hull.m_CellTetrahedra.clear();
+
+		size_t nPointCount = Points.size();
+		if (nPointCount < 4)
+			return;
+
+		std::vector<double> Coordinates(nPointCount * 3);
+		double dMin[3], dMax[3];
+		for (nfUint32 j = 0; j < 3; j++) {
+			dMin[j] = std::numeric_limits<double>::max();
+			dMax[j] = -std::numeric_limits<double>::max();
+			for (size_t nIndex = 0; nIndex < nPointCount; nIndex++)
+				pCenter[j] += Points[nIndex].m_fields[j];
+			pCenter[j] /= (double)nPointCount;
+		}
+		for (size_t nIndex = 0; nIndex < nPointCount; nIndex++) {
+			for (nfUint32 j = 0; j < 3; j++) {
+				double dValue = Points[nIndex].m_fields[j] - pCenter[j];
+				Coordinates[nIndex * 3 + j] = dValue;
+				dMin[j] = std::min(dMin[j], dValue);
+				dMax[j] = std::max(dMax[j], dValue);
+			}
+		}
+
+		double dScale = std::max(dMax[0] - dMin[0], std::max(dMax[1] - dMin[1], dMax[2] - dMin[2]));
+		if (dScale <= 0.0)
+			return;
+		double dPlaneTolerance = dScale * 1e-6;
+		double dMinDeterminant = dScale * dScale * dScale * 1e-12;
+		double dInnerRadius = std::numeric_limits<double>::max();
+		double dMaxTetrahedronWidth = 0.0;
+
+		for (size_t nA = 0; (nA < nPointCount) && (Tetrahedra.size() < NMR_MESHOUTBOXCACHE_MAXTETRAHEDRONCOUNT); nA++) {
+			for (size_t nB = nA + 1; (nB < nPointCount) && (Tetrahedra.size() < NMR_MESHOUTBOXCACHE_MAXTETRAHEDRONCOUNT); nB++) {
+				for (size_t nC = nB + 1; (nC < nPointCount) && (Tetrahedra.size() < NMR_MESHOUTBOXCACHE_MAXTETRAHEDRONCOUNT); nC++) {
+					const double * pA = &Coordinates[nA * 3];
+					const double * pB = &Coordinates[nB * 3];
+					const double * pC = &Coordinates[nC * 3];
+					double vEdge1[3], vEdge2[3], vNormal[3];
+					for (nfUint32 j = 0; j < 3; j++) {
+						vEdge1[j] = pB[j] - pA[j];
+						vEdge2[j] = pC[j] - pA[j];
+					}
+					fnMeshOutboxCacheCross(vEdge1, vEdge2, vNormal);
+					double dLength = sqrt(fnMeshOutboxCacheDot(vNormal, vNormal));
+					if (dLength <= 0.0)
+						continue;
+					for (nfUint32 j = 0; j < 3; j++)
+						vNormal[j] /= dLength;
+
+					// A hull triangle has all points on one side of its plane
+					double dOffset = fnMeshOutboxCacheDot(vNormal, pA);
+					nfBool bAbove = false;
+					nfBool bBelow = false;
+					for (size_t nIndex = 0; (nIndex < nPointCount) && !(bAbove && bBelow); nIndex++) {
+						double dDistance = fnMeshOutboxCacheDot(vNormal, &Coordinates[nIndex * 3]) - dOffset;
+						bAbove |= (dDistance > dPlaneTolerance);
+						bBelow |= (dDistance < -dPlaneTolerance);
+					}
+					if (bAbove && bBelow)
+						continue;
+					dInnerRadius = std::min(dInnerRadius, fabs(dOffset));
+
+					// Rows of the inverse of the matrix with the columns A, B and C
+					double vRows[3][3];
+					fnMeshOutboxCacheCross(pB, pC, vRows[0]);
+					fnMeshOutboxCacheCross(pC, pA, vRows[1]);
+					fnMeshOutboxCacheCross(pA, pB, vRows[2]);
+					double dDeterminant = fnMeshOutboxCacheDot(pA, vRows[0]);
+					if (fabs(dDeterminant) <= dMinDeterminant)
+						continue;
+
+					MESHOUTBOXTETRAHEDRON Tetrahedron;
+					for (nfUint32 i = 0; i < 3; i++)
+						for (nfUint32 j = 0; j < 3; j++)
+							Tetrahedron.m_dInverse[i][j] = vRows[i][j] / dDeterminant;
+					Tetrahedra.push_back(Tetrahedron);
+
+					// The width of a convex body is at least twice its volume divided by its surface area
+					double dDoubleArea = dLength + sqrt(fnMeshOutboxCacheDot(vRows[0], vRows[0])) +
+						sqrt(fnMeshOutboxCacheDot(vRows[1], vRows[1])) + sqrt(fnMeshOutboxCacheDot(vRows[2], vRows[2]));
+					dMaxTetrahedronWidth = std::max(dMaxTetrahedronWidth, fabs(dDeterminant) * 2.0 / (3.0 * dDoubleArea));
+				}
+			}
+		}
+
+		if (Tetrahedra.empty())
+			return;
+
+		// Hull planes may have points up to the plane tolerance above them
+		double dCenterDistance = dMaxTetrahedronWidth / (double)nPointCount;
+		if (Tetrahedra.size() < NMR_MESHOUTBOXCACHE_MAXTETRAHEDRONCOUNT) {
+			dInnerRadius = dInnerRadius * (1.0 - NMR_MESHOUTBOXCACHE_BARYCENTRICMARGIN) - dPlaneTolerance;
+			dCenterDistance = std::max(dCenterDistance, dInnerRadius);
+			dInnerRadius -= dDistanceMargin;
+			if (dInnerRadius > 0.0)
+				Hull.m_dInnerRadiusSquared = dInnerRadius * dInnerRadius;
+		}
+
+		// Nothing can be left out if the hull is too small for the margin
+		if (dCenterDistance * (1.0 - NMR_MESHOUTBOXCACHE_BARYCENTRICMARGIN) <= dDistanceMargin) {
+			Tetrahedra.clear();
+			Hull.m_dInnerRadiusSquared = 0.0;
+			return;
+		}
+		Hull.m_dCenterMargin = std::max(NMR_MESHOUTBOXCACHE_BARYCENTRICMARGIN, dDistanceMargin / dCenterDistance);
+		fnMeshOutboxCacheBuildCells(Hull);
+	}
+
+	static nfBool fnMeshOutboxCacheIsInside(_In_ const MESHOUTBOXHULL & Hull, _In_ const nfFloat * pPosition)
+	{
+		const double dMargin = NMR_MESHOUTBOXCACHE_BARYCENTRICMARGIN;
+		double vRelative[3];
+		for (nfUint32 j = 0; j < 3; j++)
+			vRelative[j] = pPosition[j] - Hull.m_dCenter[j];
+		if (fnMeshOutboxCacheDot(vRelative, vRelative) < Hull.m_dInnerRadiusSquared)
+			return true;
+
+		nfUint32 nCell = fnMeshOutboxCacheGetCell(vRelative);
+		for (nfUint32 nIndex = Hull.m_CellOffsets[nCell]; nIndex < Hull.m_CellOffsets[nCell + 1]; nIndex++) {
+			const MESHOUTBOXTETRAHEDRON & Tetrahedron = Hull.m_Tetrahedra[Hull.m_CellTetrahedra[nIndex]];
+			double dWeight0 = fnMeshOutboxCacheDot(Tetrahedron.m_dInverse[0], vRelative);
+			if (dWeight0 <= dMargin)
+				continue;
+			double dWeight1 = fnMeshOutboxCacheDot(Tetrahedron.m_dInverse[1], vRelative);
+			if (dWeight1 <= dMargin)
+				continue;
+			double dWeight2 = fnMeshOutboxCacheDot(Tetrahedron.m_dInverse[2], vRelative);
+			if ((dWeight2 > dMargin) && (dWeight0 + dWeight1 + dWeight2 < 1.0 - Hull.m_dCenterMargin))
+				return true;
+		}
+		return false;
+	}
+
+	// Collects the positions which are not at least dDistanceMargin inside of the convex hull of the positions
+	// that are extreme along the directions, in their original order. A margin of 0 is replaced by
+	// NMR_MESHOUTBOXCACHE_MARGINEPSILONS float epsilons of the largest coordinate of the extreme positions.
+	// Returns false if there are more than nMaxCount of them.
+	static nfBool fnMeshOutboxCacheFilter(_In_ nfUint32 nCount, _In_ const MESHOUTBOXPOSITIONSOURCE & fnSource,
+		_In_ const std::vector<double> & Directions, _Inout_ double & dDistanceMargin, _In_ size_t nMaxCount, _Out_ std::vector<nfFloat> & Result)
+	{
+		Result.clear();
+		nfUint32 nChunkCount = fnParallelGetChunkCount(nCount, NMR_MESH_PARALLELCHUNKSIZE);
+		if (nChunkCount == 0)
+			return true;
+
+		size_t nExtremeCount = Directions.size() / 3 * 2;
+		MESHOUTBOXEXTREME EmptyExtreme = { -std::numeric_limits<double>::max(), { 0.0f, 0.0f, 0.0f } };
+		std::vector<MESHOUTBOXEXTREME> ChunkExtremes(nChunkCount * nExtremeCount, EmptyExtreme);
+		fnParallelForChunks(nChunkCount, [&](nfUint32 nChunkIndex) {
+			nfUint32 nStart = (nfUint32)fnParallelGetChunkStart(nCount, nChunkCount, nChunkIndex);
+			nfUint32 nEnd = (nfUint32)fnParallelGetChunkStart(nCount, nChunkCount, nChunkIndex + 1);
+			MESHOUTBOXEXTREME * pExtremes = &ChunkExtremes[nChunkIndex * nExtremeCount];
+			std::vector<nfFloat> Buffer((size_t)std::min(nEnd - nStart, (nfUint32)NMR_MESH_MERGEBATCHSIZE) * 3);
+
+			while (nStart < nEnd) {
+				nfUint32 nBatchCount = std::min(nEnd - nStart, (nfUint32)NMR_MESH_MERGEBATCHSIZE);
+				fnSource(nStart, nBatchCount, Buffer.data());
+				for (nfUint32 nIndex = 0; nIndex < nBatchCount; nIndex++)
+					fnMeshOutboxCacheMergeExtremes(&Buffer[(size_t)nIndex * 3], Directions, pExtremes);
+				nStart += nBatchCount;
+			}
+		});
+
+		std::vector<NVEC3> ExtremePoints;
+		for (size_t nExtreme = 0; nExtreme < nExtremeCount; nExtreme++) {
+			MESHOUTBOXEXTREME Extreme = ChunkExtremes[nExtreme];
+			for (nfUint32 nChunkIndex = 1; nChunkIndex < nChunkCount; nChunkIndex++) {
+				const MESHOUTBOXEXTREME & ChunkExtreme = ChunkExtremes[nChunkIndex * nExtremeCount + nExtreme];
+				if (ChunkExtreme.m_dValue > Extreme.m_dValue)
+					Extreme = ChunkExtreme;
+			}
+
+			NVEC3 vPoint = fnVEC3_make(Extreme.m_fPosition[0], Extreme.m_fPosition[1], Extreme.m_fPosition[2]);
+			auto iDuplicate = std::find_if(ExtremePoints.begin(), ExtremePoints.end(), [&](const NVEC3 & vOther) {
+				return (vOther.m_fields[0] == vPoint.m_fields[0]) && (vOther.m_fields[1] == vPoint.m_fields[1]) && (vOther.m_fields[2] == vPoint.m_fields[2]);
+			});
+			if (iDuplicate == ExtremePoints.end())
+				ExtremePoints.push_back(vPoint);
+		}
+
+		if (dDistanceMargin <= 0.0) {
+			double dMaxCoordinate = 0.0;
+			for (auto iPoint = ExtremePoints.begin(); iPoint != ExtremePoints.end(); iPoint++)
+				for (nfUint32 j = 0; j < 3; j++)
+					dMaxCoordinate = std::max(dMaxCoordinate, (double)fabs(iPoint->m_fields[j]));
+			dDistanceMargin = NMR_MESHOUTBOXCACHE_MARGINEPSILONS * FLT_EPSILON * std::max(dMaxCoordinate, (double)FLT_MIN);
+		}
+
+		MESHOUTBOXHULL Hull;
+		fnMeshOutboxCacheBuildHull(ExtremePoints, dDistanceMargin, Hull);
+
+		std::vector<std::vector<nfFloat>> ChunkResults(nChunkCount);
+		fnParallelForChunks(nChunkCount, [&](nfUint32 nChunkIndex) {
+			nfUint32 nStart = (nfUint32)fnParallelGetChunkStart(nCount, nChunkCount, nChunkIndex);
+			nfUint32 nEnd = (nfUint32)fnParallelGetChunkStart(nCount, nChunkCount, nChunkIndex + 1);
+			std::vector<nfFloat> & ChunkResult = ChunkResults[nChunkIndex];
+			std::vector<nfFloat> Buffer((size_t)std::min(nEnd - nStart, (nfUint32)NMR_MESH_MERGEBATCHSIZE) * 3);
+
+			while ((nStart < nEnd) && (ChunkResult.size() / 3 <= nMaxCount)) {
+				nfUint32 nBatchCount = std::min(nEnd - nStart, (nfUint32)NMR_MESH_MERGEBATCHSIZE);
+				fnSource(nStart, nBatchCount, Buffer.data());
+				for (nfUint32 nIndex = 0; nIndex < nBatchCount; nIndex++) {
+					const nfFloat * pPosition = &Buffer[(size_t)nIndex * 3];
+					if (!fnMeshOutboxCacheIsInside(Hull, pPosition))
+						ChunkResult.insert(ChunkResult.end(), pPosition, pPosition + 3);
+				}
+				nStart += nBatchCount;
+			}
+		});
+
+		size_t nResultCount = 0;
+		for (auto iChunkResult = ChunkResults.begin(); iChunkResult != ChunkResults.end(); iChunkResult++)
+			nResultCount += iChunkResult->size() / 3;
+		if (nResultCount > nMaxCount)
+			return false;
+
+		Result.reserve(nResultCount * 3);
+		for (auto iChunkResult = ChunkResults.begin(); iChunkResult != ChunkResults.end(); iChunkResult++)
+			Result.insert(Result.end(), iChunkResult->begin(), iChunkResult->end());
+		return true;
+	}
+
+	CMeshOutboxCache::CMeshOutboxCache()
+		: m_bHasLocalOutbox(false), m_nFullQueryCount(0), m_bHasHullPoints(false), m_dHullMargin(0.0)
+	{
+		fnOutboxInitialize(m_LocalOutbox);
+		for (nfUint32 j = 0; j < 3; j++)
+			m_dMaxCoordinates[j] = 0.0;
+	}
+
+	void CMeshOutboxCache::invalidate()
+	{
+		m_bHasLocalOutbox = false;
+		m_nFullQueryCount = 0;
+		m_bHasHullPoints = false;
+		if (!m_HullPoints.empty())
+			std::vector<nfFloat>().swap(m_HullPoints);
+	}
+
+	_Success_(return) nfBool CMeshOutboxCache::getLocalOutbox(_Out_ NOUTBOX3 & oOutbox)
+	{
+		if (!m_bHasLocalOutbox)
+			return false;
+		oOutbox = m_LocalOutbox;
+		return true;
+	}
+
+	void CMeshOutboxCache::setLocalOutbox(_In_ const NOUTBOX3 & oOutbox)
+	{
+		m_LocalOutbox = oOutbox;
+		m_bHasLocalOutbox = true;
+	}
+
+	nfBool CMeshOutboxCache::isAxisAligned(_In_ const NMATRIX3 & mMatrix)
+	{
+		for (nfUint32 i = 0; i < 3; i++) {
+			nfUint32 nNonZeroCount = 0;
+			for (nfUint32 j = 0; j < 3; j++) {
+				if (mMatrix.m_fields[i][j] != 0.0f)
+					nNonZeroCount++;
+			}
+			if (nNonZeroCount > 1)
+				return false;
+		}
+		return true;
+	}
+
+	void CMeshOutboxCache::mergeLocalOutbox(_In_ const NMATRIX3 & mMatrix, _Inout_ NOUTBOX3 & oOutbox)
+	{
+		if (!m_bHasLocalOutbox)
+			return;
+
+		// Every transformed coordinate depends on one coordinate only, and rounding is monotonic,
+		// so the extremes of the transformed nodes are found among the transformed corners.
+		nfFloat fCorners[8 * 3];
+		for (nfUint32 nCorner = 0; nCorner < 8; nCorner++) {
+			for (nfUint32 j = 0; j < 3; j++)
+				fCorners[nCorner * 3 + j] = (nCorner & (1 << j)) ? m_LocalOutbox.m_max.m_fields[j] : m_LocalOutbox.m_min.m_fields[j];
+		}
+		fnMeshKernelMergeTransformedBounds(&fCorners[0], &fCorners[1], &fCorners[2], 3, 8, mMatrix, oOutbox);
+	}
+
+	nfBool CMeshOutboxCache::mergeHullPoints(_In_ const NMATRIX3 & mMatrix, _Inout_ NOUTBOX3 & oOutbox)
+	{
+		if (!m_bHasHullPoints)
+			return false;
+
+		// Every left out node lies at least the hull margin inside of the hull. Along a row of the matrix,
+		// this has to exceed the rounding error of transforming it and of transforming the extreme hull point.
+		for (nfUint32 i = 0; i < 3; i++) {
+			const nfFloat * pRow = mMatrix.m_fields[i];
+			double dLengthSquared = 0.0;
+			double dMaxError = fabs(pRow[3]);
+			for (nfUint32 j = 0; j < 3; j++) {
+				dLengthSquared += (double)pRow[j] * pRow[j];
+				dMaxError += fabs(pRow[j]) * m_dMaxCoordinates[j];
+			}
+			// Rows without linear part map all nodes exactly onto the translation
+			if (dLengthSquared == 0.0)
+				continue;
+			dMaxError *= NMR_MESHOUTBOXCACHE_TRANSFORMEPSILONS * FLT_EPSILON;
+			if (2.0 * dMaxError >= sqrt(dLengthSquared) * m_dHullMargin)
+				return false;
+		}
+
+		const nfFloat * pPoints = m_HullPoints.data();
+		fnMeshKernelMergeTransformedBounds(pPoints, pPoints + 1, pPoints + 2, 3, m_HullPoints.size() / 3, mMatrix, oOutbox);
+		return true;
+	}
+
+	nfBool CMeshOutboxCache::countFullQuery()
+	{
+		m_nFullQueryCount++;
+		return (m_nFullQueryCount == 2);
+	}
+
+	void CMeshOutboxCache::buildHullPoints(_In_ CMesh * pMesh)
+	{
+		__NMRASSERT(pMesh);
+		std::vector<nfFloat>().swap(m_HullPoints);
+		m_bHasHullPoints = false;
+
+		nfUint32 nNodeCount = pMesh->getNodeCount();
+		size_t nMaxHullPointCount = (size_t)(nNodeCount * NMR_MESHOUTBOXCACHE_MAXHULLFRACTION);
+
+		// The few directions of the first pass are cheap to test against all nodes,
+		// the second pass refines the remaining nodes with directions spread over the sphere
+		std::vector<double> CubeDirections(&fnMeshOutboxCacheCubeDirections[0][0], &fnMeshOutboxCacheCubeDirections[0][0] + NMR_MESHOUTBOXCACHE_CUBEDIRECTIONCOUNT * 3);
+		std::vector<nfFloat> Candidates;
+		MESHOUTBOXPOSITIONSOURCE fnNodeSource = [pMesh](nfUint32 nStart, nfUint32 nCount, nfFloat * pPositions) {
+			pMesh->copyNodePositions(nStart, nCount, pPositions);
+		};
+		double dDistanceMargin = 0.0;
+		if (!fnMeshOutboxCacheFilter(nNodeCount, fnNodeSource, CubeDirections, dDistanceMargin, nMaxHullPointCount, Candidates))
+			return;
+
+		MESHOUTBOXPOSITIONSOURCE fnCandidateSource = [&Candidates](nfUint32 nStart, nfUint32 nCount, nfFloat * pPositions) {
+			std::copy(&Candidates[(size_t)nStart * 3], &Candidates[(size_t)nStart * 3] + (size_t)nCount * 3, pPositions);
+		};
+		if (!fnMeshOutboxCacheFilter((nfUint32)(Candidates.size() / 3), fnCandidateSource, fnMeshOutboxCacheSphereDirections(), dDistanceMargin, nMaxHullPointCount, m_HullPoints))
+			return;
+
+		// The hull points contain the extremes along the axes, so they bound the coordinates of all nodes
+		for (nfUint32 j = 0; j < 3; j++)
+			m_dMaxCoordinates[j] = 0.0;
+		for (size_t nIndex = 0; nIndex < m_HullPoints.size(); nIndex++)
+			m_dMaxCoordinates[nIndex % 3] = std::max(m_dMaxCoordinates[nIndex % 3], (double)fabs(m_HullPoints[nIndex]));
+
+		m_HullPoints.shrink_to_fit();
+		m_dHullMargin = dDistanceMargin;
+		m_bHasHullPoints = true;
+	}
+
+}
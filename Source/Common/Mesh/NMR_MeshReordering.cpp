@@ -0,0 +1,222 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_MeshReordering.cpp implements the class CMeshReordering.
+
+--*/
+
+#include "Common/Mesh/NMR_MeshReordering.h"
+#include "Common/Mesh/NMR_MeshKernels.h"
+#include "Common/Mesh/NMR_MeshTypes.h"
+#include "Common/NMR_Exception.h"
+
+namespace NMR {
+
+	CMeshReordering::CMeshReordering(_In_ CMesh * pMesh)
+		: m_bReordered(false)
+	{
+		if (!pMesh)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		nfUint32 nNodeCount = pMesh->getNodeCount();
+		nfUint32 nFaceCount = pMesh->getFaceCount();
+
+		std::vector<nfInt32> NodeIndices((size_t)nFaceCount * 3);
+		if (nFaceCount > 0)
+			pMesh->copyFaceNodeIndices(0, nFaceCount, NodeIndices.data());
+
+		m_FaceOrder.resize(nFaceCount);
+		if (fnMeshKernelHasInvalidFaces(NodeIndices.data(), nFaceCount, nNodeCount)) {
+			for (nfUint32 nFaceIndex = 0; nFaceIndex < nFaceCount; nFaceIndex++)
+				m_FaceOrder[nFaceIndex] = nFaceIndex;
+
+			m_NodeOrder.resize(nNodeCount);
+			m_NewNodeIndices.resize(nNodeCount);
+			for (nfUint32 nNodeIndex = 0; nNodeIndex < nNodeCount; nNodeIndex++) {
+				m_NodeOrder[nNodeIndex] = nNodeIndex;
+				m_NewNodeIndices[nNodeIndex] = nNodeIndex;
+			}
+			return;
+		}
+
+		orderFaces(NodeIndices, nNodeCount);
+		orderNodes(pMesh, NodeIndices);
+		m_bReordered = true;
+	}
+
+	void CMeshReordering::orderFaces(_In_ const std::vector<nfInt32> & NodeIndices, _In_ nfUint32 nNodeCount)
+	{
+		nfUint32 nFaceCount = (nfUint32)m_FaceOrder.size();
+
+		// Faces of every node, in compressed rows
+		std::vector<nfUint32> AdjacencyStart((size_t)nNodeCount + 1, 0);
+		for (nfInt32 nNodeIndex : NodeIndices)
+			AdjacencyStart[nNodeIndex + 1]++;
+		for (nfUint32 nNodeIndex = 0; nNodeIndex < nNodeCount; nNodeIndex++)
+			AdjacencyStart[nNodeIndex + 1] += AdjacencyStart[nNodeIndex];
+
+		std::vector<nfUint32> Adjacency(NodeIndices.size());
+		std::vector<nfUint32> LiveFaceCounts(nNodeCount);
+		for (nfUint32 nNodeIndex = 0; nNodeIndex < nNodeCount; nNodeIndex++)
+			LiveFaceCounts[nNodeIndex] = AdjacencyStart[nNodeIndex + 1] - AdjacencyStart[nNodeIndex];
+		{
+			std::vector<nfUint32> Fill(AdjacencyStart.begin(), AdjacencyStart.end() - 1);
+			for (size_t nIndex = 0; nIndex < NodeIndices.size(); nIndex++)
+				Adjacency[Fill[NodeIndices[nIndex]]++] = (nfUint32)(nIndex / 3);
+		}
+
+		// A node is in the cache if fewer than NMR_MESHREORDERING_CACHESIZE nodes entered it after it
+		std::vector<nfUint32> CacheTimeStamps(nNodeCount, 0);
+		nfUint32 nTimeStamp = NMR_MESHREORDERING_CACHESIZE + 1;
+
+		std::vector<nfBool> FaceEmitted(nFaceCount, false);
+		std::vector<nfUint32> DeadEndStack;
+		std::vector<nfUint32> Candidates;
+		DeadEndStack.reserve(NodeIndices.size());
+		nfUint32 nCursor = 0;
+		nfUint32 nFaceOrderIndex = 0;
+
+		nfInt64 nFanningNode = (nNodeCount > 0) ? 0 : -1;
+		while (nFanningNode >= 0) {
+			nfUint32 nFanNode = (nfUint32)nFanningNode;
+			Candidates.clear();
+
+			// Emit all remaining faces around the fanning node
+			for (nfUint32 nIndex = AdjacencyStart[nFanNode]; nIndex < AdjacencyStart[nFanNode + 1]; nIndex++) {
+				nfUint32 nFaceIndex = Adjacency[nIndex];
+				if (FaceEmitted[nFaceIndex])
+					continue;
+				FaceEmitted[nFaceIndex] = true;
+				m_FaceOrder[nFaceOrderIndex++] = nFaceIndex;
+
+				for (nfUint32 j = 0; j < 3; j++) {
+					nfUint32 nNodeIndex = (nfUint32)NodeIndices[(size_t)nFaceIndex * 3 + j];
+					DeadEndStack.push_back(nNodeIndex);
+					Candidates.push_back(nNodeIndex);
+					LiveFaceCounts[nNodeIndex]--;
+					if (nTimeStamp - CacheTimeStamps[nNodeIndex] > NMR_MESHREORDERING_CACHESIZE) {
+						CacheTimeStamps[nNodeIndex] = nTimeStamp;
+						nTimeStamp++;
+					}
+				}
+			}
+
+			// Continue with the candidate that stays longest in the cache once its faces are emitted
+			nFanningNode = -1;
+			nfInt64 nBestPriority = -1;
+			for (nfUint32 nNodeIndex : Candidates) {
+				if (LiveFaceCounts[nNodeIndex] == 0)
+					continue;
+				nfInt64 nPriority = 0;
+				nfInt64 nAge = (nfInt64)nTimeStamp - CacheTimeStamps[nNodeIndex];
+				if (nAge + 2 * (nfInt64)LiveFaceCounts[nNodeIndex] <= NMR_MESHREORDERING_CACHESIZE)
+					nPriority = nAge;
+				if (nPriority > nBestPriority) {
+					nBestPriority = nPriority;
+					nFanningNode = nNodeIndex;
+				}
+			}
+
+			// Dead end: fall back to recently used nodes, then to the next node in input order
+			while ((nFanningNode < 0) && !DeadEndStack.empty()) {
+				nfUint32 nNodeIndex = DeadEndStack.back();
+				DeadEndStack.pop_back();
+				if (LiveFaceCounts[nNodeIndex] > 0)
+					nFanningNode = nNodeIndex;
+			}
+			while ((nFanningNode < 0) && (nCursor < nNodeCount)) {
+				if (LiveFaceCounts[nCursor] > 0)
+					nFanningNode = nCursor;
+				nCursor++;
+			}
+		}
+	}
+
+	void CMeshReordering::orderNodes(_In_ CMesh * pMesh, _In_ const std::vector<nfInt32> & NodeIndices)
+	{
+		nfUint32 nNodeCount = pMesh->getNodeCount();
+		nfUint32 nBeamCount = pMesh->getBeamCount();
+		const nfUint32 nUnassigned = 0xffffffff;
+
+		m_NodeOrder.reserve(nNodeCount);
+		m_NewNodeIndices.assign(nNodeCount, nUnassigned);
+
+		auto fnAssign = [&](nfUint32 nNodeIndex) {
+			if (m_NewNodeIndices[nNodeIndex] == nUnassigned) {
+				m_NewNodeIndices[nNodeIndex] = (nfUint32)m_NodeOrder.size();
+				m_NodeOrder.push_back(nNodeIndex);
+			}
+		};
+
+		for (nfUint32 nFaceIndex : m_FaceOrder) {
+			const nfInt32 * pNodeIndices = &NodeIndices[(size_t)nFaceIndex * 3];
+			fnAssign((nfUint32)pNodeIndices[0]);
+			fnAssign((nfUint32)pNodeIndices[1]);
+			fnAssign((nfUint32)pNodeIndices[2]);
+		}
+
+		// Nodes of beams follow, nodes that are not referenced at all keep their relative order
+		for (nfUint32 nBeamIndex = 0; nBeamIndex < nBeamCount; nBeamIndex++) {
+			MESHBEAM * pBeam = pMesh->getBeam(nBeamIndex);
+			for (nfUint32 j = 0; j < 2; j++) {
+				if ((pBeam->m_nodeindices[j] >= 0) && ((nfUint32)pBeam->m_nodeindices[j] < nNodeCount))
+					fnAssign((nfUint32)pBeam->m_nodeindices[j]);
+			}
+		}
+
+		for (nfUint32 nNodeIndex = 0; nNodeIndex < nNodeCount; nNodeIndex++)
+			fnAssign(nNodeIndex);
+	}
+
+	nfBool CMeshReordering::isReordered()
+	{
+		return m_bReordered;
+	}
+
+	nfUint32 CMeshReordering::getOldFaceIndex(_In_ nfUint32 nNewIndex)
+	{
+		if (nNewIndex >= m_FaceOrder.size())
+			throw CNMRException(NMR_ERROR_INVALIDINDEX);
+		return m_FaceOrder[nNewIndex];
+	}
+
+	nfUint32 CMeshReordering::getOldNodeIndex(_In_ nfUint32 nNewIndex)
+	{
+		if (nNewIndex >= m_NodeOrder.size())
+			throw CNMRException(NMR_ERROR_INVALIDINDEX);
+		return m_NodeOrder[nNewIndex];
+	}
+
+	nfUint32 CMeshReordering::getNewNodeIndex(_In_ nfUint32 nOldIndex)
+	{
+		if (nOldIndex >= m_NewNodeIndices.size())
+			throw CNMRException(NMR_ERROR_INVALIDINDEX);
+		return m_NewNodeIndices[nOldIndex];
+	}
+
+}
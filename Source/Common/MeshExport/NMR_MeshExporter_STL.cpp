@@ -62,21 +62,21 @@ namespace NMR {
 
 		nfUint32 nIdx, j;
 		nfUint32 nFaceCount = pMesh->getFaceCount();
-		MESHFACE * face;
-		MESHNODE * node;
+		nfInt32 NodeIndices[3];
+		NVEC3 vPosition;
 
 		MESHFORMAT_STL_FACET facet;
 		std::list<MESHFORMAT_STL_FACET> facetdata;
 
 		for (nIdx = 0; nIdx < nFaceCount; nIdx++) {
 
-			face = pMesh->getFace(nIdx);
+			pMesh->getFaceNodeIndices(nIdx, NodeIndices);
 			for (j = 0; j < 3; j++) {
-				node = pMesh->getNode (face->m_nodeindices[j]);
+				vPosition = pMesh->getNodePosition(NodeIndices[j]);
 				if (pmMatrix)
-					facet.m_vertices[j] = fnMATRIX3_apply(*pmMatrix, node->m_position);
+					facet.m_vertices[j] = fnMATRIX3_apply(*pmMatrix, vPosition);
 				else
-					facet.m_vertices[j] = node->m_position;
+					facet.m_vertices[j] = vPosition;
 			}	
 
 			// Calculate Triangle Normals
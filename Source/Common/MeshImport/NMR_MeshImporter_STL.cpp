@@ -34,9 +34,11 @@ This is a derived class for Importing the binary STL and color STL Mesh Format.
 #include "Common/MeshImport/NMR_MeshImporter_STL.h" 
 #include "Common/MeshInformation/NMR_MeshInformation.h" 
 #include "Common/MeshInformation/NMR_MeshInformation_Properties.h" 
-#include "Common/Math/NMR_VectorTree.h" 
+#include "Common/Math/NMR_VertexWelding.h" 
 #include "Common/Math/NMR_Matrix.h" 
+#include "Common/Math/NMR_Vector.h" 
 #include "Common/NMR_Exception.h" 
+#include "Common/NMR_ParallelFor.h" 
 #include <cmath>
 #include <array>
 #include <list>
@@ -145,27 +147,21 @@ namespace NMR {
 			}
 		}
 
-		nfUint32 nNodeIdx;
-		MESHNODE * pNodes[3];
+		// Large files are welded at once by sorting in parallel, if there are several cores to sort on
+		if ((nFaceCount < NMR_MESH_MAXNODECOUNT / 3) && (fnParallelGetChunkCount(nFaceCount * 3, NMR_VERTEXWELDING_PARALLELCHUNKSIZE) > 1)) {
+			loadMeshSorted(pMesh, pmMatrix, nFaceCount);
+			return;
+		}
+
+		nfUint32 NodeIndices[3];
 		MESHFORMAT_STL_FACET Facet;
-		CVectorTree VectorTree;
+		CVertexWeldingTable WeldingTable;
 		nfBool bIsValid;
 
-		VectorTree.setUnits(m_fUnits);
-
 		for (nfUint32 nIdx = 0; nIdx < nFaceCount; nIdx++) {
-			pStream->readBuffer((nfByte*)&Facet, sizeof(Facet), true);
-			if (isBigEndian()) {
-				Facet.swapByteOrder();
-			}
-
-			// Check, if Coordinates are in Valid Space
-			bIsValid = true;
-			for (nfUint32 j = 0; j < 3; j++)
-				for (nfUint32 k = 0; k < 3; k++)
-					bIsValid &= (fabs(Facet.m_vertices[j].m_fields[k]) < NMR_MESH_MAXCOORDINATE);
+			bIsValid = readFacet(pStream, Facet);
 
-			// Identify Nodes via Tree
+			// Identify Nodes via Welding Table
 			if (bIsValid) {
 
 				for (nfUint32 j = 0; j < 3; j++) {
@@ -173,17 +169,14 @@ namespace NMR {
 					if (pmMatrix)
 						vPosition = fnMATRIX3_apply(*pmMatrix, vPosition);
 
-					if (VectorTree.findVector3(vPosition, nNodeIdx)) {
-						pNodes[j] = pMesh->getNode(nNodeIdx);
-					}
-					else {
-						pNodes[j] = pMesh->addNode(vPosition);
-						VectorTree.addVector3(pNodes[j]->m_position, (nfUint32)pNodes[j]->m_index);
-					}
+					nfUint32 nNewIndex = pMesh->getNodeCount();
+					NodeIndices[j] = WeldingTable.findOrInsert(fnVEC3I_floor(vPosition, m_fUnits), nNewIndex);
+					if (NodeIndices[j] == nNewIndex)
+						pMesh->appendNode(vPosition);
 				}
 
 				// check, if Nodes are separate
-				bIsValid = (pNodes[0] != pNodes[1]) && (pNodes[0] != pNodes[2]) && (pNodes[1] != pNodes[2]);
+				bIsValid = (NodeIndices[0] != NodeIndices[1]) && (NodeIndices[0] != NodeIndices[2]) && (NodeIndices[1] != NodeIndices[2]);
 			}
 
 			// Throw "Invalid Exception"
@@ -192,13 +185,13 @@ namespace NMR {
 
 			/*
 			if (bIsValid) {
-				MESHFACE * pFace = pMesh->addFace(pNodes[0], pNodes[1], pNodes[2]);
+				nfUint32 nFaceIndex = pMesh->appendFace(NodeIndices[0], NodeIndices[1], NodeIndices[2]);
 				if (pMeshInformation) {
 					nfUint32 nRed = (nfUint32) ((nfFloat) (Facet.m_attribute & 0x1f) / (255.0f / 31.0f));
 					nfUint32 nGreen = (nfUint32)((nfFloat)((Facet.m_attribute >> 5) & 0x1f) / (255.0f / 31.0f));
 					nfUint32 nBlue = (nfUint32)((nfFloat)((Facet.m_attribute >> 10) & 0x1f) / (255.0f / 31.0f));;
 
-					MESHINFORMATION_NODECOLOR * pNodeColorInfo = (MESHINFORMATION_NODECOLOR*)pMeshInformation->getFaceData(pFace->m_index);
+					MESHINFORMATION_NODECOLOR * pNodeColorInfo = (MESHINFORMATION_NODECOLOR*)pMeshInformation->getFaceData(nFaceIndex);
 					if ((Facet.m_attribute & 0x8000) == 0) {
 						pNodeColorInfo->m_cColors[0] = nRed + (nGreen << 8) + (nBlue << 16);
 					} else {
@@ -215,4 +208,61 @@ namespace NMR {
 
 	}
 
-}
\ No newline at end of file
+	nfBool CMeshImporter_STL::readFacet(_In_ CImportStream * pStream, _Out_ MESHFORMAT_STL_FACET & Facet)
+	{
+		pStream->readBuffer((nfByte*)&Facet, sizeof(Facet), true);
+		if (isBigEndian()) {
+			Facet.swapByteOrder();
+		}
+
+		// Check, if Coordinates are in Valid Space
+		nfBool bIsValid = true;
+		for (nfUint32 j = 0; j < 3; j++)
+			for (nfUint32 k = 0; k < 3; k++)
+				bIsValid &= (fabs(Facet.m_vertices[j].m_fields[k]) < NMR_MESH_MAXCOORDINATE);
+
+		return bIsValid;
+	}
+
+	void CMeshImporter_STL::loadMeshSorted(_In_ CMesh * pMesh, _In_opt_ NMATRIX3 * pmMatrix, _In_ nfUint32 nFaceCount)
+	{
+		CImportStream * pStream = getStream();
+		MESHFORMAT_STL_FACET Facet;
+
+		// Collect the positions of all facets in valid space, three per facet
+		std::vector<NVEC3> Positions;
+		for (nfUint32 nIdx = 0; nIdx < nFaceCount; nIdx++) {
+			if (readFacet(pStream, Facet)) {
+				for (nfUint32 j = 0; j < 3; j++) {
+					NVEC3 vPosition = Facet.m_vertices[j];
+					if (pmMatrix)
+						vPosition = fnMATRIX3_apply(*pmMatrix, vPosition);
+					Positions.push_back(vPosition);
+				}
+			}
+			else if (!m_bIgnoreInvalidFaces)
+				throw CNMRException(NMR_ERROR_INVALIDCOORDINATES);
+		}
+
+		std::vector<nfUint32> WeldedIndices;
+		std::vector<nfUint32> UniqueIndices;
+		fnVertexWeldSorted(Positions.data(), (nfUint32)Positions.size(), m_fUnits, WeldedIndices, UniqueIndices);
+
+		// Facets whose nodes are welded together are invalid, but their nodes are added nonetheless
+		if (!m_bIgnoreInvalidFaces) {
+			for (size_t nIdx = 0; nIdx < WeldedIndices.size(); nIdx += 3) {
+				if ((WeldedIndices[nIdx] == WeldedIndices[nIdx + 1]) || (WeldedIndices[nIdx] == WeldedIndices[nIdx + 2]) || (WeldedIndices[nIdx + 1] == WeldedIndices[nIdx + 2]))
+					throw CNMRException(NMR_ERROR_INVALIDCOORDINATES);
+			}
+		}
+
+		std::vector<nfFloat> Coordinates(UniqueIndices.size() * 3);
+		for (size_t nIdx = 0; nIdx < UniqueIndices.size(); nIdx++) {
+			const NVEC3 & vPosition = Positions[UniqueIndices[nIdx]];
+			for (nfUint32 k = 0; k < 3; k++)
+				Coordinates[nIdx * 3 + k] = vPosition.m_fields[k];
+		}
+		pMesh->addNodes(Coordinates.data(), (nfUint32)UniqueIndices.size());
+	}
+
+}
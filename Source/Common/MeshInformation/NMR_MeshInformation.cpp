@@ -48,9 +48,35 @@ namespace NMR {
 	{
 		if (!m_pContainer)
 			throw CNMRException(NMR_ERROR_NOMESHINFORMATIONCONTAINER);
+		makeContainerUnique();
 		return m_pContainer->getFaceData(nFaceIndex);
 	}
 
+	_Ret_notnull_ const MESHINFORMATIONFACEDATA * CMeshInformation::readFaceData(nfUint32 nFaceIndex)
+	{
+		if (!m_pContainer)
+			throw CNMRException(NMR_ERROR_NOMESHINFORMATIONCONTAINER);
+		return m_pContainer->getFaceData(nFaceIndex);
+	}
+
+	void CMeshInformation::shareFaceDataFrom(_In_ CMeshInformation * pOtherInformation)
+	{
+		if (!pOtherInformation)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+		if (pOtherInformation->getType() != getType())
+			throw CNMRException(NMR_ERROR_INVALIDMESHINFORMATION);
+		if (!pOtherInformation->m_pContainer)
+			throw CNMRException(NMR_ERROR_NOMESHINFORMATIONCONTAINER);
+
+		m_pContainer = pOtherInformation->m_pContainer;
+	}
+
+	void CMeshInformation::makeContainerUnique()
+	{
+		if (m_pContainer && (m_pContainer.use_count() > 1))
+			m_pContainer = std::make_shared<CMeshInformationContainer>(m_pContainer.get());
+	}
+
 	void CMeshInformation::resetFaceInformation(_In_ nfUint32 nFaceIndex)
 	{
 		MESHINFORMATIONFACEDATA * pData = getFaceData(nFaceIndex);
@@ -60,9 +86,18 @@ namespace NMR {
 
 	_Ret_notnull_ MESHINFORMATIONFACEDATA * CMeshInformation::addFaceData(_In_ nfUint32 nNewFaceCount)
 	{
+		makeContainerUnique();
 		return m_pContainer->addFaceData(nNewFaceCount);
 	}
 
+	void CMeshInformation::reserveFaceData(_In_ nfUint32 nFaceCount)
+	{
+		if (!m_pContainer)
+			throw CNMRException(NMR_ERROR_NOMESHINFORMATIONCONTAINER);
+		makeContainerUnique();
+		m_pContainer->reserveFaceData(nFaceCount);
+	}
+
 	void CMeshInformation::resetAllFaceInformation()
 	{
 		nfUint32 nCount = m_pContainer->getCurrentFaceCount();
@@ -73,6 +108,23 @@ namespace NMR {
 		}
 	}
 
+	void CMeshInformation::copyFaceDataFrom(_In_ nfUint32 nFaceIndex, _In_ CMeshInformation * pOtherInformation, _In_ nfUint32 nOtherFaceIndex, _In_ nfUint32 nCount)
+	{
+		if (!pOtherInformation)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+		if ((!m_pContainer) || (!pOtherInformation->m_pContainer))
+			throw CNMRException(NMR_ERROR_NOMESHINFORMATIONCONTAINER);
+
+		makeContainerUnique();
+		m_pContainer->copyFaceData(nFaceIndex, pOtherInformation->m_pContainer.get(), nOtherFaceIndex, nCount);
+	}
+
+	void CMeshInformation::cloneFaceInfoRangeFrom(_In_ nfUint32 nFaceIndex, _In_ CMeshInformation * pOtherInformation, _In_ nfUint32 nOtherFaceIndex, _In_ nfUint32 nCount)
+	{
+		for (nfUint32 nIndex = 0; nIndex < nCount; nIndex++)
+			cloneFaceInfosFrom(nFaceIndex + nIndex, pOtherInformation, nOtherFaceIndex + nIndex);
+	}
+
 	void CMeshInformation::setInternalID(nfUint64 nInternalID)
 	{
 		m_nInternalID = nInternalID;
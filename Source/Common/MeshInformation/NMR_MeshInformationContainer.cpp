@@ -34,7 +34,9 @@ information state of a complete mesh structure.
 
 #include "Common/MeshInformation/NMR_MeshInformationContainer.h" 
 #include "Common/NMR_Exception.h" 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 namespace NMR {
 
@@ -46,40 +48,66 @@ namespace NMR {
 	}
 
 	CMeshInformationContainer::CMeshInformationContainer(nfUint32 nCurrentFaceCount, nfUint32 nRecordSize)
+		: CMeshInformationContainer(nCurrentFaceCount, nRecordSize, nullptr)
+	{
+	}
+
+	CMeshInformationContainer::CMeshInformationContainer(nfUint32 nCurrentFaceCount, nfUint32 nRecordSize, _In_opt_ PMonotonicArena pArena)
 	{
 		m_nFaceCount = 0;
 		m_nRecordSize = nRecordSize;
 		m_CurrentDataBlock = NULL;
+		m_pArena = pArena;
+
+		if (nCurrentFaceCount > 0)
+			reserveFaceData(nCurrentFaceCount);
 
 		nfUint32 nIdx;
 		for (nIdx = 1; nIdx <= nCurrentFaceCount; nIdx++)
 			addFaceData(nIdx);
 	}
 
+	CMeshInformationContainer::CMeshInformationContainer(_In_ CMeshInformationContainer * pOtherContainer)
+		: CMeshInformationContainer(pOtherContainer->m_nFaceCount, pOtherContainer->m_nRecordSize)
+	{
+		copyFaceData(0, pOtherContainer, 0, m_nFaceCount);
+	}
+
 	CMeshInformationContainer::~CMeshInformationContainer()
 	{
 		clear();
 	}
 
-	_Ret_notnull_ MESHINFORMATIONFACEDATA * CMeshInformationContainer::addFaceData(nfUint32 nNewFaceCount)
+	_Ret_notnull_ MESHINFORMATIONFACEDATA * CMeshInformationContainer::allocateData(size_t nCount)
 	{
-		nfUint32 j, nPageSize;
-		MESHINFORMATIONFACEDATA * pByte;
+		if (m_pArena) {
+			MESHINFORMATIONFACEDATA * pData = static_cast<MESHINFORMATIONFACEDATA *> (m_pArena->allocate(nCount * sizeof(MESHINFORMATIONFACEDATA), sizeof(nfUint64)));
+			memset(pData, 0, nCount * sizeof(MESHINFORMATIONFACEDATA));
+			return pData;
+		}
 
+		m_Allocations.reserve(m_Allocations.size() + 1);
+		MESHINFORMATIONFACEDATA * pData = new MESHINFORMATIONFACEDATA[nCount]();
+		m_Allocations.push_back(pData);
+		return pData;
+	}
+
+	_Ret_notnull_ MESHINFORMATIONFACEDATA * CMeshInformationContainer::addFaceData(nfUint32 nNewFaceCount)
+	{
 		if (m_nRecordSize == 0)
 			throw CNMRException(NMR_ERROR_INVALIDRECORDSIZE);
 
 		nfUint32 nIdx = m_nFaceCount % MESHINFORMATIONCOUNTER_BUFFERSIZE;
 		if (nIdx == 0) {
-			nPageSize = m_nRecordSize * MESHINFORMATIONCOUNTER_BUFFERSIZE;
-			m_CurrentDataBlock = new MESHINFORMATIONFACEDATA[nPageSize];
-
-			m_DataBlocks.push_back(m_CurrentDataBlock);
-
-			pByte = m_CurrentDataBlock;
-			for (j = 0; j < nPageSize; j++) {
-				*pByte = 0;
-				pByte++;
+			nfUint32 nBlockIdx = m_nFaceCount / MESHINFORMATIONCOUNTER_BUFFERSIZE;
+			if (nBlockIdx < m_DataBlocks.size()) {
+				// Reserved blocks are zeroed already
+				m_CurrentDataBlock = m_DataBlocks[nBlockIdx];
+			}
+			else {
+				m_DataBlocks.reserve(m_DataBlocks.size() + 1);
+				m_CurrentDataBlock = allocateData((size_t)m_nRecordSize * MESHINFORMATIONCOUNTER_BUFFERSIZE);
+				m_DataBlocks.push_back(m_CurrentDataBlock);
 			}
 		}
 
@@ -107,6 +135,49 @@ namespace NMR {
 		return &pBlock[m_nRecordSize * nModIdx];
 	}
 
+	void CMeshInformationContainer::reserveFaceData(nfUint32 nFaceCount)
+	{
+		if (m_nRecordSize == 0)
+			throw CNMRException(NMR_ERROR_INVALIDRECORDSIZE);
+
+		size_t nBlockCount = ((size_t)nFaceCount + MESHINFORMATIONCOUNTER_BUFFERSIZE - 1) / MESHINFORMATIONCOUNTER_BUFFERSIZE;
+		if (nBlockCount <= m_DataBlocks.size())
+			return;
+
+		size_t nNewBlockCount = nBlockCount - m_DataBlocks.size();
+		size_t nPageSize = (size_t)m_nRecordSize * MESHINFORMATIONCOUNTER_BUFFERSIZE;
+		m_DataBlocks.reserve(nBlockCount);
+		MESHINFORMATIONFACEDATA * pAllocation = allocateData(nNewBlockCount * nPageSize);
+
+		for (size_t nIndex = 0; nIndex < nNewBlockCount; nIndex++)
+			m_DataBlocks.push_back(&pAllocation[nIndex * nPageSize]);
+	}
+
+	void CMeshInformationContainer::copyFaceData(nfUint32 nFaceIndex, _In_ CMeshInformationContainer * pOtherContainer, nfUint32 nOtherFaceIndex, nfUint32 nCount)
+	{
+		if (!pOtherContainer)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+		if (pOtherContainer->m_nRecordSize != m_nRecordSize)
+			throw CNMRException(NMR_ERROR_INVALIDRECORDSIZE);
+		if (((nfUint64)nFaceIndex + nCount > m_nFaceCount) || ((nfUint64)nOtherFaceIndex + nCount > pOtherContainer->m_nFaceCount))
+			throw CNMRException(NMR_ERROR_INVALIDMESHINFORMATIONINDEX);
+
+		// Copy runs which do not cross a block boundary in either container
+		while (nCount > 0) {
+			nfUint32 nModIdx = nFaceIndex % MESHINFORMATIONCOUNTER_BUFFERSIZE;
+			nfUint32 nOtherModIdx = nOtherFaceIndex % MESHINFORMATIONCOUNTER_BUFFERSIZE;
+			nfUint32 nRunCount = std::min(nCount, MESHINFORMATIONCOUNTER_BUFFERSIZE - std::max(nModIdx, nOtherModIdx));
+
+			MESHINFORMATIONFACEDATA * pTarget = &m_DataBlocks[nFaceIndex / MESHINFORMATIONCOUNTER_BUFFERSIZE][m_nRecordSize * nModIdx];
+			const MESHINFORMATIONFACEDATA * pSource = &pOtherContainer->m_DataBlocks[nOtherFaceIndex / MESHINFORMATIONCOUNTER_BUFFERSIZE][m_nRecordSize * nOtherModIdx];
+			memmove(pTarget, pSource, (size_t)m_nRecordSize * nRunCount);
+
+			nFaceIndex += nRunCount;
+			nOtherFaceIndex += nRunCount;
+			nCount -= nRunCount;
+		}
+	}
+
 	nfUint32 CMeshInformationContainer::getCurrentFaceCount()
 	{
 		return m_nFaceCount;
@@ -114,13 +185,17 @@ namespace NMR {
 
 	void CMeshInformationContainer::clear()
 	{
-		std::vector<MESHINFORMATIONFACEDATA *>::iterator iter = m_DataBlocks.begin ();
-		while (iter != m_DataBlocks.end()){
-			MESHINFORMATIONFACEDATA * pBlock = *iter;
-			delete[] pBlock;
+		std::vector<MESHINFORMATIONFACEDATA *>::iterator iter = m_Allocations.begin ();
+		while (iter != m_Allocations.end()){
+			MESHINFORMATIONFACEDATA * pAllocation = *iter;
+			delete[] pAllocation;
 			iter++;
 		}
 
+		m_Allocations.clear();
+		m_DataBlocks.clear();
+		m_pArena.reset();
+
 		m_nFaceCount = 0;
 		m_nRecordSize = 0;
 		m_CurrentDataBlock = NULL;
@@ -78,6 +78,12 @@ namespace NMR {
 		}
 	}
 
+	void CMeshInformationHandler::reserveFaces(_In_ nfUint32 nFaceCount)
+	{
+		for (auto iter = m_pInformations.begin(); iter != m_pInformations.end(); iter++)
+			(*iter)->reserveFaceData(nFaceCount);
+	}
+
 	CMeshInformation * CMeshInformationHandler::getInformationIndexed(_In_ nfUint32 nIdx)
 	{
 		if (nIdx >= (nfUint32)m_pInformations.size())
@@ -115,6 +121,23 @@ namespace NMR {
 		}
 	}
 
+	void CMeshInformationHandler::shareInfoTableFrom(_In_ CMeshInformationHandler * pOtherInfoHandler)
+	{
+		__NMRASSERT(pOtherInfoHandler);
+		if (!m_pInformations.empty())
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		nfInt32 eType;
+		for (eType = emiAbstract; eType < emiLastType; eType++) {
+			CMeshInformation * pOtherInformation = pOtherInfoHandler->m_pLookup[eType];
+			if (pOtherInformation) {
+				PMeshInformation pInformation = pOtherInformation->cloneInstance(0);
+				pInformation->shareFaceDataFrom(pOtherInformation);
+				addInformation(pInformation);
+			}
+		}
+	}
+
 	void CMeshInformationHandler::cloneDefaultInfosFrom(_In_ CMeshInformationHandler * pOtherInfoHandler)
 	{
 		nfInt32 eType;
@@ -133,6 +156,15 @@ namespace NMR {
 		}
 	}
 
+	void CMeshInformationHandler::cloneFaceInfoRangeFrom(_In_ nfUint32 nFaceIdx, _In_ CMeshInformationHandler * pOtherInfoHandler, _In_ nfUint32 nOtherFaceIndex, _In_ nfUint32 nCount)
+	{
+		nfInt32 eType;
+		for (eType = emiAbstract; eType < emiLastType; eType++) {
+			if ((pOtherInfoHandler->m_pLookup[eType]) && (m_pLookup[eType]))
+				m_pLookup[eType]->cloneFaceInfoRangeFrom(nFaceIdx, pOtherInfoHandler->m_pLookup[eType], nOtherFaceIndex, nCount);
+		}
+	}
+
 	void CMeshInformationHandler::permuteNodeInformation(_In_ nfUint32 nFaceIdx, _In_ nfUint32 nNodeIndex1, _In_ nfUint32 nNodeIndex2, _In_ nfUint32 nNodeIndex3)
 	{
 		std::vector<PMeshInformation>::iterator iter = m_pInformations.begin();
@@ -90,9 +90,14 @@ namespace NMR {
 	}
 
 	CMeshInformation_Properties::CMeshInformation_Properties(nfUint32 nCurrentFaceCount)
+		: CMeshInformation_Properties(nCurrentFaceCount, nullptr)
+	{
+	}
+
+	CMeshInformation_Properties::CMeshInformation_Properties(nfUint32 nCurrentFaceCount, _In_opt_ PMonotonicArena pArena)
 	{
 		nfUint32 nIdx;
-		m_pContainer = std::make_shared<CMeshInformationContainer>(nCurrentFaceCount, (nfUint32) sizeof(MESHINFORMATION_PROPERTIES));
+		m_pContainer = std::make_shared<CMeshInformationContainer>(nCurrentFaceCount, (nfUint32) sizeof(MESHINFORMATION_PROPERTIES), pArena);
 		for (nIdx = 0; nIdx < nCurrentFaceCount; nIdx++)
 			invalidateFace(m_pContainer->getFaceData(nIdx));
 	}
@@ -137,7 +142,7 @@ namespace NMR {
 		__NMRASSERT(pOtherInformation);
 
 		MESHINFORMATION_PROPERTIES * pTargetFaceData = (MESHINFORMATION_PROPERTIES*)getFaceData(nFaceIndex);
-		MESHINFORMATION_PROPERTIES * pSourceFaceData = (MESHINFORMATION_PROPERTIES*)pOtherInformation->getFaceData(nOtherFaceIndex);
+		const MESHINFORMATION_PROPERTIES * pSourceFaceData = (const MESHINFORMATION_PROPERTIES*)pOtherInformation->readFaceData(nOtherFaceIndex);
 
 		if (pTargetFaceData && pSourceFaceData) {
 			for (nfUint32 j = 0; j < 3; j++)
@@ -147,6 +152,14 @@ namespace NMR {
 		}
 	}
 
+	void CMeshInformation_Properties::cloneFaceInfoRangeFrom(_In_ nfUint32 nFaceIndex, _In_ CMeshInformation * pOtherInformation, _In_ nfUint32 nOtherFaceIndex, _In_ nfUint32 nCount)
+	{
+		__NMRASSERT(pOtherInformation);
+
+		// Cloning a face copies its whole record
+		copyFaceDataFrom(nFaceIndex, pOtherInformation, nOtherFaceIndex, nCount);
+	}
+
 	PMeshInformation CMeshInformation_Properties::cloneInstance(_In_ nfUint32 nCurrentFaceCount)
 	{
 		return std::make_shared<CMeshInformation_Properties>(nCurrentFaceCount);
@@ -177,7 +190,7 @@ namespace NMR {
 
 	nfBool CMeshInformation_Properties::faceHasData(_In_ nfUint32 nFaceIndex)
 	{
-		MESHINFORMATION_PROPERTIES * pFaceData = (MESHINFORMATION_PROPERTIES*)getFaceData(nFaceIndex);
+		const MESHINFORMATION_PROPERTIES * pFaceData = (const MESHINFORMATION_PROPERTIES*)readFaceData(nFaceIndex);
 		if (pFaceData)
 			return (pFaceData->m_nResourceID != 0);
 
@@ -0,0 +1,103 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_MonotonicArena.cpp implements the CMonotonicArena Class, which hands out memory
+from large blocks and frees all of them at once.
+
+--*/
+
+#include "Common/NMR_MonotonicArena.h"
+#include "Common/NMR_Exception.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+namespace NMR {
+
+	CMonotonicArena::CMonotonicArena()
+		: CMonotonicArena(NMR_MONOTONICARENA_BLOCKSIZE)
+	{
+	}
+
+	CMonotonicArena::CMonotonicArena(_In_ size_t nFirstBlockSize)
+		: m_pCurrent(nullptr), m_nRemaining(0), m_nBlockSize(nFirstBlockSize), m_nReservedSize(0)
+	{
+		if ((nFirstBlockSize == 0) || (nFirstBlockSize > NMR_MONOTONICARENA_BLOCKSIZE))
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+	}
+
+	CMonotonicArena::~CMonotonicArena()
+	{
+		for (auto iBlock = m_Blocks.begin(); iBlock != m_Blocks.end(); iBlock++)
+			::operator delete(*iBlock);
+	}
+
+	_Ret_notnull_ nfByte * CMonotonicArena::allocateBlock(_In_ size_t cbSize)
+	{
+		m_Blocks.reserve(m_Blocks.size() + 1);
+		nfByte * pBlock = static_cast<nfByte *>(::operator new(cbSize));
+		m_Blocks.push_back(pBlock);
+		m_nReservedSize += cbSize;
+		return pBlock;
+	}
+
+	_Ret_notnull_ void * CMonotonicArena::allocate(_In_ size_t cbSize, _In_ size_t nAlignment)
+	{
+		if ((nAlignment == 0) || ((nAlignment & (nAlignment - 1)) != 0) || (nAlignment > std::alignment_of<std::max_align_t>::value))
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+
+		// Large allocations do not waste the rest of the current block
+		if (cbSize > NMR_MONOTONICARENA_BLOCKSIZE / 4)
+			return allocateBlock(cbSize);
+
+		size_t nPadding = (nAlignment - ((size_t)m_pCurrent & (nAlignment - 1))) & (nAlignment - 1);
+		if ((m_pCurrent == nullptr) || (nPadding + cbSize > m_nRemaining)) {
+			while (m_nBlockSize < cbSize)
+				m_nBlockSize *= 2;
+			m_pCurrent = allocateBlock(m_nBlockSize);
+			m_nRemaining = m_nBlockSize;
+			m_nBlockSize = std::min(m_nBlockSize * 2, (size_t)NMR_MONOTONICARENA_BLOCKSIZE);
+			nPadding = 0;
+		}
+
+		nfByte * pResult = m_pCurrent + nPadding;
+		m_pCurrent = pResult + cbSize;
+		m_nRemaining -= nPadding + cbSize;
+		return pResult;
+	}
+
+	nfUint64 CMonotonicArena::getReservedSize()
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		return m_nReservedSize;
+	}
+
+}
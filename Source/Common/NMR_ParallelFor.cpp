@@ -0,0 +1,108 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_ParallelFor.cpp implements the chunked processing of element ranges on worker threads.
+
+--*/
+
+#include "Common/NMR_ParallelFor.h"
+#include "Common/NMR_Exception.h"
+
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace NMR {
+
+	nfUint32 fnParallelGetChunkCount(_In_ nfUint64 nCount, _In_ nfUint64 nMinChunkSize)
+	{
+		if (nMinChunkSize == 0)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		if (nCount == 0)
+			return 0;
+
+		nfUint64 nThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+		return (nfUint32)std::max(std::min(nThreadCount, nCount / nMinChunkSize), (nfUint64)1);
+	}
+
+	nfUint64 fnParallelGetChunkStart(_In_ nfUint64 nCount, _In_ nfUint32 nChunkCount, _In_ nfUint32 nChunkIndex)
+	{
+		if ((nChunkCount == 0) || (nChunkIndex > nChunkCount))
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		// Chunk sizes differ by at most one element
+		return (nCount / nChunkCount) * nChunkIndex + std::min((nfUint64)nChunkIndex, nCount % nChunkCount);
+	}
+
+	void fnParallelForChunks(_In_ nfUint32 nChunkCount, _In_ const std::function<void(nfUint32 nChunkIndex)> & fnChunk)
+	{
+		if (!fnChunk)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		if (nChunkCount == 0)
+			return;
+
+		if (nChunkCount == 1) {
+			fnChunk(0);
+			return;
+		}
+
+		std::vector<std::exception_ptr> Exceptions(nChunkCount);
+		auto runChunk = [&fnChunk, &Exceptions](nfUint32 nChunkIndex) {
+			try {
+				fnChunk(nChunkIndex);
+			}
+			catch (...) {
+				Exceptions[nChunkIndex] = std::current_exception();
+			}
+		};
+
+		std::vector<std::thread> Threads;
+		for (nfUint32 nChunkIndex = 1; nChunkIndex < nChunkCount; nChunkIndex++) {
+			try {
+				Threads.push_back(std::thread(runChunk, nChunkIndex));
+			}
+			catch (std::system_error &) {
+				// No more threads available, the calling thread takes over
+				runChunk(nChunkIndex);
+			}
+		}
+		runChunk(0);
+		for (auto iThread = Threads.begin(); iThread != Threads.end(); iThread++)
+			iThread->join();
+
+		for (auto iException = Exceptions.begin(); iException != Exceptions.end(); iException++) {
+			if (*iException)
+				std::rethrow_exception(*iException);
+		}
+	}
+
+}
@@ -33,6 +33,7 @@ correctly and Exception-safe
 
 #include "Common/NMR_StringUtils.h"
 #include "Common/NMR_Exception.h"
+#include "Common/NMR_NumberParser.h"
 #include <climits>
 #include <sstream>
 #include <cmath>
@@ -103,18 +104,16 @@ namespace NMR {
 		nfInt64 nResult = 0;
 
 		// Convert to integer and make a input and range check!
-		nfChar * pEndPtr;
-
-		nResult = strtol(pszValue, &pEndPtr, 10);
+		const nfChar * pEndPtr = fnParseInt64(pszValue, nResult);
 
 		// Check if any conversion happened
-		if ((pEndPtr == pszValue) || (!pEndPtr))
+		if (pEndPtr == pszValue)
 			throw CNMRException(NMR_ERROR_EMPTYSTRINGTOINTCONVERSION);
 
 		if ((*pEndPtr != '\0') && (*pEndPtr != ' '))
 			throw CNMRException(NMR_ERROR_INVALIDSTRINGTOINTCONVERSION);
 
-		if ((nResult >= LONG_MAX) || (nResult <= LONG_MIN))
+		if ((nResult > INT_MAX) || (nResult < INT_MIN))
 			throw CNMRException(NMR_ERROR_STRINGTOINTCONVERSIONOUTOFRANGE);
 
 		return (nfInt32)nResult;
@@ -123,21 +122,19 @@ namespace NMR {
 	nfUint32 fnStringToUint32(_In_z_ const nfChar * pszValue)
 	{
 		__NMRASSERT(pszValue);
-		nfUint64 nResult = 0;
+		nfInt64 nResult = 0;
 
 		// Convert to integer and make a input and range check!
-		nfChar * pEndPtr;
-
-		nResult = strtoul(pszValue, &pEndPtr, 10);
+		const nfChar * pEndPtr = fnParseInt64(pszValue, nResult);
 
 		// Check if any conversion happened
-		if ((pEndPtr == pszValue) || (!pEndPtr))
+		if (pEndPtr == pszValue)
 			throw CNMRException(NMR_ERROR_EMPTYSTRINGTOINTCONVERSION);
 
 		if ((*pEndPtr != '\0') && (*pEndPtr != ' '))
 			throw CNMRException(NMR_ERROR_INVALIDSTRINGTOINTCONVERSION);
 
-		if (nResult >= ULONG_MAX)
+		if ((nResult > UINT_MAX) || (nResult < 0))
 			throw CNMRException(NMR_ERROR_STRINGTOINTCONVERSIONOUTOFRANGE);
 
 		return (nfUint32)nResult;
@@ -145,27 +142,41 @@ namespace NMR {
 
 	nfFloat fnStringToFloat(_In_z_ const nfChar * pszValue)
 	{
-		return (nfFloat)fnStringToDouble(pszValue);
+		__NMRASSERT(pszValue);
+		nfFloat fResult = 0.0f;
+
+		// Convert to float and make a input and range check!
+		const nfChar * pEndPtr = fnParseFloat(pszValue, fResult);
+
+		// Check if any conversion happened
+		if (pEndPtr == pszValue)
+			throw CNMRException(NMR_ERROR_EMPTYSTRINGTODOUBLECONVERSION);
+
+		if ((*pEndPtr != '\0') && (*pEndPtr != ' '))
+			throw CNMRException(NMR_ERROR_INVALIDSTRINGTODOUBLECONVERSION);
+
+		if (std::isinf(fResult))
+			throw CNMRException(NMR_ERROR_STRINGTODOUBLECONVERSIONOUTOFRANGE);
+
+		return fResult;
 	}
 
 	nfDouble fnStringToDouble(_In_z_ const nfChar * pszValue)
 	{
-		__NMRASSERT(pwszValue);
+		__NMRASSERT(pszValue);
 		nfDouble dResult = 0.0;
 
 		// Convert to double and make a input and range check!
-		nfChar * pEndPtr;
-
-		dResult = strtod(pszValue, &pEndPtr);
+		const nfChar * pEndPtr = fnParseDouble(pszValue, dResult);
 
 		// Check if any conversion happened
-		if ((pEndPtr == pszValue) || (!pEndPtr))
+		if (pEndPtr == pszValue)
 			throw CNMRException(NMR_ERROR_EMPTYSTRINGTODOUBLECONVERSION);
 
 		if ((*pEndPtr != '\0') && (*pEndPtr != ' '))
 			throw CNMRException(NMR_ERROR_INVALIDSTRINGTODOUBLECONVERSION);
 
-		if ((dResult == HUGE_VAL) || (dResult == -HUGE_VAL))
+		if (std::isinf(dResult))
 			throw CNMRException(NMR_ERROR_STRINGTODOUBLECONVERSIONOUTOFRANGE);
 
 		return dResult;
@@ -285,25 +296,23 @@ namespace NMR {
 
 	nfInt32 fnStringToInt32Comma(_In_z_ const nfChar * pszValue)
 	{
-		__NMRASSERT(pwszValue);
+		__NMRASSERT(pszValue);
 		nfInt64 nResult = 0;
 
 		// Convert to integer and make a input and range check!
-		nfChar * pEndPtr;
-
-		nResult = strtol(pszValue, &pEndPtr, 10);
+		const nfChar * pEndPtr = fnParseInt64(pszValue, nResult);
 
 		// Check if any conversion happened
-		if ((pEndPtr == pszValue) || (!pEndPtr))
+		if (pEndPtr == pszValue)
 			throw CNMRException(NMR_ERROR_EMPTYSTRINGTOINTCONVERSION);
 
 		if ((*pEndPtr != '\0') && (*pEndPtr != ' ') && (*pEndPtr != ','))
 			throw CNMRException(NMR_ERROR_INVALIDSTRINGTOINTCONVERSION);
 
-		if ((nResult >= LONG_MAX) || (nResult <= LONG_MIN))
+		if ((nResult > INT_MAX) || (nResult < INT_MIN))
 			throw CNMRException(NMR_ERROR_STRINGTOINTCONVERSIONOUTOFRANGE);
 
-		return (nfUint32)nResult;
+		return (nfInt32)nResult;
 	}
 
 
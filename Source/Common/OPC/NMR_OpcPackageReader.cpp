@@ -34,6 +34,7 @@ NMR_OpcPackageReader.cpp defines an OPC Package reader in a portable way.
 #include "Common/OPC/NMR_OpcPackageRelationshipReader.h" 
 #include "Common/OPC/NMR_OpcPackageContentTypesReader.h" 
 #include "Common/Platform/NMR_ImportStream_ZIP.h" 
+#include "Common/Platform/NMR_ImportStream_MMap.h" 
 #include "Common/NMR_Exception.h" 
 #include "Common/NMR_StringUtils.h" 
 
@@ -126,8 +127,14 @@ namespace NMR {
 			// create ZIP objects
 			zip_error_init(&m_ZIPError);
 
+			CImportStream_MMap * pMappedStream = dynamic_cast<CImportStream_MMap *> (pImportStream.get());
 			bool bUseCallback = true;
-			if (bUseCallback) {
+			if (pMappedStream != nullptr) {
+				// read ZIP directly from the mapped file: no data is copied
+				m_pMappedStream = pImportStream;
+				m_ZIPsource = zip_source_buffer_create(pMappedStream->getData(), (size_t)nStreamSize, 0, &m_ZIPError);
+			}
+			else if (bUseCallback) {
 				// read ZIP from callback: faster and requires less memory
 				m_ZIPsource = zip_source_function_create(custom_zip_source_callback, pImportStream.get(), &m_ZIPError);
 			}
@@ -220,6 +227,7 @@ namespace NMR {
 
 		zip_error_fini(&m_ZIPError);
 		m_Buffer.resize(0);
+		m_pMappedStream = nullptr;
 
 		m_ZIPsource = nullptr;
 		m_ZIParchive = nullptr;
@@ -0,0 +1,190 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_ImportStream_MMap.cpp implements the CImportStream_MMap Class.
+This is a platform independent class for reading from a memory mapped file.
+Copies to memory are zero-copy views that keep the mapping alive.
+
+--*/
+
+#include "Common/Platform/NMR_ImportStream_MMap.h"
+#include "Common/NMR_Exception.h"
+#include "Common/NMR_Exception_Windows.h"
+#include "Common/NMR_StringUtils.h"
+
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // _WIN32
+
+namespace NMR {
+
+	CMemoryMappedFile::CMemoryMappedFile(_In_ const nfWChar * pwszFileName)
+	{
+		if (pwszFileName == nullptr)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		m_pData = nullptr;
+		m_cbSize = 0;
+
+#ifdef _WIN32
+		m_hMapping = nullptr;
+		m_hFile = CreateFileW(pwszFileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (m_hFile == INVALID_HANDLE_VALUE)
+			throw CNMRException(NMR_ERROR_COULDNOTOPENFILE);
+
+		LARGE_INTEGER nFileSize;
+		if (!GetFileSizeEx(m_hFile, &nFileSize)) {
+			CloseHandle(m_hFile);
+			throw CNMRException_Windows(NMR_ERROR_COULDNOTREADSTREAM, GetLastError());
+		}
+		m_cbSize = (nfUint64)nFileSize.QuadPart;
+
+		// Empty files can not be mapped
+		if (m_cbSize > 0) {
+			m_hMapping = CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (m_hMapping == nullptr) {
+				CloseHandle(m_hFile);
+				throw CNMRException_Windows(NMR_ERROR_COULDNOTREADSTREAM, GetLastError());
+			}
+
+			m_pData = (const nfByte *)MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+			if (m_pData == nullptr) {
+				CloseHandle(m_hMapping);
+				CloseHandle(m_hFile);
+				throw CNMRException_Windows(NMR_ERROR_COULDNOTREADSTREAM, GetLastError());
+			}
+		}
+#else
+		std::string sUTF8FileName = fnUTF16toUTF8(pwszFileName);
+		int nFileDescriptor = open(sUTF8FileName.c_str(), O_RDONLY);
+		if (nFileDescriptor < 0)
+			throw CNMRException(NMR_ERROR_COULDNOTOPENFILE);
+
+		struct stat FileStat;
+		if ((fstat(nFileDescriptor, &FileStat) != 0) || (!S_ISREG(FileStat.st_mode))) {
+			close(nFileDescriptor);
+			throw CNMRException(NMR_ERROR_COULDNOTREADSTREAM);
+		}
+		m_cbSize = (nfUint64)FileStat.st_size;
+
+		if ((sizeof(size_t) < sizeof(nfUint64)) && (m_cbSize > (nfUint64)SIZE_MAX)) {
+			close(nFileDescriptor);
+			throw CNMRException(NMR_ERROR_INVALIDBUFFERSIZE);
+		}
+
+		// Empty files can not be mapped
+		if (m_cbSize > 0) {
+			void * pData = mmap(nullptr, (size_t)m_cbSize, PROT_READ, MAP_PRIVATE, nFileDescriptor, 0);
+			if (pData == MAP_FAILED) {
+				close(nFileDescriptor);
+				throw CNMRException(NMR_ERROR_COULDNOTREADSTREAM);
+			}
+#ifdef MADV_SEQUENTIAL
+			madvise(pData, (size_t)m_cbSize, MADV_SEQUENTIAL);
+#endif // MADV_SEQUENTIAL
+			m_pData = (const nfByte *)pData;
+		}
+
+		// The mapping stays valid after closing the descriptor
+		close(nFileDescriptor);
+#endif // _WIN32
+	}
+
+	CMemoryMappedFile::~CMemoryMappedFile()
+	{
+#ifdef _WIN32
+		if (m_pData != nullptr)
+			UnmapViewOfFile(m_pData);
+		if (m_hMapping != nullptr)
+			CloseHandle(m_hMapping);
+		if (m_hFile != INVALID_HANDLE_VALUE)
+			CloseHandle(m_hFile);
+#else
+		if (m_pData != nullptr)
+			munmap((void *)m_pData, (size_t)m_cbSize);
+#endif // _WIN32
+
+		m_pData = nullptr;
+		m_cbSize = 0;
+	}
+
+	const nfByte * CMemoryMappedFile::getData()
+	{
+		return m_pData;
+	}
+
+	nfUint64 CMemoryMappedFile::getSize()
+	{
+		return m_cbSize;
+	}
+
+	CImportStream_MMap::CImportStream_MMap(_In_ const nfWChar * pwszFileName)
+	{
+		m_pMappedFile = std::make_shared<CMemoryMappedFile>(pwszFileName);
+
+		m_Buffer = m_pMappedFile->getData();
+		m_cbSize = m_pMappedFile->getSize();
+		m_nPosition = 0;
+	}
+
+	CImportStream_MMap::CImportStream_MMap(_In_ PMemoryMappedFile pMappedFile, _In_ nfUint64 nOffset, _In_ nfUint64 cbBytes)
+	{
+		if (!pMappedFile)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		nfUint64 cbMappedSize = pMappedFile->getSize();
+		if ((nOffset > cbMappedSize) || (cbBytes > cbMappedSize - nOffset))
+			throw CNMRException(NMR_ERROR_INVALIDBUFFERSIZE);
+
+		m_pMappedFile = pMappedFile;
+		m_Buffer = (cbBytes > 0) ? (m_pMappedFile->getData() + nOffset) : nullptr;
+		m_cbSize = cbBytes;
+		m_nPosition = 0;
+	}
+
+	PImportStream CImportStream_MMap::copyToMemory()
+	{
+		__NMRASSERT(m_nPosition <= m_cbSize);
+
+		// The view shares the mapping, no data is copied
+		nfUint64 nOffset = (m_Buffer != nullptr) ? (nfUint64)(m_Buffer - m_pMappedFile->getData()) : 0;
+		return std::make_shared<CImportStream_MMap>(m_pMappedFile, nOffset + m_nPosition, m_cbSize - m_nPosition);
+	}
+
+	__NMR_INLINE const nfByte * CImportStream_MMap::getAt(nfUint64 nPosition) {
+		return &m_Buffer[nPosition];
+	}
+
+}
@@ -0,0 +1,226 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_ImportStream_Pipelined.cpp implements the CImportStream_Pipelined Class.
+The producer thread owns every chunk that is not filled. It blocks while all chunks
+are filled, the consumer blocks while none is. Errors of the source stream are
+passed on to the consumer once it has read all data before them.
+
+--*/
+
+#include "Common/Platform/NMR_ImportStream_Pipelined.h"
+#include "Common/Platform/NMR_ImportStream_Unique_Memory.h"
+#include "Common/NMR_Exception.h"
+#include "Common/NMR_Exception_Windows.h"
+
+#include <cstring>
+
+namespace NMR {
+
+	CImportStream_Pipelined::CImportStream_Pipelined(_In_ PImportStream pSourceStream)
+	{
+		if (pSourceStream.get() == nullptr)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		m_pSourceStream = pSourceStream;
+		m_nSize = pSourceStream->retrieveSize();
+		m_nPosition = 0;
+
+		m_Chunks.resize(NMR_IMPORTSTREAM_PIPELINED_CHUNKCOUNT);
+		for (auto & Chunk : m_Chunks)
+			Chunk.resize(NMR_IMPORTSTREAM_PIPELINED_CHUNKSIZE);
+		m_ChunkSizes.resize(NMR_IMPORTSTREAM_PIPELINED_CHUNKCOUNT, 0);
+
+		m_nReadChunk = 0;
+		m_nReadOffset = 0;
+		m_bHoldsChunk = false;
+
+		m_nFilledChunks = 0;
+		m_bSourceFinished = false;
+		m_bStopProducer = false;
+
+		m_ProducerThread = std::thread(&CImportStream_Pipelined::produceChunks, this);
+	}
+
+	CImportStream_Pipelined::~CImportStream_Pipelined()
+	{
+		stopProducer();
+	}
+
+	nfBool CImportStream_Pipelined::isWorthPipelining(_In_ nfUint64 nSize)
+	{
+		if (nSize < NMR_IMPORTSTREAM_PIPELINED_MINSIZE)
+			return false;
+
+		return std::thread::hardware_concurrency() > 1;
+	}
+
+	void CImportStream_Pipelined::produceChunks()
+	{
+		nfUint32 nWriteChunk = 0;
+
+		try {
+			while (true) {
+				{
+					std::unique_lock<std::mutex> Lock(m_Mutex);
+					m_ChunkReleased.wait(Lock, [this] { return m_bStopProducer || (m_nFilledChunks < NMR_IMPORTSTREAM_PIPELINED_CHUNKCOUNT); });
+					if (m_bStopProducer)
+						return;
+				}
+
+				// The chunk is not filled, so the consumer does not touch it
+				nfUint64 cbBytesRead = m_pSourceStream->readBuffer(m_Chunks[nWriteChunk].data(), NMR_IMPORTSTREAM_PIPELINED_CHUNKSIZE, false);
+				nfBool bFinished = (cbBytesRead < NMR_IMPORTSTREAM_PIPELINED_CHUNKSIZE);
+
+				{
+					std::lock_guard<std::mutex> Lock(m_Mutex);
+					m_ChunkSizes[nWriteChunk] = cbBytesRead;
+					m_nFilledChunks++;
+					m_bSourceFinished = bFinished;
+				}
+				m_ChunkFilled.notify_one();
+
+				if (bFinished)
+					return;
+
+				nWriteChunk = (nWriteChunk + 1) % NMR_IMPORTSTREAM_PIPELINED_CHUNKCOUNT;
+			}
+		}
+		catch (...) {
+			{
+				std::lock_guard<std::mutex> Lock(m_Mutex);
+				m_pProducerException = std::current_exception();
+				m_bSourceFinished = true;
+			}
+			m_ChunkFilled.notify_one();
+		}
+	}
+
+	void CImportStream_Pipelined::stopProducer()
+	{
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			m_bStopProducer = true;
+		}
+		m_ChunkReleased.notify_one();
+
+		if (m_ProducerThread.joinable())
+			m_ProducerThread.join();
+	}
+
+	nfBool CImportStream_Pipelined::seekPosition(_In_ nfUint64 position, _In_ nfBool bHasToSucceed)
+	{
+		throw CNMRException(NMR_ERROR_COULDNOTSEEKSTREAM);
+	}
+
+	nfBool CImportStream_Pipelined::seekForward(_In_ nfUint64 bytes, _In_ nfBool bHasToSucceed)
+	{
+		throw CNMRException(NMR_ERROR_COULDNOTSEEKSTREAM);
+	}
+
+	nfBool CImportStream_Pipelined::seekFromEnd(_In_ nfUint64 bytes, _In_ nfBool bHasToSucceed)
+	{
+		throw CNMRException(NMR_ERROR_COULDNOTSEEKSTREAM);
+	}
+
+	nfUint64 CImportStream_Pipelined::getPosition()
+	{
+		return m_nPosition;
+	}
+
+	nfUint64 CImportStream_Pipelined::readBuffer(_In_ nfByte * pBuffer, _In_ nfUint64 cbTotalBytesToRead, nfBool bNeedsToReadAll)
+	{
+		if ((pBuffer == nullptr) && (cbTotalBytesToRead > 0))
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		nfUint64 cbBytesRead = 0;
+		while (cbBytesRead < cbTotalBytesToRead) {
+
+			if (!m_bHoldsChunk) {
+				std::unique_lock<std::mutex> Lock(m_Mutex);
+				m_ChunkFilled.wait(Lock, [this] { return (m_nFilledChunks > 0) || m_bSourceFinished; });
+
+				if (m_nFilledChunks == 0) {
+					if (m_pProducerException)
+						std::rethrow_exception(m_pProducerException);
+					break;
+				}
+
+				m_bHoldsChunk = true;
+				m_nReadOffset = 0;
+			}
+
+			nfUint64 cbChunkSize = m_ChunkSizes[m_nReadChunk];
+			nfUint64 cbBytesToCopy = cbChunkSize - m_nReadOffset;
+			if (cbBytesToCopy > cbTotalBytesToRead - cbBytesRead)
+				cbBytesToCopy = cbTotalBytesToRead - cbBytesRead;
+
+			if (cbBytesToCopy > 0) {
+				memcpy(pBuffer + cbBytesRead, m_Chunks[m_nReadChunk].data() + m_nReadOffset, (size_t)cbBytesToCopy);
+				m_nReadOffset += cbBytesToCopy;
+				cbBytesRead += cbBytesToCopy;
+			}
+
+			if (m_nReadOffset == cbChunkSize) {
+				{
+					std::lock_guard<std::mutex> Lock(m_Mutex);
+					m_nFilledChunks--;
+				}
+				m_ChunkReleased.notify_one();
+
+				m_bHoldsChunk = false;
+				m_nReadChunk = (m_nReadChunk + 1) % NMR_IMPORTSTREAM_PIPELINED_CHUNKCOUNT;
+			}
+		}
+
+		m_nPosition += cbBytesRead;
+
+		if ((cbBytesRead != cbTotalBytesToRead) && bNeedsToReadAll)
+			throw CNMRException(NMR_ERROR_COULDNOTREADFULLDATA);
+
+		return cbBytesRead;
+	}
+
+	nfUint64 CImportStream_Pipelined::retrieveSize()
+	{
+		return m_nSize;
+	}
+
+	void CImportStream_Pipelined::writeToFile(_In_ const nfWChar * pwszFileName)
+	{
+		throw CNMRException(NMR_ERROR_NOTIMPLEMENTED);
+	}
+
+	PImportStream CImportStream_Pipelined::copyToMemory()
+	{
+		nfUint64 cbStreamSize = retrieveSize();
+
+		return std::make_shared<CImportStream_Unique_Memory>(this, cbStreamSize, false);
+	}
+
+}
@@ -0,0 +1,180 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_MappedTemporaryFile.cpp implements the CMappedTemporaryFile Class.
+This is a platform independent class for a writable memory mapping of an anonymous
+temporary file, which is removed as soon as the mapping is released.
+
+--*/
+
+#include "Common/Platform/NMR_MappedTemporaryFile.h"
+#include "Common/NMR_Exception.h"
+#include "Common/NMR_Exception_Windows.h"
+#include "Common/NMR_StringUtils.h"
+
+#include <cstdlib>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // _WIN32
+
+namespace NMR {
+
+	CMappedTemporaryFile::CMappedTemporaryFile(_In_ const std::wstring & sDirectory, _In_ nfUint64 cbSize)
+	{
+		if (cbSize == 0)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+		if ((sizeof(size_t) < sizeof(nfUint64)) && (cbSize > (nfUint64)SIZE_MAX))
+			throw CNMRException(NMR_ERROR_INVALIDBUFFERSIZE);
+
+		m_pData = nullptr;
+		m_cbSize = cbSize;
+
+#ifdef _WIN32
+		m_hMapping = nullptr;
+
+		std::wstring sTempDirectory = sDirectory;
+		if (sTempDirectory.empty()) {
+			std::vector<wchar_t> Buffer(MAX_PATH + 1);
+			DWORD nLength = GetTempPathW((DWORD)Buffer.size(), Buffer.data());
+			if ((nLength == 0) || (nLength > Buffer.size()))
+				throw CNMRException_Windows(NMR_ERROR_COULDNOTCREATEFILE, GetLastError());
+			sTempDirectory = std::wstring(Buffer.data(), nLength);
+		}
+
+		std::vector<wchar_t> FileName(MAX_PATH + 1);
+		if (GetTempFileNameW(sTempDirectory.c_str(), L"3mf", 0, FileName.data()) == 0)
+			throw CNMRException_Windows(NMR_ERROR_COULDNOTCREATEFILE, GetLastError());
+
+		// Temporary files are kept in the cache as long as possible, and removed with their last handle
+		m_hFile = CreateFileW(FileName.data(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+			FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+		if (m_hFile == INVALID_HANDLE_VALUE) {
+			DWORD nError = GetLastError();
+			DeleteFileW(FileName.data());
+			throw CNMRException_Windows(NMR_ERROR_COULDNOTCREATEFILE, nError);
+		}
+
+		// Setting the end of the file allocates its clusters, so a full disk fails here and not on a write to the mapping
+		LARGE_INTEGER nFileSize;
+		nFileSize.QuadPart = (LONGLONG)cbSize;
+		if (!SetFilePointerEx(m_hFile, nFileSize, nullptr, FILE_BEGIN) || !SetEndOfFile(m_hFile)) {
+			DWORD nError = GetLastError();
+			CloseHandle(m_hFile);
+			throw CNMRException_Windows(NMR_ERROR_COULDNOTCREATEFILE, nError);
+		}
+
+		m_hMapping = CreateFileMappingW(m_hFile, nullptr, PAGE_READWRITE, (DWORD)(cbSize >> 32), (DWORD)(cbSize & 0xffffffff), nullptr);
+		if (m_hMapping == nullptr) {
+			DWORD nError = GetLastError();
+			CloseHandle(m_hFile);
+			throw CNMRException_Windows(NMR_ERROR_COULDNOTCREATEFILE, nError);
+		}
+
+		m_pData = (nfByte *)MapViewOfFile(m_hMapping, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)cbSize);
+		if (m_pData == nullptr) {
+			DWORD nError = GetLastError();
+			CloseHandle(m_hMapping);
+			CloseHandle(m_hFile);
+			throw CNMRException_Windows(NMR_ERROR_COULDNOTCREATEFILE, nError);
+		}
+#else
+		std::string sTemplate;
+		if (sDirectory.empty()) {
+			const char * pszTempDirectory = getenv("TMPDIR");
+			sTemplate = ((pszTempDirectory != nullptr) && (*pszTempDirectory != 0)) ? pszTempDirectory : "/tmp";
+		}
+		else
+			sTemplate = fnUTF16toUTF8(sDirectory);
+		sTemplate += "/lib3mf_XXXXXX";
+
+		std::vector<char> FileName(sTemplate.begin(), sTemplate.end());
+		FileName.push_back(0);
+		int nFileDescriptor = mkstemp(FileName.data());
+		if (nFileDescriptor < 0)
+			throw CNMRException(NMR_ERROR_COULDNOTCREATEFILE);
+
+		// The file has no name anymore, so it disappears with the mapping, also if the process is killed
+		unlink(FileName.data());
+
+		// Allocate all blocks of the file, a sparse file would raise SIGBUS on a write to the mapping once the disk is full
+#ifdef __APPLE__
+		fstore_t Store = { F_ALLOCATEALL, F_PEOFPOSMODE, 0, (off_t)cbSize, 0 };
+		bool bAllocated = (fcntl(nFileDescriptor, F_PREALLOCATE, &Store) == 0) && (ftruncate(nFileDescriptor, (off_t)cbSize) == 0);
+#else
+		bool bAllocated = (posix_fallocate(nFileDescriptor, 0, (off_t)cbSize) == 0);
+#endif // __APPLE__
+		if (!bAllocated) {
+			close(nFileDescriptor);
+			throw CNMRException(NMR_ERROR_COULDNOTCREATEFILE);
+		}
+
+		void * pData = mmap(nullptr, (size_t)cbSize, PROT_READ | PROT_WRITE, MAP_SHARED, nFileDescriptor, 0);
+		close(nFileDescriptor);
+		if (pData == MAP_FAILED)
+			throw CNMRException(NMR_ERROR_COULDNOTCREATEFILE);
+
+		m_pData = (nfByte *)pData;
+#endif // _WIN32
+	}
+
+	CMappedTemporaryFile::~CMappedTemporaryFile()
+	{
+#ifdef _WIN32
+		if (m_pData != nullptr)
+			UnmapViewOfFile(m_pData);
+		if (m_hMapping != nullptr)
+			CloseHandle(m_hMapping);
+		if (m_hFile != INVALID_HANDLE_VALUE)
+			CloseHandle(m_hFile);
+#else
+		if (m_pData != nullptr)
+			munmap((void *)m_pData, (size_t)m_cbSize);
+#endif // _WIN32
+
+		m_pData = nullptr;
+		m_cbSize = 0;
+	}
+
+	nfByte * CMappedTemporaryFile::getData()
+	{
+		return m_pData;
+	}
+
+	nfUint64 CMappedTemporaryFile::getSize()
+	{
+		return m_cbSize;
+	}
+
+}
@@ -40,6 +40,7 @@ specific classes for GCC.
 #include "Common/Platform/NMR_ImportStream_GCC_Win32.h"
 #include "Common/Platform/NMR_ExportStream_GCC_Win32.h"
 #include "Common/Platform/NMR_ImportStream_GCC_Native.h"
+#include "Common/Platform/NMR_ImportStream_MMap.h"
 #include "Common/Platform/NMR_ExportStream_GCC_Native.h"
 #include "Common/Platform/NMR_XmlReader_Native.h"
 #include "Common/NMR_StringUtils.h"
@@ -53,6 +54,23 @@ namespace NMR {
 		return std::make_shared<CImportStream_GCC_Native> (sFileName.c_str());
 	}
 
+	PImportStream fnCreateImportStreamInstance (_In_ const nfChar * pszFileName, _In_ nfBool bMemoryMapped)
+	{
+		if (!bMemoryMapped)
+			return fnCreateImportStreamInstance(pszFileName);
+
+		std::wstring sFileName = fnUTF8toUTF16(pszFileName);
+		try {
+			return std::make_shared<CImportStream_MMap> (sFileName.c_str());
+		}
+		catch (CNMRException & e) {
+			// Files that can not be mapped (e.g. pipes) are read as a stream
+			if (e.getErrorCode() == NMR_ERROR_COULDNOTOPENFILE)
+				throw;
+			return std::make_shared<CImportStream_GCC_Native> (sFileName.c_str());
+		}
+	}
+
 	PExportStream fnCreateExportStreamInstance (_In_ const nfChar * pszFileName)
 	{
 		std::wstring sFileName = fnUTF8toUTF16(pszFileName);
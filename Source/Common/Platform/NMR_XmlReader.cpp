@@ -40,10 +40,26 @@ namespace NMR {
 		if (!pImportStream.get())
 			throw CNMRException(NMR_ERROR_INVALIDPARAM);
 		m_pImportStream = pImportStream;
+		m_bAllowRawContent = false;
 	}
 
 	void CXmlReader::CloseElement()
 	{
 	}
 
+	void CXmlReader::AllowRawContent(_In_ nfBool bAllowRawContent)
+	{
+		m_bAllowRawContent = bAllowRawContent;
+	}
+
+	nfBool CXmlReader::GetRawContent(_Outptr_ const nfChar ** ppStart, _Outptr_ const nfChar ** ppEnd, _Out_ nfUint32 & nDefaultNameSpaceID)
+	{
+		return false;
+	}
+
+	void CXmlReader::SkipRawContent(_In_ const nfChar * pResume)
+	{
+		throw CNMRException(NMR_ERROR_NOTIMPLEMENTED);
+	}
+
 }
@@ -30,7 +30,8 @@ NMR_XMLReader_Native.cpp implements a XML reader class with a native XML parsing
 
 --*/
 
-#include "Common/Platform/NMR_XmlReader_Native.h" 
+#include "Common/Platform/NMR_XmlReader_Native.h"
+#include "Common/Platform/NMR_ImportStream_Memory.h" 
 #include "Common/NMR_Exception.h" 
 #include "Common/NMR_StringUtils.h" 
 
@@ -41,7 +42,7 @@ NMR_XMLReader_Native.cpp implements a XML reader class with a native XML parsing
 namespace NMR {
 
 	inline void decodeXMLEscapeXMLStrings(nfChar* pChar) {
-		if (strpbrk(pChar, "&") == nullptr) {
+		if (strchr(pChar, '&') == nullptr) {
 			return;
 		}
 		nfChar *pIterChar = pChar;
@@ -97,19 +98,14 @@ namespace NMR {
 
 	nfUint32 nfStrLen(_In_ const nfChar * pszString)
 	{
-		nfUint32 nResult = 0;
-		const nfChar * pChar = pszString;
-		while (*pChar) {
-			pChar++;
-			nResult++;
-			if (nResult > NMR_MAXXMLSTRINGLENGTH)
-				throw CNMRException(NMR_ERROR_INVALIDBUFFERSIZE);
-		}
-		return nResult;
+		size_t nResult = strlen(pszString);
+		if (nResult > NMR_MAXXMLSTRINGLENGTH)
+			throw CNMRException(NMR_ERROR_INVALIDBUFFERSIZE);
+		return (nfUint32)nResult;
 	}
 
 	CXmlReader_Native::CXmlReader_Native(_In_ PImportStream pImportStream, _In_ nfUint32 cbBufferCapacity, _In_ PProgressMonitor pProgressMonitor)
-		: CXmlReader(pImportStream), m_progressCounter(0), m_pProgressMonitor(pProgressMonitor)
+		: CXmlReader(pImportStream), m_progressCounter(0), m_pProgressMonitor(pProgressMonitor), m_ScanFunctions(fnXmlScanGetFunctions())
 	{
 		if ((cbBufferCapacity < NMR_NATIVEXMLREADER_MINBUFFERCAPACITY) ||
 			(cbBufferCapacity > NMR_NATIVEXMLREADER_MAXBUFFERCAPACITY))
@@ -146,6 +142,7 @@ namespace NMR {
 		m_pCurrentElementPrefix = &m_cNullString;
 
 		m_cbDefaultNameSpaceLength = 0;
+		m_nDefaultNameSpaceID = XMLNAMESPACEID_NONE;
 		m_bNameSpaceIsAttribute = false;
 
 		m_nZeroInsertIndex = 0;
@@ -202,10 +199,10 @@ namespace NMR {
 			}
 		}
 		else {
-			auto iIterator = m_sNameSpaces.find(m_pCurrentPrefix);
-			if (iIterator != m_sNameSpaces.end()) {
-				cbLength = (nfUint32)iIterator->second.length();
-				*ppszValue = iIterator->second.c_str();
+			const XMLNATIVENAMESPACE * pNameSpace = findNameSpace(m_pCurrentPrefix);
+			if (pNameSpace != nullptr) {
+				cbLength = (nfUint32)pNameSpace->m_sURI.length();
+				*ppszValue = pNameSpace->m_sURI.c_str();
 			}
 			else {
 				cbLength = 0;
@@ -220,9 +217,9 @@ namespace NMR {
 
 	bool CXmlReader_Native::GetNamespaceURI(const std::string &sNameSpacePrefix, std::string &sNameSpaceURI)
 	{
-		auto iIterator = m_sNameSpaces.find(sNameSpacePrefix);
-		if (iIterator != m_sNameSpaces.end()) {
-			sNameSpaceURI = iIterator->second.c_str();
+		const XMLNATIVENAMESPACE * pNameSpace = findNameSpace(sNameSpacePrefix.c_str());
+		if (pNameSpace != nullptr) {
+			sNameSpaceURI = pNameSpace->m_sURI;
 			return true;
 		}
 		else {
@@ -230,10 +227,26 @@ namespace NMR {
 		}
 	}
 
+	nfUint32 CXmlReader_Native::GetNamespaceID()
+	{
+		if (*m_pCurrentPrefix == 0) {
+			if (m_bNameSpaceIsAttribute)
+				return XMLNAMESPACEID_NONE;
+			else
+				return m_nDefaultNameSpaceID;
+		}
+
+		const XMLNATIVENAMESPACE * pNameSpace = findNameSpace(m_pCurrentPrefix);
+		if (pNameSpace != nullptr)
+			return pNameSpace->m_nID;
+
+		return XMLNAMESPACEID_NONE;
+	}
+
 	bool CXmlReader_Native::NamespaceRegistered(const std::string &sNameSpaceURI)
 	{
-		for (auto it : m_sNameSpaces) {
-			if (it.second == sNameSpaceURI) {
+		for (const XMLNATIVENAMESPACE & NameSpace : m_NameSpaces) {
+			if (NameSpace.m_sURI == sNameSpaceURI) {
 				return true;
 			}
 		}
@@ -376,6 +389,7 @@ namespace NMR {
 			if ((*m_pCurrentPrefix == 0) && (strcmp(m_pCurrentName, NMR_NATIVEXMLNS_XMLNS_PREFIX) == 0)) {
 				m_sDefaultNameSpace = m_pCurrentValue;
 				m_cbDefaultNameSpaceLength = (nfUint32)m_sDefaultNameSpace.length();
+				m_nDefaultNameSpaceID = internNameSpace(m_sDefaultNameSpace);
 			}
 			if (strcmp(m_pCurrentPrefix, NMR_NATIVEXMLNS_XMLNS_PREFIX) == 0)
 				registerNameSpace(m_pCurrentName, m_pCurrentValue);
@@ -396,6 +410,95 @@ namespace NMR {
 		// Empty by purpose
 	}
 
+	nfBool CXmlReader_Native::GetRawContent(_Outptr_ const nfChar ** ppStart, _Outptr_ const nfChar ** ppEnd, _Out_ nfUint32 & nDefaultNameSpaceID)
+	{
+		if ((!ppStart) || (!ppEnd))
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		if (!m_bAllowRawContent)
+			return false;
+
+		CImportStream_Memory * pMemoryStream = dynamic_cast<CImportStream_Memory *> (m_pImportStream.get());
+		if (pMemoryStream == nullptr)
+			return false;
+
+		if (!ensureFilledBuffer())
+			return false;
+
+		// Find the first character of the next entity in the buffer. Zero inserts and escape decoding
+		// work in place, so buffer offsets are still stream offsets relative to the buffer start.
+		nfChar * pEntityStart = m_CurrentEntityList[m_nCurrentEntityIndex];
+		nfChar * pEntityPrefix = m_CurrentEntityPrefixes[m_nCurrentEntityIndex];
+		if (pEntityPrefix != &m_cNullString)
+			pEntityStart = pEntityPrefix;
+
+		switch (m_CurrentEntityTypes[m_nCurrentEntityIndex]) {
+		case NMR_NATIVEXMLTYPE_TEXT:
+			break;
+		case NMR_NATIVEXMLTYPE_ELEMENT:
+			// Skip back over "<"
+			pEntityStart -= 1;
+			break;
+		case NMR_NATIVEXMLTYPE_ELEMENTEND:
+			// Skip back over "</"
+			pEntityStart -= 2;
+			break;
+		default:
+			return false;
+		}
+
+		nfUint64 cbStreamSize = pMemoryStream->retrieveSize();
+		nfUint64 nBufferPosition = pMemoryStream->getPosition() - m_nCurrentBufferSize;
+		nfUint64 nEntityPosition = nBufferPosition + (nfUint64)(pEntityStart - &(*m_pCurrentBuffer)[0]);
+		if (nEntityPosition >= cbStreamSize)
+			throw CNMRException(NMR_ERROR_XMLPARSER_INVALIDPARSERESULT);
+
+		const nfChar * pData = (const nfChar *)pMemoryStream->getData();
+		*ppStart = pData + nEntityPosition;
+		*ppEnd = pData + cbStreamSize;
+		nDefaultNameSpaceID = m_nDefaultNameSpaceID;
+
+		return true;
+	}
+
+	void CXmlReader_Native::SkipRawContent(_In_ const nfChar * pResume)
+	{
+		CImportStream_Memory * pMemoryStream = dynamic_cast<CImportStream_Memory *> (m_pImportStream.get());
+		if ((pMemoryStream == nullptr) || (pResume == nullptr))
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		const nfChar * pData = (const nfChar *)pMemoryStream->getData();
+		nfUint64 cbStreamSize = pMemoryStream->retrieveSize();
+		if ((pResume < pData) || (pResume > pData + cbStreamSize))
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		nfUint64 nPosition = pMemoryStream->getPosition();
+		nfUint64 nResumePosition = (nfUint64)(pResume - pData);
+		if (nResumePosition < nPosition - m_nCurrentBufferSize)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		pMemoryStream->seekPosition(nResumePosition, true);
+		if (nResumePosition > nPosition)
+			m_pProgressMonitor->IncrementProgress(double(nResumePosition - nPosition));
+		m_pProgressMonitor->QueryCancelled(true);
+
+		// Drop the buffered entities, the next read starts at the resume position
+		clearZeroInserts();
+		m_nCurrentBufferSize = 0;
+		m_cbCurrentOverflowSize = 0;
+		m_nCurrentEntityCount = 0;
+		m_nCurrentVerifiedEntityCount = 0;
+		m_nCurrentFullEntityCount = 0;
+		m_nCurrentEntityIndex = 0;
+		m_pCurrentEntityPointer = nullptr;
+
+		m_pCurrentName = &m_cNullString;
+		m_pCurrentPrefix = &m_cNullString;
+		m_pCurrentValue = &m_cNullString;
+		m_pCurrentElementName = &m_cNullString;
+		m_pCurrentElementPrefix = &m_cNullString;
+	}
+
 	void CXmlReader_Native::readNextBufferFromStream()
 	{
 		if (m_progressCounter++ > PROGRESS_READBUFFERUPDATE) {
@@ -480,16 +583,17 @@ namespace NMR {
 			nfChar * pChar = pszEntityStartChar;
 			nfChar * pColon = nullptr;
 			while (pChar != pszEntityEndDelimiter) {
+				pChar = fnXmlScan<NMR_XMLSCAN_NAMESPACESEPARATOR>(pChar, pszEntityEndDelimiter, m_ScanFunctions.m_fnNameSpaceSeparator);
+				if (pChar == pszEntityEndDelimiter)
+					break;
+
 				if (*pChar == 0)
 					throw CNMRException(NMR_ERROR_XMLPARSER_INVALIDENDDELIMITER);
 
-				if (*pChar == L':') {
-					if (pColon != nullptr)
-						throw CNMRException(NMR_ERROR_XMLPARSER_INVALIDNAMESPACEPREFIX);
-
-					pColon = pChar;
-				}
+				if (pColon != nullptr)
+					throw CNMRException(NMR_ERROR_XMLPARSER_INVALIDNAMESPACEPREFIX);
 
+				pColon = pChar;
 				pChar++;
 			}
 
@@ -543,7 +647,7 @@ namespace NMR {
 
 	nfChar * CXmlReader_Native::parseText(_In_ nfChar * pszStart, _In_ nfChar * pszEnd)
 	{
-		nfChar * pChar = pszStart;
+		nfChar * pChar = fnXmlScan<NMR_XMLSCAN_TEXTEND>(pszStart, pszEnd, m_ScanFunctions.m_fnTextEnd);
 		while (pChar != pszEnd) {
 			switch (*pChar) {
 			case '<':
@@ -572,7 +676,7 @@ namespace NMR {
 
 	nfChar * CXmlReader_Native::parseElement(_In_ nfChar * pszStart, _In_ nfChar * pszEnd)
 	{
-		nfChar * pChar = pszStart;
+		nfChar * pChar = fnXmlScan<NMR_XMLSCAN_ELEMENTNAMEEND>(pszStart, pszEnd, m_ScanFunctions.m_fnElementNameEnd);
 		while (pChar != pszEnd) {
 			switch (*pChar) {
 			case 9:  // Tab
@@ -701,7 +805,7 @@ namespace NMR {
 
 	nfChar * CXmlReader_Native::parseEndElement(_In_ nfChar * pszStart, _In_ nfChar * pszEnd)
 	{
-		nfChar * pChar = pszStart;
+		nfChar * pChar = fnXmlScan<NMR_XMLSCAN_ENDELEMENTNAMEEND>(pszStart, pszEnd, m_ScanFunctions.m_fnEndElementNameEnd);
 		while (pChar != pszEnd) {
 			switch (*pChar) {
 			case 9:
@@ -810,6 +914,8 @@ namespace NMR {
 	{
 		nfBool bHadSpacing = false;
 		nfChar * pChar = skipSpaces(pszStart, pszEnd);
+		// skip all name-constituting characters up to the first name-ending one
+		pChar = fnXmlScan<NMR_XMLSCAN_ATTRIBUTENAMEEND>(pChar, pszEnd, m_ScanFunctions.m_fnAttributeNameEnd);
 		while (pChar != pszEnd) {
 			switch (*pChar) {
 			// name-ending characters
@@ -886,7 +992,7 @@ namespace NMR {
 
 	nfChar * CXmlReader_Native::parseAttributeValueDoubleQuote(_In_ nfChar * pszStart, _In_ nfChar * pszEnd)
 	{
-		nfChar * pChar = pszStart;
+		nfChar * pChar = fnXmlScan<NMR_XMLSCAN_DOUBLEQUOTE>(pszStart, pszEnd, m_ScanFunctions.m_fnDoubleQuote);
 		while (pChar != pszEnd) {
 			switch (*pChar) {
 
@@ -907,7 +1013,7 @@ namespace NMR {
 
 	nfChar * CXmlReader_Native::parseAttributeValueSingleQuote(_In_ nfChar * pszStart, _In_ nfChar * pszEnd)
 	{
-		nfChar * pChar = pszStart;
+		nfChar * pChar = fnXmlScan<NMR_XMLSCAN_SINGLEQUOTE>(pszStart, pszEnd, m_ScanFunctions.m_fnSingleQuote);
 		while (pChar != pszEnd) {
 			switch (*pChar) {
 
@@ -929,7 +1035,44 @@ namespace NMR {
 
 	void CXmlReader_Native::registerNameSpace(_In_ std::string sPrefix, _In_ std::string sURI)
 	{
-		m_sNameSpaces.insert(std::make_pair(sPrefix, sURI));
+		// The first declaration of a prefix is kept
+		if (findNameSpace(sPrefix.c_str()) != nullptr)
+			return;
+
+		XMLNATIVENAMESPACE NameSpace;
+		NameSpace.m_nID = internNameSpace(sURI);
+		NameSpace.m_sPrefix = sPrefix;
+		NameSpace.m_sURI = sURI;
+		m_NameSpaces.push_back(NameSpace);
+	}
+
+	nfUint32 CXmlReader_Native::internNameSpace(_In_ const std::string & sURI)
+	{
+		nfUint32 nID = fnXmlLookupNameSpaceID(sURI.c_str());
+		if (nID != XMLNAMESPACEID_FIRSTCUSTOM)
+			return nID;
+
+		nfUint32 nIndex = 0;
+		for (const std::string & sCustomURI : m_CustomNameSpaceURIs) {
+			if (sCustomURI == sURI)
+				return XMLNAMESPACEID_FIRSTCUSTOM + nIndex;
+			nIndex++;
+		}
+
+		m_CustomNameSpaceURIs.push_back(sURI);
+		return XMLNAMESPACEID_FIRSTCUSTOM + nIndex;
+	}
+
+	const XMLNATIVENAMESPACE * CXmlReader_Native::findNameSpace(_In_z_ const nfChar * pszPrefix)
+	{
+		__NMRASSERT(pszPrefix);
+
+		for (const XMLNATIVENAMESPACE & NameSpace : m_NameSpaces) {
+			if (strcmp(NameSpace.m_sPrefix.c_str(), pszPrefix) == 0)
+				return &NameSpace;
+		}
+
+		return nullptr;
 	}
 
 
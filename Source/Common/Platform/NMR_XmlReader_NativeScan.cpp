@@ -0,0 +1,158 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_XmlReader_NativeScan.cpp implements the wide character scanning functions of the
+native XML parser.
+
+--*/
+
+#include "Common/Platform/NMR_XmlReader_NativeScan.h"
+
+#ifdef __NMR_XMLSCAN_SSE2
+#if defined(_MSC_VER)
+#define __NMR_XMLSCAN_AVX2
+#define __NMR_XMLSCAN_AVX2_TARGET
+#include <immintrin.h>
+#elif defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9))))
+#define __NMR_XMLSCAN_AVX2
+#define __NMR_XMLSCAN_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+#endif // __NMR_XMLSCAN_SSE2
+
+namespace NMR {
+
+	template <nfChar... CSET>
+	nfChar * fnXmlScanWideScalar(_In_ nfChar * pStart, _In_ nfChar * pEnd)
+	{
+		return fnXmlScanScalar<CSET...>(pStart, pEnd);
+	}
+
+#ifdef __NMR_XMLSCAN_SSE2
+
+	template <nfChar... CSET>
+	nfChar * fnXmlScanWideSSE2(_In_ nfChar * pStart, _In_ nfChar * pEnd)
+	{
+		nfChar * pChar = pStart;
+		while (pEnd - pChar >= 16) {
+			nfUint32 nMask = fnXmlScanMaskSSE2<CSET...>(pChar);
+			if (nMask != 0)
+				return pChar + fnXmlScanFirstBit(nMask);
+			pChar += 16;
+		}
+		return fnXmlScanScalar<CSET...>(pChar, pEnd);
+	}
+
+#endif // __NMR_XMLSCAN_SSE2
+
+#ifdef __NMR_XMLSCAN_AVX2
+
+	template <nfChar C>
+	__NMR_XMLSCAN_AVX2_TARGET inline __m256i fnXmlScanCompareAVX2(_In_ __m256i vChars)
+	{
+		return _mm256_cmpeq_epi8(vChars, _mm256_set1_epi8(C));
+	}
+
+	template <nfChar C, nfChar C2, nfChar... CREST>
+	__NMR_XMLSCAN_AVX2_TARGET inline __m256i fnXmlScanCompareAVX2(_In_ __m256i vChars)
+	{
+		return _mm256_or_si256(fnXmlScanCompareAVX2<C>(vChars), fnXmlScanCompareAVX2<C2, CREST...>(vChars));
+	}
+
+	template <nfChar... CSET>
+	__NMR_XMLSCAN_AVX2_TARGET nfChar * fnXmlScanWideAVX2(_In_ nfChar * pStart, _In_ nfChar * pEnd)
+	{
+		nfChar * pChar = pStart;
+		while (pEnd - pChar >= 32) {
+			__m256i vChars = _mm256_loadu_si256((const __m256i *) pChar);
+			nfUint32 nMask = (nfUint32)_mm256_movemask_epi8(fnXmlScanCompareAVX2<CSET...>(vChars));
+			if (nMask != 0)
+				return pChar + fnXmlScanFirstBit(nMask);
+			pChar += 32;
+		}
+		return fnXmlScanWideSSE2<CSET...>(pChar, pEnd);
+	}
+
+	nfBool fnXmlScanProcessorSupportsAVX2()
+	{
+#ifdef _MSC_VER
+		int nInfo[4];
+		__cpuid(nInfo, 0);
+		if (nInfo[0] < 7)
+			return false;
+
+		// AVX2 needs OSXSAVE and AVX, and the OS has to preserve the YMM registers
+		__cpuid(nInfo, 1);
+		if (((nInfo[2] & (1 << 27)) == 0) || ((nInfo[2] & (1 << 28)) == 0))
+			return false;
+		if ((_xgetbv(0) & 6) != 6)
+			return false;
+
+		__cpuidex(nInfo, 7, 0);
+		return (nInfo[1] & (1 << 5)) != 0;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") != 0;
+#endif
+	}
+
+#endif // __NMR_XMLSCAN_AVX2
+
+#define __NMR_XMLSCAN_FUNCTIONS(SCANFUNCTION) { \
+		&SCANFUNCTION<NMR_XMLSCAN_TEXTEND>, \
+		&SCANFUNCTION<NMR_XMLSCAN_ELEMENTNAMEEND>, \
+		&SCANFUNCTION<NMR_XMLSCAN_ENDELEMENTNAMEEND>, \
+		&SCANFUNCTION<NMR_XMLSCAN_ATTRIBUTENAMEEND>, \
+		&SCANFUNCTION<NMR_XMLSCAN_DOUBLEQUOTE>, \
+		&SCANFUNCTION<NMR_XMLSCAN_SINGLEQUOTE>, \
+		&SCANFUNCTION<NMR_XMLSCAN_NAMESPACESEPARATOR> }
+
+	const XMLSCANFUNCTIONS & fnXmlScanGetScalarFunctions()
+	{
+		static const XMLSCANFUNCTIONS ScalarFunctions = __NMR_XMLSCAN_FUNCTIONS(fnXmlScanWideScalar);
+		return ScalarFunctions;
+	}
+
+	const XMLSCANFUNCTIONS & fnXmlScanGetFunctions()
+	{
+#ifdef __NMR_XMLSCAN_AVX2
+		static const XMLSCANFUNCTIONS AVX2Functions = __NMR_XMLSCAN_FUNCTIONS(fnXmlScanWideAVX2);
+		static const nfBool bHasAVX2 = fnXmlScanProcessorSupportsAVX2();
+		if (bHasAVX2)
+			return AVX2Functions;
+#endif // __NMR_XMLSCAN_AVX2
+
+#ifdef __NMR_XMLSCAN_SSE2
+		static const XMLSCANFUNCTIONS SSE2Functions = __NMR_XMLSCAN_FUNCTIONS(fnXmlScanWideSSE2);
+		return SSE2Functions;
+#else
+		return fnXmlScanGetScalarFunctions();
+#endif // __NMR_XMLSCAN_SSE2
+	}
+
+}
@@ -0,0 +1,170 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_XmlTokens.cpp implements the lookup of namespace IDs and name tokens.
+
+--*/
+
+#include "Common/Platform/NMR_XmlTokens.h"
+#include "Model/Classes/NMR_ModelConstants.h"
+
+#include <cstring>
+
+#define NMR_XMLTOKENS_HASHTABLESIZE 64
+
+namespace NMR {
+
+	typedef struct {
+		const nfChar * m_pszName;
+		eXmlToken m_Token;
+	} XMLTOKENENTRY;
+
+	typedef struct {
+		const nfChar * m_pszURI;
+		eXmlNameSpaceID m_ID;
+	} XMLNAMESPACEENTRY;
+
+	static const XMLNAMESPACEENTRY g_XmlKnownNameSpaces[] = {
+		{ XML_3MF_NAMESPACE_XML, XMLNAMESPACEID_XML },
+		{ XML_3MF_NAMESPACE_XMLNS, XMLNAMESPACEID_XMLNS },
+		{ XML_3MF_NAMESPACE_CORESPEC093, XMLNAMESPACEID_CORESPEC093 },
+		{ XML_3MF_NAMESPACE_CORESPEC100, XMLNAMESPACEID_CORESPEC100 },
+		{ XML_3MF_NAMESPACE_MATERIALSPEC, XMLNAMESPACEID_MATERIALSPEC },
+		{ XML_3MF_NAMESPACE_PRODUCTIONSPEC, XMLNAMESPACEID_PRODUCTIONSPEC },
+		{ XML_3MF_NAMESPACE_BEAMLATTICESPEC, XMLNAMESPACEID_BEAMLATTICESPEC },
+		{ XML_3MF_NAMESPACE_SLICESPEC, XMLNAMESPACEID_SLICESPEC },
+		{ XML_3MF_NAMESPACE_TOOLPATHSPEC, XMLNAMESPACEID_TOOLPATHSPEC },
+		{ XML_3MF_NAMESPACE_ZCOMPRESSION, XMLNAMESPACEID_ZCOMPRESSION }
+	};
+
+	// Slots of the perfect hash function fnXmlTokenHash for all names of eXmlToken.
+	// Every name maps to its own slot, so a lookup needs at most one string compare.
+	// The table has to be regenerated if a token is added.
+	static const XMLTOKENENTRY g_XmlTokenTable[NMR_XMLTOKENS_HASHTABLESIZE] = {
+		{ "v1", XMLTOKEN_V1 },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ "p1", XMLTOKEN_P1 },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ "type", XMLTOKEN_TYPE },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ "x1", XMLTOKEN_X1 },
+		{ "pid", XMLTOKEN_PID },
+		{ "triangle", XMLTOKEN_TRIANGLE },
+		{ "point", XMLTOKEN_POINT },
+		{ "partid", XMLTOKEN_PARTID },
+		{ "cap1", XMLTOKEN_CAP1 },
+		{ "v2", XMLTOKEN_V2 },
+		{ "profileid", XMLTOKEN_PROFILEID },
+		{ "y", XMLTOKEN_Y },
+		{ "y1", XMLTOKEN_Y1 },
+		{ "r1", XMLTOKEN_R1 },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ "startv", XMLTOKEN_STARTV },
+		{ "p2", XMLTOKEN_P2 },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ "x2", XMLTOKEN_X2 },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ "vertex", XMLTOKEN_VERTEX },
+		{ "hatch", XMLTOKEN_HATCH },
+		{ "beam", XMLTOKEN_BEAM },
+		{ "cap2", XMLTOKEN_CAP2 },
+		{ "v3", XMLTOKEN_V3 },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ "segment", XMLTOKEN_SEGMENT },
+		{ "y2", XMLTOKEN_Y2 },
+		{ "r2", XMLTOKEN_R2 },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ "x", XMLTOKEN_X },
+		{ "p3", XMLTOKEN_P3 },
+		{ "z", XMLTOKEN_Z },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN },
+		{ nullptr, XMLTOKEN_UNKNOWN }
+	};
+
+	inline nfUint32 fnXmlTokenHash(_In_z_ const nfChar * pszName, _In_ nfUint32 nLength)
+	{
+		return (nLength + 9 * (nfUint32)(nfByte)pszName[0] + 24 * (nfUint32)(nfByte)pszName[nLength - 1]) & (NMR_XMLTOKENS_HASHTABLESIZE - 1);
+	}
+
+	nfUint32 fnXmlLookupNameSpaceID(_In_z_ const nfChar * pszNameSpaceURI)
+	{
+		if (pszNameSpaceURI == nullptr)
+			return XMLNAMESPACEID_NONE;
+		if (*pszNameSpaceURI == 0)
+			return XMLNAMESPACEID_NONE;
+
+		for (const XMLNAMESPACEENTRY & Entry : g_XmlKnownNameSpaces) {
+			if (strcmp(Entry.m_pszURI, pszNameSpaceURI) == 0)
+				return Entry.m_ID;
+		}
+
+		return XMLNAMESPACEID_FIRSTCUSTOM;
+	}
+
+	eXmlToken fnXmlLookupToken(_In_z_ const nfChar * pszName, _In_ nfUint32 nLength)
+	{
+		if ((pszName == nullptr) || (nLength == 0))
+			return XMLTOKEN_UNKNOWN;
+
+		const XMLTOKENENTRY & Entry = g_XmlTokenTable[fnXmlTokenHash(pszName, nLength)];
+		if (Entry.m_pszName == nullptr)
+			return XMLTOKEN_UNKNOWN;
+
+		if ((Entry.m_pszName[0] != pszName[0]) || (strcmp(Entry.m_pszName, pszName) != 0))
+			return XMLTOKEN_UNKNOWN;
+
+		return Entry.m_Token;
+	}
+
+}
@@ -69,6 +69,7 @@ namespace NMR {
 		m_sLanguage = XML_3MF_LANG_US;
 		m_nHandleCounter = 1;
 		m_sCurPath = "";
+		m_pArena = std::make_shared<CMonotonicArena>();
 
 		setBuildUUID(std::make_shared<CUUID>());
 		m_MetaDataGroup = std::make_shared<CModelMetaDataGroup>();
@@ -102,9 +103,14 @@ namespace NMR {
 	// Merge all build items into one mesh
 	void CModel::mergeToMesh(_In_ CMesh * pMesh)
 	{
+		__NMRASSERT(pMesh);
+
+		// Flatten all build items first, so that the mesh can merge them at once
+		std::vector<MESHMERGEINSTANCE> Instances;
 		for (auto iIterator = m_BuildItems.begin(); iIterator != m_BuildItems.end(); iIterator++) {
-			(*iIterator)->mergeToMesh(pMesh);
+			(*iIterator)->collectMeshes(Instances);
 		}
+		pMesh->mergeMeshes(Instances);
 	}
 
 	// Units setter/getter
@@ -492,6 +498,13 @@ namespace NMR {
 		m_MultiPropertyGroupLookup.clear();
 
 		m_MetaDataGroup->clear();
+
+		m_pArena = std::make_shared<CMonotonicArena>();
+	}
+
+	_Ret_notnull_ PMonotonicArena CModel::getArena()
+	{
+		return m_pArena;
 	}
 
 	_Ret_maybenull_ PModelBaseMaterialResource CModel::findBaseMaterial(_In_ PackageResourceID nResourceID)
@@ -1074,6 +1087,64 @@ namespace NMR {
 		}
 	}
 
+	void CModel::shareModelAttachments(_In_ CModel * pSourceModel)
+	{
+		if (pSourceModel == nullptr)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		// Attachments are shared, not copied: textures and thumbnails read into this
+		// model have to reference the attachments of the package model
+		m_Attachments = pSourceModel->m_Attachments;
+		m_AttachmentURIMap = pSourceModel->m_AttachmentURIMap;
+	}
+
+	void CModel::mergeProductionPart(_In_ CModel * pPartModel)
+	{
+		if (pPartModel == nullptr)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		// IDs are renumbered in the order the part generated them, which yields the same
+		// unique IDs as reading the part into this model directly
+		UniqueResourceIDMapping oldToNewMapping;
+		m_resourceHandler.adoptResourceIDs(pPartModel->m_resourceHandler, oldToNewMapping);
+
+		for (auto pResource : pPartModel->m_Resources) {
+			pResource->setModel(this);
+
+			CModelMeshObject * pMeshObject = dynamic_cast<CModelMeshObject *> (pResource.get());
+			if (pMeshObject != nullptr)
+				pMeshObject->getMesh()->patchMeshInformationResources(oldToNewMapping);
+
+			CModelMultiPropertyGroupResource * pMultiPropertyGroup = dynamic_cast<CModelMultiPropertyGroupResource *> (pResource.get());
+			if (pMultiPropertyGroup != nullptr) {
+				nfUint32 nLayerCount = pMultiPropertyGroup->getLayerCount();
+				for (nfUint32 nIndex = 0; nIndex < nLayerCount; nIndex++) {
+					MODELMULTIPROPERTYLAYER sLayer = pMultiPropertyGroup->getLayer(nIndex);
+					auto iIterator = oldToNewMapping.find(sLayer.m_nResourceID);
+					if (iIterator == oldToNewMapping.end())
+						throw CNMRException(NMR_ERROR_UNKNOWNMODELRESOURCE);
+					sLayer.m_nResourceID = iIterator->second;
+					pMultiPropertyGroup->setLayer(nIndex, sLayer);
+				}
+			}
+
+			addResource(pResource);
+		}
+
+		// The build UUID of the staging model does not belong to the package
+		for (auto iIterator : pPartModel->usedUUIDs) {
+			if (iIterator.second != pPartModel->m_buildUUID)
+				registerUUID(iIterator.second);
+		}
+
+		// Every model node sets the language, the unit only if the attribute is present
+		setLanguage(pPartModel->getLanguage());
+		if (pPartModel->getUnit() != MODELUNIT_MILLIMETER)
+			setUnit(pPartModel->getUnit());
+
+		pPartModel->clearAll();
+	}
+
 
 	std::map<std::string, std::string> CModel::getCustomContentTypes()
 	{
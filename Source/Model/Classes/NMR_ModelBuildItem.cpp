@@ -144,6 +144,11 @@ namespace NMR {
 		m_pObject->mergeToMesh(pMesh, m_mTransform);
 	}
 
+	void CModelBuildItem::collectMeshes(_Inout_ std::vector<MESHMERGEINSTANCE> & Instances)
+	{
+		m_pObject->collectMeshes(Instances, m_mTransform);
+	}
+
 	nfUint32 CModelBuildItem::getHandle()
 	{
 		return m_nHandle;
@@ -108,11 +108,10 @@ namespace NMR {
 		m_UUID = uuid;
 	}
 
-	void CModelComponent::mergeToMesh(_In_ CMesh * pMesh, _In_ const NMATRIX3 mMatrix)
+	void CModelComponent::collectMeshes(_Inout_ std::vector<MESHMERGEINSTANCE> & Instances, _In_ const NMATRIX3 mMatrix)
 	{
-		__NMRASSERT(pMesh);
 		NMATRIX3 mLocalMatrix = fnMATRIX3_multiply(mMatrix, m_mTransform);
-		m_pObject->mergeToMesh(pMesh, mLocalMatrix);
+		m_pObject->collectMeshes(Instances, mLocalMatrix);
 	}
 
 }
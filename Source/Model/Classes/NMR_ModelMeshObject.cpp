@@ -34,7 +34,7 @@ mesh object.
 
 #include "Model/Classes/NMR_ModelObject.h" 
 #include "Model/Classes/NMR_ModelMeshObject.h" 
-#include "Common/Math/NMR_PairMatchingTree.h" 
+#include "Common/Mesh/NMR_MeshEdgeTopology.h" 
 
 namespace NMR {
 
@@ -54,6 +54,26 @@ namespace NMR {
 		m_pBeamLatticeAttributes = std::make_shared<CModelMeshBeamLatticeAttributes>();
 	}
 
+	CModelMeshObject::CModelMeshObject(_In_ const ModelResourceID sID, _In_ CModel * pModel, _In_ CModelMeshObject * pSourceObject)
+		: CModelObject(sID, pModel)
+	{
+		if (!pSourceObject)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		m_pMesh = std::make_shared<CMesh>(pSourceObject->getMesh());
+		if (pSourceObject->getModel() == pModel) {
+			m_pBeamLatticeAttributes = std::make_shared<CModelMeshBeamLatticeAttributes>(*pSourceObject->getBeamLatticeAttributes());
+		}
+		else {
+			m_pMesh->clearMeshInformationHandler();
+			m_pBeamLatticeAttributes = std::make_shared<CModelMeshBeamLatticeAttributes>();
+		}
+
+		setName(pSourceObject->getName());
+		setPartNumber(pSourceObject->getPartNumber());
+		setObjectType(pSourceObject->getObjectType());
+	}
+
 	CModelMeshObject::~CModelMeshObject()
 	{
 		m_pMesh = NULL;
@@ -72,10 +92,12 @@ namespace NMR {
 		m_pMesh = pMesh;
 	}
 
-	void CModelMeshObject::mergeToMesh(_In_ CMesh * pMesh, _In_ const NMATRIX3 mMatrix)
+	void CModelMeshObject::collectMeshes(_Inout_ std::vector<MESHMERGEINSTANCE> & Instances, _In_ const NMATRIX3 mMatrix)
 	{
-		__NMRASSERT(pMesh);
-		pMesh->mergeMesh(m_pMesh.get(), mMatrix);
+		MESHMERGEINSTANCE Instance;
+		Instance.m_pMesh = m_pMesh.get();
+		Instance.m_mMatrix = mMatrix;
+		Instances.push_back(Instance);
 	}
 
 	void CModelMeshObject::setObjectType(_In_ eModelObjectType ObjectType)
@@ -134,74 +156,9 @@ namespace NMR {
 		if (nFaceCount < 3)
 			return false;
 
-		CPairMatchingTree PairMatchingTree;
-		nfUint32 nFaceIndex;
-		nfInt32 nEdgeIndex;
-		nfInt32 nEdgeCounter = 0;
-		nfUint32 j;
-
-		// Build Edge Tree
-		for (nFaceIndex = 0; nFaceIndex < nFaceCount; nFaceIndex++) {
-			MESHFACE * pFace = m_pMesh->getFace(nFaceIndex);
-
-			for (j = 0; j < 3; j++) {
-				nfInt32 nNodeIndex1 = pFace->m_nodeindices[j];
-				nfInt32 nNodeIndex2 = pFace->m_nodeindices[(j + 1) % 3];
-
-				if (!PairMatchingTree.checkMatch(nNodeIndex1, nNodeIndex2, nEdgeIndex)) {
-					PairMatchingTree.addMatch(nNodeIndex1, nNodeIndex2, nEdgeCounter);
-					nEdgeCounter++;
-
-					if (nEdgeCounter > NMR_MESH_MAXEDGECOUNT)
-						throw CNMRException(NMR_ERROR_INVALIDEDGEINDEX);
-				}
-			}
-
-		}
-
-		// Count positively and negatively oriented edges...
-		std::vector<nfInt32> PositiveOrientations;
-		std::vector<nfInt32> NegativeOrientations;
-
-		// Create Edge arrays
-		PositiveOrientations.resize(nEdgeCounter);
-		NegativeOrientations.resize(nEdgeCounter);
-		for (nEdgeIndex = 0; nEdgeIndex < nEdgeCounter; nEdgeIndex++) {
-			PositiveOrientations[nEdgeIndex] = 0;
-			NegativeOrientations[nEdgeIndex] = 0;
-		}
-
-		for (nFaceIndex = 0; nFaceIndex < nFaceCount; nFaceIndex++) {
-			MESHFACE * pFace = m_pMesh->getFace(nFaceIndex);
-
-			for (j = 0; j < 3; j++) {
-				nfInt32 nNodeIndex1 = pFace->m_nodeindices[j];
-				nfInt32 nNodeIndex2 = pFace->m_nodeindices[(j + 1) % 3];
-
-				if (PairMatchingTree.checkMatch(nNodeIndex1, nNodeIndex2, nEdgeIndex)) {
-					if ((nEdgeIndex < 0) || (nEdgeIndex >= nEdgeCounter))
-						throw CNMRException(NMR_ERROR_INVALIDEDGEINDEX);
-
-					if (nNodeIndex1 <= nNodeIndex2) {
-						PositiveOrientations[nEdgeIndex]++;
-					}
-					else {
-						NegativeOrientations[nEdgeIndex]++;
-					}
-				}
-				else {
-					throw CNMRException(NMR_ERROR_INVALIDMESHTOPOLOGY);
-				}
-			}
-		}
-
-		// Check Edge Orientations and determine manifoldness
-		for (nEdgeIndex = 0; nEdgeIndex < nEdgeCounter; nEdgeIndex++) {
-			if (PositiveOrientations[nEdgeIndex] != 1)
-				return false;
-			if (NegativeOrientations[nEdgeIndex] != 1)
-				return false;
-		}
+		CMeshEdgeTopology EdgeTopology(m_pMesh.get());
+		if (!EdgeTopology.isManifoldAndOriented())
+			return false;
 
 		// Mesh is non-empty, oriented and manifold
 		return true;
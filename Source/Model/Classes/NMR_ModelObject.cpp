@@ -50,6 +50,14 @@ namespace NMR {
 	}
 
 	void CModelObject::mergeToMesh(_In_ CMesh * pMesh, _In_ const NMATRIX3 mMatrix)
+	{
+		__NMRASSERT(pMesh);
+		std::vector<MESHMERGEINSTANCE> Instances;
+		collectMeshes(Instances, mMatrix);
+		pMesh->mergeMeshes(Instances);
+	}
+
+	void CModelObject::collectMeshes(_Inout_ std::vector<MESHMERGEINSTANCE> & Instances, _In_ const NMATRIX3 mMatrix)
 	{
 		// empty on purpose, to be implemented by child classes
 	}
@@ -67,6 +67,13 @@ namespace NMR {
 		return m_pModel;
 	}
 
+	void CModelResource::setModel(_In_ CModel * pModel)
+	{
+		if (!pModel)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+		m_pModel = pModel;
+	}
+
 
 	void CModelResource::clearResourceIndexMap()
 	{
@@ -85,6 +85,24 @@ namespace NMR {
 		return nullptr;
 	}
 
+	void CResourceHandler::adoptResourceIDs(CResourceHandler & sourceHandler, std::map<PackageResourceID, PackageResourceID> &oldToNewMapping)
+	{
+		// The CPackageResourceID objects are moved, not copied: resources holding them see their new unique ID
+		PackageResourceID nCount = (PackageResourceID)sourceHandler.m_resourceIDs.size();
+		for (PackageResourceID nOldID = 1; nOldID <= nCount; nOldID++) {
+			PPackageResourceID p = sourceHandler.findResourceID(nOldID);
+			if (!p)
+				throw CNMRException(NMR_ERROR_INVALIDPARAM);
+			if (findResourceID(p->m_path, p->m_id))
+				throw CNMRException(NMR_ERROR_DUPLICATERESOURCEID);
+			p->setUniqueID(int(m_resourceIDs.size())+1);
+			m_resourceIDs.insert(std::make_pair(p->getUniqueID(), p));
+			m_IdAndPathToResourceIDs.insert(std::make_pair(std::make_pair(p->m_id, p->m_path), p));
+			oldToNewMapping[nOldID] = p->getUniqueID();
+		}
+		sourceHandler.clear();
+	}
+
 	void CResourceHandler::FlattenIDs() {
 
 	}
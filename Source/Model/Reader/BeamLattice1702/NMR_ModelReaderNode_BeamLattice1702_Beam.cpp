@@ -56,6 +56,13 @@ namespace NMR {
 	CModelReaderNode_BeamLattice1702_Beam::CModelReaderNode_BeamLattice1702_Beam(_In_ CModel * pModel, _In_ PModelReaderWarnings pWarnings)
 		: CModelReaderNode(pWarnings)
 	{
+		reset();
+	}
+
+	void CModelReaderNode_BeamLattice1702_Beam::reset()
+	{
+		resetNode();
+
 		m_nIndex1 = -1;
 		m_nIndex2 = -1;
 
@@ -66,6 +73,8 @@ namespace NMR {
 
 		m_bHasCap1 = false;
 		m_bHasCap2 = false;
+		m_eCapMode1 = MODELBEAMLATTICECAPMODE_SPHERE;
+		m_eCapMode2 = MODELBEAMLATTICECAPMODE_SPHERE;
 
 		m_bHasTag = false;
 		m_nTag = -1;
@@ -125,45 +134,52 @@ namespace NMR {
 			nTag = m_nTag;
 	}
 
-	void CModelReaderNode_BeamLattice1702_Beam::OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
+	void CModelReaderNode_BeamLattice1702_Beam::OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
 	{
 		__NMRASSERT(pAttributeName);
 		__NMRASSERT(pAttributeValue);
 
-		if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_BEAMLATTICE_V1) == 0) {
+		switch (Token) {
+		case XMLTOKEN_V1: {
 			nfInt32 nValue = fnStringToInt32(pAttributeValue);
 			if ((nValue >= 0) && (nValue < XML_3MF_MAXRESOURCEINDEX))
 				m_nIndex1 = nValue;
+			break;
 		}
-		else if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_BEAMLATTICE_V2) == 0) {
+		case XMLTOKEN_V2: {
 			nfInt32 nValue = fnStringToInt32(pAttributeValue);
 			if ((nValue >= 0) && (nValue < XML_3MF_MAXRESOURCEINDEX))
 				m_nIndex2 = nValue;
+			break;
 		}
-		else if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_BEAMLATTICE_R1) == 0) {
+		case XMLTOKEN_R1: {
 			nfFloat fValue = fnStringToFloat(pAttributeValue);
 			if ((fValue >= 0) && (fValue < XML_3MF_MAXIMUMBEAMRADIUSVALUE)) {
 				m_dRadius1 = fValue;
 				m_bHasRadius1 = true;
 			}
+			break;
 		}
-		else if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_BEAMLATTICE_R2) == 0) {
+		case XMLTOKEN_R2: {
 			nfFloat fValue = fnStringToFloat(pAttributeValue);
 			if ((fValue >= 0) && (fValue < XML_3MF_MAXIMUMBEAMRADIUSVALUE)) {
 				m_dRadius2 = fValue;
 				m_bHasRadius2 = true;
 			}
+			break;
 		}
-		else if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_BEAMLATTICE_CAP1) == 0) {
+		case XMLTOKEN_CAP1:
 			m_bHasCap1 = true;
 			m_eCapMode1 = stringToCapMode(pAttributeValue);
-		}
-		else if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_BEAMLATTICE_CAP2) == 0) {
+			break;
+		case XMLTOKEN_CAP2:
 			m_bHasCap2 = true;
 			m_eCapMode2 = stringToCapMode(pAttributeValue);
-		}
-		else
+			break;
+		default:
 			m_pWarnings->addException(CNMRException(NMR_ERROR_BEAMLATTICEINVALIDATTRIBUTE), mrwInvalidOptionalValue);
+			break;
+		}
 	}
 
 	void CModelReaderNode_BeamLattice1702_Beam::OnNSAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue, _In_z_ const nfChar * pNameSpace)
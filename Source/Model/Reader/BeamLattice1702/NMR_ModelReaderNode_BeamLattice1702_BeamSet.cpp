@@ -93,7 +93,7 @@ namespace NMR {
 
 		if (strcmp(pNameSpace, XML_3MF_NAMESPACE_BEAMLATTICESPEC) == 0) {
 			if (strcmp(pChildName, XML_3MF_ELEMENT_REF) == 0) {
-				PModelReaderNode_BeamLattice1702_Ref pXMLNode = std::make_shared<CModelReaderNode_BeamLattice1702_Ref>(m_pWarnings);
+				CModelReaderNode_BeamLattice1702_Ref * pXMLNode = reuseChildNode(m_pRefNode, m_pWarnings);
 				pXMLNode->parseXML(pXMLReader);
 				nfInt32 nIndex;
 				pXMLNode->retrieveIndex(nIndex);
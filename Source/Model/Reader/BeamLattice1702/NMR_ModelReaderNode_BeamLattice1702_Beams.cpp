@@ -73,26 +73,26 @@ namespace NMR {
 		__NMRASSERT(pAttributeValue);
 	}
 
-	void CModelReaderNode_BeamLattice1702_Beams::OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader)
+	void CModelReaderNode_BeamLattice1702_Beams::OnTokenizedNSChildElement(_In_ nfUint32 nNameSpaceID, _In_ eXmlToken Token, _In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader)
 	{
 		__NMRASSERT(pChildName);
 		__NMRASSERT(pXMLReader);
 		__NMRASSERT(pNameSpace);
 
-		if (strcmp(pNameSpace, XML_3MF_NAMESPACE_BEAMLATTICESPEC) == 0) {
-			if (strcmp(pChildName, XML_3MF_ELEMENT_BEAM) == 0) {
+		if (nNameSpaceID == XMLNAMESPACEID_BEAMLATTICESPEC) {
+			if (Token == XMLTOKEN_BEAM) {
 				// Parse XML
-				PModelReaderNode_BeamLattice1702_Beam pXMLNode = std::make_shared<CModelReaderNode_BeamLattice1702_Beam>(m_pModel, m_pWarnings);
+				CModelReaderNode_BeamLattice1702_Beam * pXMLNode = reuseChildNode(m_pBeamNode, m_pModel, m_pWarnings);
 				pXMLNode->parseXML(pXMLReader);
 
 				// Retrieve node indices
 				nfInt32 nIndex1, nIndex2;
 				pXMLNode->retrieveIndices(nIndex1, nIndex2, m_pMesh->getNodeCount());
 
-				MESHNODE* pNode1 = m_pMesh->getNode(nIndex1);
-				MESHNODE* pNode2 = m_pMesh->getNode(nIndex2);
+				NVEC3 vPosition1 = m_pMesh->getNodePosition(nIndex1);
+				NVEC3 vPosition2 = m_pMesh->getNodePosition(nIndex2);
 				
-				if (fnVEC3_length(fnVEC3_sub(pNode1->m_position, pNode2->m_position)) < m_pMesh->getBeamLatticeMinLength())
+				if (fnVEC3_length(fnVEC3_sub(vPosition1, vPosition2)) < m_pMesh->getBeamLatticeMinLength())
 					m_pWarnings->addException(CNMRException(NMR_ERROR_BEAMLATTICENODESTOOCLOSE), mrwInvalidMandatoryValue);
 
 				nfInt32 nTag;
@@ -121,9 +121,7 @@ namespace NMR {
 
 				// Create beam if valid
 				if (nIndex1 != nIndex2) {
-					MESHNODE * pNode1 = m_pMesh->getNode(nIndex1);
-					MESHNODE * pNode2 = m_pMesh->getNode(nIndex2);
-					m_pMesh->addBeam(pNode1, pNode2, dRadius1, dRadius2, nCap1, nCap2);
+					m_pMesh->addBeam(nIndex1, nIndex2, dRadius1, dRadius2, nCap1, nCap2);
 				}
 			}
 			else
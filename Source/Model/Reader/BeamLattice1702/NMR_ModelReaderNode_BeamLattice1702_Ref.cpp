@@ -42,8 +42,16 @@ NMR_ModelReaderNode_BeamLattice1702_Ref.cpp covers the official 3MF beamlattice
 namespace NMR {
 
 	CModelReaderNode_BeamLattice1702_Ref::CModelReaderNode_BeamLattice1702_Ref(_In_ PModelReaderWarnings pWarnings)
-		: CModelReaderNode(pWarnings), m_nIndex(0)
+		: CModelReaderNode(pWarnings)
 	{
+		reset();
+	}
+
+	void CModelReaderNode_BeamLattice1702_Ref::reset()
+	{
+		resetNode();
+
+		m_nIndex = 0;
 	}
 
 	void CModelReaderNode_BeamLattice1702_Ref::parseXML(_In_ CXmlReader * pXMLReader)
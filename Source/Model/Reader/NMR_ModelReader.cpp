@@ -61,6 +61,8 @@ namespace NMR {
 
 		// Create Empty Mesh
 		PMesh pMesh = std::make_shared<CMesh>();
+		pMesh->setArena(m_pModel->getArena());
+		pMesh->setMappedStorage(m_pMeshMappedStorage);
 
 		// Import Mesh
 		pImporter->loadMesh(pMesh.get(), nullptr);
@@ -99,4 +101,14 @@ namespace NMR {
 	{
 		m_pProgressMonitor->SetProgressCallback(callback, userData);
 	}
+
+	void CModelReader::setMeshMappedStorage(_In_opt_ PMeshMappedStorage pMeshMappedStorage)
+	{
+		m_pMeshMappedStorage = pMeshMappedStorage;
+	}
+
+	PMeshMappedStorage CModelReader::getMeshMappedStorage()
+	{
+		return m_pMeshMappedStorage;
+	}
 }
@@ -42,9 +42,7 @@ namespace NMR {
 
 	CModelReaderNode::CModelReaderNode(_In_ PModelReaderWarnings pWarnings, _In_ PProgressMonitor pProgressMonitor)
 	{
-		m_bParsedAttributes = false;
-		m_bParsedContent = false;
-		m_bIsEmptyElement = false;
+		resetNode();
 
 		if (pProgressMonitor) {
 			m_pProgressMonitor = pProgressMonitor;
@@ -61,6 +59,15 @@ namespace NMR {
 		}
 	}
 
+	void CModelReaderNode::resetNode()
+	{
+		m_pszName = nullptr;
+		m_sName.clear();
+		m_bParsedAttributes = false;
+		m_bParsedContent = false;
+		m_bIsEmptyElement = false;
+	}
+
 	void CModelReaderNode::parseName(_In_ CXmlReader * pXMLReader)
 	{
 		__NMRASSERT(pXMLReader);
@@ -70,18 +77,27 @@ namespace NMR {
 		if (!pszName)
 			throw CNMRException(NMR_ERROR_COULDNOTGETLOCALXMLNAME);
 
-		std::string sName(pszName);
-		m_sName = sName;
-
-		if (m_sName == "")
+		if (*pszName == 0)
 			throw CNMRException(NMR_ERROR_NODENAMEISEMPTY);
 
+		m_pszName = pszName;
+
 		m_bIsEmptyElement = pXMLReader->IsEmptyElement() != 0;
 	}
 
+	void CModelReaderNode::persistName()
+	{
+		if (m_pszName != m_sName.c_str()) {
+			m_sName = m_pszName;
+			m_pszName = m_sName.c_str();
+		}
+	}
+
 	std::string CModelReaderNode::getName()
 	{
-		return m_sName;
+		if (m_pszName == nullptr)
+			return "";
+		return m_pszName;
 	}
 
 	PModelReaderWarnings CModelReaderNode::getWarnings()
@@ -127,7 +143,7 @@ namespace NMR {
 
 				if (nNameCount > 0) {
 					if (nNameSpaceCount == 0) {
-						OnAttribute(pszLocalName, pszValue);
+						OnTokenizedAttribute(fnXmlLookupToken(pszLocalName, nNameCount), pszLocalName, pszValue);
 					}
 					else {
 						OnNSAttribute(pszLocalName, pszValue, pszNameSpaceURI);
@@ -139,11 +155,55 @@ namespace NMR {
 		}
 	}
 
+	void CModelReaderNode::parseRawAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
+	{
+		__NMRASSERT(pAttributeName);
+		__NMRASSERT(pAttributeValue);
+
+		OnTokenizedAttribute(Token, pAttributeName, pAttributeValue);
+	}
+
+	nfBool CModelReaderNode::parseRawContent(_In_ CXmlReader * pXMLReader, _In_ nfUint32 nNameSpaceID, _In_ CModelReader_RawBlockParser & BlockParser)
+	{
+		__NMRASSERT(pXMLReader);
+
+		if (m_pszName == nullptr)
+			throw CNMRException(NMR_ERROR_NODENAMEISEMPTY);
+
+		if (m_bParsedContent)
+			throw CNMRException(NMR_ERROR_ALREADYPARSEDXMLNODE);
+
+		if (m_bIsEmptyElement)
+			return false;
+
+		// Looking ahead might refill the reader buffer
+		persistName();
+
+		const nfChar * pStart = nullptr;
+		const nfChar * pEnd = nullptr;
+		nfUint32 nDefaultNameSpaceID = 0;
+		if (!pXMLReader->GetRawContent(&pStart, &pEnd, nDefaultNameSpaceID))
+			return false;
+
+		// Unprefixed child elements have to resolve to the expected namespace
+		if (nDefaultNameSpaceID != nNameSpaceID)
+			return false;
+
+		const nfChar * pResume = nullptr;
+		if (!BlockParser.parse(m_pszName, pStart, pEnd, &pResume))
+			return false;
+
+		pXMLReader->SkipRawContent(pResume);
+		m_bParsedContent = true;
+
+		return true;
+	}
+
 	void CModelReaderNode::parseContent(_In_ CXmlReader * pXMLReader)
 	{
 		__NMRASSERT(pXMLReader);
 
-		if (m_sName == "")
+		if (m_pszName == nullptr)
 			throw CNMRException(NMR_ERROR_NODENAMEISEMPTY);
 
 		if (m_bParsedContent)
@@ -165,6 +225,10 @@ namespace NMR {
 			eXmlReaderNodeType NodeType;
 			pXMLReader->Read(NodeType);
 
+			// Child content might refill the reader buffer, so the name needs to be kept
+			if ((NodeType == XMLREADERNODETYPE_STARTELEMENT) || (NodeType == XMLREADERNODETYPE_TEXT))
+				persistName();
+
 			switch (NodeType) {
 			case XMLREADERNODETYPE_STARTELEMENT:
 				pXMLReader->GetLocalName(&pszLocalName, &nCount);
@@ -176,11 +240,12 @@ namespace NMR {
 					throw CNMRException(NMR_ERROR_COULDNOTGETNAMESPACE);
 
 					if (nCount > 0) {
+						eXmlToken Token = fnXmlLookupToken(pszLocalName, nCount);
 						if (pszNameSpaceURI == nullptr) {
-							OnNSChildElement(pszLocalName, "", pXMLReader);
+							OnTokenizedNSChildElement(XMLNAMESPACEID_NONE, Token, pszLocalName, "", pXMLReader);
 						}
 						else {
-							OnNSChildElement(pszLocalName, pszNameSpaceURI, pXMLReader);
+							OnTokenizedNSChildElement(pXMLReader->GetNamespaceID(), Token, pszLocalName, pszNameSpaceURI, pXMLReader);
 						}
 					}
 				break;
@@ -199,7 +264,7 @@ namespace NMR {
 				if (!pszLocalName)
 					throw CNMRException(NMR_ERROR_COULDNOTGETLOCALXMLNAME);
 
-				if (strcmp(pszLocalName, m_sName.c_str()) == 0) {
+				if (strcmp(pszLocalName, m_pszName) == 0) {
 					OnEndElement (pXMLReader);
 
 					pXMLReader->CloseElement();
@@ -239,6 +304,16 @@ namespace NMR {
 
 	}
 
+	void CModelReaderNode::OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
+	{
+		OnAttribute(pAttributeName, pAttributeValue);
+	}
+
+	void CModelReaderNode::OnTokenizedNSChildElement(_In_ nfUint32 nNameSpaceID, _In_ eXmlToken Token, _In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader)
+	{
+		OnNSChildElement(pChildName, pNameSpace, pXMLReader);
+	}
+
 	void CModelReaderNode::setBinaryStreamCollection(PChunkedBinaryStreamCollection pBinaryStreamCollection)
 	{
 		m_pBinaryStreamCollection = pBinaryStreamCollection;
@@ -254,4 +329,14 @@ namespace NMR {
 		return m_pBinaryStreamCollection.get() != nullptr;
 	}
 
+	void CModelReaderNode::setMeshMappedStorage(PMeshMappedStorage pMeshMappedStorage)
+	{
+		m_pMeshMappedStorage = pMeshMappedStorage;
+	}
+
+	PMeshMappedStorage CModelReaderNode::getMeshMappedStorage()
+	{
+		return m_pMeshMappedStorage;
+	}
+
 }
@@ -198,6 +198,7 @@ namespace NMR {
 					throw CNMRException(NMR_ERROR_DUPLICATERESOURCES);
 
 				pXMLNode->setBinaryStreamCollection(m_pBinaryStreamCollection);
+				pXMLNode->setMeshMappedStorage(m_pMeshMappedStorage);
 				pXMLNode->parseXML(pXMLReader);
 				m_bHasResources = true;
 			}
@@ -243,6 +244,7 @@ namespace NMR {
 				if (m_bHasResources)
 					throw CNMRException(NMR_ERROR_DUPLICATERESOURCES);
 
+				pXMLNode->setMeshMappedStorage(m_pMeshMappedStorage);
 				pXMLNode->parseXML(pXMLReader);
 				m_bHasResources = true;
 			}
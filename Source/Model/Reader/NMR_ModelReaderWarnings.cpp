@@ -108,6 +108,18 @@ namespace NMR {
 		return m_Warnings[nIndex];
 	}
 
+	void CModelReaderWarnings::mergeWarnings(_In_ CModelReaderWarnings * pSourceWarnings)
+	{
+		if (pSourceWarnings == nullptr)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		for (auto pWarning : pSourceWarnings->m_Warnings) {
+			if (m_Warnings.size() >= NMR_MAXWARNINGCOUNT) // Failsafe check for Index overflows
+				break;
+			m_Warnings.push_back(pWarning);
+		}
+	}
+
 
 
 }
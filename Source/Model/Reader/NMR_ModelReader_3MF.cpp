@@ -42,6 +42,8 @@ NMR_ModelReader_3MF.cpp implements the Model Reader Class for
 #include "Common/NMR_Exception_Windows.h"
 #include "Common/MeshImport/NMR_MeshImporter_STL.h"
 #include "Common/Platform/NMR_Platform.h"
+#include "Common/Platform/NMR_ImportStream_Pipelined.h"
+#include "Common/Platform/NMR_ImportStream_Memory.h"
 #include "Model/Classes/NMR_ModelAttachment.h" 
 
 #include "Model/Reader/Slice1507/NMR_ModelReader_Slice1507_SliceRefModel.h"
@@ -49,17 +51,73 @@ NMR_ModelReader_3MF.cpp implements the Model Reader Class for
 
 #include "Common/3MF_ProgressMonitor.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+
 namespace NMR {
 
 	CModelReader_3MF::CModelReader_3MF(_In_ PModel pModel, _In_ nfBool bAllowBinaryStreams)
-		: CModelReader(pModel), m_bAllowBinaryStreams (bAllowBinaryStreams)
+		: CModelReader(pModel), m_bAllowBinaryStreams (bAllowBinaryStreams), m_bPipelinedInflate (true), m_bParallelProductionParts (true), m_bParallelMeshParsing (false)
 	{
 		// empty on purpose
 		if (bAllowBinaryStreams)
 			m_pBinaryStreamCollection = std::make_shared<CChunkedBinaryStreamCollection>();
 	}
 
-	void readProductionAttachmentModels(_In_ PModel pModel, _In_ PModelReaderWarnings pWarnings, _In_ PProgressMonitor pProgressMonitor)
+	void readProductionAttachmentModel(_In_ PModel pModel, _In_ PModelAttachment pProdAttachment, _In_ PModelReaderWarnings pWarnings, _In_ PProgressMonitor pProgressMonitor, _In_ nfBool bParallelMeshParsing, _In_ PMeshMappedStorage pMeshMappedStorage)
+	{
+		std::string path = pProdAttachment->getPathURI();
+		PImportStream pSubModelStream = pProdAttachment->getStream();
+
+		// Create XML Reader
+		PXmlReader pXMLReader = fnCreateXMLReaderInstance(pSubModelStream, pProgressMonitor);
+		pXMLReader->AllowRawContent(bParallelMeshParsing);
+
+		nfBool bHasModel = false;
+		eXmlReaderNodeType NodeType;
+		// Read all XML Root Nodes
+		while (!pXMLReader->IsEOF()) {
+			if (!pXMLReader->Read(NodeType))
+				break;
+
+			// Get Node Name
+			LPCSTR pszLocalName = nullptr;
+			pXMLReader->GetLocalName(&pszLocalName, nullptr);
+			if (!pszLocalName)
+				throw CNMRException(NMR_ERROR_COULDNOTGETLOCALXMLNAME);
+
+			if (strcmp(pszLocalName, XML_3MF_ATTRIBUTE_PREFIX_XML) == 0) {
+				PModelReader_InstructionElement pXMLNode = std::make_shared<CModelReader_InstructionElement>(pWarnings);
+				pXMLNode->parseXML(pXMLReader.get());
+			}
+
+			// Compare with Model Node Name
+			if (strcmp(pszLocalName, XML_3MF_ELEMENT_MODEL) == 0) {
+				if (bHasModel)
+					throw CNMRException(NMR_ERROR_DUPLICATEMODELNODE);
+				bHasModel = true;
+
+				PModelReaderNode_Model pXMLNode;
+				pModel->setCurPath(path.c_str());
+
+				pXMLNode = std::make_shared<CModelReaderNode_Model>(pModel.get(), pWarnings, path.c_str(), pProgressMonitor);
+				pXMLNode->setIgnoreBuild(true);
+				pXMLNode->setIgnoreMetaData(true);
+				pXMLNode->setMeshMappedStorage(pMeshMappedStorage);
+				pXMLNode->parseXML(pXMLReader.get());
+
+				if (!pXMLNode->getHasResources())
+					throw CNMRException(NMR_ERROR_NORESOURCES);
+				if (!pXMLNode->getHasBuild())
+					throw CNMRException(NMR_ERROR_BUILDITEMNOTFOUND);
+			}
+		}
+	}
+
+	void readProductionAttachmentModels(_In_ PModel pModel, _In_ PModelReaderWarnings pWarnings, _In_ PProgressMonitor pProgressMonitor, _In_ nfBool bParallelMeshParsing, _In_ PMeshMappedStorage pMeshMappedStorage)
 	{
 		nfUint32 prodAttCount = pModel->getProductionAttachmentCount();
 		for (nfInt32 i = prodAttCount-1; i >=0; i--)
@@ -69,54 +127,107 @@ namespace NMR {
 				pProgressMonitor->ReportProgressAndQueryCancelled(true);
 			}
 
-			PModelAttachment pProdAttachment = pModel->getProductionModelAttachment(i);
-			std::string path = pProdAttachment->getPathURI();
-			PImportStream pSubModelStream = pProdAttachment->getStream();
-
-			// Create XML Reader
-			PXmlReader pXMLReader = fnCreateXMLReaderInstance(pSubModelStream, pProgressMonitor);
-
-			nfBool bHasModel = false;
-			eXmlReaderNodeType NodeType;
-			// Read all XML Root Nodes
-			while (!pXMLReader->IsEOF()) {
-				if (!pXMLReader->Read(NodeType))
-					break;
-
-				// Get Node Name
-				LPCSTR pszLocalName = nullptr;
-				pXMLReader->GetLocalName(&pszLocalName, nullptr);
-				if (!pszLocalName)
-					throw CNMRException(NMR_ERROR_COULDNOTGETLOCALXMLNAME);
-
-				if (strcmp(pszLocalName, XML_3MF_ATTRIBUTE_PREFIX_XML) == 0) {
-					PModelReader_InstructionElement pXMLNode = std::make_shared<CModelReader_InstructionElement>(pWarnings);
-					pXMLNode->parseXML(pXMLReader.get());
-				}
+			readProductionAttachmentModel(pModel, pModel->getProductionModelAttachment(i), pWarnings, pProgressMonitor, bParallelMeshParsing, pMeshMappedStorage);
+		}
+	}
 
-				// Compare with Model Node Name
-				if (strcmp(pszLocalName, XML_3MF_ELEMENT_MODEL) == 0) {
-					if (bHasModel)
-						throw CNMRException(NMR_ERROR_DUPLICATEMODELNODE);
-					bHasModel = true;
+	typedef struct {
+		PModelAttachment m_pAttachment;
+		PModel m_pModel;
+		PModelReaderWarnings m_pWarnings;
+		std::exception_ptr m_pException;
+	} PRODUCTIONPARTSTAGE;
 
-					PModelReaderNode_Model pXMLNode;
-					pModel->setCurPath(path.c_str());
+	void readProductionAttachmentModelsParallel(_In_ PModel pModel, _In_ PModelReaderWarnings pWarnings, _In_ PProgressMonitor pProgressMonitor, _In_ nfBool bParallelMeshParsing, _In_ PMeshMappedStorage pMeshMappedStorage)
+	{
+		nfUint32 prodAttCount = pModel->getProductionAttachmentCount();
 
-					pXMLNode = std::make_shared<CModelReaderNode_Model>(pModel.get(), pWarnings, path.c_str(), pProgressMonitor);
-					pXMLNode->setIgnoreBuild(true);
-					pXMLNode->setIgnoreMetaData(true);
-					pXMLNode->parseXML(pXMLReader.get());
+		// Every part is read into a staging model of its own
+		std::vector<PRODUCTIONPARTSTAGE> Stages(prodAttCount);
+		for (nfUint32 i = 0; i < prodAttCount; i++) {
+			PRODUCTIONPARTSTAGE & Stage = Stages[i];
+			Stage.m_pAttachment = pModel->getProductionModelAttachment(i);
+			Stage.m_pModel = std::make_shared<CModel>();
+			Stage.m_pModel->setRootPath(pModel->rootPath());
+			Stage.m_pModel->shareModelAttachments(pModel.get());
+			Stage.m_pWarnings = std::make_shared<CModelReaderWarnings>();
+			Stage.m_pWarnings->setCriticalWarningLevel(pWarnings->getCriticalWarningLevel());
+		}
 
-					if (!pXMLNode->getHasResources())
-						throw CNMRException(NMR_ERROR_NORESOURCES);
-					if (!pXMLNode->getHasBuild())
-						throw CNMRException(NMR_ERROR_BUILDITEMNOTFOUND);
+		// The calling thread reads parts with the monitor of the caller, workers with monitors without callback.
+		// All of them share one cancel flag, so that a cancel stops the parts in progress and no new ones are taken.
+		std::shared_ptr<std::atomic<bool>> pCancelFlag = std::make_shared<std::atomic<bool>>(false);
+		std::shared_ptr<std::atomic<bool>> pPreviousCancelFlag = pProgressMonitor->GetCancelFlag();
+		pProgressMonitor->SetCancelFlag(pCancelFlag);
+
+		std::atomic<nfUint32> nNextStage(0);
+		auto readStages = [&Stages, &nNextStage, prodAttCount, bParallelMeshParsing, pMeshMappedStorage, pCancelFlag](PProgressMonitor pStageProgressMonitor) {
+			nfUint32 nIndex;
+			while (!pCancelFlag->load() && ((nIndex = nNextStage++) < prodAttCount)) {
+				PRODUCTIONPARTSTAGE & Stage = Stages[nIndex];
+				try {
+					pStageProgressMonitor->SetProgressIdentifier(ProgressIdentifier::PROGRESS_READNONROOTMODELS);
+					pStageProgressMonitor->ReportProgressAndQueryCancelled(true);
+					readProductionAttachmentModel(Stage.m_pModel, Stage.m_pAttachment, Stage.m_pWarnings, pStageProgressMonitor, bParallelMeshParsing, pMeshMappedStorage);
+				}
+				catch (...) {
+					Stage.m_pException = std::current_exception();
 				}
 			}
+		};
+		auto createWorkerProgressMonitor = [pCancelFlag]() {
+			PProgressMonitor pWorkerProgressMonitor = std::make_shared<CProgressMonitor>();
+			pWorkerProgressMonitor->SetCancelFlag(pCancelFlag);
+			return pWorkerProgressMonitor;
+		};
+
+		nfUint32 nThreadCount = std::min(std::thread::hardware_concurrency(), prodAttCount);
+		std::vector<std::thread> Workers;
+		try {
+			for (nfUint32 i = 1; i < nThreadCount; i++)
+				Workers.push_back(std::thread(readStages, createWorkerProgressMonitor()));
+		}
+		catch (std::system_error &) {
+			// Fewer workers only cost time, the calling thread reads the remaining parts
+		}
+		readStages(pProgressMonitor);
+		for (auto & Worker : Workers)
+			Worker.join();
+
+		pProgressMonitor->SetCancelFlag(pPreviousCancelFlag);
+		if (pCancelFlag->load())
+			throw CNMRException(NMR_USERABORTED);
+
+		// Merge in the order of a serial read, so that IDs and warnings come out the same
+		for (nfInt32 i = prodAttCount - 1; i >= 0; i--)
+		{
+			if (pProgressMonitor) {
+				pProgressMonitor->SetProgressIdentifier(ProgressIdentifier::PROGRESS_READNONROOTMODELS);
+				pProgressMonitor->ReportProgressAndQueryCancelled(true);
+			}
+
+			PRODUCTIONPARTSTAGE & Stage = Stages[i];
+			if (Stage.m_pException) {
+				// A part that refers to resources of another part (e.g. by a slice reference) cannot be
+				// read on its own. Read it again into the package model, which also reproduces the error
+				// of a broken part.
+				Stage.m_pAttachment->getStream()->seekPosition(0, true);
+				readProductionAttachmentModel(pModel, Stage.m_pAttachment, pWarnings, pProgressMonitor, bParallelMeshParsing, pMeshMappedStorage);
+			}
+			else {
+				pModel->setCurPath(Stage.m_pAttachment->getPathURI());
+				pWarnings->mergeWarnings(Stage.m_pWarnings.get());
+				pModel->mergeProductionPart(Stage.m_pModel.get());
+			}
+			Stage.m_pModel = nullptr;
 		}
 	}
 
+	nfBool isWorthReadingInParallel(_In_ PModel pModel)
+	{
+		return (pModel->getProductionAttachmentCount() > 1) && (std::thread::hardware_concurrency() > 1);
+	}
+
 
 	void CModelReader_3MF::readStream(_In_ PImportStream pStream)
 	{
@@ -132,13 +243,25 @@ namespace NMR {
 		PImportStream pModelStream = extract3MFOPCPackage(pStream);
 		
 		// before reading the root model, read the other models in the file
-		readProductionAttachmentModels(m_pModel, m_pWarnings, m_pProgressMonitor);
+		if (m_bParallelProductionParts && isWorthReadingInParallel(m_pModel))
+			readProductionAttachmentModelsParallel(m_pModel, m_pWarnings, m_pProgressMonitor, m_bParallelMeshParsing, m_pMeshMappedStorage);
+		else
+			readProductionAttachmentModels(m_pModel, m_pWarnings, m_pProgressMonitor, m_bParallelMeshParsing, m_pMeshMappedStorage);
 
 		m_pProgressMonitor->SetProgressIdentifier(ProgressIdentifier::PROGRESS_READROOTMODEL);
 		m_pProgressMonitor->ReportProgressAndQueryCancelled(true);
 
+		// Mesh blocks can only be parsed in parallel from memory. Packages that are not held in memory
+		// themselves keep the streaming path.
+		nfBool bParallelMeshParsing = m_bParallelMeshParsing && (dynamic_cast<CImportStream_Memory *> (pStream.get()) != nullptr);
+		if (bParallelMeshParsing)
+			pModelStream = pModelStream->copyToMemory();
+		else if (m_bPipelinedInflate && CImportStream_Pipelined::isWorthPipelining(pModelStream->retrieveSize()))
+			pModelStream = std::make_shared<CImportStream_Pipelined>(pModelStream);
+
 		// Create XML Reader
 		PXmlReader pXMLReader = fnCreateXMLReaderInstance(pModelStream, m_pProgressMonitor);
+		pXMLReader->AllowRawContent(bParallelMeshParsing);
 
 		eXmlReaderNodeType NodeType;
 		// Read all XML Root Nodes
@@ -166,6 +289,7 @@ namespace NMR {
 				m_pModel->setCurPath(m_pModel->rootPath().c_str());
 				PModelReaderNode_Model pXMLNode = std::make_shared<CModelReaderNode_Model>(m_pModel.get(), m_pWarnings, m_pModel->rootPath().c_str(), m_pProgressMonitor);
 				pXMLNode->setBinaryStreamCollection(m_pBinaryStreamCollection);
+				pXMLNode->setMeshMappedStorage(m_pMeshMappedStorage);
 
 				pXMLNode->parseXML(pXMLReader.get());
 
@@ -180,6 +304,10 @@ namespace NMR {
 		m_pProgressMonitor->SetProgressIdentifier(ProgressIdentifier::PROGRESS_CLEANUP);
 		m_pProgressMonitor->ReportProgressAndQueryCancelled(false);
 
+		// A producer thread must not outlive the package it reads from
+		pXMLReader = nullptr;
+		pModelStream = nullptr;
+
 		// Release Memory of 3MF Package
 		release3MFOPCPackage();
 
@@ -190,6 +318,36 @@ namespace NMR {
 		m_pProgressMonitor->ReportProgressAndQueryCancelled(false);
 	}
 
+	void CModelReader_3MF::setPipelinedInflate(_In_ nfBool bPipelinedInflate)
+	{
+		m_bPipelinedInflate = bPipelinedInflate;
+	}
+
+	nfBool CModelReader_3MF::getPipelinedInflate()
+	{
+		return m_bPipelinedInflate;
+	}
+
+	void CModelReader_3MF::setParallelProductionParts(_In_ nfBool bParallelProductionParts)
+	{
+		m_bParallelProductionParts = bParallelProductionParts;
+	}
+
+	nfBool CModelReader_3MF::getParallelProductionParts()
+	{
+		return m_bParallelProductionParts;
+	}
+
+	void CModelReader_3MF::setParallelMeshParsing(_In_ nfBool bParallelMeshParsing)
+	{
+		m_bParallelMeshParsing = bParallelMeshParsing;
+	}
+
+	nfBool CModelReader_3MF::getParallelMeshParsing()
+	{
+		return m_bParallelMeshParsing;
+	}
+
 	void CModelReader_3MF::addTextureAttachment(_In_ std::string sPath, _In_ PImportStream pStream)
 	{
 		if (pStream.get() == nullptr)
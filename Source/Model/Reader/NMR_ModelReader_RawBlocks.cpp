@@ -0,0 +1,272 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+NMR_ModelReader_RawBlocks.cpp implements a parser for large blocks of uniform, empty elements
+that reads them directly from an in-memory document on worker threads.
+
+--*/
+
+#include "Model/Reader/NMR_ModelReader_RawBlocks.h"
+#include "Common/NMR_Exception.h"
+
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+#include <thread>
+
+namespace NMR {
+
+	static nfBool fnRawBlockIsSpace(_In_ nfChar cChar)
+	{
+		return (cChar == 9) || (cChar == 10) || (cChar == 13) || (cChar == 32);
+	}
+
+	CModelReader_RawBlockParser::CModelReader_RawBlockParser(_In_z_ const nfChar * pszElementName, _In_ std::function<PModelReader_RawRange()> fnCreateRange)
+		: m_sElementName(pszElementName), m_fnCreateRange(fnCreateRange)
+	{
+		if (!m_fnCreateRange)
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		m_nThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+
+	nfBool CModelReader_RawBlockParser::parse(_In_z_ const nfChar * pszBlockName, _In_ const nfChar * pStart, _In_ const nfChar * pEnd, _Outptr_ const nfChar ** ppResume)
+	{
+		if ((!pszBlockName) || (!pStart) || (!pEnd) || (!ppResume) || (pStart > pEnd))
+			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		m_sBlockName = pszBlockName;
+		m_Ranges.clear();
+
+		size_t cbRangeSize = NMR_RAWBLOCK_MINRANGESIZE;
+		const nfChar * pWindowStart = pStart;
+
+		while (pWindowStart != pEnd) {
+			// Split the next window into one range per thread, ranges end in front of a '<'
+			std::vector<MODELREADERRAWRANGE> Ranges;
+			const nfChar * pRangeStart = pWindowStart;
+			while ((Ranges.size() < m_nThreadCount) && (pRangeStart != pEnd)) {
+				const nfChar * pRangeEnd = pEnd;
+				size_t cbRemaining = (size_t)(pEnd - pRangeStart);
+				if (cbRemaining > cbRangeSize) {
+					const void * pBoundary = memchr(pRangeStart + cbRangeSize, '<', cbRemaining - cbRangeSize);
+					if (pBoundary != nullptr)
+						pRangeEnd = (const nfChar *)pBoundary;
+				}
+
+				MODELREADERRAWRANGE Range;
+				Range.m_pRange = m_fnCreateRange();
+				Range.m_pStart = pRangeStart;
+				Range.m_pEnd = pRangeEnd;
+				Range.m_pBlockEnd = nullptr;
+				Range.m_bSuccess = false;
+				Ranges.push_back(Range);
+
+				pRangeStart = pRangeEnd;
+			}
+
+			// The calling thread parses the first range itself
+			std::vector<std::thread> Threads;
+			for (size_t nIndex = 1; nIndex < Ranges.size(); nIndex++) {
+				try {
+					Threads.push_back(std::thread(&CModelReader_RawBlockParser::parseRange, this, std::ref(Ranges[nIndex])));
+				}
+				catch (std::system_error &) {
+					parseRange(Ranges[nIndex]);
+				}
+			}
+			parseRange(Ranges[0]);
+			for (auto iThread = Threads.begin(); iThread != Threads.end(); iThread++)
+				iThread->join();
+
+			// A split inside an attribute value lets one of the two ranges fail
+			for (auto iRange = Ranges.begin(); iRange != Ranges.end(); iRange++) {
+				if (!iRange->m_bSuccess)
+					return false;
+
+				m_Ranges.push_back(iRange->m_pRange);
+
+				if (iRange->m_pBlockEnd != nullptr) {
+					*ppResume = iRange->m_pBlockEnd;
+					return true;
+				}
+			}
+
+			pWindowStart = pRangeStart;
+			cbRangeSize = std::min(cbRangeSize * 2, (size_t)NMR_RAWBLOCK_MAXRANGESIZE);
+		}
+
+		// The end tag is missing
+		return false;
+	}
+
+	void CModelReader_RawBlockParser::parseRange(_Inout_ MODELREADERRAWRANGE & Range)
+	{
+		Range.m_bSuccess = false;
+
+		try {
+			const nfChar * pChar = Range.m_pStart;
+			const nfChar * pEnd = Range.m_pEnd;
+
+			while (true) {
+				while ((pChar != pEnd) && fnRawBlockIsSpace(*pChar))
+					pChar++;
+
+				if (pChar == pEnd) {
+					Range.m_bSuccess = true;
+					return;
+				}
+
+				// Text and any other markup is left to the streaming reader
+				if (*pChar != '<')
+					return;
+				pChar++;
+
+				if ((pChar != pEnd) && (*pChar == '/')) {
+					Range.m_pBlockEnd = parseBlockEnd(pChar + 1, pEnd);
+					Range.m_bSuccess = (Range.m_pBlockEnd != nullptr);
+					return;
+				}
+
+				pChar = parseElement(pChar, pEnd, Range.m_pRange.get());
+				if (pChar == nullptr)
+					return;
+			}
+		}
+		catch (...) {
+			Range.m_bSuccess = false;
+		}
+	}
+
+	const nfChar * CModelReader_RawBlockParser::parseElement(_In_ const nfChar * pChar, _In_ const nfChar * pEnd, _In_ CModelReader_RawRange * pRange)
+	{
+		nfChar Name[NMR_RAWBLOCK_MAXATTRIBUTELENGTH];
+		nfChar Value[NMR_RAWBLOCK_MAXATTRIBUTELENGTH];
+
+		size_t nElementNameLength = m_sElementName.length();
+		if (((size_t)(pEnd - pChar) < nElementNameLength) || (memcmp(pChar, m_sElementName.c_str(), nElementNameLength) != 0))
+			return nullptr;
+		pChar += nElementNameLength;
+
+		pRange->beginElement();
+
+		while (true) {
+			nfBool bHadSpacing = false;
+			while ((pChar != pEnd) && fnRawBlockIsSpace(*pChar)) {
+				bHadSpacing = true;
+				pChar++;
+			}
+			if (pChar == pEnd)
+				return nullptr;
+
+			// Only empty elements are accepted
+			if (*pChar == '/') {
+				pChar++;
+				if ((pChar == pEnd) || (*pChar != '>'))
+					return nullptr;
+
+				pRange->endElement();
+				return pChar + 1;
+			}
+
+			// Rejects longer element names as well
+			if (!bHadSpacing)
+				return nullptr;
+
+			nfUint32 nNameLength = 0;
+			while ((pChar != pEnd) && (*pChar != '=')) {
+				nfChar cChar = *pChar;
+				if (fnRawBlockIsSpace(cChar) || (cChar == 0) || (cChar == '<') || (cChar == '>') || (cChar == '/') ||
+					(cChar == ':') || (cChar == '"') || (cChar == '\'') || (cChar == '&'))
+					return nullptr;
+				if (nNameLength + 1 >= NMR_RAWBLOCK_MAXATTRIBUTELENGTH)
+					return nullptr;
+
+				Name[nNameLength++] = cChar;
+				pChar++;
+			}
+			if ((pChar == pEnd) || (nNameLength == 0))
+				return nullptr;
+			Name[nNameLength] = 0;
+			pChar++;
+
+			if ((pChar == pEnd) || ((*pChar != '"') && (*pChar != '\'')))
+				return nullptr;
+			nfChar cQuote = *pChar;
+			pChar++;
+
+			// Escaped values are left to the streaming reader
+			nfUint32 nValueLength = 0;
+			while ((pChar != pEnd) && (*pChar != cQuote)) {
+				nfChar cChar = *pChar;
+				if ((cChar == 0) || (cChar == '<') || (cChar == '&'))
+					return nullptr;
+				if (nValueLength + 1 >= NMR_RAWBLOCK_MAXATTRIBUTELENGTH)
+					return nullptr;
+
+				Value[nValueLength++] = cChar;
+				pChar++;
+			}
+			if (pChar == pEnd)
+				return nullptr;
+			Value[nValueLength] = 0;
+			pChar++;
+
+			if (!pRange->onAttribute(fnXmlLookupToken(Name, nNameLength), Name, Value))
+				return nullptr;
+		}
+	}
+
+	const nfChar * CModelReader_RawBlockParser::parseBlockEnd(_In_ const nfChar * pChar, _In_ const nfChar * pEnd)
+	{
+		// The streaming reader does not strip spaces from end tag names, so none are accepted here
+		size_t nBlockNameLength = m_sBlockName.length();
+		if (((size_t)(pEnd - pChar) <= nBlockNameLength) || (memcmp(pChar, m_sBlockName.c_str(), nBlockNameLength) != 0))
+			return nullptr;
+		pChar += nBlockNameLength;
+
+		if (*pChar != '>')
+			return nullptr;
+
+		return pChar + 1;
+	}
+
+	nfUint32 CModelReader_RawBlockParser::getRangeCount()
+	{
+		return (nfUint32)m_Ranges.size();
+	}
+
+	CModelReader_RawRange * CModelReader_RawBlockParser::getRange(_In_ nfUint32 nIndex)
+	{
+		if (nIndex >= m_Ranges.size())
+			throw CNMRException(NMR_ERROR_INVALIDINDEX);
+
+		return m_Ranges[nIndex].get();
+	}
+
+}
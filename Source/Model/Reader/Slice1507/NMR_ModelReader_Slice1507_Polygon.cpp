@@ -46,10 +46,10 @@ namespace NMR {
 			throw CNMRException(NMR_ERROR_SLICE_INVALIDATTRIBUTE);
 	}
 
-	void CModelReaderNode_Slices1507_Polygon::OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader) {
-		if (strcmp(pNameSpace, XML_3MF_NAMESPACE_SLICESPEC) == 0) {
-			if (strcmp(pChildName, XML_3MF_ELEMENT_SLICESEGMENT) == 0) {
-				PModelReaderNode_Slices1507_Segment pXMLNode = std::make_shared<CModelReaderNode_Slices1507_Segment>(m_pSlice, m_PolygonIndex, m_pWarnings);
+	void CModelReaderNode_Slices1507_Polygon::OnTokenizedNSChildElement(_In_ nfUint32 nNameSpaceID, _In_ eXmlToken Token, _In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader) {
+		if (nNameSpaceID == XMLNAMESPACEID_SLICESPEC) {
+			if (Token == XMLTOKEN_SEGMENT) {
+				CModelReaderNode_Slices1507_Segment * pXMLNode = reuseChildNode(m_pSegmentNode, m_pSlice, m_PolygonIndex, m_pWarnings);
 				pXMLNode->parseXML(pXMLReader);
 			}
 			else
@@ -33,9 +33,13 @@ Abstract:
 #include "Model/Classes/NMR_ModelConstants.h"
 
 namespace NMR {
-	void CModelReaderNode_Slices1507_Segment::OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue) {
-		if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_SLICESEGMENT_V2) == 0) {
+	void CModelReaderNode_Slices1507_Segment::OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue) {
+		switch (Token) {
+		case XMLTOKEN_V2:
 			m_pSlice->addPolygonIndex(m_PolygonIndex, fnStringToInt32(pAttributeValue));
+			break;
+		default:
+			break;
 		}
 	}
 
@@ -48,6 +52,10 @@ namespace NMR {
 		m_PolygonIndex = nPolygonIndex;
 	}
 
+	void CModelReaderNode_Slices1507_Segment::reset() {
+		resetNode();
+	}
+
 	void CModelReaderNode_Slices1507_Segment::parseXML(_In_ CXmlReader * pXMLReader) {
 		// Parse name
 		parseName(pXMLReader);
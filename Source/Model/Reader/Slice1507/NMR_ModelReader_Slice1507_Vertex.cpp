@@ -33,15 +33,17 @@ Abstract:
 #include "Model/Classes/NMR_ModelConstants.h"
 
 namespace NMR {
-	void CModelReaderNode_Slices1507_Vertex::OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue) {
-		if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_SLICEVERTEX_X) == 0) {
+	void CModelReaderNode_Slices1507_Vertex::OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue) {
+		switch (Token) {
+		case XMLTOKEN_X:
 			m_x = fnStringToFloat(pAttributeValue);
-		}
-		else if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_SLICEVERTEX_Y) == 0) {
+			break;
+		case XMLTOKEN_Y:
 			m_y = fnStringToFloat(pAttributeValue);
-		}
-		else
+			break;
+		default:
 			throw CNMRException(NMR_ERROR_SLICE_INVALIDATTRIBUTE);
+		}
 	}
 
 	void CModelReaderNode_Slices1507_Vertex::OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader) {
@@ -50,6 +52,14 @@ namespace NMR {
 
 	CModelReaderNode_Slices1507_Vertex::CModelReaderNode_Slices1507_Vertex(_In_ CSlice *pSlice, _In_ PModelReaderWarnings pWarnings) : CModelReaderNode(pWarnings) {
 		m_pSlice = pSlice;
+		reset();
+	}
+
+	void CModelReaderNode_Slices1507_Vertex::reset() {
+		resetNode();
+
+		m_x = 0.0f;
+		m_y = 0.0f;
 	}
 
 	void CModelReaderNode_Slices1507_Vertex::parseXML(_In_ CXmlReader * pXMLReader) {
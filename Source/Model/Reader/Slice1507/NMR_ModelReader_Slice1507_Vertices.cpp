@@ -39,9 +39,9 @@ namespace NMR {
 
 	}
 
-	void CModelReaderNode_Slices1507_Vertices::OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader) {
-		if (strcmp(pChildName, XML_3MF_ELEMENT_SLICEVERTEX) == 0) {
-			PModelReaderNode_Slices1507_Vertex pXMLNode = std::make_shared<CModelReaderNode_Slices1507_Vertex>(m_pSlice, m_pWarnings);
+	void CModelReaderNode_Slices1507_Vertices::OnTokenizedNSChildElement(_In_ nfUint32 nNameSpaceID, _In_ eXmlToken Token, _In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader) {
+		if (Token == XMLTOKEN_VERTEX) {
+			CModelReaderNode_Slices1507_Vertex * pXMLNode = reuseChildNode(m_pVertexNode, m_pSlice, m_pWarnings);
 			pXMLNode->parseXML(pXMLReader);
 		}
 		else
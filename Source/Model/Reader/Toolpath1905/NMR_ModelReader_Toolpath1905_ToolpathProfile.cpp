@@ -37,6 +37,7 @@ NMR_ModelReaderNode_Toolpath1905_ToolpathProfile.h covers the official 3MF Toolp
 #include "Common/NMR_Exception.h"
 #include "Common/NMR_Exception_Windows.h"
 #include "Common/NMR_StringUtils.h"
+#include "Common/NMR_NumberParser.h"
 #include <climits>
 #include <cmath>
 
@@ -102,7 +103,7 @@ namespace NMR {
 			if (m_bHasLaserPower)
 				throw CNMRException(NMR_ERROR_DUPLICATEVALUE);
 
-			m_dLaserPower = strtof(pAttributeValue, nullptr);
+			fnParseFloat(pAttributeValue, m_dLaserPower);
 			if (std::isnan(m_dLaserPower))
 				throw CNMRException(NMR_ERROR_INVALIDFLOATVALUE);
 			if (fabs(m_dLaserPower) > XML_3MF_MAXIMUMCOORDINATEVALUE)
@@ -115,7 +116,7 @@ namespace NMR {
 			if (m_bHasLaserSpeed)
 				throw CNMRException(NMR_ERROR_DUPLICATEVALUE);
 
-			m_dLaserSpeed = strtof(pAttributeValue, nullptr);
+			fnParseFloat(pAttributeValue, m_dLaserSpeed);
 			if (std::isnan(m_dLaserSpeed))
 				throw CNMRException(NMR_ERROR_INVALIDFLOATVALUE);
 			if (fabs(m_dLaserSpeed) > XML_3MF_MAXIMUMCOORDINATEVALUE)
@@ -127,7 +128,7 @@ namespace NMR {
 			if (m_bHasLaserFocus)
 				throw CNMRException(NMR_ERROR_DUPLICATEVALUE);
 
-			m_dLaserFocus = strtof(pAttributeValue, nullptr);
+			fnParseFloat(pAttributeValue, m_dLaserFocus);
 			if (std::isnan(m_dLaserFocus))
 				throw CNMRException(NMR_ERROR_INVALIDFLOATVALUE);
 			if (fabs(m_dLaserFocus) > XML_3MF_MAXIMUMCOORDINATEVALUE)
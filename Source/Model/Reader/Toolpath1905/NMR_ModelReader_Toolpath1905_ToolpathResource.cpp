@@ -39,6 +39,7 @@ NMR_ModelReaderNode_Toolpath1905_ToolpathResource.h covers the official 3MF Tool
 #include "Common/NMR_Exception.h"
 #include "Common/NMR_Exception_Windows.h"
 #include "Common/NMR_StringUtils.h"
+#include "Common/NMR_NumberParser.h"
 #include <climits>
 #include <cmath>
 
@@ -92,7 +93,7 @@ namespace NMR {
 			if (m_bHasUnitFactor)
 				throw CNMRException(NMR_ERROR_DUPLICATEVALUE);
 
-			m_dUnitFactor = strtod(pAttributeValue, nullptr);
+			fnParseDouble(pAttributeValue, m_dUnitFactor);
 			if (std::isnan(m_dUnitFactor))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs(m_dUnitFactor) > XML_3MF_MAXIMUMCOORDINATEVALUE)
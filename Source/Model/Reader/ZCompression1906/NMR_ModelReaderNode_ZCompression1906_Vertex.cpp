@@ -34,6 +34,7 @@ A vertex reader model node is a parser for the vertex node of an XML Model Strea
 
 #include "Model/Classes/NMR_ModelConstants.h"
 #include "Common/NMR_StringUtils.h"
+#include "Common/NMR_NumberParser.h"
 #include "Common/NMR_Exception.h"
 #include "Common/NMR_Exception_Windows.h"
 #include <cmath>
@@ -88,21 +89,21 @@ namespace NMR {
 				m_nZBinaryID = nValue;
 		}
 		else if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_VERTEX_ORIGINX) == 0) {
-			m_fOriginX = strtof(pAttributeValue, nullptr);
+			fnParseFloat(pAttributeValue, m_fOriginX);
 			if (std::isnan(m_fOriginX))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs(m_fOriginX) > XML_3MF_MAXIMUMCOORDINATEVALUE)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 		}
 		else if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_VERTEX_ORIGINY) == 0) {
-			m_fOriginY = strtof(pAttributeValue, nullptr);
+			fnParseFloat(pAttributeValue, m_fOriginY);
 			if (std::isnan(m_fOriginY))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs(m_fOriginY) > XML_3MF_MAXIMUMCOORDINATEVALUE)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 		}
 		else if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_VERTEX_ORIGINZ) == 0) {
-			m_fOriginZ = strtof(pAttributeValue, nullptr);
+			fnParseFloat(pAttributeValue, m_fOriginZ);
 			if (std::isnan(m_fOriginZ))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs(m_fOriginZ) > XML_3MF_MAXIMUMCOORDINATEVALUE)
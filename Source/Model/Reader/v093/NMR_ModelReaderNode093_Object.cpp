@@ -158,6 +158,8 @@ namespace NMR {
 
 				// Create Empty Mesh
 				PMesh pMesh = std::make_shared<CMesh>();
+				pMesh->setArena(m_pModel->getArena());
+				pMesh->setMappedStorage(m_pMeshMappedStorage);
 				// Create Mesh Object
 				m_pObject = std::make_shared<CModelMeshObject>(m_nID, m_pModel, pMesh);
 
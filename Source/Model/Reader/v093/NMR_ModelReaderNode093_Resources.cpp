@@ -91,6 +91,7 @@ namespace NMR {
 
 			if (strcmp(pChildName, XML_3MF_ELEMENT_OBJECT) == 0) {
 				PModelReaderNode pXMLNode = std::make_shared<CModelReaderNode093_Object>(m_pModel, m_pColorMapping, m_pWarnings);
+				pXMLNode->setMeshMappedStorage(m_pMeshMappedStorage);
 				pXMLNode->parseXML(pXMLReader);
 			}
 			else if (strcmp(pChildName, XML_3MF_ELEMENT_COLOR) == 0) {
@@ -34,6 +34,7 @@ A texture vertex reader model node is a parser for the vertex node of an XML Mod
 
 #include "Model/Classes/NMR_ModelConstants.h"
 #include "Common/NMR_StringUtils.h"
+#include "Common/NMR_NumberParser.h"
 #include "Common/NMR_Exception.h"
 #include "Common/NMR_Exception_Windows.h"
 #include <cmath>
@@ -45,6 +46,13 @@ namespace NMR {
 	CModelReaderNode093_TextureVertex::CModelReaderNode093_TextureVertex(_In_ PModelReaderWarnings pWarnings)
 		: CModelReaderNode(pWarnings)
 	{
+		reset();
+	}
+
+	void CModelReaderNode093_TextureVertex::reset()
+	{
+		resetNode();
+
 		m_fU = 0.0f;
 		m_fV = 0.0f;
 		m_bHasU = false;
@@ -86,7 +94,7 @@ namespace NMR {
 		__NMRASSERT(pAttributeValue);
 
 		if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_TEXTURE_U) == 0) {
-			m_fU = strtof(pAttributeValue, nullptr);
+			fnParseFloat(pAttributeValue, m_fU);
 			if (std::isnan (m_fU))
 				throw CNMRException(NMR_ERROR_INVALIDMODELTEXTURECOORDINATES);
 			if (fabs (m_fU) > XML_3MF_MAXIMUMCOORDINATEVALUE)
@@ -95,7 +103,7 @@ namespace NMR {
 		}
 
 		if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_TEXTURE_V) == 0) {
-			m_fV = strtof(pAttributeValue, nullptr);
+			fnParseFloat(pAttributeValue, m_fV);
 			if (std::isnan (m_fV))
 				throw CNMRException(NMR_ERROR_INVALIDMODELTEXTURECOORDINATES);
 			if (fabs(m_fV) > XML_3MF_MAXIMUMCOORDINATEVALUE)
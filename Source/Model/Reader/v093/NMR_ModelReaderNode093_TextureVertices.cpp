@@ -81,7 +81,7 @@ namespace NMR {
 		if ((strcmp(pNameSpace, XML_3MF_NAMESPACE_CORESPEC093) == 0) || (strcmp(pNameSpace, "") == 0)) {
 			if (strcmp(pChildName, XML_3MF_ELEMENT_TEXTUREVERTEX) == 0)
 			{
-				PModelReaderNode093_TextureVertex pXMLNode = std::make_shared<CModelReaderNode093_TextureVertex>(m_pWarnings);
+				CModelReaderNode093_TextureVertex * pXMLNode = reuseChildNode(m_pTextureVertexNode, m_pWarnings);
 				pXMLNode->parseXML(pXMLReader);
 
 				// Create Mesh Node
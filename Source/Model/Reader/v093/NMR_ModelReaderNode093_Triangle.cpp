@@ -47,6 +47,13 @@ namespace NMR {
 	CModelReaderNode093_Triangle::CModelReaderNode093_Triangle(_In_ PModelReaderWarnings pWarnings)
 		: CModelReaderNode(pWarnings)
 	{
+		reset();
+	}
+
+	void CModelReaderNode093_Triangle::reset()
+	{
+		resetNode();
+
 		// Initialise default values
 		m_nIndex1 = -1;
 		m_nIndex2 = -1;
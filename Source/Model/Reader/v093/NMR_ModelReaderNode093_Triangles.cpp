@@ -88,7 +88,7 @@ namespace NMR {
 
 			if (strcmp(pChildName, XML_3MF_ELEMENT_TRIANGLE) == 0) {
 				// Parse XML
-				PModelReaderNode093_Triangle pXMLNode = std::make_shared<CModelReaderNode093_Triangle>(m_pWarnings);
+				CModelReaderNode093_Triangle * pXMLNode = reuseChildNode(m_pTriangleNode, m_pWarnings);
 				pXMLNode->parseXML(pXMLReader);
 
 				// Retrieve node indices
@@ -99,10 +99,7 @@ namespace NMR {
 
 				// Create face if valid
 				if ((nIndex1 != nIndex2) && (nIndex1 != nIndex3) && (nIndex2 != nIndex3)) {
-					MESHNODE * pNode1 = m_pMesh->getNode(nIndex1);
-					MESHNODE * pNode2 = m_pMesh->getNode(nIndex2);
-					MESHNODE * pNode3 = m_pMesh->getNode(nIndex3);
-					MESHFACE * pFace = m_pMesh->addFace(pNode1, pNode2, pNode3);
+					nfUint32 nFaceIndex = m_pMesh->appendFace(nIndex1, nIndex2, nIndex3);
 
 					nfInt32 nColorID1, nColorID2, nColorID3;
 					pXMLNode->retrieveColorIDs(nColorID1, nColorID2, nColorID3);
@@ -120,7 +117,7 @@ namespace NMR {
 					// Create Texture Info
 					if (nTextureID > 0) {
 						CMeshInformation_Properties * pProperties = createPropertiesInformation();
-						MESHINFORMATION_PROPERTIES* pFaceData = (MESHINFORMATION_PROPERTIES*)pProperties->getFaceData(pFace->m_index);
+						MESHINFORMATION_PROPERTIES* pFaceData = (MESHINFORMATION_PROPERTIES*)pProperties->getFaceData(nFaceIndex);
 						if (pFaceData) {
 
 							PModelTexture2DResource pTexture2dResource;
@@ -186,7 +183,7 @@ namespace NMR {
 										pBaseMaterialResource->buildResourceIndexMap();
 
 									CMeshInformation_Properties * pProperties = createPropertiesInformation();
-									MESHINFORMATION_PROPERTIES* pFaceData = (MESHINFORMATION_PROPERTIES*)pProperties->getFaceData(pFace->m_index);
+									MESHINFORMATION_PROPERTIES* pFaceData = (MESHINFORMATION_PROPERTIES*)pProperties->getFaceData(nFaceIndex);
 									if (pFaceData) {
 										pFaceData->m_nResourceID = pBaseMaterialResource->getResourceID()->getUniqueID();
 										pFaceData->m_nPropertyIDs[0] = 1;
@@ -229,7 +226,7 @@ namespace NMR {
 			pProperties = dynamic_cast<CMeshInformation_Properties *> (pInformation);
 
 		if (!pProperties) {
-			PMeshInformation_Properties pNewMeshInformation = std::make_shared<CMeshInformation_Properties>(m_pMesh->getFaceCount());
+			PMeshInformation_Properties pNewMeshInformation = std::make_shared<CMeshInformation_Properties>(m_pMesh->getFaceCount(), m_pMesh->getArena());
 			pMeshInformationHandler->addInformation(pNewMeshInformation);
 
 			pProperties = pNewMeshInformation.get();
@@ -34,6 +34,7 @@ A vertex reader model node is a parser for the vertex node of an XML Model Strea
 
 #include "Model/Classes/NMR_ModelConstants.h"
 #include "Common/NMR_StringUtils.h"
+#include "Common/NMR_NumberParser.h"
 #include "Common/NMR_Exception.h"
 #include "Common/NMR_Exception_Windows.h"
 #include <cmath>
@@ -45,6 +46,13 @@ namespace NMR {
 	CModelReaderNode093_Vertex::CModelReaderNode093_Vertex(_In_ PModelReaderWarnings pWarnings)
 		: CModelReaderNode(pWarnings)
 	{
+		reset();
+	}
+
+	void CModelReaderNode093_Vertex::reset()
+	{
+		resetNode();
+
 		m_fX = 0.0f;
 		m_fY = 0.0f;
 		m_fZ = 0.0f;
@@ -82,7 +90,7 @@ namespace NMR {
 		__NMRASSERT(pAttributeValue);
 
 		if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_VERTEX_X) == 0) {
-			m_fX = strtof(pAttributeValue, nullptr);
+			fnParseFloat(pAttributeValue, m_fX);
 			if (std::isnan (m_fX))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs (m_fX) > XML_3MF_MAXIMUMCOORDINATEVALUE)
@@ -91,7 +99,7 @@ namespace NMR {
 		}
 
 		if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_VERTEX_Y) == 0) {
-			m_fY = strtof(pAttributeValue, nullptr);
+			fnParseFloat(pAttributeValue, m_fY);
 			if (std::isnan (m_fY))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs(m_fY) > XML_3MF_MAXIMUMCOORDINATEVALUE)
@@ -100,7 +108,7 @@ namespace NMR {
 		}
 
 		if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_VERTEX_Z) == 0) {
-			m_fZ = strtof(pAttributeValue, nullptr);
+			fnParseFloat(pAttributeValue, m_fZ);
 			if (std::isnan (m_fZ))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs(m_fZ) > XML_3MF_MAXIMUMCOORDINATEVALUE)
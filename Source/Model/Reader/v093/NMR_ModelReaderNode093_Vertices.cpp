@@ -77,13 +77,13 @@ namespace NMR {
 
 			if (strcmp(pChildName, XML_3MF_ELEMENT_VERTEX) == 0)
 			{
-				PModelReaderNode093_Vertex pXMLNode = std::make_shared<CModelReaderNode093_Vertex>(m_pWarnings);
+				CModelReaderNode093_Vertex * pXMLNode = reuseChildNode(m_pVertexNode, m_pWarnings);
 				pXMLNode->parseXML(pXMLReader);
 
 				// Create Mesh Node
 				nfFloat fX, fY, fZ;
 				pXMLNode->retrievePosition(fX, fY, fZ);
-				m_pMesh->addNode(fnVEC3_make(fX, fY, fZ));
+				m_pMesh->appendNode(fnVEC3_make(fX, fY, fZ));
 			}
 		}
 	}
@@ -92,6 +92,7 @@ namespace NMR {
 
 				PModelReaderNode pXMLNode = std::make_shared<CModelReaderNode100_Object>(m_pModel, m_pWarnings, m_pProgressMonitor);
 				pXMLNode->setBinaryStreamCollection(m_pBinaryStreamCollection);
+				pXMLNode->setMeshMappedStorage(m_pMeshMappedStorage);
 				pXMLNode->parseXML(pXMLReader);
 
 			}
@@ -43,8 +43,56 @@ XML Model Stream.
 #include "Common/NMR_Exception_Windows.h"
 #include "Model/Reader/NMR_ModelReader_ColorMapping.h"
 
+#include <algorithm>
+
 namespace NMR {
 
+	CModelReaderNode100_TriangleRange::CModelReaderNode100_TriangleRange(_In_ nfInt32 nNodeCount, _In_ ModelResourceID nDefaultResourceID, _In_ ModelResourceIndex nDefaultResourceIndex)
+		: m_TriangleNode(nullptr), m_nNodeCount(nNodeCount), m_nDefaultResourceID(nDefaultResourceID), m_nDefaultResourceIndex(nDefaultResourceIndex)
+	{
+	}
+
+	void CModelReaderNode100_TriangleRange::beginElement()
+	{
+		m_TriangleNode.reset();
+	}
+
+	nfBool CModelReaderNode100_TriangleRange::onAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pszName, _In_z_ const nfChar * pszValue)
+	{
+		switch (Token) {
+		case XMLTOKEN_V1:
+		case XMLTOKEN_V2:
+		case XMLTOKEN_V3:
+		case XMLTOKEN_PID:
+		case XMLTOKEN_P1:
+		case XMLTOKEN_P2:
+		case XMLTOKEN_P3:
+			m_TriangleNode.parseRawAttribute(Token, pszName, pszValue);
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void CModelReaderNode100_TriangleRange::endElement()
+	{
+		MODELREADERTRIANGLE Triangle;
+		m_TriangleNode.retrieveIndices(Triangle.m_nIndices[0], Triangle.m_nIndices[1], Triangle.m_nIndices[2], m_nNodeCount);
+
+		Triangle.m_nResourceID = m_nDefaultResourceID;
+		Triangle.m_nResourceIndices[0] = m_nDefaultResourceIndex;
+		Triangle.m_nResourceIndices[1] = m_nDefaultResourceIndex;
+		Triangle.m_nResourceIndices[2] = m_nDefaultResourceIndex;
+		m_TriangleNode.retrieveProperties(Triangle.m_nResourceID, Triangle.m_nResourceIndices[0], Triangle.m_nResourceIndices[1], Triangle.m_nResourceIndices[2]);
+
+		m_Triangles.push_back(Triangle);
+	}
+
+	const std::vector<MODELREADERTRIANGLE> & CModelReaderNode100_TriangleRange::getTriangles()
+	{
+		return m_Triangles;
+	}
+
 	CModelReaderNode100_Triangles::CModelReaderNode100_Triangles(_In_ CModel * pModel, _In_ CMesh * pMesh, _In_ std::string sBinaryStreamPath, _In_ PModelReaderWarnings pWarnings, _In_ ModelResourceID nDefaultPropertyID, _In_ ModelResourceIndex nDefaultPropertyIndex)
 		: CModelReaderNode(pWarnings), m_sBinaryStreamPath (sBinaryStreamPath)
 	{
@@ -55,6 +103,11 @@ namespace NMR {
 		m_nDefaultResourceIndex = nDefaultPropertyIndex;
 
 		m_nUsedResourceID = 0;
+		m_nEstimatedFaceCount = 0;
+
+		m_nCachedResourceID = 0;
+		m_pCachedResource = nullptr;
+		m_pProperties = nullptr;
 
 		m_pModel = pModel;
 		m_pMesh = pMesh;
@@ -68,8 +121,41 @@ namespace NMR {
 		// Parse attribute
 		parseAttributes(pXMLReader);
 
-		// Parse Content
-		parseContent(pXMLReader);
+		// Parse Content, plain blocks of in-memory documents are split up and parsed on worker threads.
+		// Faces are added in document order afterwards, so warnings and errors stay the same.
+		nfInt32 nNodeCount = m_pMesh->getNodeCount();
+		ModelResourceID nDefaultResourceID = m_nDefaultResourceID;
+		ModelResourceIndex nDefaultResourceIndex = m_nDefaultResourceIndex;
+		CModelReader_RawBlockParser BlockParser(XML_3MF_ELEMENT_TRIANGLE, [nNodeCount, nDefaultResourceID, nDefaultResourceIndex]() {
+			return std::make_shared<CModelReaderNode100_TriangleRange>(nNodeCount, nDefaultResourceID, nDefaultResourceIndex);
+		});
+		if (parseRawContent(pXMLReader, XMLNAMESPACEID_CORESPEC100, BlockParser)) {
+			nfUint32 nRangeCount = BlockParser.getRangeCount();
+			nfUint64 nTriangleCount = 0;
+			for (nfUint32 nRangeIndex = 0; nRangeIndex < nRangeCount; nRangeIndex++)
+				nTriangleCount += static_cast<CModelReaderNode100_TriangleRange *> (BlockParser.getRange(nRangeIndex))->getTriangles().size();
+			reserveFaces(nTriangleCount);
+
+			for (nfUint32 nRangeIndex = 0; nRangeIndex < nRangeCount; nRangeIndex++) {
+				CModelReaderNode100_TriangleRange * pRange = static_cast<CModelReaderNode100_TriangleRange *> (BlockParser.getRange(nRangeIndex));
+				const std::vector<MODELREADERTRIANGLE> & Triangles = pRange->getTriangles();
+				for (auto iTriangle = Triangles.begin(); iTriangle != Triangles.end(); iTriangle++)
+					addFace(iTriangle->m_nIndices[0], iTriangle->m_nIndices[1], iTriangle->m_nIndices[2], iTriangle->m_nResourceID,
+						iTriangle->m_nResourceIndices[0], iTriangle->m_nResourceIndices[1], iTriangle->m_nResourceIndices[2]);
+			}
+		}
+		else {
+			// Closed meshes have about twice as many faces as vertices. The estimate is reserved with the
+			// first triangle and only in paged memory; array storage would allocate (and map) all of it.
+			if ((m_pMesh->getStorageMode() == MESHSTORAGEMODE_PAGED) && (m_pMesh->getMappedStorage() == nullptr))
+				m_nEstimatedFaceCount = 2 * (nfUint64)nNodeCount;
+			parseContent(pXMLReader);
+		}
+	}
+
+	void CModelReaderNode100_Triangles::reserveFaces(_In_ nfUint64 nFaceCount)
+	{
+		m_pMesh->reserveFaces((nfUint32)std::min(m_pMesh->getFaceCount() + nFaceCount, (nfUint64)NMR_MESH_MAXFACECOUNT));
 	}
 
 	void CModelReaderNode100_Triangles::OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
@@ -81,6 +167,9 @@ namespace NMR {
 
 	_Ret_notnull_ CMeshInformation_Properties * CModelReaderNode100_Triangles::createPropertiesInformation()
 	{
+		if (m_pProperties)
+			return m_pProperties;
+
 		CMeshInformationHandler * pMeshInformationHandler = m_pMesh->createMeshInformationHandler();
 
 		CMeshInformation * pInformation = pMeshInformationHandler->getInformationByType(0, emiProperties);
@@ -90,34 +179,41 @@ namespace NMR {
 			pProperties = dynamic_cast<CMeshInformation_Properties *> (pInformation);
 
 		if (!pProperties) {
-			PMeshInformation_Properties pNewMeshInformation = std::make_shared<CMeshInformation_Properties>(m_pMesh->getFaceCount());
+			PMeshInformation_Properties pNewMeshInformation = std::make_shared<CMeshInformation_Properties>(m_pMesh->getFaceCount(), m_pMesh->getArena());
 			pMeshInformationHandler->addInformation(pNewMeshInformation);
+			pNewMeshInformation->reserveFaceData(m_pMesh->getFaceCapacity());
 
 			pProperties = pNewMeshInformation.get();
 		}
 
+		m_pProperties = pProperties;
 		return pProperties;
 	}
 
 
 	void CModelReaderNode100_Triangles::addFace(ModelResourceIndex nIndex1, ModelResourceIndex nIndex2, ModelResourceIndex nIndex3, ModelResourceID nResourceID, ModelResourceIndex nResourceIndex1, ModelResourceIndex nResourceIndex2, ModelResourceIndex nResourceIndex3)
 	{
-		// Create face if valid
+		// Create face if valid, the indices have been checked against the node count already
 		if ((nIndex1 != nIndex2) && (nIndex1 != nIndex3) && (nIndex2 != nIndex3)) {
-			MESHNODE * pNode1 = m_pMesh->getNode(nIndex1);
-			MESHNODE * pNode2 = m_pMesh->getNode(nIndex2);
-			MESHNODE * pNode3 = m_pMesh->getNode(nIndex3);
-			MESHFACE * pFace = m_pMesh->addFace(pNode1, pNode2, pNode3);
+			nfUint32 nFaceIndex = m_pMesh->appendFace(nIndex1, nIndex2, nIndex3);
 
 			if (nResourceID != 0) {
 				// set potential default properties (i.e. used pid)
 				m_nUsedResourceID = nResourceID;
 
-				PPackageResourceID pID = m_pModel->findPackageResourceID(m_pModel->curPath(), nResourceID);
-				if (pID.get()) {
+				if (nResourceID != m_nCachedResourceID) {
+					m_pCachedPackageResourceID = m_pModel->findPackageResourceID(m_pModel->curPath(), nResourceID);
+					m_pCachedResource = nullptr;
+					if (m_pCachedPackageResourceID.get())
+						m_pCachedResource = m_pModel->findResource(m_pCachedPackageResourceID->getUniqueID()).get();
+					m_nCachedResourceID = nResourceID;
+				}
+
+				CPackageResourceID * pID = m_pCachedPackageResourceID.get();
+				if (pID) {
 					// Find and Assign Resource of this Property
-					PModelResource pResource = m_pModel->findResource(pID->getUniqueID());
-					if (pResource.get() != nullptr) {
+					CModelResource * pResource = m_pCachedResource;
+					if (pResource != nullptr) {
 						if (!pResource->hasResourceIndexMap())
 							pResource->buildResourceIndexMap();
 
@@ -129,7 +225,7 @@ namespace NMR {
 							&& pResource->mapResourceIndexToPropertyID(nResourceIndex3, pPropertyID3)) {
 
 							CMeshInformation_Properties * pProperties = createPropertiesInformation();
-							MESHINFORMATION_PROPERTIES* pFaceData = (MESHINFORMATION_PROPERTIES*)pProperties->getFaceData(pFace->m_index);
+							MESHINFORMATION_PROPERTIES* pFaceData = (MESHINFORMATION_PROPERTIES*)pProperties->getFaceData(nFaceIndex);
 							if (pFaceData) {
 								pFaceData->m_nResourceID = pID->getUniqueID();
 								pFaceData->m_nPropertyIDs[0] = pPropertyID1;
@@ -153,16 +249,21 @@ namespace NMR {
 
 	}
 
-	void CModelReaderNode100_Triangles::OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader)
+	void CModelReaderNode100_Triangles::OnTokenizedNSChildElement(_In_ nfUint32 nNameSpaceID, _In_ eXmlToken Token, _In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader)
 	{
 		__NMRASSERT(pChildName);
 		__NMRASSERT(pXMLReader);
 		__NMRASSERT(pNameSpace);
 
-		if (strcmp(pNameSpace, XML_3MF_NAMESPACE_CORESPEC100) == 0) {
-			if (strcmp(pChildName, XML_3MF_ELEMENT_TRIANGLE) == 0) {
+		if (nNameSpaceID == XMLNAMESPACEID_CORESPEC100) {
+			if (Token == XMLTOKEN_TRIANGLE) {
+				if (m_nEstimatedFaceCount > 0) {
+					reserveFaces(m_nEstimatedFaceCount);
+					m_nEstimatedFaceCount = 0;
+				}
+
 				// Parse XML
-				PModelReaderNode100_Triangle pXMLNode = std::make_shared<CModelReaderNode100_Triangle>(m_pWarnings);
+				CModelReaderNode100_Triangle * pXMLNode = reuseChildNode(m_pTriangleNode, m_pWarnings);
 				pXMLNode->parseXML(pXMLReader);
 
 				// Retrieve node indices
@@ -184,8 +285,8 @@ namespace NMR {
 
 		}
 
-		if (strcmp(pNameSpace, XML_3MF_NAMESPACE_ZCOMPRESSION) == 0) {
-			if (strcmp(pChildName, XML_3MF_ELEMENT_TRIANGLE) == 0)
+		if (nNameSpaceID == XMLNAMESPACEID_ZCOMPRESSION) {
+			if (Token == XMLTOKEN_TRIANGLE)
 			{
 				PModelReaderNode_ZCompression1906_Triangle pXMLNode = std::make_shared<CModelReaderNode_ZCompression1906_Triangle>(m_pWarnings);
 				pXMLNode->parseXML(pXMLReader);
@@ -209,6 +310,7 @@ namespace NMR {
 				nfUint32 nCount = nV1Count;
 
 				if (nCount > 0) {
+					reserveFaces(nCount);
 
 					std::vector<nfInt32> V1Values;
 					std::vector<nfInt32> V2Values;
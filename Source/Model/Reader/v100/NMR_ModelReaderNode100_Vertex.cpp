@@ -34,6 +34,7 @@ A vertex reader model node is a parser for the vertex node of an XML Model Strea
 
 #include "Model/Classes/NMR_ModelConstants.h"
 #include "Common/NMR_StringUtils.h"
+#include "Common/NMR_NumberParser.h"
 #include "Common/NMR_Exception.h"
 #include "Common/NMR_Exception_Windows.h"
 #include <cmath>
@@ -45,6 +46,13 @@ namespace NMR {
 	CModelReaderNode100_Vertex::CModelReaderNode100_Vertex(_In_ PModelReaderWarnings pWarnings)
 		: CModelReaderNode(pWarnings)
 	{
+		reset();
+	}
+
+	void CModelReaderNode100_Vertex::reset()
+	{
+		resetNode();
+
 		m_fX = 0.0f;
 		m_fY = 0.0f;
 		m_fZ = 0.0f;
@@ -76,37 +84,40 @@ namespace NMR {
 		fZ = m_fZ;
 	}
 
-	void CModelReaderNode100_Vertex::OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
+	void CModelReaderNode100_Vertex::OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
 	{
 		__NMRASSERT(pAttributeName);
 		__NMRASSERT(pAttributeValue);
 
-		if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_VERTEX_X) == 0) {
-			m_fX = strtof(pAttributeValue, nullptr);
+		switch (Token) {
+		case XMLTOKEN_X:
+			fnParseFloat(pAttributeValue, m_fX);
 			if (std::isnan (m_fX))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs (m_fX) > XML_3MF_MAXIMUMCOORDINATEVALUE)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			m_bHasX = true;
-		}
-		else if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_VERTEX_Y) == 0) {
-			m_fY = strtof(pAttributeValue, nullptr);
+			break;
+		case XMLTOKEN_Y:
+			fnParseFloat(pAttributeValue, m_fY);
 			if (std::isnan (m_fY))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs(m_fY) > XML_3MF_MAXIMUMCOORDINATEVALUE)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			m_bHasY = true;
-		}
-		else if (strcmp(pAttributeName, XML_3MF_ATTRIBUTE_VERTEX_Z) == 0) {
-			m_fZ = strtof(pAttributeValue, nullptr);
+			break;
+		case XMLTOKEN_Z:
+			fnParseFloat(pAttributeValue, m_fZ);
 			if (std::isnan (m_fZ))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs(m_fZ) > XML_3MF_MAXIMUMCOORDINATEVALUE)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			m_bHasZ = true;
-		}
-		else
+			break;
+		default:
 			m_pWarnings->addException(CNMRException(NMR_ERROR_NAMESPACE_INVALID_ATTRIBUTE), mrwInvalidOptionalValue);
+			break;
+		}
 	}
 
 
@@ -42,8 +42,45 @@ XML Model Stream.
 #include "Common/NMR_Exception.h"
 #include "Common/NMR_Exception_Windows.h"
 
+#include <algorithm>
+
 namespace NMR {
 
+	CModelReaderNode100_VertexRange::CModelReaderNode100_VertexRange()
+		: m_VertexNode(nullptr)
+	{
+	}
+
+	void CModelReaderNode100_VertexRange::beginElement()
+	{
+		m_VertexNode.reset();
+	}
+
+	nfBool CModelReaderNode100_VertexRange::onAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pszName, _In_z_ const nfChar * pszValue)
+	{
+		switch (Token) {
+		case XMLTOKEN_X:
+		case XMLTOKEN_Y:
+		case XMLTOKEN_Z:
+			m_VertexNode.parseRawAttribute(Token, pszName, pszValue);
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void CModelReaderNode100_VertexRange::endElement()
+	{
+		nfFloat fX, fY, fZ;
+		m_VertexNode.retrievePosition(fX, fY, fZ);
+		m_Vertices.push_back(fnVEC3_make(fX, fY, fZ));
+	}
+
+	const std::vector<NVEC3> & CModelReaderNode100_VertexRange::getVertices()
+	{
+		return m_Vertices;
+	}
+
 	CModelReaderNode100_Vertices::CModelReaderNode100_Vertices(_In_ CMesh * pMesh, _In_ std::string sBinaryStreamPath, _In_ PModelReaderWarnings pWarnings)
 		: CModelReaderNode(pWarnings)
 	{
@@ -60,8 +97,25 @@ namespace NMR {
 		// Parse attribute
 		parseAttributes(pXMLReader);
 
-		// Parse Content
-		parseContent(pXMLReader);
+		// Parse Content, plain blocks of in-memory documents are split up and parsed on worker threads
+		CModelReader_RawBlockParser BlockParser(XML_3MF_ELEMENT_VERTEX, []() { return std::make_shared<CModelReaderNode100_VertexRange>(); });
+		if (parseRawContent(pXMLReader, XMLNAMESPACEID_CORESPEC100, BlockParser)) {
+			nfUint32 nRangeCount = BlockParser.getRangeCount();
+			nfUint64 nVertexCount = 0;
+			for (nfUint32 nRangeIndex = 0; nRangeIndex < nRangeCount; nRangeIndex++)
+				nVertexCount += static_cast<CModelReaderNode100_VertexRange *> (BlockParser.getRange(nRangeIndex))->getVertices().size();
+			m_pMesh->reserveNodes((nfUint32)std::min(m_pMesh->getNodeCount() + nVertexCount, (nfUint64)NMR_MESH_MAXNODECOUNT));
+
+			for (nfUint32 nRangeIndex = 0; nRangeIndex < nRangeCount; nRangeIndex++) {
+				CModelReaderNode100_VertexRange * pRange = static_cast<CModelReaderNode100_VertexRange *> (BlockParser.getRange(nRangeIndex));
+				const std::vector<NVEC3> & Vertices = pRange->getVertices();
+				for (auto iVertex = Vertices.begin(); iVertex != Vertices.end(); iVertex++)
+					m_pMesh->appendNode(*iVertex);
+			}
+		}
+		else {
+			parseContent(pXMLReader);
+		}
 	}
 
 	void CModelReaderNode100_Vertices::OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
@@ -70,29 +124,29 @@ namespace NMR {
 		__NMRASSERT(pAttributeValue);
 	}
 
-	void CModelReaderNode100_Vertices::OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader)
+	void CModelReaderNode100_Vertices::OnTokenizedNSChildElement(_In_ nfUint32 nNameSpaceID, _In_ eXmlToken Token, _In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader)
 	{
 		__NMRASSERT(pChildName);
 		__NMRASSERT(pXMLReader);
 		__NMRASSERT(pNameSpace);
 
-		if (strcmp(pNameSpace, XML_3MF_NAMESPACE_CORESPEC100) == 0) {
-			if (strcmp(pChildName, XML_3MF_ELEMENT_VERTEX) == 0)
+		if (nNameSpaceID == XMLNAMESPACEID_CORESPEC100) {
+			if (Token == XMLTOKEN_VERTEX)
 			{
-				PModelReaderNode100_Vertex pXMLNode = std::make_shared<CModelReaderNode100_Vertex>(m_pWarnings);
+				CModelReaderNode100_Vertex * pXMLNode = reuseChildNode(m_pVertexNode, m_pWarnings);
 				pXMLNode->parseXML(pXMLReader);
 
 				// Create Mesh Node
 				nfFloat fX, fY, fZ;
 				pXMLNode->retrievePosition(fX, fY, fZ);
-				m_pMesh->addNode(fnVEC3_make(fX, fY, fZ));
+				m_pMesh->appendNode(fnVEC3_make(fX, fY, fZ));
 			}
 			else
 				m_pWarnings->addException(CNMRException(NMR_ERROR_NAMESPACE_INVALID_ELEMENT), mrwInvalidOptionalValue);
 		}
 
-		if (strcmp(pNameSpace, XML_3MF_NAMESPACE_ZCOMPRESSION) == 0) {
-			if (strcmp(pChildName, XML_3MF_ELEMENT_VERTEX) == 0)
+		if (nNameSpaceID == XMLNAMESPACEID_ZCOMPRESSION) {
+			if (Token == XMLTOKEN_VERTEX)
 			{
 				PModelReaderNode_ZCompression1906_Vertex pXMLNode = std::make_shared<CModelReaderNode_ZCompression1906_Vertex>(m_pWarnings);
 				pXMLNode->parseXML(pXMLReader);
@@ -118,6 +172,7 @@ namespace NMR {
 				nfUint32 nCount = nXCount;
 
 				if (nCount > 0) {
+					m_pMesh->reserveNodes((nfUint32)std::min((nfUint64)m_pMesh->getNodeCount() + nCount, (nfUint64)NMR_MESH_MAXNODECOUNT));
 
 					std::vector<nfFloat> XValues;
 					std::vector<nfFloat> YValues;
@@ -136,7 +191,7 @@ namespace NMR {
 					auto iZ = ZValues.data();
 
 					for (nfUint32 nIndex = 0; nIndex < nCount; nIndex++) {
-						m_pMesh->addNode(fnVEC3_make(*iX + fOriginX, *iY + fOriginY, *iZ + fOriginZ));
+						m_pMesh->appendNode(fnVEC3_make(*iX + fOriginX, *iY + fOriginY, *iZ + fOriginZ));
 						iX++; iY++; iZ++;
 					}
 				}
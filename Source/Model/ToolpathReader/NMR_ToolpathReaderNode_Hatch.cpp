@@ -33,6 +33,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Common/3MF_ProgressMonitor.h"
 #include "Common/NMR_Exception.h"
 #include "Common/NMR_StringUtils.h"
+#include "Common/NMR_NumberParser.h"
 
 #include <iostream>
 #include <sstream>
@@ -43,20 +44,26 @@ namespace NMR {
 
 	CToolpathReaderNode_Hatch::CToolpathReaderNode_Hatch(_In_ PModelReaderWarnings pWarnings, _In_ PProgressMonitor pProgressMonitor, CModelToolpathLayerReadData * pReadData)
 		: CModelReaderNode(pWarnings, pProgressMonitor), 
-			m_pReadData (pReadData),
-			m_dX1 (0.0),
-			m_dY1(0.0),
-			m_dX2(0.0),
-			m_dY2(0.0),
-			m_bHasX1 (false),
-			m_bHasY1 (false),
-			m_bHasX2 (false),
-			m_bHasY2 (false)
-
-
+			m_pReadData (pReadData)
 	{
 		if (pReadData == nullptr)
 			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		reset();
+	}
+
+	void CToolpathReaderNode_Hatch::reset()
+	{
+		resetNode();
+
+		m_dX1 = 0.0;
+		m_dY1 = 0.0;
+		m_dX2 = 0.0;
+		m_dY2 = 0.0;
+		m_bHasX1 = false;
+		m_bHasY1 = false;
+		m_bHasX2 = false;
+		m_bHasY2 = false;
 	}
 
 
@@ -73,53 +80,56 @@ namespace NMR {
 
 	}
 
-	void CToolpathReaderNode_Hatch::OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
+	void CToolpathReaderNode_Hatch::OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
 	{
 		__NMRASSERT(pAttributeName);
 		__NMRASSERT(pAttributeValue);
 
-		if (strcmp(pAttributeName, XML_3MF_TOOLPATHATTRIBUTE_X1) == 0) {
+		switch (Token) {
+		case XMLTOKEN_X1:
 			if (m_bHasX1)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
-			m_dX1 = strtod(pAttributeValue, nullptr);
+			fnParseDouble(pAttributeValue, m_dX1);
 			if (std::isnan(m_dX1))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs(m_dX1) > XML_3MF_MAXIMUMCOORDINATEVALUE)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			m_bHasX1 = true;
-		}
-		else if (strcmp(pAttributeName, XML_3MF_TOOLPATHATTRIBUTE_Y1) == 0) {
+			break;
+		case XMLTOKEN_Y1:
 			if (m_bHasY1)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
-			m_dY1 = strtod(pAttributeValue, nullptr);
+			fnParseDouble(pAttributeValue, m_dY1);
 			if (std::isnan(m_dY1))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs(m_dY1) > XML_3MF_MAXIMUMCOORDINATEVALUE)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			m_bHasY1 = true;
-		}
-		else if (strcmp(pAttributeName, XML_3MF_TOOLPATHATTRIBUTE_X2) == 0) {
+			break;
+		case XMLTOKEN_X2:
 			if (m_bHasX2)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
-			m_dX2 = strtod(pAttributeValue, nullptr);
+			fnParseDouble(pAttributeValue, m_dX2);
 			if (std::isnan(m_dX2))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs(m_dX2) > XML_3MF_MAXIMUMCOORDINATEVALUE)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			m_bHasX2 = true;
-		}
-		else if (strcmp(pAttributeName, XML_3MF_TOOLPATHATTRIBUTE_Y2) == 0) {
+			break;
+		case XMLTOKEN_Y2:
 			if (m_bHasY2)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
-			m_dY2 = strtod(pAttributeValue, nullptr);
+			fnParseDouble(pAttributeValue, m_dY2);
 			if (std::isnan(m_dY2))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs(m_dY2) > XML_3MF_MAXIMUMCOORDINATEVALUE)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			m_bHasY2 = true;
-		}
-		else
+			break;
+		default:
 			m_pWarnings->addException(CNMRException(NMR_ERROR_NAMESPACE_INVALID_ATTRIBUTE), mrwInvalidOptionalValue);
+			break;
+		}
 
 	}
 
@@ -33,6 +33,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Common/3MF_ProgressMonitor.h"
 #include "Common/NMR_Exception.h"
 #include "Common/NMR_StringUtils.h"
+#include "Common/NMR_NumberParser.h"
 
 #include <iostream>
 #include <sstream>
@@ -43,15 +44,22 @@ namespace NMR {
 
 	CToolpathReaderNode_Point::CToolpathReaderNode_Point(_In_ PModelReaderWarnings pWarnings, _In_ PProgressMonitor pProgressMonitor, CModelToolpathLayerReadData * pReadData)
 		: CModelReaderNode(pWarnings, pProgressMonitor), 
-		m_pReadData(pReadData),
-		m_bHasX (false),
-		m_bHasY (false),
-		m_dX (0.0),
-		m_dY (0.0)
+		m_pReadData(pReadData)
 	{
 		if (pReadData == nullptr)
 			throw CNMRException(NMR_ERROR_INVALIDPARAM);
 
+		reset();
+	}
+
+	void CToolpathReaderNode_Point::reset()
+	{
+		resetNode();
+
+		m_bHasX = false;
+		m_bHasY = false;
+		m_dX = 0.0;
+		m_dY = 0.0;
 	}
 
 
@@ -68,7 +76,7 @@ namespace NMR {
 
 	}
 
-	void CToolpathReaderNode_Point::OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
+	void CToolpathReaderNode_Point::OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
 	{
 		__NMRASSERT(pAttributeName);
 		__NMRASSERT(pAttributeValue);
@@ -76,28 +84,31 @@ namespace NMR {
 		__NMRASSERT(pAttributeName);
 		__NMRASSERT(pAttributeValue);
 
-		if (strcmp(pAttributeName, XML_3MF_TOOLPATHATTRIBUTE_X) == 0) {
+		switch (Token) {
+		case XMLTOKEN_X:
 			if (m_bHasX)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
-			m_dX = strtod(pAttributeValue, nullptr);
+			fnParseDouble(pAttributeValue, m_dX);
 			if (std::isnan(m_dX))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs(m_dX) > XML_3MF_MAXIMUMCOORDINATEVALUE)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			m_bHasX = true;
-		}
-		else if (strcmp(pAttributeName, XML_3MF_TOOLPATHATTRIBUTE_Y) == 0) {
+			break;
+		case XMLTOKEN_Y:
 			if (m_bHasY)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
-			m_dY = strtod(pAttributeValue, nullptr);
+			fnParseDouble(pAttributeValue, m_dY);
 			if (std::isnan(m_dY))
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			if (fabs(m_dY) > XML_3MF_MAXIMUMCOORDINATEVALUE)
 				throw CNMRException(NMR_ERROR_INVALIDMODELCOORDINATES);
 			m_bHasY = true;
-		}
-		else
+			break;
+		default:
 			m_pWarnings->addException(CNMRException(NMR_ERROR_NAMESPACE_INVALID_ATTRIBUTE), mrwInvalidOptionalValue);
+			break;
+		}
 
 	}
 
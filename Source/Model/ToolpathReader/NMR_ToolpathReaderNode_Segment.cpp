@@ -138,28 +138,28 @@ namespace NMR {
 
 	}
 
-	void CToolpathReaderNode_Segment::OnNSChildElement(_In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader)
+	void CToolpathReaderNode_Segment::OnTokenizedNSChildElement(_In_ nfUint32 nNameSpaceID, _In_ eXmlToken Token, _In_z_ const nfChar * pChildName, _In_z_ const nfChar * pNameSpace, _In_ CXmlReader * pXMLReader)
 	{
 
-		if (strcmp(pNameSpace, XML_3MF_NAMESPACE_TOOLPATHSPEC) == 0) {
-			if (strcmp(pChildName, XML_3MF_TOOLPATHELEMENT_HATCH) == 0) {
+		if (nNameSpaceID == XMLNAMESPACEID_TOOLPATHSPEC) {
+			if (Token == XMLTOKEN_HATCH) {
 
 				if (m_eSegmentType != eModelToolpathSegmentType::HatchSegment)
 					throw CNMRException(NMR_ERROR_INVALIDTYPEATTRIBUTE);
 
-				PToolpathReaderNode_Hatch pXMLNode = std::make_shared<CToolpathReaderNode_Hatch>(m_pWarnings, m_pProgressMonitor, m_pReadData);
+				CToolpathReaderNode_Hatch * pXMLNode = reuseChildNode(m_pHatchNode, m_pWarnings, m_pProgressMonitor, m_pReadData);
 				pXMLNode->parseXML(pXMLReader);
 
 				m_pReadData->addPoint((nfFloat)pXMLNode->getX1(), (nfFloat)pXMLNode->getY1());
 				m_pReadData->addPoint((nfFloat)pXMLNode->getX2(), (nfFloat)pXMLNode->getY2());
 
 			}
-			else if (strcmp(pChildName, XML_3MF_TOOLPATHELEMENT_POINT) == 0) {
+			else if (Token == XMLTOKEN_POINT) {
 
 				if ((m_eSegmentType != eModelToolpathSegmentType::LoopSegment) && (m_eSegmentType != eModelToolpathSegmentType::PolylineSegment))
 					throw CNMRException(NMR_ERROR_INVALIDTYPEATTRIBUTE);
 
-				PToolpathReaderNode_Point pXMLNode = std::make_shared<CToolpathReaderNode_Point>(m_pWarnings, m_pProgressMonitor, m_pReadData);
+				CToolpathReaderNode_Point * pXMLNode = reuseChildNode(m_pPointNode, m_pWarnings, m_pProgressMonitor, m_pReadData);
 				pXMLNode->parseXML(pXMLReader);
 
 				m_pReadData->addPoint((nfFloat)pXMLNode->getX(), (nfFloat)pXMLNode->getY());
@@ -169,12 +169,12 @@ namespace NMR {
 				m_pWarnings->addException(CNMRException(NMR_ERROR_NAMESPACE_INVALID_ELEMENT), mrwInvalidOptionalValue);
 		}
 
-		if (strcmp(pNameSpace, XML_3MF_NAMESPACE_ZCOMPRESSION) == 0) {
-			if (strcmp(pChildName, XML_3MF_TOOLPATHELEMENT_HATCH) == 0) {
+		if (nNameSpaceID == XMLNAMESPACEID_ZCOMPRESSION) {
+			if (Token == XMLTOKEN_HATCH) {
 				if (m_eSegmentType != eModelToolpathSegmentType::HatchSegment)
 					throw CNMRException(NMR_ERROR_INVALIDTYPEATTRIBUTE);
 
-				PToolpathReaderNode_ZHatch pXMLNode = std::make_shared<CToolpathReaderNode_ZHatch>(m_pWarnings, m_pProgressMonitor, m_pReadData);
+				CToolpathReaderNode_ZHatch * pXMLNode = reuseChildNode(m_pZHatchNode, m_pWarnings, m_pProgressMonitor, m_pReadData);
 				pXMLNode->parseXML(pXMLReader);
 
 				nfInt32 nX1ID, nY1ID, nX2ID, nY2ID;
@@ -228,11 +228,11 @@ namespace NMR {
 
 			}
 
-			if (strcmp(pChildName, XML_3MF_TOOLPATHELEMENT_POINT) == 0) {
+			if (Token == XMLTOKEN_POINT) {
 				if ((m_eSegmentType != eModelToolpathSegmentType::LoopSegment) && (m_eSegmentType != eModelToolpathSegmentType::PolylineSegment))
 					throw CNMRException(NMR_ERROR_INVALIDTYPEATTRIBUTE);
 
-				PToolpathReaderNode_ZPoint pXMLNode = std::make_shared<CToolpathReaderNode_ZPoint>(m_pWarnings, m_pProgressMonitor, m_pReadData);
+				CToolpathReaderNode_ZPoint * pXMLNode = reuseChildNode(m_pZPointNode, m_pWarnings, m_pProgressMonitor, m_pReadData);
 				pXMLNode->parseXML(pXMLReader);
 
 				nfInt32 nXID, nYID;
@@ -43,20 +43,26 @@ namespace NMR {
 
 	CToolpathReaderNode_ZHatch::CToolpathReaderNode_ZHatch(_In_ PModelReaderWarnings pWarnings, _In_ PProgressMonitor pProgressMonitor, CModelToolpathLayerReadData * pReadData)
 		: CModelReaderNode(pWarnings, pProgressMonitor), 
-			m_pReadData (pReadData),
-			m_nX1Id (0),
-			m_nY1Id (0),
-			m_nX2Id (0),
-			m_nY2Id (0),
-			m_bHasX1 (false),
-			m_bHasY1 (false),
-			m_bHasX2 (false),
-			m_bHasY2 (false)
-
-
+			m_pReadData (pReadData)
 	{
 		if (pReadData == nullptr)
 			throw CNMRException(NMR_ERROR_INVALIDPARAM);
+
+		reset();
+	}
+
+	void CToolpathReaderNode_ZHatch::reset()
+	{
+		resetNode();
+
+		m_nX1Id = 0;
+		m_nY1Id = 0;
+		m_nX2Id = 0;
+		m_nY2Id = 0;
+		m_bHasX1 = false;
+		m_bHasY1 = false;
+		m_bHasX2 = false;
+		m_bHasY2 = false;
 	}
 
 
@@ -73,12 +79,13 @@ namespace NMR {
 
 	}
 
-	void CToolpathReaderNode_ZHatch::OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
+	void CToolpathReaderNode_ZHatch::OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
 	{
 		__NMRASSERT(pAttributeName);
 		__NMRASSERT(pAttributeValue);
 
-		if (strcmp(pAttributeName, XML_3MF_TOOLPATHATTRIBUTE_X1) == 0) {
+		switch (Token) {
+		case XMLTOKEN_X1: {
 			if (m_bHasX1)
 				throw CNMRException(NMR_ERROR_INVALIDBINARYELEMENTID);
 			nfInt32 nValue = fnStringToInt32(pAttributeValue);
@@ -86,8 +93,9 @@ namespace NMR {
 				throw CNMRException(NMR_ERROR_INVALIDBINARYELEMENTID);
 			m_nX1Id = nValue;
 			m_bHasX1 = true;
+			break;
 		}
-		else if (strcmp(pAttributeName, XML_3MF_TOOLPATHATTRIBUTE_Y1) == 0) {
+		case XMLTOKEN_Y1: {
 			if (m_bHasY1)
 				throw CNMRException(NMR_ERROR_INVALIDBINARYELEMENTID);
 			nfInt32 nValue = fnStringToInt32(pAttributeValue);
@@ -95,8 +103,9 @@ namespace NMR {
 				throw CNMRException(NMR_ERROR_INVALIDBINARYELEMENTID);
 			m_nY1Id = nValue;
 			m_bHasY1 = true;
+			break;
 		}
-		else if (strcmp(pAttributeName, XML_3MF_TOOLPATHATTRIBUTE_X2) == 0) {
+		case XMLTOKEN_X2: {
 			if (m_bHasX2)
 				throw CNMRException(NMR_ERROR_INVALIDBINARYELEMENTID);
 			nfInt32 nValue = fnStringToInt32(pAttributeValue);
@@ -104,8 +113,9 @@ namespace NMR {
 				throw CNMRException(NMR_ERROR_INVALIDBINARYELEMENTID);
 			m_nX2Id = nValue;
 			m_bHasX2 = true;
+			break;
 		}
-		else if (strcmp(pAttributeName, XML_3MF_TOOLPATHATTRIBUTE_Y2) == 0) {
+		case XMLTOKEN_Y2: {
 			if (m_bHasY2)
 				throw CNMRException(NMR_ERROR_INVALIDBINARYELEMENTID);
 			nfInt32 nValue = fnStringToInt32(pAttributeValue);
@@ -113,9 +123,12 @@ namespace NMR {
 				throw CNMRException(NMR_ERROR_INVALIDBINARYELEMENTID);
 			m_nY2Id = nValue;
 			m_bHasY2 = true;
+			break;
 		}
-		else
+		default:
 			m_pWarnings->addException(CNMRException(NMR_ERROR_NAMESPACE_INVALID_ATTRIBUTE), mrwInvalidOptionalValue);
+			break;
+		}
 
 	}
 
@@ -43,15 +43,22 @@ namespace NMR {
 
 	CToolpathReaderNode_ZPoint::CToolpathReaderNode_ZPoint(_In_ PModelReaderWarnings pWarnings, _In_ PProgressMonitor pProgressMonitor, CModelToolpathLayerReadData * pReadData)
 		: CModelReaderNode(pWarnings, pProgressMonitor), 
-		m_pReadData(pReadData),
-		m_bHasX (false),
-		m_bHasY (false),
-		m_nXId (0),
-		m_nYId (0)
+		m_pReadData(pReadData)
 	{
 		if (pReadData == nullptr)
 			throw CNMRException(NMR_ERROR_INVALIDPARAM);
 
+		reset();
+	}
+
+	void CToolpathReaderNode_ZPoint::reset()
+	{
+		resetNode();
+
+		m_bHasX = false;
+		m_bHasY = false;
+		m_nXId = 0;
+		m_nYId = 0;
 	}
 
 
@@ -68,7 +75,7 @@ namespace NMR {
 
 	}
 
-	void CToolpathReaderNode_ZPoint::OnAttribute(_In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
+	void CToolpathReaderNode_ZPoint::OnTokenizedAttribute(_In_ eXmlToken Token, _In_z_ const nfChar * pAttributeName, _In_z_ const nfChar * pAttributeValue)
 	{
 		__NMRASSERT(pAttributeName);
 		__NMRASSERT(pAttributeValue);
@@ -76,7 +83,8 @@ namespace NMR {
 		__NMRASSERT(pAttributeName);
 		__NMRASSERT(pAttributeValue);
 
-		if (strcmp(pAttributeName, XML_3MF_TOOLPATHATTRIBUTE_X) == 0) {
+		switch (Token) {
+		case XMLTOKEN_X: {
 			if (m_bHasX)
 				throw CNMRException(NMR_ERROR_INVALIDBINARYELEMENTID);
 			nfInt32 nValue = fnStringToInt32(pAttributeValue);
@@ -84,8 +92,9 @@ namespace NMR {
 				throw CNMRException(NMR_ERROR_INVALIDBINARYELEMENTID);
 			m_nXId = nValue;
 			m_bHasX = true;
+			break;
 		}
-		else if (strcmp(pAttributeName, XML_3MF_TOOLPATHATTRIBUTE_Y) == 0) {
+		case XMLTOKEN_Y: {
 			if (m_bHasY)
 				throw CNMRException(NMR_ERROR_INVALIDBINARYELEMENTID);
 			nfInt32 nValue = fnStringToInt32(pAttributeValue);
@@ -93,9 +102,12 @@ namespace NMR {
 				throw CNMRException(NMR_ERROR_INVALIDBINARYELEMENTID);
 			m_nYId = nValue;
 			m_bHasY = true;
+			break;
 		}
-		else
+		default:
 			m_pWarnings->addException(CNMRException(NMR_ERROR_NAMESPACE_INVALID_ATTRIBUTE), mrwInvalidOptionalValue);
+			break;
+		}
 
 	}
 
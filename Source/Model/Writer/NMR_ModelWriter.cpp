@@ -46,7 +46,7 @@ namespace NMR {
 	const int MAX_DECIMAL_PRECISION = 16;
 
 	CModelWriter::CModelWriter(_In_ PModel pModel, _In_ nfBool bAllowBinaryStreams):
-		m_nDecimalPrecision(6), m_bAllowBinaryStreams(bAllowBinaryStreams)	{
+		m_nDecimalPrecision(6), m_bMeshReordering(false), m_bAllowBinaryStreams(bAllowBinaryStreams)	{
 		if (!pModel.get())
 			throw CNMRException(NMR_ERROR_INVALIDPARAM);
 
@@ -75,6 +75,17 @@ namespace NMR {
 	{
 		return m_nDecimalPrecision;
 	}
+
+	void CModelWriter::SetMeshReordering(nfBool bMeshReordering)
+	{
+		m_bMeshReordering = bMeshReordering;
+	}
+
+	nfBool CModelWriter::GetMeshReordering()
+	{
+		return m_bMeshReordering;
+	}
+
 	CModel * CModelWriter::getModel()
 	{
 		return m_pModel.get();
@@ -87,6 +87,7 @@ namespace NMR {
 		pXMLWriter->WriteStartDocument();
 		CModelWriterNode100_Model ModelNode(m_pModel.get(), pXMLWriter, m_pProgressMonitor, GetDecimalPrecision(), false);
 		ModelNode.setWriteLZMAExtension(m_bAllowBinaryStreams);
+		ModelNode.setReorderMeshes(GetMeshReordering());
 
 		for (auto iAssignmentIter : m_BinaryWriterAssignmentMap) {
 			auto iBinaryIter = m_BinaryWriterUUIDMap.find(iAssignmentIter.second);
@@ -111,6 +112,7 @@ namespace NMR {
 
 		CModelWriterNode100_Model ModelNode(pModel, pXMLWriter, m_pProgressMonitor, GetDecimalPrecision());
 		ModelNode.setWriteLZMAExtension(m_bAllowBinaryStreams);
+		ModelNode.setReorderMeshes(GetMeshReordering());
 
 		for (auto iAssignmentIter : m_BinaryWriterAssignmentMap) {
 			auto iBinaryIter = m_BinaryWriterUUIDMap.find(iAssignmentIter.second);
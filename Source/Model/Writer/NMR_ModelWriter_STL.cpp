@@ -51,7 +51,9 @@ namespace NMR {
 			throw CNMRException(NMR_ERROR_INVALIDPARAM);
 
 		// Create Merged Mesh
+		// The exporter only reads positions and indices, so the merged mesh needs no node and face records
 		PMesh pMesh = std::make_shared<CMesh>();
+		pMesh->setStorageMode(MESHSTORAGEMODE_SOA);
 		m_pModel->mergeToMesh(pMesh.get());
 
 		// Export Merged Mesh to STL
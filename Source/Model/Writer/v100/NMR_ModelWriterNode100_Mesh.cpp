@@ -41,6 +41,9 @@ This is the class for exporting the 3mf mesh node.
 #include "Common/3MF_ProgressMonitor.h"
 
 #include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
 
 #ifdef __GNUC__
 #include <stdio.h>
@@ -65,6 +68,7 @@ namespace NMR {
 
 		m_bWriteMaterialExtension = bWriteMaterialExtension;
 		m_bWriteBeamLatticeExtension = bWriteBeamLatticeExtension;
+		m_bReorderMesh = false;
 
 		m_pModelMeshObject = pModelMeshObject;
 		m_pPropertyIndexMapping = pPropertyIndexMapping;
@@ -113,6 +117,20 @@ namespace NMR {
 		const nfUint32 nBeamCount = pMesh->getBeamCount();
 		nfUint32 nNodeIndex, nFaceIndex, nBeamIndex;
 
+		// Faces and nodes are written in new order, node indices are mapped to their new index
+		PMeshReordering pReordering;
+		if (m_bReorderMesh) {
+			pReordering = std::make_shared<CMeshReordering>(pMesh);
+			if (!pReordering->isReordered())
+				pReordering.reset();
+		}
+		auto fnSourceNodeIndex = [&](nfUint32 nIndex) {
+			return pReordering ? pReordering->getOldNodeIndex(nIndex) : nIndex;
+		};
+		auto fnSourceFaceIndex = [&](nfUint32 nIndex) {
+			return pReordering ? pReordering->getOldFaceIndex(nIndex) : nIndex;
+		};
+
 		// Write Mesh Element
 		writeStartElement(XML_3MF_ELEMENT_MESH);
 
@@ -130,37 +148,92 @@ namespace NMR {
 
 			if (nNodeCount > 0) {
 
-				MESHNODE * pMeshNode = pMesh->getNode(0);
-				nfFloat originX = pMeshNode->m_position.m_fields[0];
-				nfFloat originY = pMeshNode->m_position.m_fields[1];
-				nfFloat originZ = pMeshNode->m_position.m_fields[2];
-
-				std::vector<nfFloat> XValues;
-				std::vector<nfFloat> YValues;
-				std::vector<nfFloat> ZValues;
-				XValues.resize(nNodeCount);
-				YValues.resize(nNodeCount);
-				ZValues.resize(nNodeCount);
-
-				for (nNodeIndex = 0; nNodeIndex < nNodeCount; nNodeIndex++) {
-					// Get Mesh Node
-					MESHNODE * pMeshNode = pMesh->getNode(nNodeIndex);
-					XValues[nNodeIndex] = pMeshNode->m_position.m_fields[0] - originX;
-					YValues[nNodeIndex] = pMeshNode->m_position.m_fields[1] - originY;
-					ZValues[nNodeIndex] = pMeshNode->m_position.m_fields[2] - originZ;
+				unsigned int binaryKeyX, binaryKeyY, binaryKeyZ;
+				nfFloat originX = 0.0f, originY = 0.0f, originZ = 0.0f;
+				std::string sQuantizedOrigin[3];
+
+				nfBool bQuantized = (pMesh->getStorageMode() == MESHSTORAGEMODE_QUANTIZED);
+				if (bQuantized) {
+					// Quantized coordinates are the discretized values of the stream already, relative to the
+					// origin of the quantization. The origin is written exactly, so that positions read back unchanged.
+					const MESHQUANTIZATION & Quantization = pMesh->getQuantization();
+					std::vector<nfInt32> QuantizedValues((size_t)nNodeCount * 3);
+					pMesh->copyQuantizedNodeCoordinates(0, nNodeCount, QuantizedValues.data());
+
+					std::vector<nfInt32> XValues(nNodeCount);
+					std::vector<nfInt32> YValues(nNodeCount);
+					std::vector<nfInt32> ZValues(nNodeCount);
+					for (nNodeIndex = 0; nNodeIndex < nNodeCount; nNodeIndex++) {
+						const nfInt32 * pValues = &QuantizedValues[(size_t)fnSourceNodeIndex(nNodeIndex) * 3];
+						XValues[nNodeIndex] = pValues[0];
+						YValues[nNodeIndex] = pValues[1];
+						ZValues[nNodeIndex] = pValues[2];
+					}
+
+					binaryKeyX = m_pBinaryStreamWriter->addQuantizedFloatArray(XValues.data(), nNodeCount, eptDeltaPredicition, Quantization.m_fUnits);
+					binaryKeyY = m_pBinaryStreamWriter->addQuantizedFloatArray(YValues.data(), nNodeCount, eptDeltaPredicition, Quantization.m_fUnits);
+					binaryKeyZ = m_pBinaryStreamWriter->addQuantizedFloatArray(ZValues.data(), nNodeCount, eptDeltaPredicition, Quantization.m_fUnits);
+
+					for (nfUint32 j = 0; j < 3; j++) {
+						std::stringstream sStream;
+						sStream << std::setprecision(std::numeric_limits<nfFloat>::max_digits10) << Quantization.m_vOrigin.m_fields[j];
+						sQuantizedOrigin[j] = sStream.str();
+					}
 				}
+				else {
+					NVEC3 vOrigin = pMesh->getNodePosition(fnSourceNodeIndex(0));
+					originX = vOrigin.m_fields[0];
+					originY = vOrigin.m_fields[1];
+					originZ = vOrigin.m_fields[2];
+
+					std::vector<nfFloat> XValues;
+					std::vector<nfFloat> YValues;
+					std::vector<nfFloat> ZValues;
+					XValues.resize(nNodeCount);
+					YValues.resize(nNodeCount);
+					ZValues.resize(nNodeCount);
+
+					if (pMesh->getStorageMode() == MESHSTORAGEMODE_SOA) {
+						// Coordinates are contiguous already
+						const nfFloat * pX = pMesh->getNodeCoordinates(0);
+						const nfFloat * pY = pMesh->getNodeCoordinates(1);
+						const nfFloat * pZ = pMesh->getNodeCoordinates(2);
+						for (nNodeIndex = 0; nNodeIndex < nNodeCount; nNodeIndex++) {
+							nfUint32 nSourceIndex = fnSourceNodeIndex(nNodeIndex);
+							XValues[nNodeIndex] = pX[nSourceIndex] - originX;
+							YValues[nNodeIndex] = pY[nSourceIndex] - originY;
+							ZValues[nNodeIndex] = pZ[nSourceIndex] - originZ;
+						}
+					}
+					else {
+						for (nNodeIndex = 0; nNodeIndex < nNodeCount; nNodeIndex++) {
+							// Get Mesh Node
+							NVEC3 vPosition = pMesh->getNodePosition(fnSourceNodeIndex(nNodeIndex));
+							XValues[nNodeIndex] = vPosition.m_fields[0] - originX;
+							YValues[nNodeIndex] = vPosition.m_fields[1] - originY;
+							ZValues[nNodeIndex] = vPosition.m_fields[2] - originZ;
+						}
+					}
 
-				unsigned int binaryKeyX = m_pBinaryStreamWriter->addFloatArray(XValues.data(), nNodeCount, eptDeltaPredicition, fUnits);
-				unsigned int binaryKeyY = m_pBinaryStreamWriter->addFloatArray(YValues.data(), nNodeCount, eptDeltaPredicition, fUnits);
-				unsigned int binaryKeyZ = m_pBinaryStreamWriter->addFloatArray(ZValues.data(), nNodeCount, eptDeltaPredicition, fUnits);
+					binaryKeyX = m_pBinaryStreamWriter->addFloatArray(XValues.data(), nNodeCount, eptDeltaPredicition, fUnits);
+					binaryKeyY = m_pBinaryStreamWriter->addFloatArray(YValues.data(), nNodeCount, eptDeltaPredicition, fUnits);
+					binaryKeyZ = m_pBinaryStreamWriter->addFloatArray(ZValues.data(), nNodeCount, eptDeltaPredicition, fUnits);
+				}
 
 				writeStartElementWithPrefix(XML_3MF_ELEMENT_VERTEX, XML_3MF_NAMESPACEPREFIX_LZMACOMPRESSION);
 				writeIntAttribute(XML_3MF_ATTRIBUTE_VERTEX_X, binaryKeyX);
 				writeIntAttribute(XML_3MF_ATTRIBUTE_VERTEX_Y, binaryKeyY);
 				writeIntAttribute(XML_3MF_ATTRIBUTE_VERTEX_Z, binaryKeyZ);
-				writeFloatAttribute(XML_3MF_ATTRIBUTE_VERTEX_ORIGINX, originX);
-				writeFloatAttribute(XML_3MF_ATTRIBUTE_VERTEX_ORIGINY, originY);
-				writeFloatAttribute(XML_3MF_ATTRIBUTE_VERTEX_ORIGINZ, originZ);
+				if (bQuantized) {
+					writeConstStringAttribute(XML_3MF_ATTRIBUTE_VERTEX_ORIGINX, sQuantizedOrigin[0].c_str());
+					writeConstStringAttribute(XML_3MF_ATTRIBUTE_VERTEX_ORIGINY, sQuantizedOrigin[1].c_str());
+					writeConstStringAttribute(XML_3MF_ATTRIBUTE_VERTEX_ORIGINZ, sQuantizedOrigin[2].c_str());
+				}
+				else {
+					writeFloatAttribute(XML_3MF_ATTRIBUTE_VERTEX_ORIGINX, originX);
+					writeFloatAttribute(XML_3MF_ATTRIBUTE_VERTEX_ORIGINY, originY);
+					writeFloatAttribute(XML_3MF_ATTRIBUTE_VERTEX_ORIGINZ, originZ);
+				}
 				writeEndElement();
 
 			}
@@ -171,8 +244,7 @@ namespace NMR {
 
 			for (nNodeIndex = 0; nNodeIndex < nNodeCount; nNodeIndex++) {
 				// Get Mesh Node
-				MESHNODE * pMeshNode = pMesh->getNode(nNodeIndex);
-				writeVertexData(pMeshNode);
+				writeVertexData(pMesh->getNodePosition(fnSourceNodeIndex(nNodeIndex)));
 
 				/* The following works, but would be a major output speed bottleneck!
 
@@ -227,11 +299,25 @@ namespace NMR {
 			Node2Indices.resize(nFaceCount);
 			Node3Indices.resize(nFaceCount);
 
+			const nfInt32 * pIndexArray = pMesh->getFaceNodeIndexArray();
 			for (nFaceIndex = 0; nFaceIndex < nFaceCount; nFaceIndex++) {
-				MESHFACE * pMeshFace = pMesh->getFace(nFaceIndex);
-				Node1Indices[nFaceIndex] = (nfInt32) pMeshFace->m_nodeindices[0];
-				Node2Indices[nFaceIndex] = (nfInt32) pMeshFace->m_nodeindices[1];
-				Node3Indices[nFaceIndex] = (nfInt32) pMeshFace->m_nodeindices[2];
+				nfUint32 nSourceFaceIndex = fnSourceFaceIndex(nFaceIndex);
+				nfInt32 NodeIndices[3];
+				if (pIndexArray != nullptr) {
+					const nfInt32 * pFaceIndices = &pIndexArray[(size_t)nSourceFaceIndex * 3];
+					NodeIndices[0] = pFaceIndices[0];
+					NodeIndices[1] = pFaceIndices[1];
+					NodeIndices[2] = pFaceIndices[2];
+				}
+				else
+					pMesh->getFaceNodeIndices(nSourceFaceIndex, NodeIndices);
+				if (pReordering) {
+					for (nfUint32 j = 0; j < 3; j++)
+						NodeIndices[j] = (nfInt32)pReordering->getNewNodeIndex(NodeIndices[j]);
+				}
+				Node1Indices[nFaceIndex] = NodeIndices[0];
+				Node2Indices[nFaceIndex] = NodeIndices[1];
+				Node3Indices[nFaceIndex] = NodeIndices[2];
 			}
 
 			unsigned int binaryKeyV1 = m_pBinaryStreamWriter->addIntArray(Node1Indices.data(), nFaceCount, eptDeltaPredicition);
@@ -252,7 +338,13 @@ namespace NMR {
 				}
 
 				// Get Mesh Face
-				MESHFACE * pMeshFace = pMesh->getFace(nFaceIndex);
+				nfUint32 nSourceFaceIndex = fnSourceFaceIndex(nFaceIndex);
+				nfInt32 NodeIndices[3];
+				pMesh->getFaceNodeIndices(nSourceFaceIndex, NodeIndices);
+				if (pReordering) {
+					for (nfUint32 j = 0; j < 3; j++)
+						NodeIndices[j] = (nfInt32)pReordering->getNewNodeIndex(NodeIndices[j]);
+				}
 
 				ModelResourceID nPropertyID = 0;
 				ModelResourceIndex nPropertyIndex1 = 0;
@@ -262,7 +354,7 @@ namespace NMR {
 				nfChar * pAdditionalString = nullptr;
 				// Retrieve Property Indices
 				if (pProperties != nullptr) {
-					MESHINFORMATION_PROPERTIES* pFaceData = (MESHINFORMATION_PROPERTIES*)pProperties->getFaceData(nFaceIndex);
+					const MESHINFORMATION_PROPERTIES* pFaceData = (const MESHINFORMATION_PROPERTIES*)pProperties->readFaceData(nSourceFaceIndex);
 					if (pFaceData != nullptr) {
 						if (pFaceData->m_nResourceID) {
 							nPropertyID = pFaceData->m_nResourceID;
@@ -277,20 +369,20 @@ namespace NMR {
 				if (nPropertyID != 0) {
 					bMeshHasAProperty = true;
 					if ((nPropertyIndex1 != nPropertyIndex2) || (nPropertyIndex1 != nPropertyIndex3)) {
-						writeFaceData_ThreeProperties(pMeshFace, nPropertyID, nPropertyIndex1, nPropertyIndex2, nPropertyIndex3, pAdditionalString);
+						writeFaceData_ThreeProperties(NodeIndices, nPropertyID, nPropertyIndex1, nPropertyIndex2, nPropertyIndex3, pAdditionalString);
 					}
 					else {
 						if ((nPropertyID == nObjectLevelPropertyID) && (nPropertyIndex1 == nObjectLevelPropertyIndex)) {
-							writeFaceData_Plain(pMeshFace, pAdditionalString);
+							writeFaceData_Plain(NodeIndices, pAdditionalString);
 						}
 						else {
-							writeFaceData_OneProperty(pMeshFace, nPropertyID, nPropertyIndex1, pAdditionalString);
+							writeFaceData_OneProperty(NodeIndices, nPropertyID, nPropertyIndex1, pAdditionalString);
 						}
 					}
 				}
 				else
 				{
-					writeFaceData_Plain(pMeshFace, pAdditionalString);
+					writeFaceData_Plain(NodeIndices, pAdditionalString);
 				}
 
 				/* The following works, but would be a major output speed bottleneck!
@@ -345,7 +437,14 @@ namespace NMR {
 					for (nBeamIndex = 0; nBeamIndex < nBeamCount; nBeamIndex++) {
 						// write beamlattice: beam
 						MESHBEAM * pMeshBeam = pMesh->getBeam(nBeamIndex);
-						writeBeamData(pMeshBeam, dDefaultRadius, eDefaultCapMode);
+						if (pReordering) {
+							MESHBEAM Beam = *pMeshBeam;
+							for (nfUint32 j = 0; j < 2; j++)
+								Beam.m_nodeindices[j] = (nfInt32)pReordering->getNewNodeIndex(Beam.m_nodeindices[j]);
+							writeBeamData(&Beam, dDefaultRadius, eDefaultCapMode);
+						}
+						else
+							writeBeamData(pMeshBeam, dDefaultRadius, eDefaultCapMode);
 					}
 					writeFullEndElement();
 
@@ -382,6 +481,11 @@ namespace NMR {
 	}
 
 
+	void CModelWriterNode100_Mesh::setReorderMesh(_In_ nfBool bValue)
+	{
+		m_bReorderMesh = bValue;
+	}
+
 	void CModelWriterNode100_Mesh::putVertexString(_In_ const nfChar * pszString)
 	{
 		__NMRASSERT(pszString);
@@ -577,29 +681,28 @@ namespace NMR {
 	}
 
 
-	void CModelWriterNode100_Mesh::writeVertexData(_In_ MESHNODE * pNode)
+	void CModelWriterNode100_Mesh::writeVertexData(_In_ const NVEC3 & vPosition)
 	{
-		__NMRASSERT(pNode);
 		m_nVertexBufferPos = MODELWRITERMESH100_VERTEXLINESTARTLENGTH;
-		putVertexFloat(pNode->m_position.m_values.x);
+		putVertexFloat(vPosition.m_values.x);
 		putVertexString("\" y=\"");
-		putVertexFloat(pNode->m_position.m_values.y);
+		putVertexFloat(vPosition.m_values.y);
 		putVertexString("\" z=\"");
-		putVertexFloat(pNode->m_position.m_values.z);
+		putVertexFloat(vPosition.m_values.z);
 		putVertexString("\" />");
 
 		m_pXMLWriter->WriteRawLine(&m_VertexLine[0], m_nVertexBufferPos);
 	}
 
-	void CModelWriterNode100_Mesh::writeFaceData_Plain(_In_ MESHFACE * pFace, _In_opt_ const nfChar * pszAdditionalString)
+	void CModelWriterNode100_Mesh::writeFaceData_Plain(_In_ const nfInt32 * pNodeIndices, _In_opt_ const nfChar * pszAdditionalString)
 	{
-		__NMRASSERT(pFace);
+		__NMRASSERT(pNodeIndices);
 		m_nTriangleBufferPos = MODELWRITERMESH100_TRIANGLELINESTARTLENGTH;
-		putTriangleUInt32(pFace->m_nodeindices[0]);
+		putTriangleUInt32(pNodeIndices[0]);
 		putTriangleString("\" v2=\"");
-		putTriangleUInt32(pFace->m_nodeindices[1]);
+		putTriangleUInt32(pNodeIndices[1]);
 		putTriangleString("\" v3=\"");
-		putTriangleUInt32(pFace->m_nodeindices[2]);
+		putTriangleUInt32(pNodeIndices[2]);
 		putTriangleString("\"");
 		if (pszAdditionalString) {
 			putTriangleString(pszAdditionalString);
@@ -608,15 +711,15 @@ namespace NMR {
 		m_pXMLWriter->WriteRawLine(&m_TriangleLine[0], m_nTriangleBufferPos);
 	}
 
-	void CModelWriterNode100_Mesh::writeFaceData_OneProperty(_In_ MESHFACE * pFace, _In_ const ModelResourceID nPropertyID, _In_ const ModelResourceIndex nPropertyIndex, _In_opt_ const nfChar * pszAdditionalString)
+	void CModelWriterNode100_Mesh::writeFaceData_OneProperty(_In_ const nfInt32 * pNodeIndices, _In_ const ModelResourceID nPropertyID, _In_ const ModelResourceIndex nPropertyIndex, _In_opt_ const nfChar * pszAdditionalString)
 	{
-		__NMRASSERT(pFace);
+		__NMRASSERT(pNodeIndices);
 		m_nTriangleBufferPos = MODELWRITERMESH100_TRIANGLELINESTARTLENGTH;
-		putTriangleUInt32(pFace->m_nodeindices[0]);
+		putTriangleUInt32(pNodeIndices[0]);
 		putTriangleString("\" v2=\"");
-		putTriangleUInt32(pFace->m_nodeindices[1]);
+		putTriangleUInt32(pNodeIndices[1]);
 		putTriangleString("\" v3=\"");
-		putTriangleUInt32(pFace->m_nodeindices[2]);
+		putTriangleUInt32(pNodeIndices[2]);
 		if (nPropertyID != 0) {
 			putTriangleString("\" pid=\"");
 			putTriangleUInt32(nPropertyID);
@@ -631,15 +734,15 @@ namespace NMR {
 		m_pXMLWriter->WriteRawLine(&m_TriangleLine[0], m_nTriangleBufferPos);
 	}
 
-	void CModelWriterNode100_Mesh::writeFaceData_ThreeProperties(_In_ MESHFACE * pFace, _In_ const ModelResourceID nPropertyID, _In_ const ModelResourceIndex nPropertyIndex1, _In_ const ModelResourceIndex nPropertyIndex2, _In_ const ModelResourceIndex nPropertyIndex3, _In_opt_ const nfChar * pszAdditionalString)
+	void CModelWriterNode100_Mesh::writeFaceData_ThreeProperties(_In_ const nfInt32 * pNodeIndices, _In_ const ModelResourceID nPropertyID, _In_ const ModelResourceIndex nPropertyIndex1, _In_ const ModelResourceIndex nPropertyIndex2, _In_ const ModelResourceIndex nPropertyIndex3, _In_opt_ const nfChar * pszAdditionalString)
 	{
-		__NMRASSERT(pFace);
+		__NMRASSERT(pNodeIndices);
 		m_nTriangleBufferPos = MODELWRITERMESH100_TRIANGLELINESTARTLENGTH;
-		putTriangleUInt32(pFace->m_nodeindices[0]);
+		putTriangleUInt32(pNodeIndices[0]);
 		putTriangleString("\" v2=\"");
-		putTriangleUInt32(pFace->m_nodeindices[1]);
+		putTriangleUInt32(pNodeIndices[1]);
 		putTriangleString("\" v3=\"");
-		putTriangleUInt32(pFace->m_nodeindices[2]);
+		putTriangleUInt32(pNodeIndices[2]);
 		if (nPropertyID != 0) {
 			putTriangleString("\" pid=\"");
 			putTriangleUInt32(nPropertyID);
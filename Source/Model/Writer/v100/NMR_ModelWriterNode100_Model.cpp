@@ -76,6 +76,7 @@ namespace NMR {
 		m_bIsRootModel = true;
 		m_bWriteCustomNamespaces = true;
 		m_bWriteLZMAExtension = false;
+		m_bReorderMeshes = false;
 
 		// register custom NameSpaces from metadata in objects, build items and the model itself
 		RegisterMetaDataNameSpaces();
@@ -98,6 +99,7 @@ namespace NMR {
 		m_bWriteSliceExtension = true;
 		m_bWriteCustomNamespaces = true;
 		m_bWriteLZMAExtension = false;
+		m_bReorderMeshes = false;
 	}
 
 
@@ -521,6 +523,7 @@ namespace NMR {
 				CModelWriterNode100_Mesh ModelWriter_Mesh(pMeshObject, m_pXMLWriter, m_pProgressMonitor,
 					m_pPropertyIndexMapping, m_nDecimalPrecision, m_bWriteMaterialExtension, m_bWriteBeamLatticeExtension,
 					pMeshBinaryWriter, sMeshBinaryPath);
+				ModelWriter_Mesh.setReorderMesh(m_bReorderMeshes);
 
 				ModelWriter_Mesh.writeToXML();
 			}
@@ -977,6 +980,11 @@ namespace NMR {
 		m_bWriteLZMAExtension = bValue;
 	}
 
+	void CModelWriterNode100_Model::setReorderMeshes(nfBool bValue)
+	{
+		m_bReorderMeshes = bValue;
+	}
+
 }
 
 
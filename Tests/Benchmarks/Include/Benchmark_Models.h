@@ -0,0 +1,68 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+Benchmark_Models.h: Generators of the synthetic models the benchmarks read and write.
+All geometry is computed from closed formulas and a fixed-seed generator, so every run
+produces identical files.
+
+--*/
+
+#ifndef __NMR_BENCHMARK_MODELS
+#define __NMR_BENCHMARK_MODELS
+
+#include "lib3mf_implicit.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Lib3MF
+{
+	// Fills an empty model with about nItemCount items and returns the exact count.
+	// If bBinaryStreams is set, the data is assigned to binary streams of pWriter.
+	typedef std::function<Lib3MF_uint64(PWrapper pWrapper, PModel pModel, PWriter pWriter, bool bBinaryStreams, Lib3MF_uint64 nItemCount)> BenchmarkGenerator;
+
+	struct sBenchmarkScenario {
+		std::string m_sName;
+		// What the item count and the item rate refer to, e.g. "triangles"
+		std::string m_sItemName;
+		std::vector<Lib3MF_uint64> m_ItemCounts;
+		bool m_bSupportsBinaryStreams;
+		BenchmarkGenerator m_Generator;
+	};
+
+	Lib3MF_uint64 fnGenerateMesh(PWrapper pWrapper, PModel pModel, PWriter pWriter, bool bBinaryStreams, Lib3MF_uint64 nTriangleCount);
+	Lib3MF_uint64 fnGenerateColoredMesh(PWrapper pWrapper, PModel pModel, PWriter pWriter, bool bBinaryStreams, Lib3MF_uint64 nTriangleCount);
+	Lib3MF_uint64 fnGenerateBeamLattice(PWrapper pWrapper, PModel pModel, PWriter pWriter, bool bBinaryStreams, Lib3MF_uint64 nBeamCount);
+	Lib3MF_uint64 fnGenerateSliceStack(PWrapper pWrapper, PModel pModel, PWriter pWriter, bool bBinaryStreams, Lib3MF_uint64 nVertexCount);
+	Lib3MF_uint64 fnGenerateToolpath(PWrapper pWrapper, PModel pModel, PWriter pWriter, bool bBinaryStreams, Lib3MF_uint64 nHatchCount);
+
+	std::vector<sBenchmarkScenario> fnGetBenchmarkScenarios();
+}
+
+#endif //__NMR_BENCHMARK_MODELS
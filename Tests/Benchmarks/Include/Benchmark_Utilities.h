@@ -0,0 +1,102 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+Benchmark_Utilities.h: Timing and memory measurement utilities for the benchmarks
+
+--*/
+
+#ifndef __NMR_BENCHMARK_UTILITIES
+#define __NMR_BENCHMARK_UTILITIES
+
+#include <chrono>
+#include <string>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+class CBenchmarkTimer {
+private:
+	std::chrono::steady_clock::time_point m_Start;
+public:
+	CBenchmarkTimer()
+		: m_Start(std::chrono::steady_clock::now())
+	{
+	}
+
+	double elapsedSeconds() const
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_Start).count();
+	}
+};
+
+// Resets the peak resident set size of the process, so that the next measurement only covers
+// the following operation. Only Linux supports this, elsewhere the peak covers the whole run.
+inline void fnResetPeakMemory()
+{
+#ifdef __linux__
+	std::ofstream clearRefs("/proc/self/clear_refs");
+	if (clearRefs.is_open())
+		clearRefs << "5";
+#endif
+}
+
+// Returns the peak resident set size of the process in bytes
+inline unsigned long long fnGetPeakMemory()
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS Counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &Counters, sizeof(Counters)))
+		return Counters.PeakWorkingSetSize;
+	return 0;
+#else
+#ifdef __linux__
+	// VmHWM honours fnResetPeakMemory, while getrusage does not
+	std::ifstream status("/proc/self/status");
+	std::string sLine;
+	while (std::getline(status, sLine)) {
+		if (sLine.compare(0, 6, "VmHWM:") == 0)
+			return std::stoull(sLine.substr(6)) * 1024;
+	}
+#endif
+	struct rusage Usage;
+	if (getrusage(RUSAGE_SELF, &Usage) != 0)
+		return 0;
+#ifdef __APPLE__
+	return (unsigned long long) Usage.ru_maxrss;
+#else
+	return (unsigned long long) Usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+#endif //__NMR_BENCHMARK_UTILITIES
@@ -0,0 +1,311 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+Benchmark_Models.cpp: Generators of the synthetic models the benchmarks read and write
+
+--*/
+
+#include "Benchmark_Models.h"
+
+#include <algorithm>
+#include <cmath>
+
+#define BENCHMARK_PI 3.14159265358979323846
+#define BENCHMARK_SEED 0x3D3D3D3Du
+
+#define BENCHMARK_COLORCOUNT 256
+#define BENCHMARK_SLICEVERTEXCOUNT 512
+#define BENCHMARK_LAYERHATCHCOUNT 256
+
+namespace Lib3MF
+{
+	// Linear congruential generator, which gives the same sequence on every platform
+	class CBenchmarkRandom {
+	private:
+		Lib3MF_uint32 m_nState;
+	public:
+		CBenchmarkRandom()
+			: m_nState(BENCHMARK_SEED)
+		{
+		}
+
+		Lib3MF_uint32 next()
+		{
+			m_nState = m_nState * 1664525u + 1013904223u;
+			return m_nState >> 8;
+		}
+
+		// Returns a value in [0, 1)
+		double nextUnit()
+		{
+			return (double)next() / (double)(1u << 24);
+		}
+	};
+
+	// Closed and consistently oriented torus with about nTriangleCount triangles
+	static void fnCreateTorus(Lib3MF_uint64 nTriangleCount, std::vector<sPosition> & Vertices, std::vector<sTriangle> & Triangles)
+	{
+		Lib3MF_uint32 nMinor = std::max(3u, (Lib3MF_uint32)std::sqrt((double)nTriangleCount / 8.0));
+		Lib3MF_uint32 nMajor = std::max(3u, (Lib3MF_uint32)(nTriangleCount / (2 * (Lib3MF_uint64)nMinor)));
+		const double dMajorRadius = 50.0;
+		const double dMinorRadius = 15.0;
+
+		Vertices.resize((size_t)nMajor * nMinor);
+		Triangles.resize((size_t)nMajor * nMinor * 2);
+
+		for (Lib3MF_uint32 i = 0; i < nMajor; i++) {
+			double dPhi = 2.0 * BENCHMARK_PI * i / nMajor;
+			for (Lib3MF_uint32 j = 0; j < nMinor; j++) {
+				double dTheta = 2.0 * BENCHMARK_PI * j / nMinor;
+				double dRadius = dMajorRadius + dMinorRadius * std::cos(dTheta);
+				sPosition & Vertex = Vertices[(size_t)i * nMinor + j];
+				Vertex.m_Coordinates[0] = (Lib3MF_single)(dRadius * std::cos(dPhi) + 70.0);
+				Vertex.m_Coordinates[1] = (Lib3MF_single)(dRadius * std::sin(dPhi) + 70.0);
+				Vertex.m_Coordinates[2] = (Lib3MF_single)(dMinorRadius * std::sin(dTheta) + 20.0);
+			}
+		}
+
+		size_t nTriangle = 0;
+		for (Lib3MF_uint32 i = 0; i < nMajor; i++) {
+			Lib3MF_uint32 iNext = (i + 1) % nMajor;
+			for (Lib3MF_uint32 j = 0; j < nMinor; j++) {
+				Lib3MF_uint32 jNext = (j + 1) % nMinor;
+				Lib3MF_uint32 nA = i * nMinor + j;
+				Lib3MF_uint32 nB = iNext * nMinor + j;
+				Lib3MF_uint32 nC = iNext * nMinor + jNext;
+				Lib3MF_uint32 nD = i * nMinor + jNext;
+
+				sTriangle & First = Triangles[nTriangle++];
+				First.m_Indices[0] = nA;
+				First.m_Indices[1] = nB;
+				First.m_Indices[2] = nC;
+
+				sTriangle & Second = Triangles[nTriangle++];
+				Second.m_Indices[0] = nA;
+				Second.m_Indices[1] = nC;
+				Second.m_Indices[2] = nD;
+			}
+		}
+	}
+
+	static PMeshObject fnAddTorus(PWrapper pWrapper, PModel pModel, PWriter pWriter, bool bBinaryStreams, Lib3MF_uint64 nTriangleCount)
+	{
+		std::vector<sPosition> Vertices;
+		std::vector<sTriangle> Triangles;
+		fnCreateTorus(nTriangleCount, Vertices, Triangles);
+
+		PMeshObject pMeshObject = pModel->AddMeshObject();
+		pMeshObject->SetName("Torus");
+		pMeshObject->SetGeometry(Vertices, Triangles);
+		pModel->AddBuildItem(pMeshObject.get(), pWrapper->GetIdentityTransform());
+
+		if (bBinaryStreams) {
+			PBinaryStream pBinaryStream = pWriter->CreateBinaryStream("/3D/Binary/mesh.bin");
+			pWriter->AssignBinaryStream(pMeshObject.get(), pBinaryStream.get());
+		}
+
+		return pMeshObject;
+	}
+
+	Lib3MF_uint64 fnGenerateMesh(PWrapper pWrapper, PModel pModel, PWriter pWriter, bool bBinaryStreams, Lib3MF_uint64 nTriangleCount)
+	{
+		return fnAddTorus(pWrapper, pModel, pWriter, bBinaryStreams, nTriangleCount)->GetTriangleCount();
+	}
+
+	Lib3MF_uint64 fnGenerateColoredMesh(PWrapper pWrapper, PModel pModel, PWriter pWriter, bool bBinaryStreams, Lib3MF_uint64 nTriangleCount)
+	{
+		PMeshObject pMeshObject = fnAddTorus(pWrapper, pModel, pWriter, bBinaryStreams, nTriangleCount);
+		CBenchmarkRandom Random;
+
+		PColorGroup pColorGroup = pModel->AddColorGroup();
+		std::vector<Lib3MF_uint32> ColorIDs(BENCHMARK_COLORCOUNT);
+		for (Lib3MF_uint32 nIndex = 0; nIndex < BENCHMARK_COLORCOUNT; nIndex++) {
+			Lib3MF_uint32 nValue = Random.next();
+			ColorIDs[nIndex] = pColorGroup->AddColor(pWrapper->RGBAToColor((Lib3MF_uint8)nValue, (Lib3MF_uint8)(nValue >> 8), (Lib3MF_uint8)(nValue >> 16), 255));
+		}
+
+		// Every triangle gets its own color, with slightly different shades at its corners
+		std::vector<sTriangleProperties> Properties((size_t)pMeshObject->GetTriangleCount());
+		for (sTriangleProperties & Property : Properties) {
+			Lib3MF_uint32 nColor = Random.next();
+			Property.m_ResourceID = pColorGroup->GetResourceID();
+			for (int j = 0; j < 3; j++)
+				Property.m_PropertyIDs[j] = ColorIDs[(nColor + j) % BENCHMARK_COLORCOUNT];
+		}
+		pMeshObject->SetAllTriangleProperties(Properties);
+
+		return Properties.size();
+	}
+
+	Lib3MF_uint64 fnGenerateBeamLattice(PWrapper pWrapper, PModel pModel, PWriter pWriter, bool bBinaryStreams, Lib3MF_uint64 nBeamCount)
+	{
+		// A cubic grid of n^3 nodes has 3 * n^2 * (n - 1) beams along its axes
+		Lib3MF_uint32 nGridSize = std::max(2u, (Lib3MF_uint32)std::cbrt((double)nBeamCount / 3.0) + 1);
+		const double dSpacing = 2.0;
+		CBenchmarkRandom Random;
+
+		std::vector<sPosition> Vertices;
+		Vertices.reserve((size_t)nGridSize * nGridSize * nGridSize);
+		for (Lib3MF_uint32 z = 0; z < nGridSize; z++) {
+			for (Lib3MF_uint32 y = 0; y < nGridSize; y++) {
+				for (Lib3MF_uint32 x = 0; x < nGridSize; x++) {
+					sPosition Vertex;
+					Vertex.m_Coordinates[0] = (Lib3MF_single)(x * dSpacing);
+					Vertex.m_Coordinates[1] = (Lib3MF_single)(y * dSpacing);
+					Vertex.m_Coordinates[2] = (Lib3MF_single)(z * dSpacing);
+					Vertices.push_back(Vertex);
+				}
+			}
+		}
+
+		std::vector<sBeam> Beams;
+		Beams.reserve((size_t)nGridSize * nGridSize * (nGridSize - 1) * 3);
+		for (Lib3MF_uint32 z = 0; z < nGridSize; z++) {
+			for (Lib3MF_uint32 y = 0; y < nGridSize; y++) {
+				for (Lib3MF_uint32 x = 0; x < nGridSize; x++) {
+					Lib3MF_uint32 nNode = (z * nGridSize + y) * nGridSize + x;
+					Lib3MF_uint32 Neighbours[3] = { nNode + 1, nNode + nGridSize, nNode + nGridSize * nGridSize };
+					bool Exists[3] = { x + 1 < nGridSize, y + 1 < nGridSize, z + 1 < nGridSize };
+
+					for (int nAxis = 0; nAxis < 3; nAxis++) {
+						if (!Exists[nAxis])
+							continue;
+						sBeam Beam;
+						Beam.m_Indices[0] = nNode;
+						Beam.m_Indices[1] = Neighbours[nAxis];
+						Beam.m_Radii[0] = 0.2 + 0.1 * Random.nextUnit();
+						Beam.m_Radii[1] = 0.2 + 0.1 * Random.nextUnit();
+						Beam.m_CapModes[0] = eBeamLatticeCapMode::Sphere;
+						Beam.m_CapModes[1] = eBeamLatticeCapMode::Sphere;
+						Beams.push_back(Beam);
+					}
+				}
+			}
+		}
+
+		PMeshObject pMeshObject = pModel->AddMeshObject();
+		pMeshObject->SetName("Lattice");
+		pMeshObject->SetGeometry(Vertices, std::vector<sTriangle>());
+		pMeshObject->BeamLattice()->SetBeams(Beams);
+
+		if (bBinaryStreams) {
+			PBinaryStream pBinaryStream = pWriter->CreateBinaryStream("/3D/Binary/lattice.bin");
+			pWriter->AssignBinaryStream(pMeshObject.get(), pBinaryStream.get());
+		}
+
+		return Beams.size();
+	}
+
+	Lib3MF_uint64 fnGenerateSliceStack(PWrapper pWrapper, PModel pModel, PWriter pWriter, bool bBinaryStreams, Lib3MF_uint64 nVertexCount)
+	{
+		Lib3MF_uint64 nSliceCount = std::max((Lib3MF_uint64)1, nVertexCount / BENCHMARK_SLICEVERTEXCOUNT);
+		const double dLayerHeight = 0.03;
+
+		std::vector<Lib3MF_uint32> Polygon(BENCHMARK_SLICEVERTEXCOUNT + 1);
+		for (Lib3MF_uint32 nIndex = 0; nIndex < BENCHMARK_SLICEVERTEXCOUNT; nIndex++)
+			Polygon[nIndex] = nIndex;
+		Polygon[BENCHMARK_SLICEVERTEXCOUNT] = 0;
+
+		PSliceStack pSliceStack = pModel->AddSliceStack(0.0);
+		std::vector<sPosition2D> Vertices(BENCHMARK_SLICEVERTEXCOUNT);
+		for (Lib3MF_uint64 nSlice = 0; nSlice < nSliceCount; nSlice++) {
+			// A wavy outline that turns from slice to slice
+			for (Lib3MF_uint32 nIndex = 0; nIndex < BENCHMARK_SLICEVERTEXCOUNT; nIndex++) {
+				double dAngle = 2.0 * BENCHMARK_PI * nIndex / BENCHMARK_SLICEVERTEXCOUNT;
+				double dRadius = 20.0 + 2.0 * std::sin(5.0 * dAngle + 0.1 * nSlice);
+				Vertices[nIndex].m_Coordinates[0] = (Lib3MF_single)(dRadius * std::cos(dAngle) + 50.0);
+				Vertices[nIndex].m_Coordinates[1] = (Lib3MF_single)(dRadius * std::sin(dAngle) + 50.0);
+			}
+
+			PSlice pSlice = pSliceStack->AddSlice(dLayerHeight * (nSlice + 1));
+			pSlice->SetVertices(Vertices);
+			pSlice->AddPolygon(Polygon);
+		}
+
+		return nSliceCount * BENCHMARK_SLICEVERTEXCOUNT;
+	}
+
+	Lib3MF_uint64 fnGenerateToolpath(PWrapper pWrapper, PModel pModel, PWriter pWriter, bool bBinaryStreams, Lib3MF_uint64 nHatchCount)
+	{
+		Lib3MF_uint64 nLayerCount = std::max((Lib3MF_uint64)1, nHatchCount / BENCHMARK_LAYERHATCHCOUNT);
+		const Lib3MF_uint32 nLayerHeight = 30;
+		const double dHatchDistance = 0.1;
+		const double dHatchLength = 40.0;
+
+		PMeshObject pPart = fnAddTorus(pWrapper, pModel, pWriter, false, 1000);
+		PToolpath pToolpath = pModel->AddToolpath(0.001);
+		PToolpathProfile pProfile = pToolpath->AddProfile("default", 200.0, 800.0, 0.0, 0);
+
+		PBinaryStream pBinaryStream;
+		if (bBinaryStreams)
+			pBinaryStream = pWriter->CreateBinaryStream("/Toolpath/layers.bin");
+
+		std::vector<sPosition2D> Points(BENCHMARK_LAYERHATCHCOUNT * 2);
+		for (Lib3MF_uint64 nLayer = 0; nLayer < nLayerCount; nLayer++) {
+			PToolpathLayerData pLayerData = pToolpath->AddLayer((Lib3MF_uint32)(nLayerHeight * (nLayer + 1)), "/Toolpath/layer" + std::to_string(nLayer) + ".xml", pWriter.get());
+			if (bBinaryStreams)
+				pWriter->AssignBinaryStream(pLayerData.get(), pBinaryStream.get());
+			Lib3MF_uint32 nProfileID = pLayerData->RegisterProfile(pProfile.get());
+			Lib3MF_uint32 nPartID = pLayerData->RegisterPart(pPart.get());
+
+			// Parallel hatches, rotated by 67 degrees from layer to layer
+			double dAngle = BENCHMARK_PI * 67.0 / 180.0 * nLayer;
+			double dCos = std::cos(dAngle);
+			double dSin = std::sin(dAngle);
+			for (Lib3MF_uint32 nHatch = 0; nHatch < BENCHMARK_LAYERHATCHCOUNT; nHatch++) {
+				double dOffset = (nHatch - BENCHMARK_LAYERHATCHCOUNT / 2.0) * dHatchDistance;
+				for (int j = 0; j < 2; j++) {
+					double dAlong = (j - 0.5) * dHatchLength;
+					sPosition2D & Point = Points[nHatch * 2 + j];
+					Point.m_Coordinates[0] = (Lib3MF_single)(dAlong * dCos - dOffset * dSin + 70.0);
+					Point.m_Coordinates[1] = (Lib3MF_single)(dAlong * dSin + dOffset * dCos + 70.0);
+				}
+			}
+
+			pLayerData->WriteHatchData(nProfileID, nPartID, Points);
+			pLayerData->Finish();
+		}
+
+		return nLayerCount * BENCHMARK_LAYERHATCHCOUNT;
+	}
+
+	std::vector<sBenchmarkScenario> fnGetBenchmarkScenarios()
+	{
+		std::vector<Lib3MF_uint64> MeshSizes = { 1000, 10000, 100000, 1000000, 10000000, 50000000 };
+		std::vector<Lib3MF_uint64> LatticeSizes = { 1000, 10000, 100000, 1000000, 10000000 };
+		std::vector<Lib3MF_uint64> LayerSizes = { 10000, 100000, 1000000, 10000000 };
+
+		std::vector<sBenchmarkScenario> Scenarios;
+		Scenarios.push_back({ "mesh", "triangles", MeshSizes, true, fnGenerateMesh });
+		Scenarios.push_back({ "coloredmesh", "triangles", MeshSizes, true, fnGenerateColoredMesh });
+		Scenarios.push_back({ "beamlattice", "beams", LatticeSizes, true, fnGenerateBeamLattice });
+		Scenarios.push_back({ "slicestack", "vertices", LayerSizes, false, fnGenerateSliceStack });
+		Scenarios.push_back({ "toolpath", "hatches", LayerSizes, true, fnGenerateToolpath });
+		return Scenarios;
+	}
+}
@@ -0,0 +1,273 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+Benchmarks.cpp: Measures the read and write throughput of the library on synthetic models.
+
+Usage: lib3mf_benchmarks [--filter <name>] [--max-items <count>] [--repetitions <count>]
+                         [--output <directory>] [--csv <file>]
+
+Every scenario is run for every item count up to --max-items (default 1000000) and for
+every file format. Each operation is repeated and the fastest run is reported, together
+with the peak resident memory of the process during the operation, which includes the
+model being written or the buffer being read.
+
+--*/
+
+#include "Benchmark_Models.h"
+#include "Benchmark_Utilities.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace Lib3MF
+{
+	struct sBenchmarkFormat {
+		std::string m_sName;
+		std::string m_sWriterClass;
+		std::string m_sReaderClass;
+		std::string m_sExtension;
+		bool m_bBinaryStreams;
+	};
+
+	struct sBenchmarkOptions {
+		std::string m_sFilter;
+		Lib3MF_uint64 m_nMaxItems;
+		Lib3MF_uint32 m_nRepetitions;
+		std::string m_sOutputDirectory;
+		std::string m_sCSVFile;
+	};
+
+	struct sBenchmarkResult {
+		double m_dSeconds;
+		unsigned long long m_nPeakMemory;
+	};
+
+	class CBenchmarkRunner {
+	private:
+		PWrapper m_pWrapper;
+		sBenchmarkOptions m_Options;
+		std::ofstream m_CSV;
+		Lib3MF_uint32 m_nFailures;
+
+		// Runs a measurement several times and keeps the fastest time and the highest memory peak.
+		// The measurement resets the memory peak itself, once its preparations are done.
+		template<typename F> sBenchmarkResult measure(F Measurement)
+		{
+			sBenchmarkResult Result = { 0.0, 0 };
+			for (Lib3MF_uint32 nRepetition = 0; nRepetition < m_Options.m_nRepetitions; nRepetition++) {
+				double dSeconds = Measurement();
+				unsigned long long nPeakMemory = fnGetPeakMemory();
+				if ((nRepetition == 0) || (dSeconds < Result.m_dSeconds))
+					Result.m_dSeconds = dSeconds;
+				Result.m_nPeakMemory = std::max(Result.m_nPeakMemory, nPeakMemory);
+			}
+			return Result;
+		}
+
+		void report(const sBenchmarkScenario & Scenario, const sBenchmarkFormat & Format, const std::string & sOperation, Lib3MF_uint64 nItems, Lib3MF_uint64 nBytes, const sBenchmarkResult & Result)
+		{
+			double dSeconds = std::max(Result.m_dSeconds, 1e-9);
+			double dMBPerSecond = (double)nBytes / (1024.0 * 1024.0) / dSeconds;
+			double dItemsPerSecond = (double)nItems / dSeconds;
+			double dPeakMB = (double)Result.m_nPeakMemory / (1024.0 * 1024.0);
+
+			printf("%-12s %10llu %-12s %-15s %10.4f s %10.2f MB/s %14.0f %s/s %10.1f MB peak\n",
+				Scenario.m_sName.c_str(), (unsigned long long)nItems, Format.m_sName.c_str(), sOperation.c_str(),
+				dSeconds, dMBPerSecond, dItemsPerSecond, Scenario.m_sItemName.c_str(), dPeakMB);
+			fflush(stdout);
+
+			if (m_CSV.is_open()) {
+				m_CSV << Scenario.m_sName << "," << nItems << "," << Format.m_sName << "," << sOperation << ","
+					<< dSeconds << "," << nBytes << "," << dMBPerSecond << "," << dItemsPerSecond << "," << Result.m_nPeakMemory << std::endl;
+			}
+		}
+
+		void run(const sBenchmarkScenario & Scenario, const sBenchmarkFormat & Format, Lib3MF_uint64 nItemCount)
+		{
+			std::string sFileName = m_Options.m_sOutputDirectory + "/" + Scenario.m_sName + "_" + std::to_string(nItemCount) + Format.m_sExtension;
+			Lib3MF_uint64 nItems = 0;
+			std::vector<Lib3MF_uint8> Buffer;
+
+			// Binary streams are filled while writing, so every write starts from a newly generated model
+			sBenchmarkResult WriteBuffer = measure([&]() {
+				PModel pModel = m_pWrapper->CreateModel();
+				PWriter pWriter = pModel->QueryWriter(Format.m_sWriterClass);
+				nItems = Scenario.m_Generator(m_pWrapper, pModel, pWriter, Format.m_bBinaryStreams, nItemCount);
+				Buffer.clear();
+
+				fnResetPeakMemory();
+				CBenchmarkTimer Timer;
+				pWriter->WriteToBuffer(Buffer);
+				return Timer.elapsedSeconds();
+			});
+			report(Scenario, Format, "WriteToBuffer", nItems, Buffer.size(), WriteBuffer);
+
+			sBenchmarkResult WriteFile = measure([&]() {
+				PModel pModel = m_pWrapper->CreateModel();
+				PWriter pWriter = pModel->QueryWriter(Format.m_sWriterClass);
+				Scenario.m_Generator(m_pWrapper, pModel, pWriter, Format.m_bBinaryStreams, nItemCount);
+
+				fnResetPeakMemory();
+				CBenchmarkTimer Timer;
+				pWriter->WriteToFile(sFileName);
+				return Timer.elapsedSeconds();
+			});
+			report(Scenario, Format, "WriteToFile", nItems, Buffer.size(), WriteFile);
+
+			sBenchmarkResult ReadBuffer = measure([&]() {
+				PModel pModel = m_pWrapper->CreateModel();
+				PReader pReader = pModel->QueryReader(Format.m_sReaderClass);
+
+				fnResetPeakMemory();
+				CBenchmarkTimer Timer;
+				pReader->ReadFromBuffer(Buffer);
+				return Timer.elapsedSeconds();
+			});
+			report(Scenario, Format, "ReadFromBuffer", nItems, Buffer.size(), ReadBuffer);
+
+			// Release the buffer, so that it does not count towards the peak of reading the file
+			Lib3MF_uint64 nBytes = Buffer.size();
+			std::vector<Lib3MF_uint8>().swap(Buffer);
+
+			sBenchmarkResult ReadFile = measure([&]() {
+				PModel pModel = m_pWrapper->CreateModel();
+				PReader pReader = pModel->QueryReader(Format.m_sReaderClass);
+
+				fnResetPeakMemory();
+				CBenchmarkTimer Timer;
+				pReader->ReadFromFile(sFileName);
+				return Timer.elapsedSeconds();
+			});
+			report(Scenario, Format, "ReadFromFile", nItems, nBytes, ReadFile);
+
+			std::remove(sFileName.c_str());
+		}
+
+	public:
+		CBenchmarkRunner(PWrapper pWrapper, const sBenchmarkOptions & Options)
+			: m_pWrapper(pWrapper), m_Options(Options), m_nFailures(0)
+		{
+			if (!m_Options.m_sCSVFile.empty()) {
+				m_CSV.open(m_Options.m_sCSVFile);
+				m_CSV << "scenario,items,format,operation,seconds,bytes,mb_per_second,items_per_second,peak_memory" << std::endl;
+			}
+		}
+
+		Lib3MF_uint32 runAll()
+		{
+			std::vector<sBenchmarkFormat> Formats = {
+				{ "3mf", "3mf", "3mf", ".3mf", false },
+				{ "3mfz-binary", "3mfz", "3mfz", ".3mfz", true }
+			};
+
+			for (const sBenchmarkScenario & Scenario : fnGetBenchmarkScenarios()) {
+				if (Scenario.m_sName.find(m_Options.m_sFilter) == std::string::npos)
+					continue;
+
+				for (Lib3MF_uint64 nItemCount : Scenario.m_ItemCounts) {
+					if (nItemCount > m_Options.m_nMaxItems)
+						continue;
+
+					for (const sBenchmarkFormat & Format : Formats) {
+						if (Format.m_bBinaryStreams && !Scenario.m_bSupportsBinaryStreams)
+							continue;
+
+						try {
+							run(Scenario, Format, nItemCount);
+						}
+						catch (ELib3MFException & Exception) {
+							printf("%-12s %10llu %-12s FAILED: %s\n", Scenario.m_sName.c_str(), (unsigned long long)nItemCount, Format.m_sName.c_str(), Exception.what());
+							m_nFailures++;
+						}
+					}
+				}
+			}
+
+			return m_nFailures;
+		}
+	};
+}
+
+static void fnPrintUsage()
+{
+	printf("Usage: lib3mf_benchmarks [--filter <name>] [--max-items <count>] [--repetitions <count>]\n");
+	printf("                         [--output <directory>] [--csv <file>]\n");
+	printf("Scenarios: ");
+	for (const Lib3MF::sBenchmarkScenario & Scenario : Lib3MF::fnGetBenchmarkScenarios())
+		printf("%s ", Scenario.m_sName.c_str());
+	printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+	Lib3MF::sBenchmarkOptions Options;
+	Options.m_nMaxItems = 1000000;
+	Options.m_nRepetitions = 3;
+	Options.m_sOutputDirectory = ".";
+
+	for (int nIndex = 1; nIndex < argc; nIndex++) {
+		std::string sArgument = argv[nIndex];
+		if ((sArgument == "--help") || (nIndex + 1 >= argc)) {
+			fnPrintUsage();
+			return (sArgument == "--help") ? 0 : 1;
+		}
+
+		std::string sValue = argv[++nIndex];
+		if (sArgument == "--filter")
+			Options.m_sFilter = sValue;
+		else if (sArgument == "--max-items")
+			Options.m_nMaxItems = std::stoull(sValue);
+		else if (sArgument == "--repetitions")
+			Options.m_nRepetitions = std::max(1, std::stoi(sValue));
+		else if (sArgument == "--output")
+			Options.m_sOutputDirectory = sValue;
+		else if (sArgument == "--csv")
+			Options.m_sCSVFile = sValue;
+		else {
+			fnPrintUsage();
+			return 1;
+		}
+	}
+
+	try {
+		Lib3MF::PWrapper pWrapper = Lib3MF::CWrapper::loadLibrary();
+		Lib3MF_uint32 nMajor, nMinor, nMicro;
+		pWrapper->GetLibraryVersion(nMajor, nMinor, nMicro);
+		printf("lib3mf %u.%u.%u, %u repetitions, up to %llu items\n", nMajor, nMinor, nMicro, Options.m_nRepetitions, (unsigned long long)Options.m_nMaxItems);
+
+		Lib3MF::CBenchmarkRunner Runner(pWrapper, Options);
+		return (Runner.runAll() == 0) ? 0 : 1;
+	}
+	catch (Lib3MF::ELib3MFException & Exception) {
+		std::cout << Exception.what() << std::endl;
+		return 1;
+	}
+}
@@ -33,6 +33,8 @@ UnitTest_Model.cpp: Defines Unittests for the functionality to merge models
 #include "UnitTest_Utilities.h"
 #include "lib3mf_implicit.hpp"
 
+#include <cstring>
+
 namespace Lib3MF
 {
 	class MergeModels : public ::testing::Test {
@@ -51,6 +53,46 @@ namespace Lib3MF
 			wrapper = CWrapper::loadLibrary();
 		}
 		static PWrapper wrapper;
+
+		// Adds the build items nFirstItem to nFirstItem + nItemCount - 1. Every item has its own colored strip of
+		// nVertexCount vertices and a transformation that depends on the item index only.
+		static PModel CreateColoredStripModel(Lib3MF_uint32 nFirstItem, Lib3MF_uint32 nItemCount, Lib3MF_uint32 nVertexCount)
+		{
+			auto pModel = wrapper->CreateModel();
+			auto pColorGroup = pModel->AddColorGroup();
+			std::vector<Lib3MF_uint32> vctColors;
+			for (Lib3MF_uint32 nColor = 0; nColor < 256; nColor++)
+				vctColors.push_back(pColorGroup->AddColor(wrapper->RGBAToColor(Lib3MF_uint8(nColor), 0, Lib3MF_uint8(255 - nColor), 255)));
+
+			for (Lib3MF_uint32 nItem = nFirstItem; nItem < nFirstItem + nItemCount; nItem++) {
+				std::vector<sLib3MFPosition> vctVertices(nVertexCount);
+				std::vector<sLib3MFTriangle> vctTriangles(nVertexCount - 2);
+				std::vector<sTriangleProperties> vctProperties(nVertexCount - 2);
+				for (Lib3MF_uint32 i = 0; i < nVertexCount; i++) {
+					vctVertices[i] = fnCreateVertex(float(i % 100) + 0.1f * nItem, float((i / 100) % 100), float(i / 10000));
+					if (i + 2 < nVertexCount) {
+						vctTriangles[i] = fnCreateTriangle(i, i + 1, i + 2);
+						vctProperties[i].m_ResourceID = pColorGroup->GetResourceID();
+						for (int k = 0; k < 3; k++)
+							vctProperties[i].m_PropertyIDs[k] = vctColors[(i + k + nItem) % 256];
+					}
+				}
+
+				auto pMesh = pModel->AddMeshObject();
+				pMesh->SetGeometry(vctVertices, vctTriangles);
+				pMesh->SetAllTriangleProperties(vctProperties);
+
+				sTransform Transform = getIdentityTransform();
+				Transform.m_Fields[0][0] = 0.75f;
+				Transform.m_Fields[1][0] = 0.3f + 0.01f * nItem;
+				Transform.m_Fields[2][2] = 1.5f;
+				Transform.m_Fields[3][0] = 150.0f * nItem;
+				Transform.m_Fields[3][1] = -0.25f;
+				pModel->AddBuildItem(pMesh.get(), Transform);
+			}
+
+			return pModel;
+		}
 	};
 	PWrapper MergeModels::wrapper;
 
@@ -88,4 +130,118 @@ namespace Lib3MF
 		ExpectEqModels(m_pModel, pReadModel);
 	}
 
+	TEST_F(MergeModels, MergeKeepsTransformedGeometryAndProperties)
+	{
+		auto pModel = wrapper->CreateModel();
+		std::vector<sLib3MFPosition> vctVertices;
+		std::vector<sLib3MFTriangle> vctTriangles;
+		fnCreateBox(vctVertices, vctTriangles);
+		auto pMesh = pModel->AddMeshObject();
+		pMesh->SetGeometry(vctVertices, vctTriangles);
+
+		auto pColorGroup = pModel->AddColorGroup();
+		Lib3MF_uint32 nRed = pColorGroup->AddColor(wrapper->RGBAToColor(255, 0, 0, 255));
+		Lib3MF_uint32 nGreen = pColorGroup->AddColor(wrapper->RGBAToColor(0, 255, 0, 255));
+		std::vector<sTriangleProperties> properties(vctTriangles.size());
+		for (size_t i = 0; i < properties.size(); i++) {
+			properties[i].m_ResourceID = pColorGroup->GetResourceID();
+			for (int k = 0; k < 3; k++)
+				properties[i].m_PropertyIDs[k] = ((i + k) % 2) ? nRed : nGreen;
+		}
+		pMesh->SetAllTriangleProperties(properties);
+
+		sTransform translation = getIdentityTransform();
+		translation.m_Fields[3][0] = 10.0f;
+		pModel->AddBuildItem(pMesh.get(), getIdentityTransform());
+		pModel->AddBuildItem(pMesh.get(), translation);
+
+		auto pMergedModel = pModel->MergeToModel();
+		auto pMeshObjects = pMergedModel->GetMeshObjects();
+		ASSERT_EQ(pMeshObjects->Count(), 1);
+		ASSERT_TRUE(pMeshObjects->MoveNext());
+		auto pMergedMesh = pMeshObjects->GetCurrentMeshObject();
+
+		size_t nVertexCount = vctVertices.size();
+		size_t nTriangleCount = vctTriangles.size();
+		ASSERT_EQ(pMergedMesh->GetVertexCount(), 2 * nVertexCount);
+		ASSERT_EQ(pMergedMesh->GetTriangleCount(), 2 * nTriangleCount);
+
+		std::vector<sLib3MFPosition> vctMergedVertices;
+		pMergedMesh->GetVertices(vctMergedVertices);
+		for (size_t i = 0; i < nVertexCount; i++) {
+			EXPECT_EQ(vctMergedVertices[i].m_Coordinates[0], vctVertices[i].m_Coordinates[0]);
+			EXPECT_EQ(vctMergedVertices[nVertexCount + i].m_Coordinates[0], vctVertices[i].m_Coordinates[0] + 10.0f);
+			for (int k = 1; k < 3; k++)
+				EXPECT_EQ(vctMergedVertices[nVertexCount + i].m_Coordinates[k], vctVertices[i].m_Coordinates[k]);
+		}
+
+		std::vector<sLib3MFTriangle> vctMergedTriangles;
+		pMergedMesh->GetTriangleIndices(vctMergedTriangles);
+		std::vector<sTriangleProperties> mergedProperties;
+		pMergedMesh->GetAllTriangleProperties(mergedProperties);
+		for (size_t i = 0; i < nTriangleCount; i++) {
+			for (int k = 0; k < 3; k++) {
+				EXPECT_EQ(vctMergedTriangles[nTriangleCount + i].m_Indices[k], vctTriangles[i].m_Indices[k] + nVertexCount);
+				EXPECT_EQ(mergedProperties[i].m_PropertyIDs[k], properties[i].m_PropertyIDs[k]);
+				EXPECT_EQ(mergedProperties[nTriangleCount + i].m_PropertyIDs[k], properties[i].m_PropertyIDs[k]);
+			}
+			EXPECT_EQ(mergedProperties[nTriangleCount + i].m_ResourceID, mergedProperties[i].m_ResourceID);
+		}
+	}
+
+	TEST_F(MergeModels, ParallelMergeMatchesSerialMerge)
+	{
+		// Together the build items exceed the chunk size of the parallel merge, each of them alone does not.
+		// The parallel merge only runs on machines with more than one hardware thread.
+		const Lib3MF_uint32 nItemCount = 4;
+		const Lib3MF_uint32 nVertexCount = 50000;
+
+		auto pMergedModel = CreateColoredStripModel(0, nItemCount, nVertexCount)->MergeToModel();
+		auto pMergedMeshObjects = pMergedModel->GetMeshObjects();
+		ASSERT_EQ(pMergedMeshObjects->Count(), 1);
+		ASSERT_TRUE(pMergedMeshObjects->MoveNext());
+		auto pMergedMesh = pMergedMeshObjects->GetCurrentMeshObject();
+		ASSERT_EQ(pMergedMesh->GetVertexCount(), nItemCount * nVertexCount);
+		ASSERT_EQ(pMergedMesh->GetTriangleCount(), nItemCount * (nVertexCount - 2));
+
+		std::vector<sLib3MFPosition> vctMergedVertices;
+		std::vector<sLib3MFTriangle> vctMergedTriangles;
+		std::vector<sTriangleProperties> vctMergedProperties;
+		pMergedMesh->GetVertices(vctMergedVertices);
+		pMergedMesh->GetTriangleIndices(vctMergedTriangles);
+		pMergedMesh->GetAllTriangleProperties(vctMergedProperties);
+
+		Lib3MF_uint32 nVertexStart = 0;
+		Lib3MF_uint32 nTriangleStart = 0;
+		for (Lib3MF_uint32 nItem = 0; nItem < nItemCount; nItem++) {
+			auto pItemModel = CreateColoredStripModel(nItem, 1, nVertexCount)->MergeToModel();
+			auto pItemMeshObjects = pItemModel->GetMeshObjects();
+			ASSERT_TRUE(pItemMeshObjects->MoveNext());
+			auto pItemMesh = pItemMeshObjects->GetCurrentMeshObject();
+
+			std::vector<sLib3MFPosition> vctVertices;
+			std::vector<sLib3MFTriangle> vctTriangles;
+			std::vector<sTriangleProperties> vctProperties;
+			pItemMesh->GetVertices(vctVertices);
+			pItemMesh->GetTriangleIndices(vctTriangles);
+			pItemMesh->GetAllTriangleProperties(vctProperties);
+			ASSERT_EQ(vctVertices.size(), nVertexCount);
+			ASSERT_EQ(vctTriangles.size(), nVertexCount - 2);
+
+			EXPECT_EQ(memcmp(&vctMergedVertices[nVertexStart], vctVertices.data(), vctVertices.size() * sizeof(sLib3MFPosition)), 0) << "build item " << nItem;
+			for (size_t i = 0; i < vctTriangles.size(); i++) {
+				const sLib3MFTriangle & MergedTriangle = vctMergedTriangles[nTriangleStart + i];
+				const sTriangleProperties & MergedProperties = vctMergedProperties[nTriangleStart + i];
+				ASSERT_EQ(MergedProperties.m_ResourceID, vctProperties[i].m_ResourceID) << "build item " << nItem << ", triangle " << i;
+				for (int k = 0; k < 3; k++) {
+					ASSERT_EQ(MergedTriangle.m_Indices[k], vctTriangles[i].m_Indices[k] + nVertexStart) << "build item " << nItem << ", triangle " << i;
+					ASSERT_EQ(MergedProperties.m_PropertyIDs[k], vctProperties[i].m_PropertyIDs[k]) << "build item " << nItem << ", triangle " << i;
+				}
+			}
+
+			nVertexStart += nVertexCount;
+			nTriangleStart += nVertexCount - 2;
+		}
+	}
+
 }
@@ -33,6 +33,8 @@ UnitTest_MeshObject.cpp: Defines Unittests for the mesh object class
 #include "UnitTest_Utilities.h"
 #include "lib3mf_implicit.hpp"
 
+#include <cstring>
+
 namespace Lib3MF
 {
 	class MeshObject : public ::testing::Test {
@@ -188,7 +190,48 @@ namespace Lib3MF
 			for (int j = 0; j < 3; j++)
 				ASSERT_EQ(pTriangles[i].m_Indices[j], vctTriangles[i].m_Indices[j]);
 		}
-		
+
+	}
+
+	TEST_F(MeshObject, LargeGeometryOperations)
+	{
+		// Spans several blocks of the paged mesh storage
+		const Lib3MF_uint32 nVertexCount = 10000;
+		std::vector<sPosition> vctVertices(nVertexCount);
+		std::vector<sTriangle> vctTriangles(nVertexCount - 2);
+		for (Lib3MF_uint32 i = 0; i < nVertexCount; i++) {
+			vctVertices[i] = fnCreateVertex(float(i % 100), float(i / 100), float(i % 7));
+			if (i + 2 < nVertexCount)
+				vctTriangles[i] = fnCreateTriangle(i, i + 1, i + 2);
+		}
+		mesh->SetGeometry(vctVertices, vctTriangles);
+		ASSERT_EQ(mesh->GetVertexCount(), nVertexCount);
+		ASSERT_EQ(mesh->GetTriangleCount(), nVertexCount - 2);
+
+		std::vector<sPosition> vctPositions;
+		mesh->GetVertices(vctPositions);
+		ASSERT_EQ(vctPositions.size(), nVertexCount);
+		for (Lib3MF_uint32 i = 0; i < nVertexCount; i++) {
+			for (int j = 0; j < 3; j++)
+				ASSERT_EQ(vctVertices[i].m_Coordinates[j], vctPositions[i].m_Coordinates[j]);
+		}
+
+		std::vector<sTriangle> vctIndices;
+		mesh->GetTriangleIndices(vctIndices);
+		ASSERT_EQ(vctIndices.size(), nVertexCount - 2);
+		for (Lib3MF_uint32 i = 0; i < nVertexCount - 2; i++) {
+			for (int j = 0; j < 3; j++)
+				ASSERT_EQ(vctTriangles[i].m_Indices[j], vctIndices[i].m_Indices[j]);
+		}
+
+		// Invalid input is rejected as a whole
+		vctTriangles[5000] = fnCreateTriangle(0, 1, nVertexCount);
+		ASSERT_SPECIFIC_THROW(mesh->SetGeometry(vctVertices, vctTriangles), ELib3MFException);
+		vctTriangles[5000] = fnCreateTriangle(7, 8, 7);
+		ASSERT_SPECIFIC_THROW(mesh->SetGeometry(vctVertices, vctTriangles), ELib3MFException);
+		vctTriangles[5000] = fnCreateTriangle(7, 8, 9);
+		vctVertices[5000] = fnCreateVertex(0.0f, 1.0e30f, 0.0f);
+		ASSERT_SPECIFIC_THROW(mesh->SetGeometry(vctVertices, vctTriangles), ELib3MFException);
 	}
 
 	TEST_F(MeshObject, IsManifoldAndOriented)
@@ -198,6 +241,34 @@ namespace Lib3MF
 		ASSERT_TRUE(mesh->IsManifoldAndOriented());
 	}
 
+	TEST_F(MeshObject, IsManifoldAndOrientedDetectsDefects)
+	{
+		std::vector<sPosition> vctVertices(pVertices, pVertices + 8);
+		std::vector<sTriangle> vctTriangles(pTriangles, pTriangles + 12);
+
+		// A flipped triangle
+		std::swap(vctTriangles[3].m_Indices[0], vctTriangles[3].m_Indices[1]);
+		mesh->SetGeometry(vctVertices, vctTriangles);
+		ASSERT_FALSE(mesh->IsManifoldAndOriented());
+		std::swap(vctTriangles[3].m_Indices[0], vctTriangles[3].m_Indices[1]);
+
+		// A hole
+		sTriangle Removed = vctTriangles.back();
+		vctTriangles.pop_back();
+		mesh->SetGeometry(vctVertices, vctTriangles);
+		ASSERT_FALSE(mesh->IsManifoldAndOriented());
+
+		// A triangle on top of another one
+		vctTriangles.push_back(Removed);
+		vctTriangles.push_back(Removed);
+		mesh->SetGeometry(vctVertices, vctTriangles);
+		ASSERT_FALSE(mesh->IsManifoldAndOriented());
+
+		vctTriangles.pop_back();
+		mesh->SetGeometry(vctVertices, vctTriangles);
+		ASSERT_TRUE(mesh->IsManifoldAndOriented());
+	}
+
 	TEST_F(MeshObject, IsValid)
 	{
 		ASSERT_FALSE(mesh->IsValid());
@@ -216,7 +287,122 @@ namespace Lib3MF
 	{
 		auto beamLattice = mesh->BeamLattice();
 	}
-	
-}
 
+	TEST_F(MeshObject, AddMeshObjectCopy)
+	{
+		std::vector<sPosition> vctVertices(pVertices, pVertices + 8);
+		std::vector<sTriangle> vctTriangles(pTriangles, pTriangles + 12);
+		mesh->SetGeometry(vctVertices, vctTriangles);
+		mesh->SetName("Box");
+
+		auto baseMaterial = model->AddBaseMaterialGroup();
+		Lib3MF_uint32 nMaterialID = baseMaterial->AddMaterial("Red", wrapper->RGBAToColor(255, 0, 0, 255));
+		sTriangleProperties sProperties;
+		sProperties.m_ResourceID = baseMaterial->GetResourceID();
+		for (int j = 0; j < 3; j++)
+			sProperties.m_PropertyIDs[j] = nMaterialID;
+		mesh->SetTriangleProperties(0, sProperties);
+
+		auto copy = model->AddMeshObjectCopy(mesh.get());
+		ASSERT_NE(copy->GetResourceID(), mesh->GetResourceID());
+		ASSERT_EQ(copy->GetName(), "Box");
+		ASSERT_EQ(copy->GetVertexCount(), 8);
+		ASSERT_EQ(copy->GetTriangleCount(), 12);
+		sTriangleProperties sCopiedProperties;
+		copy->GetTriangleProperties(0, sCopiedProperties);
+		ASSERT_EQ(sCopiedProperties.m_ResourceID, sProperties.m_ResourceID);
+
+		// Changes to either object do not show in the other one
+		sPosition vMoved = fnCreateVertex(1.0f, 2.0f, 3.0f);
+		copy->SetVertex(0, vMoved);
+		ASSERT_EQ(mesh->GetVertex(0).m_Coordinates[0], 0.0f);
+		mesh->SetTriangle(0, fnCreateTriangle(0, 1, 2));
+		ASSERT_EQ(copy->GetTriangle(0).m_Indices[0], 2);
+		copy->SetTriangleProperties(1, sProperties);
+		sTriangleProperties sOriginalProperties;
+		mesh->GetTriangleProperties(1, sOriginalProperties);
+		ASSERT_EQ(sOriginalProperties.m_ResourceID, 0);
+
+		// Triangle properties refer to resources of the source model, and are not copied into another one
+		auto otherModel = wrapper->CreateModel();
+		auto otherCopy = otherModel->AddMeshObjectCopy(mesh.get());
+		ASSERT_EQ(otherCopy->GetVertexCount(), 8);
+		ASSERT_EQ(otherCopy->GetVertex(0).m_Coordinates[0], 0.0f);
+		otherCopy->GetTriangleProperties(0, sCopiedProperties);
+		ASSERT_EQ(sCopiedProperties.m_ResourceID, 0);
+	}
+
+	TEST_F(MeshObject, QuantizedStorage)
+	{
+		mesh->SetGeometry(CLib3MFInputVector<sPosition>(pVertices, 8), CLib3MFInputVector<sTriangle>(pTriangles, 12));
+		ASSERT_FALSE(mesh->GetQuantizedStorageActive());
 
+		// The box spans 30000 units of 0.01 along z, which fits into 16 bits
+		sPosition vOrigin = fnCreateVertex(0.0f, 0.0f, 0.0f);
+		mesh->SetQuantizedStorageActive(true, vOrigin, 0.01, 16);
+		ASSERT_TRUE(mesh->GetQuantizedStorageActive());
+		ASSERT_EQ(mesh->GetVertexCount(), 8);
+		ASSERT_EQ(mesh->GetTriangleCount(), 12);
+		for (Lib3MF_uint32 i = 0; i < 8; i++) {
+			sPosition vPosition = mesh->GetVertex(i);
+			for (int j = 0; j < 3; j++)
+				ASSERT_NEAR(vPosition.m_Coordinates[j], pVertices[i].m_Coordinates[j], 0.005);
+		}
+		ASSERT_TRUE(mesh->IsManifoldAndOriented());
+
+		// New vertices are rounded as well, and have to fit
+		Lib3MF_uint32 nIndex = mesh->AddVertex(fnCreateVertex(1.004f, 2.0f, 3.0f));
+		ASSERT_NEAR(mesh->GetVertex(nIndex).m_Coordinates[0], 1.0f, 1.0e-5);
+		ASSERT_SPECIFIC_THROW(mesh->AddVertex(fnCreateVertex(1000.0f, 0.0f, 0.0f)), ELib3MFException);
+		ASSERT_EQ(mesh->GetVertexCount(), 9);
+
+		// A quantization the mesh does not fit into leaves it as it is
+		ASSERT_SPECIFIC_THROW(mesh->SetQuantizedStorageActive(true, vOrigin, 0.001, 16), ELib3MFException);
+		ASSERT_SPECIFIC_THROW(mesh->SetQuantizedStorageActive(true, vOrigin, 0.0, 32), ELib3MFException);
+		ASSERT_SPECIFIC_THROW(mesh->SetQuantizedStorageActive(true, vOrigin, 0.01, 8), ELib3MFException);
+		ASSERT_TRUE(mesh->GetQuantizedStorageActive());
+		ASSERT_NEAR(mesh->GetVertex(6).m_Coordinates[2], 300.0f, 0.005);
+
+		mesh->SetQuantizedStorageActive(false, vOrigin, 0.0, 0);
+		ASSERT_FALSE(mesh->GetQuantizedStorageActive());
+		ASSERT_EQ(mesh->GetVertexCount(), 9);
+		ASSERT_NEAR(mesh->GetVertex(6).m_Coordinates[1], 200.0f, 0.005);
+	}
+
+	TEST_F(MeshObject, QuantizedStorageWritesBinaryStreams)
+	{
+		// Coordinates which are no multiples of the units, so that rounding them again on writing would change them
+		const Lib3MF_uint32 nVertexCount = 1000;
+		std::vector<sPosition> vctVertices(nVertexCount);
+		std::vector<sTriangle> vctTriangles(nVertexCount - 2);
+		for (Lib3MF_uint32 i = 0; i < nVertexCount; i++) {
+			vctVertices[i] = fnCreateVertex(0.3713f * i, 17.0f - 0.0271f * i, 5.0f + 0.00913f * (i % 37));
+			if (i + 2 < nVertexCount)
+				vctTriangles[i] = fnCreateTriangle(i, i + 1, i + 2);
+		}
+		mesh->SetGeometry(vctVertices, vctTriangles);
+		mesh->SetQuantizedStorageActive(true, fnCreateVertex(-1.25f, 2.5f, 10.125f), 0.0005, 32);
+		std::vector<sPosition> vctQuantizedVertices;
+		mesh->GetVertices(vctQuantizedVertices);
+
+		model->AddBuildItem(mesh.get(), getIdentityTransform());
+		auto writer = model->QueryWriter("3mfz");
+		auto binaryStream = writer->CreateBinaryStream("Binary/quantizedmesh.dat");
+		writer->AssignBinaryStream(mesh.get(), binaryStream.get());
+		writer->WriteToFile(sOutFilesPath + "/Writer/quantizedmesh.3mf");
+
+		auto readModel = wrapper->CreateModel();
+		auto reader = readModel->QueryReader("3mfz");
+		reader->ReadFromFile(sOutFilesPath + "/Writer/quantizedmesh.3mf");
+		CheckReaderWarnings(reader, 0);
+
+		auto meshObjects = readModel->GetMeshObjects();
+		ASSERT_TRUE(meshObjects->MoveNext());
+		std::vector<sPosition> vctReadVertices;
+		meshObjects->GetCurrentMeshObject()->GetVertices(vctReadVertices);
+		ASSERT_EQ(vctReadVertices.size(), vctQuantizedVertices.size());
+		for (size_t i = 0; i < vctReadVertices.size(); i++)
+			ASSERT_EQ(memcmp(vctReadVertices[i].m_Coordinates, vctQuantizedVertices[i].m_Coordinates, sizeof(vctReadVertices[i].m_Coordinates)), 0);
+	}
+
+}
@@ -0,0 +1,182 @@
+/*++
+
+Copyright (C) 2019 3MF Consortium
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Abstract:
+
+UnitTest_NumberParser.cpp: Defines Unittests for the parsing of numeric attributes
+while reading 3MF files. The results are compared against the C runtime in the "C" locale.
+
+--*/
+
+#include "UnitTest_Utilities.h"
+#include "lib3mf_implicit.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+
+namespace Lib3MF
+{
+	class NumberParser : public ::testing::Test {
+	protected:
+		virtual void SetUp() {
+			model = wrapper->CreateModel();
+		}
+		virtual void TearDown() {
+			model.reset();
+		}
+
+		// The test files contain one mesh object per literal, named after the literal
+		void ReadTestFile(const std::string & sFileName)
+		{
+			model->QueryReader("3mf")->ReadFromFile(sTestFilesPath + "/NumberParser/" + sFileName);
+		}
+
+		// Iterates the mesh objects in order and checks that their names match the literals
+		void ForEachLiteral(const char * Literals[], const std::function<void(const char *, PMeshObject)> & fnCheck)
+		{
+			auto meshObjects = model->GetMeshObjects();
+			int nIndex = 0;
+			while (meshObjects->MoveNext()) {
+				ASSERT_NE(Literals[nIndex], nullptr);
+				auto meshObject = meshObjects->GetCurrentMeshObject();
+				ASSERT_EQ(meshObject->GetName(), Literals[nIndex]);
+				fnCheck(Literals[nIndex], meshObject);
+				nIndex++;
+			}
+			ASSERT_EQ(Literals[nIndex], nullptr);
+		}
+
+		PModel model;
+
+		static void SetUpTestCase() {
+			wrapper = CWrapper::loadLibrary();
+		}
+		static PWrapper wrapper;
+	};
+	PWrapper NumberParser::wrapper;
+
+	TEST_F(NumberParser, CoordinatesMatchStrtof)
+	{
+		const char * Literals[] = {
+			// signed zeros
+			"0", "-0", "+0", "0.0e0", "-0.000e-7",
+			// subnormals and the smallest normal number
+			"1.401298464324817e-45", "-1.401298464324817e-45", "1.1754942e-38", "1.17549435e-38",
+			// half of the smallest subnormal rounds to zero, anything above it does not
+			"7.006492321624085e-46", "7.006492321624086e-46",
+			// underflow and huge negative exponents
+			"1e-50", "-1e-50", "1e-99999999999", "0e999999999",
+			// halfway cases round to even
+			"1.000000059604644775390625", "1.000000178813934326171875", "1.0000000596046447753906251",
+			"16777217", "16777217.000000000000000000001", "-16777219",
+			// more than 19 significant digits
+			"3.14159265358979323846264338327950288", "123456789.012345678901234567890",
+			"0.000000000000000000000000000000000000000000001401298464324817070923729583289916131280",
+			"0.0000000000000000000000000000000000000000000000000000000000001e61",
+			"000000000000000000000000000000000000001",
+			// notation variants
+			"1E5", "1e+05", ".5", "5.", "00000.5e1", "  2.5", "1e9", "-1e9",
+			nullptr
+		};
+
+		ReadTestFile("Coordinates.3mf");
+		ForEachLiteral(Literals, [](const char * pLiteral, PMeshObject meshObject) {
+			float fExpected = strtof(pLiteral, nullptr);
+			sLib3MFPosition Position = meshObject->GetVertex(0);
+			for (int nCoordinate = 0; nCoordinate < 3; nCoordinate++)
+				EXPECT_EQ(memcmp(&Position.m_Coordinates[nCoordinate], &fExpected, sizeof(float)), 0)
+					<< pLiteral << ": " << Position.m_Coordinates[nCoordinate] << " != " << fExpected;
+		});
+	}
+
+	TEST_F(NumberParser, DoublesMatchStrtod)
+	{
+		const char * Literals[] = {
+			// subnormals and the smallest normal number
+			"4.9406564584124654e-324", "2.4703282292062328e-324", "2.2250738585072011e-308", "2.2250738585072012e-308",
+			// halfway cases round to even
+			"1.00000000000000011102230246251565404236316680908203125", "1.00000000000000011102230246251565404236316680908203126",
+			"1.00000000000000033306690738754696212708950042724609375", "999999999.99999994039535522460937500",
+			// more than 19 significant digits
+			"0.1000000000000000055511151231257827021181583404541015625", "2.718281828459045235360287471352662497757",
+			"0.000000000000000000000000000000000000000000000000000000000000000000000000000000000000001e80",
+			// notation variants
+			"0.1", "1E-3", "1e+2", ".25", "7.", "  3.5", "1e9",
+			nullptr
+		};
+
+		ReadTestFile("MinLengths.3mf");
+		ForEachLiteral(Literals, [](const char * pLiteral, PMeshObject meshObject) {
+			double dExpected = strtod(pLiteral, nullptr);
+			double dMinLength = meshObject->BeamLattice()->GetMinLength();
+			EXPECT_EQ(memcmp(&dMinLength, &dExpected, sizeof(double)), 0)
+				<< pLiteral << ": " << dMinLength << " != " << dExpected;
+		});
+	}
+
+	TEST_F(NumberParser, IndicesMatchStrtoll)
+	{
+		const char * Literals[] = { "2", "+2", "0002", "000000000000000000000000002", "  2", nullptr };
+
+		ReadTestFile("Indices.3mf");
+		ForEachLiteral(Literals, [](const char * pLiteral, PMeshObject meshObject) {
+			ASSERT_EQ(strtoll(pLiteral, nullptr, 10), 2);
+			EXPECT_EQ(meshObject->GetTriangle(0).m_Indices[2], 2u) << pLiteral;
+		});
+	}
+
+	class NumberParser_InvalidLiteral : public NumberParser, public ::testing::WithParamInterface<const char *> {
+	};
+
+	TEST_P(NumberParser_InvalidLiteral, IsRejected)
+	{
+		EXPECT_THROW(ReadTestFile(GetParam()), ELib3MFException);
+	}
+
+	// Exponent overflow yields infinity, which is no valid coordinate; neither are NaN and values above 1e9:
+	// "1e39", "-3.4028236e38", "3.4028234e38", "1e99999999999", "1.0000001e9", "inf", "-infinity", "nan"
+	INSTANTIATE_TEST_SUITE_P(Coordinates, NumberParser_InvalidLiteral,
+		::testing::Values("InvalidCoordinate1.3mf", "InvalidCoordinate2.3mf", "InvalidCoordinate3.3mf", "InvalidCoordinate4.3mf",
+			"InvalidCoordinate5.3mf", "InvalidCoordinate6.3mf", "InvalidCoordinate7.3mf", "InvalidCoordinate8.3mf"));
+
+	// Malformed minimal lengths; 3MF numbers have no hexadecimal notation, so "0x10" is rejected although strtod accepts it:
+	// "", "abc", "1.5x", "--1", "1e+", ".", "1..2", "1,5", "0x10",
+	// exponent overflow, underflow to zero, negative values and values above 1e9:
+	// "1e400", "2.4703282292062327e-324", "-1", "-0", "9007199254740993"
+	INSTANTIATE_TEST_SUITE_P(MinLengths, NumberParser_InvalidLiteral,
+		::testing::Values("InvalidMinLength1.3mf", "InvalidMinLength2.3mf", "InvalidMinLength3.3mf", "InvalidMinLength4.3mf",
+			"InvalidMinLength5.3mf", "InvalidMinLength6.3mf", "InvalidMinLength7.3mf", "InvalidMinLength8.3mf",
+			"InvalidMinLength9.3mf", "InvalidMinLength10.3mf", "InvalidMinLength11.3mf", "InvalidMinLength12.3mf",
+			"InvalidMinLength13.3mf", "InvalidMinLength14.3mf"));
+
+	// Malformed and out of range indices:
+	// "", "-", "2.0", "2x", "4294967298", "99999999999999999999"
+	INSTANTIATE_TEST_SUITE_P(Indices, NumberParser_InvalidLiteral,
+		::testing::Values("InvalidIndex1.3mf", "InvalidIndex2.3mf", "InvalidIndex3.3mf", "InvalidIndex4.3mf",
+			"InvalidIndex5.3mf", "InvalidIndex6.3mf"));
+
+}
@@ -33,6 +33,8 @@ UnitTest_Object.cpp: Defines Unittests for the object class and its descendants
 #include "UnitTest_Utilities.h"
 #include "lib3mf_implicit.hpp"
 
+#include <cmath>
+
 namespace Lib3MF
 {
 	class Outbox : public ::testing::Test {
@@ -152,6 +154,90 @@ namespace Lib3MF
 
 		CompareBoxes(sOutbox, sExpectedOutbox);
 	}
-}
 
+	TEST_F(Outbox, CheckRepeatedQueriesAfterVertexChange)
+	{
+		Lib3MF::sBox sOutbox = model->GetOutbox();
+		// Later queries use the cached bounds of the meshes
+		CompareBoxes(model->GetOutbox(), sOutbox);
+		CompareBoxes(model->GetOutbox(), sOutbox);
+
+		auto meshes = model->GetMeshObjects();
+		meshes->MoveNext();
+		auto mesh = meshes->GetCurrentMeshObject();
+		Lib3MF::sPosition sVertex = mesh->GetVertex(0);
+		Lib3MF::sPosition sMovedVertex = sVertex;
+		sMovedVertex.m_Coordinates[0] = 1000.0f;
+		mesh->SetVertex(0, sMovedVertex);
+
+		EXPECT_FLOAT_EQ(mesh->GetOutbox().m_MaxCoordinate[0], 1000.0f);
 
+		Lib3MF::sBox sExpectedOutbox;
+		sExpectedOutbox.m_MinCoordinate[0] = 1.25774193f;
+		sExpectedOutbox.m_MinCoordinate[1] = -308.181976f;
+		sExpectedOutbox.m_MinCoordinate[2] = -39.4011765f;
+		sExpectedOutbox.m_MaxCoordinate[0] = 871.601013f;
+		sExpectedOutbox.m_MaxCoordinate[1] = 671.528748f;
+		sExpectedOutbox.m_MaxCoordinate[2] = 279.938263f;
+		CompareBoxes(model->GetOutbox(), sExpectedOutbox);
+		CompareBoxes(model->GetOutbox(), sExpectedOutbox);
+
+		mesh->SetVertex(0, sVertex);
+		CompareBoxes(model->GetOutbox(), sOutbox);
+	}
+
+	TEST_F(Outbox, CheckRepeatedQueriesOfSmallMeshFarFromOrigin)
+	{
+		// A tiny point cloud far from the origin, whose single precision
+		// rounding exceeds a fixed margin of the cached hull
+		auto pModel = wrapper->CreateModel();
+		Lib3MF_uint32 nSeed = 1;
+		auto fnRandom = [&nSeed]() {
+			nSeed = nSeed * 1103515245u + 12345u;
+			return float((nSeed >> 8) & 0xFFFF) / 32767.5f - 1.0f;
+		};
+		std::vector<sLib3MFPosition> vctVertices;
+		while (vctVertices.size() < 20000) {
+			float fX = fnRandom(), fY = fnRandom(), fZ = fnRandom();
+			if (fX * fX + fY * fY + fZ * fZ > 1.0f)
+				continue;
+			vctVertices.push_back(fnCreateVertex(1000.0f + 0.001f * fX, -1000.0f + 0.001f * fY, 500.0f + 0.001f * fZ));
+		}
+		std::vector<sLib3MFTriangle> vctTriangles;
+		for (Lib3MF_uint32 i = 0; i + 2 < vctVertices.size(); i++)
+			vctTriangles.push_back(fnCreateTriangle(i, i + 1, i + 2));
+		auto pMesh = pModel->AddMeshObject();
+		pMesh->SetGeometry(vctVertices, vctTriangles);
+
+		// Rotation about (1, 2, 3) / sqrt(14)
+		float fAxis[3] = { 1.0f / sqrtf(14.0f), 2.0f / sqrtf(14.0f), 3.0f / sqrtf(14.0f) };
+		float fCos = cosf(1.9f), fSin = sinf(1.9f);
+		sTransform Transform = getIdentityTransform();
+		for (int i = 0; i < 3; i++) {
+			for (int j = 0; j < 3; j++) {
+				float fValue = (1.0f - fCos) * fAxis[i] * fAxis[j];
+				if (i == j)
+					fValue += fCos;
+				else if ((j - i + 3) % 3 == 1)
+					fValue -= fSin * fAxis[3 - i - j];
+				else
+					fValue += fSin * fAxis[3 - i - j];
+				Transform.m_Fields[j][i] = fValue;
+			}
+		}
+		Transform.m_Fields[3][0] = 300.0f;
+		Transform.m_Fields[3][1] = -7.25f;
+		Transform.m_Fields[3][2] = 11.0f;
+		auto pBuildItem = pModel->AddBuildItem(pMesh.get(), Transform);
+
+		// The first query scans all vertices, later ones use the cached hull
+		Lib3MF::sBox sOutbox = pBuildItem->GetOutbox();
+		for (int nQuery = 0; nQuery < 3; nQuery++) {
+			Lib3MF::sBox sCachedOutbox = pBuildItem->GetOutbox();
+			for (int i = 0; i < 3; i++) {
+				EXPECT_EQ(sCachedOutbox.m_MinCoordinate[i], sOutbox.m_MinCoordinate[i]);
+				EXPECT_EQ(sCachedOutbox.m_MaxCoordinate[i], sOutbox.m_MaxCoordinate[i]);
+			}
+		}
+	}
+}
@@ -33,8 +33,94 @@ UnitTest_Reader.cpp: Defines Unittests for the Reader classes
 #include "UnitTest_Utilities.h"
 #include "lib3mf_implicit.hpp"
 
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
 namespace Lib3MF
 {
+	// Bytes of the heap in use, or 0 where this can not be determined
+	static Lib3MF_uint64 GetHeapSizeInUse()
+	{
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+		struct mallinfo2 Info = mallinfo2();
+		return Info.uordblks + Info.hblkhd;
+#else
+		return 0;
+#endif
+	}
+
+	// A strip of nVertexCount - 2 triangles on a 100 x 100 grid of layers
+	static void CreateStripGeometry(Lib3MF_uint32 nVertexCount, std::vector<sLib3MFPosition> & vctVertices, std::vector<sLib3MFTriangle> & vctTriangles)
+	{
+		vctVertices.resize(nVertexCount);
+		vctTriangles.resize(nVertexCount - 2);
+		for (Lib3MF_uint32 i = 0; i < nVertexCount; i++) {
+			vctVertices[i] = fnCreateVertex(float(i % 100), float((i / 100) % 100), float(i / 10000));
+			if (i + 2 < nVertexCount)
+				vctTriangles[i] = fnCreateTriangle(i, i + 1, i + 2);
+		}
+	}
+
+	// A binary STL whose facets share vertices, some exactly and some only up to a small jitter
+	// around the default welding unit of 0.001. Positions receives the vertices of all facets.
+	static void CreateWeldingSTL(Lib3MF_uint32 nFacetCount, std::vector<Lib3MF_uint8> & Buffer, std::vector<sLib3MFPosition> & Positions)
+	{
+		auto fnAppendUint32 = [&Buffer](Lib3MF_uint32 nValue) {
+			for (int i = 0; i < 4; i++)
+				Buffer.push_back(Lib3MF_uint8(nValue >> (8 * i)));
+		};
+		auto fnAppendFloat = [&fnAppendUint32](float fValue) {
+			Lib3MF_uint32 nValue;
+			memcpy(&nValue, &fValue, sizeof(nValue));
+			fnAppendUint32(nValue);
+		};
+
+		Buffer.assign(80, 0);
+		fnAppendUint32(nFacetCount);
+		Positions.clear();
+
+		const float fJitter[4] = { 0.0f, 0.0002f, -0.0004f, 0.0011f };
+		Lib3MF_uint32 nSeed = 1;
+		for (Lib3MF_uint32 nFacet = 0; nFacet < nFacetCount; nFacet++) {
+			for (int i = 0; i < 3; i++)
+				fnAppendFloat(0.0f);
+			for (int j = 0; j < 3; j++) {
+				nSeed = nSeed * 1103515245u + 12345u;
+				Lib3MF_uint32 nPoint = (nSeed >> 8) % (nFacetCount / 4);
+				float fOffset = fJitter[(nSeed >> 28) & 3];
+				sLib3MFPosition Position = fnCreateVertex(float(nPoint % 50) * 0.01f - 0.25f + fOffset,
+					float((nPoint / 50) % 50) * 0.01f + fOffset, float(nPoint / 2500) * -0.01f);
+				for (int k = 0; k < 3; k++)
+					fnAppendFloat(Position.m_Coordinates[k]);
+				Positions.push_back(Position);
+			}
+			Buffer.push_back(0);
+			Buffer.push_back(0);
+		}
+	}
+
+	// Welds the positions with the ordered map of grid cells the STL importer used to use
+	static void WeldWithMap(const std::vector<sLib3MFPosition> & Positions, std::vector<sLib3MFPosition> & WeldedVertices)
+	{
+		std::map<std::array<Lib3MF_int32, 3>, Lib3MF_uint32> Cells;
+		WeldedVertices.clear();
+		for (auto Position : Positions) {
+			std::array<Lib3MF_int32, 3> Cell;
+			for (int k = 0; k < 3; k++)
+				Cell[k] = Lib3MF_int32(floor(Position.m_Coordinates[k] / 0.001f));
+			if (Cells.insert(std::make_pair(Cell, Lib3MF_uint32(WeldedVertices.size()))).second)
+				WeldedVertices.push_back(Position);
+		}
+	}
+
 	class Reader : public ::testing::Test {
 	protected:
 		virtual void SetUp() {
@@ -55,6 +141,82 @@ namespace Lib3MF
 		PReader readerSTL;
 		PReader reader3MFz;
 
+		// Reads an STL of nFacetCount facets and compares its vertices with those welded by WeldWithMap
+		void CheckWeldedSTL(Lib3MF_uint32 nFacetCount)
+		{
+			std::vector<Lib3MF_uint8> Buffer;
+			std::vector<sLib3MFPosition> Positions;
+			CreateWeldingSTL(nFacetCount, Buffer, Positions);
+			readerSTL->ReadFromBuffer(Buffer);
+			CheckReaderWarnings(readerSTL, 0);
+
+			std::vector<sLib3MFPosition> ExpectedVertices;
+			WeldWithMap(Positions, ExpectedVertices);
+			ASSERT_LT(ExpectedVertices.size(), Positions.size() / 2);
+
+			auto meshObjects = model->GetMeshObjects();
+			ASSERT_EQ(meshObjects->Count(), 1);
+			ASSERT_TRUE(meshObjects->MoveNext());
+			std::vector<sLib3MFPosition> Vertices;
+			meshObjects->GetCurrentMeshObject()->GetVertices(Vertices);
+			ASSERT_EQ(Vertices.size(), ExpectedVertices.size());
+			for (size_t i = 0; i < Vertices.size(); i++)
+				for (int k = 0; k < 3; k++)
+					ASSERT_EQ(Vertices[i].m_Coordinates[k], ExpectedVertices[i].m_Coordinates[k]);
+		}
+
+		// Reads with parallel mesh parsing off and on into new models. Both have to end up with the
+		// same meshes, warnings and errors.
+		void CheckParallelMeshParsing(const std::function<void(PReader)> & fnRead)
+		{
+			PModel models[2];
+			PReader readers[2];
+			std::string sErrors[2];
+			for (int i = 0; i < 2; i++) {
+				models[i] = wrapper->CreateModel();
+				readers[i] = models[i]->QueryReader("3mf");
+				readers[i]->SetParallelMeshParsingActive(i == 1);
+				try {
+					fnRead(readers[i]);
+				}
+				catch (ELib3MFException & e) {
+					sErrors[i] = std::to_string(e.getErrorCode()) + ": " + e.what();
+				}
+			}
+			EXPECT_EQ(sErrors[0], sErrors[1]);
+
+			ASSERT_EQ(readers[0]->GetWarningCount(), readers[1]->GetWarningCount());
+			for (Lib3MF_uint32 iWarning = 0; iWarning < readers[0]->GetWarningCount(); iWarning++) {
+				Lib3MF_uint32 nErrorCodes[2];
+				EXPECT_EQ(readers[0]->GetWarning(iWarning, nErrorCodes[0]), readers[1]->GetWarning(iWarning, nErrorCodes[1]));
+				EXPECT_EQ(nErrorCodes[0], nErrorCodes[1]);
+			}
+
+			auto meshObjects = models[0]->GetMeshObjects();
+			auto parallelMeshObjects = models[1]->GetMeshObjects();
+			ASSERT_EQ(meshObjects->Count(), parallelMeshObjects->Count());
+			while (meshObjects->MoveNext() && parallelMeshObjects->MoveNext()) {
+				auto mesh = meshObjects->GetCurrentMeshObject();
+				auto parallelMesh = parallelMeshObjects->GetCurrentMeshObject();
+
+				std::vector<sLib3MFPosition> vertices, parallelVertices;
+				mesh->GetVertices(vertices);
+				parallelMesh->GetVertices(parallelVertices);
+				ASSERT_EQ(vertices.size(), parallelVertices.size());
+				for (size_t i = 0; i < vertices.size(); i++)
+					for (int j = 0; j < 3; j++)
+						ASSERT_EQ(vertices[i].m_Coordinates[j], parallelVertices[i].m_Coordinates[j]);
+
+				std::vector<sLib3MFTriangle> triangles, parallelTriangles;
+				mesh->GetTriangleIndices(triangles);
+				parallelMesh->GetTriangleIndices(parallelTriangles);
+				ASSERT_EQ(triangles.size(), parallelTriangles.size());
+				for (size_t i = 0; i < triangles.size(); i++)
+					for (int j = 0; j < 3; j++)
+						ASSERT_EQ(triangles[i].m_Indices[j], parallelTriangles[i].m_Indices[j]);
+			}
+		}
+
 		static void SetUpTestCase() {
 			wrapper = CWrapper::loadLibrary();
 		}
@@ -68,6 +230,42 @@ namespace Lib3MF
 		CheckReaderWarnings(Reader::reader3MF, 0);
 	}
 
+	TEST_F(Reader, 3MFReadFromMappedFile)
+	{
+		// ReadFromFile maps the package and opens the ZIP archive on the mapped bytes
+		Reader::reader3MF->ReadFromFile(sTestFilesPath + "/Reader/" + "Pyramid.3mf");
+		CheckReaderWarnings(Reader::reader3MF, 0);
+
+		auto bufferModel = wrapper->CreateModel();
+		auto bufferReader = bufferModel->QueryReader("3mf");
+		bufferReader->ReadFromBuffer(ReadFileIntoBuffer(sTestFilesPath + "/Reader/" + "Pyramid.3mf"));
+		CheckReaderWarnings(bufferReader, 0);
+
+		auto meshObjects = Reader::model->GetMeshObjects();
+		auto bufferMeshObjects = bufferModel->GetMeshObjects();
+		ASSERT_EQ(meshObjects->Count(), bufferMeshObjects->Count());
+		while (meshObjects->MoveNext() && bufferMeshObjects->MoveNext()) {
+			auto mesh = meshObjects->GetCurrentMeshObject();
+			auto bufferMesh = bufferMeshObjects->GetCurrentMeshObject();
+
+			std::vector<sLib3MFPosition> vertices, bufferVertices;
+			mesh->GetVertices(vertices);
+			bufferMesh->GetVertices(bufferVertices);
+			ASSERT_EQ(vertices.size(), bufferVertices.size());
+			for (size_t i = 0; i < vertices.size(); i++)
+				for (int j = 0; j < 3; j++)
+					ASSERT_EQ(vertices[i].m_Coordinates[j], bufferVertices[i].m_Coordinates[j]);
+
+			std::vector<sLib3MFTriangle> triangles, bufferTriangles;
+			mesh->GetTriangleIndices(triangles);
+			bufferMesh->GetTriangleIndices(bufferTriangles);
+			ASSERT_EQ(triangles.size(), bufferTriangles.size());
+			for (size_t i = 0; i < triangles.size(); i++)
+				for (int j = 0; j < 3; j++)
+					ASSERT_EQ(triangles[i].m_Indices[j], bufferTriangles[i].m_Indices[j]);
+		}
+	}
+
 	TEST_F(Reader, STLReadFromFile)
 	{
 		Reader::readerSTL->ReadFromFile(sTestFilesPath + "/Reader/" + "Pyramid.stl");
@@ -100,6 +298,17 @@ namespace Lib3MF
 		CheckReaderWarnings(Reader::readerSTL, 0);
 	}
 
+	TEST_F(Reader, STLWeldNearDuplicateVertices)
+	{
+		CheckWeldedSTL(1000);
+	}
+
+	TEST_F(Reader, STLWeldNearDuplicateVerticesOfLargeFile)
+	{
+		// Large enough to be welded by sorting in parallel on several cores
+		CheckWeldedSTL(200000);
+	}
+
 	TEST_F(Reader, 3MFReadFromCallback)
 	{
 		PositionedVector<Lib3MF_uint8> bufferCallback;
@@ -129,4 +338,213 @@ namespace Lib3MF
 		writer->WriteToFile(sOutFilesPath + "/Writer/binarypart_decoded.3mf");
 	}
 
+	TEST_F(Reader, 3MFReadWithFileBackedMeshStorage)
+	{
+		ASSERT_FALSE(Reader::reader3MF->GetFileBackedMeshStorageActive());
+		Reader::reader3MF->SetFileBackedMeshStorageActive(true, "");
+		ASSERT_TRUE(Reader::reader3MF->GetFileBackedMeshStorageActive());
+		Reader::reader3MF->ReadFromFile(sTestFilesPath + "/Reader/" + "Pyramid.3mf");
+		CheckReaderWarnings(Reader::reader3MF, 0);
+
+		auto inMemoryModel = wrapper->CreateModel();
+		auto inMemoryReader = inMemoryModel->QueryReader("3mf");
+		inMemoryReader->ReadFromFile(sTestFilesPath + "/Reader/" + "Pyramid.3mf");
+
+		auto meshObjects = Reader::model->GetMeshObjects();
+		auto inMemoryMeshObjects = inMemoryModel->GetMeshObjects();
+		ASSERT_EQ(meshObjects->Count(), inMemoryMeshObjects->Count());
+		while (meshObjects->MoveNext() && inMemoryMeshObjects->MoveNext()) {
+			auto mesh = meshObjects->GetCurrentMeshObject();
+			auto inMemoryMesh = inMemoryMeshObjects->GetCurrentMeshObject();
+			ASSERT_TRUE(mesh->GetFileBackedStorageActive());
+			ASSERT_FALSE(inMemoryMesh->GetFileBackedStorageActive());
+
+			std::vector<sLib3MFPosition> vertices, inMemoryVertices;
+			mesh->GetVertices(vertices);
+			inMemoryMesh->GetVertices(inMemoryVertices);
+			ASSERT_EQ(vertices.size(), inMemoryVertices.size());
+			for (size_t i = 0; i < vertices.size(); i++)
+				for (int j = 0; j < 3; j++)
+					ASSERT_EQ(vertices[i].m_Coordinates[j], inMemoryVertices[i].m_Coordinates[j]);
+
+			std::vector<sLib3MFTriangle> triangles, inMemoryTriangles;
+			mesh->GetTriangleIndices(triangles);
+			inMemoryMesh->GetTriangleIndices(inMemoryTriangles);
+			ASSERT_EQ(triangles.size(), inMemoryTriangles.size());
+			for (size_t i = 0; i < triangles.size(); i++)
+				for (int j = 0; j < 3; j++)
+					ASSERT_EQ(triangles[i].m_Indices[j], inMemoryTriangles[i].m_Indices[j]);
+
+			// Moving the mesh back to memory keeps it as it is
+			mesh->SetFileBackedStorageActive(false, "");
+			ASSERT_FALSE(mesh->GetFileBackedStorageActive());
+			ASSERT_EQ(mesh->GetVertexCount(), (Lib3MF_uint32)inMemoryVertices.size());
+		}
+	}
+
+	TEST_F(Reader, 3MFReadWriteLargeFileBackedMesh)
+	{
+		// The coordinate and index arrays are large enough to be kept in the temporary file
+		std::vector<sLib3MFPosition> vctVertices;
+		std::vector<sLib3MFTriangle> vctTriangles;
+		CreateStripGeometry(300000, vctVertices, vctTriangles);
+
+		auto sourceModel = wrapper->CreateModel();
+		auto sourceMesh = sourceModel->AddMeshObject();
+		sourceMesh->SetFileBackedStorageActive(true, "");
+		sourceMesh->SetGeometry(vctVertices, vctTriangles);
+		ASSERT_TRUE(sourceMesh->GetFileBackedStorageActive());
+		sourceModel->AddBuildItem(sourceMesh.get(), getIdentityTransform());
+		std::vector<Lib3MF_uint8> buffer;
+		sourceModel->QueryWriter("3mf")->WriteToBuffer(buffer);
+
+		Reader::reader3MF->SetFileBackedMeshStorageActive(true, "");
+		Reader::reader3MF->ReadFromBuffer(buffer);
+		CheckReaderWarnings(Reader::reader3MF, 0);
+		auto meshObjects = Reader::model->GetMeshObjects();
+		ASSERT_TRUE(meshObjects->MoveNext());
+		auto mesh = meshObjects->GetCurrentMeshObject();
+		ASSERT_TRUE(mesh->GetFileBackedStorageActive());
+
+		for (auto currentMesh : { sourceMesh, mesh }) {
+			std::vector<sLib3MFPosition> vctPositions;
+			currentMesh->GetVertices(vctPositions);
+			ASSERT_EQ(vctPositions.size(), vctVertices.size());
+			for (size_t i = 0; i < vctPositions.size(); i++)
+				for (int j = 0; j < 3; j++)
+					ASSERT_EQ(vctPositions[i].m_Coordinates[j], vctVertices[i].m_Coordinates[j]);
+
+			std::vector<sLib3MFTriangle> vctIndices;
+			currentMesh->GetTriangleIndices(vctIndices);
+			ASSERT_EQ(vctIndices.size(), vctTriangles.size());
+			for (size_t i = 0; i < vctIndices.size(); i++)
+				for (int j = 0; j < 3; j++)
+					ASSERT_EQ(vctIndices[i].m_Indices[j], vctTriangles[i].m_Indices[j]);
+		}
+	}
+
+	TEST_F(Reader, 3MFReadAndQuantizeReleasesPagedStorage)
+	{
+		std::vector<sLib3MFPosition> vctVertices;
+		std::vector<sLib3MFTriangle> vctTriangles;
+		CreateStripGeometry(300000, vctVertices, vctTriangles);
+
+		auto sourceModel = wrapper->CreateModel();
+		auto sourceMesh = sourceModel->AddMeshObject();
+		sourceMesh->SetGeometry(vctVertices, vctTriangles);
+		sourceModel->AddBuildItem(sourceMesh.get(), getIdentityTransform());
+		std::vector<Lib3MF_uint8> buffer;
+		sourceModel->QueryWriter("3mf")->WriteToBuffer(buffer);
+		sourceModel.reset();
+		sourceMesh.reset();
+
+		Reader::reader3MF->ReadFromBuffer(buffer);
+		CheckReaderWarnings(Reader::reader3MF, 0);
+		auto meshObjects = Reader::model->GetMeshObjects();
+		ASSERT_TRUE(meshObjects->MoveNext());
+		auto mesh = meshObjects->GetCurrentMeshObject();
+
+		// The read mesh is in paged storage. Quantizing it has to free the paged blocks, which take more
+		// memory than the quantized coordinates and the node indices.
+		Lib3MF_uint64 nHeapSizeBefore = GetHeapSizeInUse();
+		mesh->SetQuantizedStorageActive(true, fnCreateVertex(0.0f, 0.0f, 0.0f), 0.01, 16);
+		Lib3MF_uint64 nHeapSizeAfter = GetHeapSizeInUse();
+		if (nHeapSizeBefore > 0)
+			ASSERT_LT(nHeapSizeAfter, nHeapSizeBefore);
+
+		std::vector<sLib3MFPosition> vctPositions;
+		mesh->GetVertices(vctPositions);
+		ASSERT_EQ(vctPositions.size(), vctVertices.size());
+		for (size_t i = 0; i < vctPositions.size(); i++)
+			for (int j = 0; j < 3; j++)
+				ASSERT_NEAR(vctPositions[i].m_Coordinates[j], vctVertices[i].m_Coordinates[j], 0.005);
+	}
+
+	TEST_F(Reader, 3MFParallelMeshParsingOption)
+	{
+		ASSERT_FALSE(Reader::reader3MF->GetParallelMeshParsingActive());
+		Reader::reader3MF->SetParallelMeshParsingActive(true);
+		ASSERT_TRUE(Reader::reader3MF->GetParallelMeshParsingActive());
+		Reader::reader3MF->SetParallelMeshParsingActive(false);
+		ASSERT_FALSE(Reader::reader3MF->GetParallelMeshParsingActive());
+
+		ASSERT_FALSE(Reader::readerSTL->GetParallelMeshParsingActive());
+		ASSERT_THROW(Reader::readerSTL->SetParallelMeshParsingActive(true), ELib3MFException);
+	}
+
+	TEST_F(Reader, 3MFParallelMeshParsingFromBuffer)
+	{
+		// Large enough to be split into several ranges
+		std::vector<sLib3MFPosition> vctVertices;
+		std::vector<sLib3MFTriangle> vctTriangles;
+		CreateStripGeometry(300000, vctVertices, vctTriangles);
+
+		auto sourceModel = wrapper->CreateModel();
+		auto sourceMesh = sourceModel->AddMeshObject();
+		sourceMesh->SetGeometry(vctVertices, vctTriangles);
+		sourceModel->AddBuildItem(sourceMesh.get(), getIdentityTransform());
+		std::vector<Lib3MF_uint8> buffer;
+		sourceModel->QueryWriter("3mf")->WriteToBuffer(buffer);
+
+		CheckParallelMeshParsing([&buffer](PReader reader) {
+			reader->ReadFromBuffer(buffer);
+			CheckReaderWarnings(reader, 0);
+		});
+
+		auto pyramidBuffer = ReadFileIntoBuffer(sTestFilesPath + "/Reader/" + "Pyramid.3mf");
+		CheckParallelMeshParsing([&pyramidBuffer](PReader reader) {
+			reader->ReadFromBuffer(pyramidBuffer);
+			CheckReaderWarnings(reader, 0);
+		});
+	}
+
+	TEST_F(Reader, 3MFParallelMeshParsingFromFile)
+	{
+		std::vector<sLib3MFPosition> vctVertices;
+		std::vector<sLib3MFTriangle> vctTriangles;
+		CreateStripGeometry(300000, vctVertices, vctTriangles);
+
+		auto sourceModel = wrapper->CreateModel();
+		auto sourceMesh = sourceModel->AddMeshObject();
+		sourceMesh->SetGeometry(vctVertices, vctTriangles);
+		sourceModel->AddBuildItem(sourceMesh.get(), getIdentityTransform());
+		std::string sFileName = sOutFilesPath + "ParallelMeshParsing.3mf";
+		sourceModel->QueryWriter("3mf")->WriteToFile(sFileName);
+
+		CheckParallelMeshParsing([&sFileName](PReader reader) {
+			reader->ReadFromFile(sFileName);
+			CheckReaderWarnings(reader, 0);
+		});
+
+		CheckParallelMeshParsing([](PReader reader) {
+			reader->ReadFromFile(sTestFilesPath + "/Reader/" + "Pyramid.3mf");
+			CheckReaderWarnings(reader, 0);
+		});
+	}
+
+	TEST_F(Reader, 3MFParallelMeshParsingFallback)
+	{
+		// These triangle blocks are left to the streaming reader
+		for (auto sFileName : { "PyramidWithComment.3mf", "PyramidWithEscapedIndex.3mf", "PyramidWithUnknownAttribute.3mf", "PyramidWithInvalidIndex.3mf" }) {
+			std::string sPath = sTestFilesPath + "/Reader/" + sFileName;
+			CheckParallelMeshParsing([&sPath](PReader reader) {
+				reader->ReadFromFile(sPath);
+			});
+
+			auto buffer = ReadFileIntoBuffer(sPath);
+			CheckParallelMeshParsing([&buffer](PReader reader) {
+				reader->ReadFromBuffer(buffer);
+			});
+		}
+
+		Reader::reader3MF->SetParallelMeshParsingActive(true);
+		Reader::reader3MF->ReadFromFile(sTestFilesPath + "/Reader/" + "PyramidWithUnknownAttribute.3mf");
+		CheckReaderWarnings(Reader::reader3MF, 1);
+
+		auto invalidModel = wrapper->CreateModel();
+		auto invalidReader = invalidModel->QueryReader("3mf");
+		invalidReader->SetParallelMeshParsingActive(true);
+		ASSERT_THROW(invalidReader->ReadFromFile(sTestFilesPath + "/Reader/" + "PyramidWithInvalidIndex.3mf"), ELib3MFException);
+	}
+
 }
@@ -33,6 +33,9 @@ UnitTest_Writer.cpp: Defines Unittests for the Writer classes
 #include "UnitTest_Utilities.h"
 #include "lib3mf_implicit.hpp"
 
+#include <algorithm>
+#include <array>
+
 namespace Lib3MF
 {
 	class Writer : public ::testing::Test {
@@ -126,6 +129,74 @@ namespace Lib3MF
 		ASSERT_TRUE(buffer.size() < bufferLargr.size());
 	}
 
+	// Triangles by the positions of their corners, each rotated to start at its smallest corner
+	static std::vector<std::array<Lib3MF_single, 9>> GetTriangleCorners(PMeshObject pMesh)
+	{
+		std::vector<sPosition> vctVertices;
+		std::vector<sTriangle> vctTriangles;
+		pMesh->GetVertices(vctVertices);
+		pMesh->GetTriangleIndices(vctTriangles);
+
+		std::vector<std::array<Lib3MF_single, 9>> vctCorners;
+		for (auto triangle : vctTriangles) {
+			std::array<std::array<Lib3MF_single, 3>, 3> corners;
+			for (int j = 0; j < 3; j++)
+				for (int k = 0; k < 3; k++)
+					corners[j][k] = vctVertices[triangle.m_Indices[j]].m_Coordinates[k];
+			std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end()), corners.end());
+
+			std::array<Lib3MF_single, 9> triangleCorners;
+			for (int j = 0; j < 3; j++)
+				for (int k = 0; k < 3; k++)
+					triangleCorners[j * 3 + k] = corners[j][k];
+			vctCorners.push_back(triangleCorners);
+		}
+		std::sort(vctCorners.begin(), vctCorners.end());
+		return vctCorners;
+	}
+
+	TEST_F(Writer, 3MFMeshReordering)
+	{
+		std::vector<sPosition> vctVertices;
+		std::vector<sTriangle> vctTriangles;
+		fnCreateBox(vctVertices, vctTriangles);
+		std::reverse(vctTriangles.begin(), vctTriangles.end());
+		auto mesh = model->AddMeshObject();
+		mesh->SetGeometry(vctVertices, vctTriangles);
+		model->AddBuildItem(mesh.get(), getIdentityTransform());
+		auto vctCorners = GetTriangleCorners(mesh);
+
+		ASSERT_FALSE(writer3MF->GetMeshReorderingActive());
+		writer3MF->SetMeshReorderingActive(true);
+		ASSERT_TRUE(writer3MF->GetMeshReorderingActive());
+		std::vector<Lib3MF_uint8> buffer;
+		writer3MF->WriteToBuffer(buffer);
+
+		// The model itself keeps its order
+		std::vector<sTriangle> vctWrittenTriangles;
+		mesh->GetTriangleIndices(vctWrittenTriangles);
+		for (size_t i = 0; i < vctTriangles.size(); i++)
+			for (int j = 0; j < 3; j++)
+				ASSERT_EQ(vctWrittenTriangles[i].m_Indices[j], vctTriangles[i].m_Indices[j]);
+
+		auto readModel = wrapper->CreateModel();
+		readModel->QueryReader("3mf")->ReadFromBuffer(buffer);
+		auto readMeshes = readModel->GetMeshObjects();
+		PMeshObject readMesh;
+		while (readMeshes->MoveNext())
+			readMesh = readMeshes->GetCurrentMeshObject();
+		ASSERT_TRUE(readMesh != nullptr);
+		ASSERT_EQ(readMesh->GetVertexCount(), vctVertices.size());
+		ASSERT_EQ(readMesh->GetTriangleCount(), vctTriangles.size());
+		ASSERT_TRUE(GetTriangleCorners(readMesh) == vctCorners);
+
+		std::vector<sTriangle> vctReadTriangles;
+		readMesh->GetTriangleIndices(vctReadTriangles);
+		ASSERT_EQ(vctReadTriangles[0].m_Indices[0], 0u);
+		ASSERT_EQ(vctReadTriangles[0].m_Indices[1], 1u);
+		ASSERT_EQ(vctReadTriangles[0].m_Indices[2], 2u);
+	}
+
 	TEST_F(Writer, STLCompare)
 	{
 		// This test is atleast functional